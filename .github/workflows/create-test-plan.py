@@ -460,6 +460,8 @@ def spec_to_job(spec: JobSpec, key: str, trackmem_symbol_names: bool) -> JobDeta
                 ubuntu_year, ubuntu_month = [int(match["year"]), int(match["month"])]
                 if ubuntu_year >= 22:
                     job.apt_packages.extend(("libpipewire-0.3-dev", "libdecor-0-dev"))
+                if ubuntu_year >= 24:
+                    job.apt_packages.append("liburing-dev")  # the io_uring async I/O backend wants liburing 2.2 or later
                 job.apt_packages.extend((
                     "libunwind-dev",  # For SDL_test memory tracking
                 ))
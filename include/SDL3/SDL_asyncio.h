@@ -104,6 +104,7 @@
 #define SDL_asyncio_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -132,7 +133,8 @@ typedef enum SDL_AsyncIOTaskType
 {
     SDL_ASYNCIO_TASK_READ,   /**< A read operation. */
     SDL_ASYNCIO_TASK_WRITE,  /**< A write operation. */
-    SDL_ASYNCIO_TASK_CLOSE   /**< A close operation. */
+    SDL_ASYNCIO_TASK_CLOSE,  /**< A close operation. */
+    SDL_ASYNCIO_TASK_COPY    /**< A file copy operation, from SDL_CopyFileAsync(). */
 } SDL_AsyncIOTaskType;
 
 /**
@@ -381,6 +383,169 @@ extern SDL_DECLSPEC bool SDLCALL SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, bool flu
  */
 extern SDL_DECLSPEC SDL_AsyncIOQueue * SDLCALL SDL_CreateAsyncIOQueue(void);
 
+/**
+ * Priority classes for async I/O task queues.
+ *
+ * Backends that run requests on their own worker threads start work queued
+ * on higher priority queues before work on lower priority ones, so a few
+ * small urgent reads don't have to wait behind a large background transfer.
+ * Backends that hand requests straight to the operating system ignore this.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAsyncIOQueueWithProperties
+ */
+typedef enum SDL_AsyncIOPriority
+{
+    SDL_ASYNCIO_PRIORITY_LOW,     /**< Background work, like prefetching or saving. */
+    SDL_ASYNCIO_PRIORITY_NORMAL,  /**< The default for new queues. */
+    SDL_ASYNCIO_PRIORITY_HIGH     /**< Work the app is about to block on. */
+} SDL_AsyncIOPriority;
+
+/**
+ * Create a task queue for tracking multiple I/O operations, with the
+ * specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER`: the number of operations
+ *   the backend can have submitted at once, if the backend uses a
+ *   fixed-size submission queue. Defaults to 128.
+ * - `SDL_PROP_ASYNCIOQUEUE_CREATE_SQPOLL_BOOLEAN`: true to ask the backend
+ *   to use a kernel thread that polls for new requests, so submitting work
+ *   doesn't need a system call. This trades CPU time for latency and is
+ *   silently ignored if the backend or system doesn't support it. Defaults
+ *   to false.
+ * - `SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_FILES_NUMBER`: the number of
+ *   files that can be registered with the kernel for this queue. Files used
+ *   with the queue are registered on first use, while there are free slots,
+ *   which lowers the per-operation overhead for long-lived SDL_AsyncIO
+ *   objects. Defaults to 0.
+ * - `SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER`: the number of
+ *   buffers that can be registered with SDL_RegisterAsyncIOBuffer() for this
+ *   queue. Defaults to 0.
+ * - `SDL_PROP_ASYNCIOQUEUE_CREATE_PRIORITY_NUMBER`: an SDL_AsyncIOPriority
+ *   value for work on this queue. Defaults to SDL_ASYNCIO_PRIORITY_NORMAL.
+ *
+ * The priority is used by the threadpool backend that SDL falls back to when
+ * no native async I/O is available. The other properties are currently only
+ * used by the io_uring backend on Linux. Backends accept and ignore
+ * properties they don't use.
+ *
+ * \param props the properties to use.
+ * \returns a new task queue object or NULL if there was an error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ * \sa SDL_DestroyAsyncIOQueue
+ * \sa SDL_BeginAsyncIOBatch
+ * \sa SDL_RegisterAsyncIOBuffer
+ */
+extern SDL_DECLSPEC SDL_AsyncIOQueue * SDLCALL SDL_CreateAsyncIOQueueWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER             "SDL.asyncioqueue.create.entries"
+#define SDL_PROP_ASYNCIOQUEUE_CREATE_SQPOLL_BOOLEAN             "SDL.asyncioqueue.create.sqpoll"
+#define SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_FILES_NUMBER    "SDL.asyncioqueue.create.registered_files"
+#define SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER  "SDL.asyncioqueue.create.registered_buffers"
+#define SDL_PROP_ASYNCIOQUEUE_CREATE_PRIORITY_NUMBER            "SDL.asyncioqueue.create.priority"
+
+/**
+ * Start batching async I/O requests made on a task queue.
+ *
+ * While a batch is open, backends that support it will collect new requests
+ * for this queue instead of handing each one to the operating system
+ * individually, and submit all of them at once when SDL_EndAsyncIOBatch() is
+ * called. This can greatly reduce system call overhead when starting many
+ * small operations at the same time.
+ *
+ * Requests made during a batch might not start until the batch ends, so
+ * don't wait for their results before ending it. Batching applies to the
+ * whole queue, including requests made by other threads. Batches may be
+ * nested; requests are submitted when the outermost batch ends.
+ *
+ * Backends that don't support batching start requests immediately, as
+ * usual.
+ *
+ * \param queue the task queue to batch requests for.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndAsyncIOBatch
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_BeginAsyncIOBatch(SDL_AsyncIOQueue *queue);
+
+/**
+ * Submit all async I/O requests collected since SDL_BeginAsyncIOBatch().
+ *
+ * \param queue the task queue to end the batch on.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BeginAsyncIOBatch
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_EndAsyncIOBatch(SDL_AsyncIOQueue *queue);
+
+/**
+ * Register a memory buffer with a task queue.
+ *
+ * Backends that support it will pin the memory and map it into the kernel
+ * once, so reads and writes through this queue that fall entirely inside
+ * this buffer don't have to do so for every operation. The queue must have
+ * been created with `SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER`
+ * set to a non-zero value for this to have any effect.
+ *
+ * On backends without support for registered buffers, this function does
+ * nothing and returns true.
+ *
+ * The buffer must remain valid until it is unregistered with
+ * SDL_UnregisterAsyncIOBuffer() or the queue is destroyed.
+ *
+ * \param queue the task queue to register the buffer with.
+ * \param buffer the memory to register.
+ * \param size the size of the memory, in bytes.
+ * \returns true on success or false on failure (for example, if all slots are
+ *          in use or the memory can't be locked); call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAsyncIOQueueWithProperties
+ * \sa SDL_UnregisterAsyncIOBuffer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RegisterAsyncIOBuffer(SDL_AsyncIOQueue *queue, void *buffer, size_t size);
+
+/**
+ * Unregister a memory buffer previously registered with a task queue.
+ *
+ * Operations already in flight that use the buffer are unaffected.
+ *
+ * \param queue the task queue the buffer was registered with.
+ * \param buffer the memory that was passed to SDL_RegisterAsyncIOBuffer().
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RegisterAsyncIOBuffer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnregisterAsyncIOBuffer(SDL_AsyncIOQueue *queue, void *buffer);
+
 /**
  * Destroy a previously-created async I/O task queue.
  *
@@ -537,6 +702,42 @@ extern SDL_DECLSPEC void SDLCALL SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata);
 
+/**
+ * Copy a file, asynchronously.
+ *
+ * This does the same work as SDL_CopyFile(), including letting the OS copy
+ * the data without passing it through the app where possible, but returns
+ * as quickly as possible; it does not wait for the copy to complete. On a
+ * successful return, this work will continue in the background. If the work
+ * begins, even failure is asynchronous: a failing return value from this
+ * function only means the work couldn't start at all.
+ *
+ * When the copy is done, a task of type SDL_ASYNCIO_TASK_COPY is added to
+ * `queue`. Its asyncio and buffer fields are NULL, bytes_requested is the
+ * size of `oldpath` when the copy started, and bytes_transferred is the
+ * number of bytes copied.
+ *
+ * A copy in progress can't be canceled. SDL_DestroyAsyncIOQueue() will block
+ * until any copies added to the queue have finished.
+ *
+ * The same caveats about atomicity apply here as with SDL_CopyFile().
+ *
+ * \param oldpath the old path.
+ * \param newpath the new path.
+ * \param queue a queue to add the new task to when it completes.
+ * \param userdata an app-defined pointer that will be provided with the task
+ *                 results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CopyFile
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CopyFileAsync(const char *oldpath, const char *newpath, SDL_AsyncIOQueue *queue, void *userdata);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -437,6 +437,26 @@ typedef struct SDL_MouseDeviceEvent
     SDL_MouseID which;  /**< The mouse instance id */
 } SDL_MouseDeviceEvent;
 
+/**
+ * A single raw motion sample merged into a motion event.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is set to "2", consecutive motion
+ * events are merged into one, and the individual events are available
+ * through the `samples` field of SDL_MouseMotionEvent and SDL_PenMotionEvent.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+typedef struct SDL_MotionSample
+{
+    Uint64 timestamp;   /**< In nanoseconds, populated using SDL_GetTicksNS() */
+    float x;            /**< X coordinate, relative to window */
+    float y;            /**< Y coordinate, relative to window */
+    float xrel;         /**< The relative motion in the X direction, 0 for pen motion */
+    float yrel;         /**< The relative motion in the Y direction, 0 for pen motion */
+} SDL_MotionSample;
+
 /**
  * Mouse motion event structure (event.motion.*)
  *
@@ -454,6 +474,8 @@ typedef struct SDL_MouseMotionEvent
     float y;            /**< Y coordinate, relative to window */
     float xrel;         /**< The relative motion in the X direction */
     float yrel;         /**< The relative motion in the Y direction */
+    int num_samples;    /**< The number of entries in `samples`, 0 if no motion history was recorded (added in 3.4.0) */
+    const SDL_MotionSample *samples; /**< The raw motion merged into this event, oldest first, or NULL. This is only set if SDL_HINT_EVENT_COALESCE_MOTION is "2" and will be freed later (added in 3.4.0) */
 } SDL_MouseMotionEvent;
 
 /**
@@ -826,6 +848,8 @@ typedef struct SDL_PenMotionEvent
     SDL_PenInputFlags pen_state;   /**< Complete pen input state at time of event */
     float x;                /**< X coordinate, relative to window */
     float y;                /**< Y coordinate, relative to window */
+    int num_samples;        /**< The number of entries in `samples`, 0 if no motion history was recorded (added in 3.4.0) */
+    const SDL_MotionSample *samples; /**< The raw motion merged into this event, oldest first, or NULL. This is only set if SDL_HINT_EVENT_COALESCE_MOTION is "2" and will be freed later (added in 3.4.0) */
 } SDL_PenMotionEvent;
 
 /**
@@ -1224,6 +1248,38 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvent(Uint32 type);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
 
+/**
+ * Remove events of a set of types from the event queue.
+ *
+ * Up to `numevents` events whose type is one of `types` are removed from the
+ * queue and stored in `events`, in the order they were queued. Events of
+ * other types are left in the queue.
+ *
+ * The event queue keeps a separate list of queued events for each event
+ * type, so the cost of this function depends on the number of matching
+ * events, not on the total number of events in the queue. This makes it a
+ * cheap way to pull out, for example, just the mouse motion events for a
+ * frame.
+ *
+ * You may have to call SDL_PumpEvents() before calling this function.
+ *
+ * \param events destination buffer for the retrieved events.
+ * \param numevents the maximum number of events to retrieve.
+ * \param types an array of event types to retrieve; see SDL_EventType for
+ *              details.
+ * \param numtypes the number of entries in `types`.
+ * \returns the number of events actually stored or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FlushEvents
+ * \sa SDL_PeepEvents
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_DrainEvents(SDL_Event *events, int numevents, const Uint32 *types, int numtypes);
+
 /**
  * Poll for currently pending events.
  *
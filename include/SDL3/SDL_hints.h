@@ -459,6 +459,21 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DUMMY_TIMESCALE "SDL_AUDIO_DUMMY_TIMESCALE"
 
+/**
+ * A variable that makes the dummy audio driver act as if the device changed
+ * its buffer size.
+ *
+ * When this is set to a number of sample frames that differs from the opened
+ * device's, the dummy audio driver reports a format change to that buffer
+ * size, the way some real audio devices can change format while they are
+ * open. This is useful for testing. By default this is not set.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES "SDL_AUDIO_DUMMY_SAMPLE_FRAMES"
+
 /**
  * A variable controlling the default audio format.
  *
@@ -522,6 +537,30 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_INCLUDE_MONITORS "SDL_AUDIO_INCLUDE_MONITORS"
 
+/**
+ * A variable controlling the number of worker threads used to pull audio
+ * streams bound to playback devices.
+ *
+ * By default, each playback device thread converts and resamples its bound
+ * streams one after another. If this is set to a number greater than zero,
+ * SDL creates that many worker threads, shared by all playback devices, and
+ * a device with more than one bound stream will pull them in parallel
+ * before mixing. The streams are still mixed in the order they were bound,
+ * so the output is identical either way.
+ *
+ * When this is enabled, audio stream get callbacks might run on these
+ * worker threads instead of the device thread, and all of a physical
+ * device's logical devices have their iteration callbacks started before
+ * any of their streams are pulled.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before the audio subsystem is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_MIXER_THREADS "SDL_AUDIO_MIXER_THREADS"
+
 /**
  * A variable controlling whether SDL updates joystick state when getting
  * input events.
@@ -613,6 +652,7 @@ extern "C" {
  * - "avx"
  * - "avx2"
  * - "avx512f"
+ * - "avx512bw" (since SDL 3.4.0)
  * - "arm-simd"
  * - "neon"
  * - "lsx"
@@ -796,6 +836,56 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING "SDL_EVENT_LOGGING"
 
+/**
+ * A variable controlling whether events can be pushed onto the event queue
+ * without taking the event queue lock.
+ *
+ * When enabled, SDL_PushEvent() and SDL_PeepEvents() with SDL_ADDEVENT place
+ * events into a bounded ring buffer that any number of threads can fill
+ * concurrently, and the events are moved into the main queue the next time
+ * it is inspected. This reduces contention when many threads post events at
+ * a high rate. If the ring buffer fills up, events are added through the
+ * locked path, so no events are lost and the order of events pushed from a
+ * single thread is preserved.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Events are always added with the event queue locked. (default)
+ * - "1": Events are added through the lock-free ring buffer when possible.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_QUEUE_LOCKFREE "SDL_EVENT_QUEUE_LOCKFREE"
+
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * High rate mice and pens can generate thousands of motion events per second.
+ * When this is enabled, a SDL_EVENT_MOUSE_MOTION or SDL_EVENT_PEN_MOTION event
+ * that directly follows a motion event for the same window, device and button
+ * state at the end of the queue is merged into it: the relative motion is
+ * accumulated and the latest position and timestamp are kept.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Motion events are not merged. (default)
+ * - "1": Consecutive motion events are merged.
+ * - "2": Consecutive motion events are merged, and the individual events are
+ *   kept in the `samples` field of the merged event.
+ *
+ * The samples of an event that is peeked at with SDL_PeepEvents() stay valid
+ * until that event is removed from the queue, even if more motion is merged
+ * into it afterwards.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling whether raising the window should be done more
  * forcefully.
@@ -3042,6 +3132,29 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling the number of worker threads used by the software
+ * renderer.
+ *
+ * By default, the software renderer draws each command in order on the
+ * thread that flushes the command queue. If this is set to a number greater
+ * than zero, the renderer creates that many worker threads, splits its
+ * target into tiles, and the workers and the flushing thread draw different
+ * tiles at the same time. Each tile still sees the commands in the order
+ * they were queued, so the output is identical either way.
+ *
+ * Lines, scaled and rotated copies, and anything else that can't be split
+ * exactly along tile edges are still drawn on the flushing thread, between
+ * the parallel batches.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -3196,6 +3309,77 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling whether surfaces are RLE encoded automatically.
+ *
+ * When this is enabled, the first time a colorkeyed or alpha blended surface
+ * is blitted, SDL tries to RLE encode it as if SDL_SetSurfaceRLE() had been
+ * called, and keeps the encoding if large parts of the surface are
+ * transparent. Encoded surfaces must be locked before accessing the pixels,
+ * so only enable this if your application always checks SDL_MUSTLOCK().
+ * Alpha blended blits of encoded surfaces may differ slightly from the
+ * regular blitters.
+ *
+ * Surfaces created from application memory and surfaces where RLE was
+ * disabled with SDL_SetSurfaceRLE() are never encoded automatically.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Surfaces are only RLE encoded when requested. (default)
+ * - "1": Surfaces with large transparent areas are RLE encoded automatically.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_AUTO_RLE "SDL_SURFACE_AUTO_RLE"
+
+/**
+ * A variable controlling whether surface blits without a specialized
+ * blitter are run as a cached pipeline of conversion stages.
+ *
+ * Blits between pixel formats that SDL has no dedicated blitter for are
+ * broken into stages (unpack, color modulation, blending, pack) that are
+ * chosen once and then run over whole rows. Disabling this falls back to
+ * converting one pixel at a time, which is much slower but is useful for
+ * checking that the pipeline gives the same results.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Blits without a specialized blitter convert one pixel at a time.
+ * - "1": Blits without a specialized blitter use the stage pipeline.
+ *   (default)
+ *
+ * This hint is checked when a blit between two surfaces is first set up, so
+ * it should be set before blitting.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_BLIT_PIPELINE "SDL_SURFACE_BLIT_PIPELINE"
+
+/**
+ * A variable controlling the number of worker threads used for large surface
+ * operations.
+ *
+ * By default, surface operations run on the calling thread. If this is set
+ * to a number greater than zero, SDL creates that many worker threads, and
+ * SDL_ConvertPixels(), SDL_ConvertSurface(), SDL_BlitSurface(),
+ * SDL_PremultiplyAlpha() and SDL_StretchSurface() split large images into
+ * bands of rows that the workers and the calling thread process at the same
+ * time. Every row is computed the same way either way, so the output is
+ * identical to the single threaded result.
+ *
+ * Scaled blits, blits to paletted surfaces and RLE blits always run on the
+ * calling thread, as do operations on images smaller than 256x256 pixels.
+ *
+ * The default value is "0".
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_THREADS "SDL_SURFACE_THREADS"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -3268,6 +3452,29 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ * A variable controlling the number of worker threads used to run timer
+ * callbacks.
+ *
+ * By default, all timer callbacks run one after another on a single timer
+ * thread, so a slow callback delays every other timer. If this is set to a
+ * number greater than zero, the timer thread only tracks deadlines and hands
+ * expired timers to a pool of that many worker threads. A single timer's
+ * callback never runs on more than one thread at a time.
+ *
+ * Individual timers can be pinned to a worker with
+ * `SDL_PROP_TIMER_CREATE_WORKER_NUMBER`.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before the first timer is created.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddTimerWithProperties
+ */
+#define SDL_HINT_TIMER_WORKER_THREADS "SDL_TIMER_WORKER_THREADS"
+
 /**
  * A variable controlling whether touch events should generate synthetic mouse
  * events.
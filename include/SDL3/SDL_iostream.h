@@ -225,6 +225,16 @@ typedef struct SDL_IOStream SDL_IOStream;
  * effect. For example, "t" is sometimes appended to make explicit the file is
  * a text file.
  *
+ * An "m" character may be added to a read-only mode ("rm", "rbm") to ask for
+ * the file to be memory mapped. Reads from a mapped file are copied straight
+ * out of the mapping, and the mapping itself is available through the
+ * `SDL_PROP_IOSTREAM_MEMORY_POINTER` property, so data can be used in place
+ * without being copied at all. If the file can't be mapped, it is opened
+ * normally. On Unix platforms, if another process truncates the file while
+ * it is mapped, touching the pages past the new end of the file raises
+ * SIGBUS and crashes the program instead of failing the read, so only use
+ * "m" for files that nothing else writes to. (since SDL 3.4.0)
+ *
  * This function supports Unicode filenames, but they must be encoded in UTF-8
  * format, regardless of the underlying operating system.
  *
@@ -253,6 +263,11 @@ typedef struct SDL_IOStream SDL_IOStream;
  *   to an Android NDK `AAsset *`, that this SDL_IOStream is using to access
  *   the filesystem. If SDL used some other method to access the filesystem,
  *   this property will not be set.
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: a pointer to the start of the file,
+ *   if it was memory mapped. The memory is read-only and stays valid until
+ *   the stream is closed. (since SDL 3.4.0)
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: the size of the file, if it was
+ *   memory mapped. (since SDL 3.4.0)
  *
  * \param file a UTF-8 string representing the filename to open.
  * \param mode an ASCII string representing the mode to be used for opening
@@ -493,6 +508,40 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetIOProperties(SDL_IOStream *c
  */
 extern SDL_DECLSPEC SDL_IOStatus SDLCALL SDL_GetIOStatus(SDL_IOStream *context);
 
+/**
+ * Set the size of the userspace buffer of an SDL_IOStream.
+ *
+ * By default, every read and write goes straight to the stream's
+ * implementation, which for files can mean a system call for each
+ * SDL_ReadU32LE() or similar. With a buffer, reads fetch `size` bytes at a
+ * time and small writes are collected until the buffer is full, so parsing
+ * or writing many small fields only touches the underlying stream
+ * occasionally. Reads and writes at least as large as the buffer bypass it.
+ *
+ * Buffered writes are sent to the stream by SDL_FlushIO(), SDL_SeekIO(),
+ * SDL_GetIOSize(), SDL_CloseIO(), a following read, or when the buffer
+ * fills up. Errors writing the buffer are reported by whichever of these
+ * triggered it, not by the SDL_WriteIO() call that added the data.
+ *
+ * Switching between reading and writing on a buffered stream requires the
+ * stream to be seekable, as read-ahead data has to be given back first.
+ *
+ * Any pending writes are flushed and read-ahead data is discarded before the
+ * buffer is resized.
+ *
+ * \param context the SDL_IOStream to change.
+ * \param size the size of the buffer in bytes, or 0 to disable buffering.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FlushIO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetIOBufferSize(SDL_IOStream *context, size_t size);
+
 /**
  * Use this function to get the size of the data stream in an SDL_IOStream.
  *
@@ -724,6 +773,53 @@ extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile_IO(SDL_IOStream *src, size_t *da
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile(const char *file, size_t *datasize);
 
+/**
+ * A callback that releases file data returned by SDL_LoadFileNoCopy().
+ *
+ * \param userdata the userdata returned along with the data.
+ * \param data the data returned by SDL_LoadFileNoCopy().
+ *
+ * \threadsafety This callback may be called from any thread.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadFileNoCopy
+ */
+typedef void (SDLCALL *SDL_ReleaseFileDataCallback)(void *userdata, const void *data);
+
+/**
+ * Load all the data from a file path without copying it, where possible.
+ *
+ * Where the platform allows it, the file is memory mapped and the mapping
+ * itself is returned, so the data is paged in from the file as it is used
+ * and never takes up heap memory. Otherwise this falls back to
+ * SDL_LoadFile().
+ *
+ * The data is read-only and is not null terminated. When you are done with
+ * it, release it by calling `release(userdata, data)`, using the values this
+ * function stored in `release` and `userdata`.
+ *
+ * Mapped data reflects the file on disk until it is released. On Unix
+ * platforms, if another process truncates the file in the meantime, touching
+ * the data past the new end of the file raises SIGBUS and crashes the
+ * program. Use SDL_LoadFile() instead for files that may be changed while in
+ * use.
+ *
+ * \param file the path to read all available data from.
+ * \param datasize if not NULL, will store the number of bytes read.
+ * \param release a pointer filled in with the function to release the data.
+ * \param userdata a pointer filled in with the userdata to pass to `release`.
+ * \returns the data or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadFile
+ */
+extern SDL_DECLSPEC const void * SDLCALL SDL_LoadFileNoCopy(const char *file, size_t *datasize, SDL_ReleaseFileDataCallback *release, void **userdata);
+
 /**
  * Save all the data into an SDL data stream.
  *
@@ -1084,6 +1180,150 @@ extern SDL_DECLSPEC bool SDLCALL SDL_ReadU64BE(SDL_IOStream *src, Uint64 *value)
  * \since This function is available since SDL 3.2.0.
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_ReadS64BE(SDL_IOStream *src, Sint64 *value);
+
+/**
+ * Use this function to read an array of 16-bit little-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU16LE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU16LEArray(SDL_IOStream *src, Uint16 *values, size_t count);
+
+/**
+ * Use this function to read an array of 16-bit big-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU16BE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU16BEArray(SDL_IOStream *src, Uint16 *values, size_t count);
+
+/**
+ * Use this function to read an array of 32-bit little-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU32LE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU32LEArray(SDL_IOStream *src, Uint32 *values, size_t count);
+
+/**
+ * Use this function to read an array of 32-bit big-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU32BE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU32BEArray(SDL_IOStream *src, Uint32 *values, size_t count);
+
+/**
+ * Use this function to read an array of 64-bit little-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU64LE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU64LEArray(SDL_IOStream *src, Uint64 *values, size_t count);
+
+/**
+ * Use this function to read an array of 64-bit big-endian values from an
+ * SDL_IOStream and return them in native format.
+ *
+ * The values are read with a single SDL_ReadIO() call and byteswapped
+ * together, using SIMD instructions where available, only if necessary.
+ *
+ * This function will return false if fewer than `count` values could be
+ * read; the contents of `values` are undefined in that case.
+ *
+ * \param src the stream from which to read data.
+ * \param values an array of `count` values filled in with the data read.
+ * \param count the number of values to read.
+ * \returns true on successful read or false on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadU64BE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadU64BEArray(SDL_IOStream *src, Uint64 *values, size_t count);
 /* @} *//* Read endian functions */
 
 /**
@@ -463,6 +463,19 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   that can be displayed, in terms of the SDR white point. When HDR is not
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_WINDOW_HDR_STATE_CHANGED is sent.
+ * - `SDL_PROP_RENDERER_ATLAS_PAGES_NUMBER`: the number of atlas pages holding
+ *   textures created with `SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN`. (since SDL
+ *   3.4.0)
+ * - `SDL_PROP_RENDERER_ATLAS_USED_PIXELS_NUMBER`: the number of pixels of the
+ *   atlas pages taken up by textures. Dividing this by
+ *   `SDL_PROP_RENDERER_ATLAS_TOTAL_PIXELS_NUMBER` gives the atlas occupancy.
+ *   (since SDL 3.4.0)
+ * - `SDL_PROP_RENDERER_ATLAS_TOTAL_PIXELS_NUMBER`: the total number of pixels
+ *   in all atlas pages. (since SDL 3.4.0)
+ * - `SDL_PROP_RENDERER_ATLAS_BATCHES_SAVED_NUMBER`: the number of draws in
+ *   the last frame that could join the previous draw call only because both
+ *   textures share an atlas page. This property changes every time the
+ *   renderer is presented. (since SDL 3.4.0)
  *
  * With the direct3d renderer:
  *
@@ -508,6 +521,14 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  * - `SDL_PROP_RENDERER_GPU_DEVICE_POINTER`: the SDL_GPUDevice associated with
  *   the renderer
  *
+ * With the software renderer:
+ *
+ * - `SDL_PROP_RENDERER_SOFTWARE_PRESENTED_PIXELS_NUMBER`: the number of
+ *   pixels the last call to SDL_RenderPresent() sent to the window. Only the
+ *   areas drawn since the previous present are sent, so this shows how much
+ *   of the window changed. This property changes every time the renderer is
+ *   presented. (since SDL 3.4.0)
+ *
  * \param renderer the rendering context.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -528,6 +549,10 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_ATLAS_PAGES_NUMBER                        "SDL.renderer.atlas.pages"
+#define SDL_PROP_RENDERER_ATLAS_USED_PIXELS_NUMBER                  "SDL.renderer.atlas.used_pixels"
+#define SDL_PROP_RENDERER_ATLAS_TOTAL_PIXELS_NUMBER                 "SDL.renderer.atlas.total_pixels"
+#define SDL_PROP_RENDERER_ATLAS_BATCHES_SAVED_NUMBER                "SDL.renderer.atlas.batches_saved"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -542,6 +567,7 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER  "SDL.renderer.vulkan.present_queue_family_index"
 #define SDL_PROP_RENDERER_VULKAN_SWAPCHAIN_IMAGE_COUNT_NUMBER       "SDL.renderer.vulkan.swapchain_image_count"
 #define SDL_PROP_RENDERER_GPU_DEVICE_POINTER                        "SDL.renderer.gpu.device"
+#define SDL_PROP_RENDERER_SOFTWARE_PRESENTED_PIXELS_NUMBER          "SDL.renderer.software.presented_pixels"
 
 /**
  * Get the output size in pixels of a rendering context.
@@ -671,6 +697,13 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  *   If this is defined, any values outside the range supported by the display
  *   will be scaled into the available HDR headroom, otherwise they are
  *   clipped.
+ * - `SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN`: true if the texture may be
+ *   packed into a page shared with other textures, so that drawing different
+ *   textures one after another doesn't break up draw calls. This is only done
+ *   for small static textures in a format the renderer supports directly;
+ *   other textures are created normally. Atlased textures can't be used with
+ *   texture coordinates outside [0, 1] in SDL_RenderGeometry() and have no
+ *   backend specific texture properties. Defaults to false. (since SDL 3.4.0)
  *
  * With the direct3d11 renderer:
  *
@@ -761,6 +794,7 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
 #define SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER               "SDL.texture.create.height"
 #define SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT       "SDL.texture.create.SDR_white_point"
 #define SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT          "SDL.texture.create.HDR_headroom"
+#define SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN               "SDL.texture.create.atlas"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER       "SDL.texture.create.d3d11.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_U_POINTER     "SDL.texture.create.d3d11.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_V_POINTER     "SDL.texture.create.d3d11.texture_v"
@@ -2232,6 +2266,42 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextureAffine(SDL_Renderer *renderer,
                                                      const SDL_FRect *srcrect, const SDL_FPoint *origin,
                                                      const SDL_FPoint *right, const SDL_FPoint *down);
 
+/**
+ * Copy many portions of a texture to the current rendering target in one
+ * call, at subpixel precision.
+ *
+ * This is equivalent to calling SDL_RenderTextureRotated() for each sprite,
+ * with each sprite rotated around the center of its destination rectangle,
+ * but the sprites are submitted to the renderer as a few large draws where
+ * the backend allows it.
+ *
+ * \param renderer the renderer which should copy parts of a texture.
+ * \param texture the source texture.
+ * \param srcrects an array of `count` source rectangles, or NULL to use the
+ *                 entire texture for every sprite.
+ * \param dstrects an array of `count` destination rectangles.
+ * \param colors an array of `count` colors which are multiplied with the
+ *               texture color and alpha modulation, or NULL.
+ * \param angles an array of `count` angles in degrees indicating the
+ *               clockwise rotation of each sprite, or NULL for no rotation.
+ * \param flips an array of `count` SDL_FlipMode values, or NULL for no
+ *              flipping.
+ * \param count the number of sprites to draw.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_RenderTextureRotated
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextures(SDL_Renderer *renderer, SDL_Texture *texture,
+                                                   const SDL_FRect *srcrects, const SDL_FRect *dstrects,
+                                                   const SDL_FColor *colors, const double *angles,
+                                                   const SDL_FlipMode *flips, int count);
+
 /**
  * Tile a portion of the texture to the current rendering target at subpixel
  * precision.
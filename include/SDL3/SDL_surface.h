@@ -79,6 +79,10 @@ typedef Uint32 SDL_SurfaceFlags;
 /**
  * The scaling mode.
  *
+ * The bicubic, Lanczos and area modes are only available for surfaces, in
+ * functions like SDL_BlitSurfaceScaled(), SDL_ScaleSurface() and
+ * SDL_StretchSurface(). Textures can't use them.
+ *
  * \since This enum is available since SDL 3.2.0.
  */
 typedef enum SDL_ScaleMode
@@ -86,7 +90,10 @@ typedef enum SDL_ScaleMode
     SDL_SCALEMODE_INVALID = -1,
     SDL_SCALEMODE_NEAREST,  /**< nearest pixel sampling */
     SDL_SCALEMODE_LINEAR,   /**< linear filtering */
-    SDL_SCALEMODE_PIXELART  /**< nearest pixel sampling with improved scaling for pixel art */
+    SDL_SCALEMODE_PIXELART, /**< nearest pixel sampling with improved scaling for pixel art */
+    SDL_SCALEMODE_BICUBIC,  /**< bicubic filtering, sharper than linear filtering */
+    SDL_SCALEMODE_LANCZOS,  /**< Lanczos-3 filtering, the sharpest, but may ring around hard edges */
+    SDL_SCALEMODE_AREA      /**< averages all the source pixels covered by each destination pixel, best for shrinking */
 } SDL_ScaleMode;
 
 /**
@@ -583,6 +590,9 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SaveBMP(SDL_Surface *surface, const char *f
  * If RLE is enabled, color key and alpha blending blits are much faster, but
  * the surface must be locked before directly accessing the pixels.
  *
+ * Disabling RLE also keeps the surface from being encoded automatically, see
+ * SDL_HINT_SURFACE_AUTO_RLE.
+ *
  * \param surface the SDL_Surface structure to optimize.
  * \param enabled true to enable RLE acceleration, false to disable it.
  * \returns true on success or false on failure; call SDL_GetError() for more
@@ -43,6 +43,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -429,6 +430,42 @@ typedef Uint64 (SDLCALL *SDL_NSTimerCallback)(void *userdata, SDL_TimerID timerI
  */
 extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata);
 
+/**
+ * Call a callback function at a future time, with the specified properties.
+ *
+ * This works like SDL_AddTimerNS(), but allows extra options to be set.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_TIMER_CREATE_INTERVAL_NUMBER`: the timer delay, in nanoseconds,
+ *   passed to the callback. Required.
+ * - `SDL_PROP_TIMER_CREATE_CALLBACK_POINTER`: the SDL_NSTimerCallback function
+ *   to call when the interval elapses. Required.
+ * - `SDL_PROP_TIMER_CREATE_USERDATA_POINTER`: a pointer that is passed to the
+ *   callback. Optional, defaults to NULL.
+ * - `SDL_PROP_TIMER_CREATE_WORKER_NUMBER`: the index of the worker thread
+ *   that should run the callback, if SDL_HINT_TIMER_WORKER_THREADS is set.
+ *   The index wraps around the number of workers. Optional, defaults to -1,
+ *   which lets any worker run the callback.
+ *
+ * \param props the properties to use.
+ * \returns a timer ID or 0 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddTimerNS
+ * \sa SDL_RemoveTimer
+ */
+extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_TIMER_CREATE_INTERVAL_NUMBER   "SDL.timer.create.interval"
+#define SDL_PROP_TIMER_CREATE_CALLBACK_POINTER  "SDL.timer.create.callback"
+#define SDL_PROP_TIMER_CREATE_USERDATA_POINTER  "SDL.timer.create.userdata"
+#define SDL_PROP_TIMER_CREATE_WORKER_NUMBER     "SDL.timer.create.worker"
+
 /**
  * Remove a timer created with SDL_AddTimer().
  *
@@ -444,6 +481,38 @@ extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ * Statistics on how closely timer callbacks follow their schedule.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetTimerStatistics
+ */
+typedef struct SDL_TimerStatistics
+{
+    Uint64 num_callbacks;   /**< The number of timer callbacks that have run */
+    Uint64 total_lateness;  /**< The total time between when callbacks were scheduled and when they ran, in nanoseconds */
+    Uint64 max_lateness;    /**< The longest time between when a callback was scheduled and when it ran, in nanoseconds */
+} SDL_TimerStatistics;
+
+/**
+ * Get statistics on how closely timer callbacks follow their schedule.
+ *
+ * The statistics cover every timer callback run since the timer subsystem
+ * was initialized or the statistics were last reset. The average lateness
+ * is `total_lateness / num_callbacks`.
+ *
+ * \param stats a pointer filled in with the current statistics.
+ * \param reset true to reset the statistics after reading them.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTimerStatistics(SDL_TimerStatistics *stats, bool reset);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
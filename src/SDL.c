@@ -37,6 +37,7 @@
 // Initialization code for SDL
 
 #include "SDL_assert_c.h"
+#include "SDL_epoch_c.h"
 #include "SDL_hints_c.h"
 #include "SDL_log_c.h"
 #include "SDL_properties_c.h"
@@ -54,6 +55,8 @@
 #include "tray/SDL_tray_utils.h"
 #include "video/SDL_pixels_c.h"
 #include "video/SDL_surface_c.h"
+#include "video/SDL_blit_pipeline.h"
+#include "video/SDL_surface_threads.h"
 #include "video/SDL_video_c.h"
 #include "filesystem/SDL_filesystem_c.h"
 #include "io/SDL_asyncio_c.h"
@@ -665,10 +668,12 @@ void SDL_Quit(void)
 
     SDL_QuitTimers();
     SDL_QuitAsyncIO();
+    SDL_QuitSurfaceThreads();
 
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
 
+    SDL_QuitBlitPipelines();
     SDL_QuitPixelFormatDetails();
 
     SDL_QuitCPUInfo();
@@ -681,6 +686,7 @@ void SDL_Quit(void)
     SDL_QuitLog();
     SDL_QuitHints();
     SDL_QuitProperties();
+    SDL_QuitEpoch();
 
     SDL_QuitMainThread();
 
@@ -0,0 +1,231 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_epoch_c.h"
+
+// Each thread that reads gets a record, on its own cache line, that holds the
+// global epoch as it was when the thread's outermost read section started, or
+// 0 while it isn't reading. Retiring something bumps the global epoch and tags
+// it with the new value; anything it replaced was unpublished before the bump,
+// so once every record is either 0 or in that epoch or later, no reader can
+// still be looking at it.
+//
+// The records are linked into a global list, which only changes when a thread
+// reads for the first time or exits. It's walked under a spinlock to find the
+// oldest epoch still in use, but nothing ever waits with the lock held.
+
+typedef struct SDL_EpochReader
+{
+    SDL_AtomicU32 epoch;
+    int nesting;  // only touched by the owning thread
+    struct SDL_EpochReader *prev;
+    struct SDL_EpochReader *next;
+} SDL_EpochReader;
+
+typedef union SDL_EpochReaderStorage
+{
+    SDL_EpochReader reader;
+    Uint8 padding[SDL_CACHELINE_SIZE];
+} SDL_EpochReaderStorage;
+
+static SDL_TLSID SDL_epoch_reader_tls;
+static SDL_SpinLock SDL_epoch_readers_lock;
+static SDL_EpochReader *SDL_epoch_readers;
+static SDL_AtomicInt SDL_epoch;
+static SDL_SpinLock SDL_epoch_retired_lock;
+static SDL_RetiredNode *SDL_epoch_retired;
+
+// Threads that couldn't allocate a record are counted here instead. Writers have to wait for this to drop to zero.
+static SDL_AtomicInt SDL_epoch_unregistered_readers;
+
+// Epochs are always odd, so they're never 0.
+#define EPOCH_VALUE(epoch) (((Uint32)(epoch) * 2) + 1)
+
+static void SDLCALL SDL_FreeEpochReader(void *data)
+{
+    SDL_EpochReader *reader = (SDL_EpochReader *)data;
+
+    SDL_LockSpinlock(&SDL_epoch_readers_lock);
+    if (reader->prev) {
+        reader->prev->next = reader->next;
+    } else {
+        SDL_epoch_readers = reader->next;
+    }
+    if (reader->next) {
+        reader->next->prev = reader->prev;
+    }
+    SDL_UnlockSpinlock(&SDL_epoch_readers_lock);
+
+    // Other TLS destructors may still look things up on this thread, so make sure they don't find the freed record.
+    SDL_SetTLS(&SDL_epoch_reader_tls, NULL, NULL);
+    SDL_aligned_free(reader);
+}
+
+static SDL_EpochReader *SDL_CreateEpochReader(void)
+{
+    SDL_EpochReader *reader = (SDL_EpochReader *)SDL_aligned_alloc(SDL_CACHELINE_SIZE, sizeof(SDL_EpochReaderStorage));
+    if (!reader) {
+        return NULL;
+    }
+    SDL_zerop(reader);
+
+    if (!SDL_SetTLS(&SDL_epoch_reader_tls, reader, SDL_FreeEpochReader)) {
+        SDL_aligned_free(reader);
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&SDL_epoch_readers_lock);
+    reader->next = SDL_epoch_readers;
+    if (reader->next) {
+        reader->next->prev = reader;
+    }
+    SDL_epoch_readers = reader;
+    SDL_UnlockSpinlock(&SDL_epoch_readers_lock);
+
+    return reader;
+}
+
+void SDL_EnterReadEpoch(void)
+{
+    SDL_EpochReader *reader = (SDL_EpochReader *)SDL_GetTLS(&SDL_epoch_reader_tls);
+    if (!reader) {
+        reader = SDL_CreateEpochReader();
+        if (!reader) {
+            SDL_AtomicIncRef(&SDL_epoch_unregistered_readers);
+            return;
+        }
+    }
+
+    if (reader->nesting++ == 0) {
+        // This has to be a full barrier: the store must be visible before we load anything the writer might free.
+        SDL_CompareAndSwapAtomicU32(&reader->epoch, 0, EPOCH_VALUE(SDL_GetAtomicInt(&SDL_epoch)));
+    }
+}
+
+void SDL_LeaveReadEpoch(void)
+{
+    SDL_EpochReader *reader = (SDL_EpochReader *)SDL_GetTLS(&SDL_epoch_reader_tls);
+    if (!reader) {
+        SDL_AddAtomicInt(&SDL_epoch_unregistered_readers, -1);
+        return;
+    }
+
+    SDL_assert(reader->nesting > 0);
+    if (--reader->nesting == 0) {
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicU32(&reader->epoch, 0);
+    }
+}
+
+static void SDL_EpochWaitPause(int *iterations)
+{
+    if (*iterations < 32) {
+        (*iterations)++;
+        SDL_CPUPauseInstruction();
+    } else {
+        SDL_Delay(0);
+    }
+}
+
+// The oldest epoch a reader other than `skip` could be in. Anything retired in this epoch or before can be reclaimed.
+static Uint32 SDL_GetOldestReaderEpoch(const SDL_EpochReader *skip)
+{
+    // A reader that isn't registered yet, or that's about to store an older epoch than this, can't see anything retired before this point.
+    Uint32 oldest = EPOCH_VALUE(SDL_GetAtomicInt(&SDL_epoch));
+
+    SDL_LockSpinlock(&SDL_epoch_readers_lock);
+    for (SDL_EpochReader *reader = SDL_epoch_readers; reader; reader = reader->next) {
+        const Uint32 epoch = SDL_GetAtomicU32(&reader->epoch);
+        if (reader != skip && epoch != 0 && (Sint32)(epoch - oldest) < 0) {
+            oldest = epoch;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_epoch_readers_lock);
+
+    return oldest;
+}
+
+static void SDL_ReclaimRetired(bool all)
+{
+    SDL_RetiredNode *reclaimed = NULL;
+    Uint32 oldest = 0;
+
+    if (!all) {
+        if (SDL_GetAtomicInt(&SDL_epoch_unregistered_readers) > 0) {
+            return;  // there's no telling what they might be looking at, try again next time.
+        }
+        oldest = SDL_GetOldestReaderEpoch(NULL);
+    }
+
+    SDL_LockSpinlock(&SDL_epoch_retired_lock);
+    SDL_RetiredNode **prev = &SDL_epoch_retired;
+    while (*prev) {
+        SDL_RetiredNode *node = *prev;
+        if (all || (Sint32)(oldest - node->epoch) >= 0) {
+            *prev = node->next;
+            node->next = reclaimed;
+            reclaimed = node;
+        } else {
+            prev = &node->next;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_epoch_retired_lock);
+
+    // Callbacks run without any locks held, so they're free to retire more things.
+    while (reclaimed) {
+        SDL_RetiredNode *next = reclaimed->next;
+        reclaimed->callback(reclaimed);
+        reclaimed = next;
+    }
+}
+
+void SDL_RetireForReaders(SDL_RetiredNode *node, SDL_RetiredCallback callback)
+{
+    node->callback = callback;
+    node->epoch = EPOCH_VALUE(SDL_AddAtomicInt(&SDL_epoch, 1) + 1);
+
+    SDL_LockSpinlock(&SDL_epoch_retired_lock);
+    node->next = SDL_epoch_retired;
+    SDL_epoch_retired = node;
+    SDL_UnlockSpinlock(&SDL_epoch_retired_lock);
+
+    SDL_ReclaimRetired(false);
+}
+
+void SDL_WaitForReaders(void)
+{
+    const Uint32 target = EPOCH_VALUE(SDL_AddAtomicInt(&SDL_epoch, 1) + 1);
+    const SDL_EpochReader *self = (const SDL_EpochReader *)SDL_GetTLS(&SDL_epoch_reader_tls);
+    int iterations = 0;
+
+    // we can't wait for ourselves, and the caller knows what it's reading.
+    while (SDL_GetAtomicInt(&SDL_epoch_unregistered_readers) > 0 ||
+           (Sint32)(SDL_GetOldestReaderEpoch(self) - target) < 0) {
+        SDL_EpochWaitPause(&iterations);
+    }
+}
+
+void SDL_QuitEpoch(void)
+{
+    SDL_WaitForReaders();
+    SDL_ReclaimRetired(true);
+}
@@ -0,0 +1,64 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_epoch_c_h_
+#define SDL_epoch_c_h_
+
+// Epoch based reclamation, a simple form of RCU.
+//
+// Readers bracket their access to shared data with SDL_EnterReadEpoch() and
+// SDL_LeaveReadEpoch(). These never block and only write to memory owned by
+// the calling thread. Sections may nest. A reader may block inside a section,
+// but that holds up the reclamation of everything retired in the meantime.
+//
+// A writer unpublishes something (unlinks it, or swaps in a new copy), then
+// passes it to SDL_RetireForReaders(), which calls the node's callback once no
+// reader can still be looking at the old copy. That happens the next time any
+// thread retires something and finds the readers have moved on, or in
+// SDL_QuitEpoch(); writers never wait for readers. Writers still need their
+// own lock to serialize against each other.
+
+typedef struct SDL_RetiredNode SDL_RetiredNode;
+
+typedef void (*SDL_RetiredCallback)(SDL_RetiredNode *node);
+
+// Embed this in anything that gets retired, the epoch code owns its contents until the callback runs.
+struct SDL_RetiredNode
+{
+    SDL_RetiredCallback callback;
+    Uint32 epoch;
+    SDL_RetiredNode *next;
+};
+
+extern void SDL_EnterReadEpoch(void);
+extern void SDL_LeaveReadEpoch(void);
+
+// Call `callback` with `node`, now or later on any thread, once no read section that might have seen what was unpublished before this call is still active.
+extern void SDL_RetireForReaders(SDL_RetiredNode *node, SDL_RetiredCallback callback);
+
+// Wait for every read section that was active on another thread when this was called to finish.
+extern void SDL_WaitForReaders(void);
+
+// Wait for readers and run the callbacks for everything that's still retired.
+extern void SDL_QuitEpoch(void);
+
+#endif // SDL_epoch_c_h_
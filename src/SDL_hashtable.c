@@ -20,50 +20,309 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_epoch_c.h"
+
+// This is a "Swiss table": open addressing with a separate array of control
+// bytes, one per slot, which are checked a whole group of slots at a time with
+// SIMD. A control byte is either EMPTY, DELETED, or (for a live slot) the top
+// 7 bits of that item's hash, so most mismatches are ruled out without
+// touching the slots themselves, let alone calling the keymatch callback.
+//
+// Lookups start at the group at `hash & hash_mask` and move on to other groups
+// with triangular probing until the key is found or a group has an EMPTY slot.
+// Removing an item leaves a DELETED tombstone, so probe sequences that passed
+// over the slot stay intact; they're cleared out when the table is rehashed.
+//
+// Tables created threadsafe don't lock for lookups at all. Writers serialize
+// on a mutex and change the table so that a reader racing with them always
+// sees something consistent, and anything a reader might still be looking at
+// is passed to SDL_RetireForReaders() and only freed once no reader can be
+// using it, so writers never wait for readers:
+//  - A new item is written before its control byte is published.
+//  - Items are never overwritten in place. Removing one always leaves a
+//    tombstone, new items only go in EMPTY slots, and replacing an item
+//    inserts the new one before removing the old one.
+//  - Growing, rehashing or clearing the table builds a new set of slots and
+//    swaps it in, and retires the old one.
+//  - A removed item's destroy callback is deferred the same way. The node
+//    for that is allocated before the table is changed, so running out of
+//    memory fails the removal instead of leaving nowhere to put the item.
+//  - Clearing the table without the memory for new slots leaves the items
+//    in CLEARED tombstones, which are retired with the slots by the next
+//    write that manages to rehash.
+
+#define CTRL_EMPTY   ((Uint8)0x80)
+#define CTRL_DELETED ((Uint8)0xFE)
+#define CTRL_CLEARED ((Uint8)0xFF)  // a DELETED slot whose item hasn't been destroyed yet, left by clearing without memory to spare.
+#define CTRL_IS_FULL(c) (((c) & 0x80) == 0)
+
+#define GROUP_WIDTH 16
+
 typedef struct SDL_HashItem
 {
-    // TODO: Splitting off values into a separate array might be more cache-friendly
     const void *key;
     const void *value;
-    Uint32 hash;
-    Uint32 probe_len : 31;
-    Uint32 live : 1;
 } SDL_HashItem;
 
-// Must be a power of 2 >= sizeof(SDL_HashItem)
+// Must be a power of 2 >= sizeof(SDL_HashItem) + 1 control byte
 #define MAX_HASHITEM_SIZEOF 32u
-SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
+SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) + 1 <= MAX_HASHITEM_SIZEOF);
 
 // Anything larger than this will cause integer overflows
 #define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
 
-struct SDL_HashTable
+// Tables using SDL's own hash/keymatch callbacks skip the function pointers entirely.
+typedef enum SDL_HashKeyKind
+{
+    SDL_HASHKEY_GENERIC,
+    SDL_HASHKEY_POINTER,
+    SDL_HASHKEY_STRING,
+    SDL_HASHKEY_ID
+} SDL_HashKeyKind;
+
+// The slots and their control bytes are allocated together, so a reader can grab a consistent set with a single load.
+typedef struct SDL_HashSlots
 {
-    SDL_RWLock *lock;  // NULL if not created threadsafe
+    SDL_RetiredNode retired;  // must be first
+    SDL_HashDestroyCallback destroy;  // set when retired slots still hold items to destroy
+    void *userdata;
+    bool cleared_only;  // the FULL slots were copied into the new slots, so only the CLEARED ones are destroyed
+    Uint32 hash_mask;
+    Uint8 *ctrl;  // hash_mask + 1 + GROUP_WIDTH bytes, the last GROUP_WIDTH mirror the first so a group can be loaded from any slot.
     SDL_HashItem *table;
+} SDL_HashSlots;
+
+// An item removed from a threadsafe table, waiting for readers to finish with it before it's destroyed.
+typedef struct SDL_RetiredHashItem
+{
+    SDL_RetiredNode retired;  // must be first
+    SDL_HashDestroyCallback destroy;
+    void *userdata;
+    const void *key;
+    const void *value;
+} SDL_RetiredHashItem;
+
+struct SDL_HashTable
+{
+    SDL_Mutex *lock;  // serializes writers, NULL if not created threadsafe
+    SDL_HashSlots *slots;
     SDL_HashCallback hash;
     SDL_HashKeyMatchCallback keymatch;
     SDL_HashDestroyCallback destroy;
     void *userdata;
-    Uint32 hash_mask;
-    Uint32 max_probe_len;
+    SDL_HashKeyKind kind;
     Uint32 num_occupied_slots;
+    Uint32 num_deleted_slots;
+    Uint32 num_cleared_slots;  // CLEARED tombstones, their items are destroyed when these slots are next retired
 };
 
+// Every lookup touches the control bytes, so there's no runtime CPU check here: SIMD is only used
+//  when the compiler can assume it's always available (x86-64, ARM64, or builds that target it).
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define HASHTABLE_SSE2 1
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define HASHTABLE_NEON 1
+#endif
+
+// Bitmasks of matching slots in a group. With NEON, each slot gets 4 bits, so the slot index has to be shifted down.
+#ifdef HASHTABLE_SSE2
+typedef Uint32 GroupMask;
+#define GROUP_MASK_SHIFT 0
+#elif defined(HASHTABLE_NEON)
+typedef Uint64 GroupMask;
+#define GROUP_MASK_SHIFT 2
+#else
+typedef Uint32 GroupMask;
+#define GROUP_MASK_SHIFT 0
+#endif
+
+static SDL_INLINE Uint32 lowest_slot_in_mask(GroupMask mask)
+{
+    SDL_assert(mask != 0);
+#if (defined(__GNUC__) && (__GNUC__ >= 4)) || defined(__clang__)
+    if (sizeof(mask) == sizeof(Uint64)) {
+        return (Uint32)__builtin_ctzll((unsigned long long)mask) >> GROUP_MASK_SHIFT;
+    }
+    return (Uint32)__builtin_ctz((unsigned int)mask) >> GROUP_MASK_SHIFT;
+#else
+    Uint32 bit = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit >> GROUP_MASK_SHIFT;
+#endif
+}
+
+static SDL_INLINE Uint32 highest_slot_in_mask(GroupMask mask)
+{
+    SDL_assert(mask != 0);
+    if (sizeof(mask) == sizeof(Uint64) && ((Uint64)mask >> 32)) {
+        return (Uint32)(32 + SDL_MostSignificantBitIndex32((Uint32)((Uint64)mask >> 32))) >> GROUP_MASK_SHIFT;
+    }
+    return (Uint32)SDL_MostSignificantBitIndex32((Uint32)mask) >> GROUP_MASK_SHIFT;
+}
+
+#define NEXT_IN_MASK(mask) ((mask) & ((mask) - 1))
+
+#ifdef HASHTABLE_NEON
+#define GROUP_MASK_ALL ((GroupMask)0x8888888888888888ull)
+#else
+#define GROUP_MASK_ALL ((GroupMask)0xFFFF)
+#endif
+
+#ifdef HASHTABLE_SSE2
+static SDL_INLINE GroupMask match_group(const Uint8 *ctrl, Uint8 h2)
+{
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+static SDL_INLINE GroupMask match_group_empty(const Uint8 *ctrl)
+{
+    return match_group(ctrl, CTRL_EMPTY);
+}
+
+static SDL_INLINE GroupMask match_group_not_full(const Uint8 *ctrl)
+{
+    // EMPTY, DELETED and CLEARED are the only control bytes with the high bit set.
+    return (GroupMask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+#elif defined(HASHTABLE_NEON)
+static SDL_INLINE GroupMask neon_mask(uint8x16_t cmp)
+{
+    // Narrow each byte of the comparison to 4 bits, then keep one bit per slot.
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull;
+}
+
+static SDL_INLINE GroupMask match_group(const Uint8 *ctrl, Uint8 h2)
+{
+    return neon_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+
+static SDL_INLINE GroupMask match_group_empty(const Uint8 *ctrl)
+{
+    return match_group(ctrl, CTRL_EMPTY);
+}
+
+static SDL_INLINE GroupMask match_group_not_full(const Uint8 *ctrl)
+{
+    return neon_mask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0)));
+}
+#else
+static SDL_INLINE GroupMask match_group(const Uint8 *ctrl, Uint8 h2)
+{
+    GroupMask mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i) {
+        mask |= (GroupMask)(ctrl[i] == h2) << i;
+    }
+    return mask;
+}
+
+static SDL_INLINE GroupMask match_group_empty(const Uint8 *ctrl)
+{
+    return match_group(ctrl, CTRL_EMPTY);
+}
+
+static SDL_INLINE GroupMask match_group_not_full(const Uint8 *ctrl)
+{
+    GroupMask mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i) {
+        mask |= (GroupMask)(!CTRL_IS_FULL(ctrl[i])) << i;
+    }
+    return mask;
+}
+#endif
+
+static SDL_INLINE GroupMask match_group_full(const Uint8 *ctrl)
+{
+    return ~match_group_not_full(ctrl) & GROUP_MASK_ALL;
+}
 
 static Uint32 CalculateHashBucketsFromEstimate(int estimated_capacity)
 {
     if (estimated_capacity <= 0) {
-        return 4;  // start small, grow as necessary.
+        return GROUP_WIDTH;  // start small, grow as necessary.
     }
 
-    const Uint32 estimated32 = (Uint32) estimated_capacity;
-    Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(estimated32);
-    if (!SDL_HasExactlyOneBitSet32(estimated32)) {
+    // Leave room for the maximum load factor.
+    const Uint32 estimated32 = (Uint32) SDL_min(estimated_capacity, (int)(MAX_HASHTABLE_SIZE / 8 * 7));
+    const Uint32 needed = estimated32 + (estimated32 / 7);
+    Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(needed);
+    if (!SDL_HasExactlyOneBitSet32(needed)) {
         buckets <<= 1;  // need next power of two up to fit overflow capacity bits.
     }
 
-    return SDL_min(buckets, MAX_HASHTABLE_SIZE);
+    return SDL_clamp(buckets, GROUP_WIDTH, MAX_HASHTABLE_SIZE);
+}
+
+static SDL_HashSlots *create_slots(Uint32 num_buckets)
+{
+    SDL_HashSlots *slots = (SDL_HashSlots *)SDL_malloc(sizeof(SDL_HashSlots) + (num_buckets * sizeof(SDL_HashItem)) + num_buckets + GROUP_WIDTH);
+    if (!slots) {
+        return NULL;
+    }
+
+    slots->destroy = NULL;
+    slots->userdata = NULL;
+    slots->cleared_only = false;
+    slots->hash_mask = num_buckets - 1;
+    slots->table = (SDL_HashItem *)(slots + 1);
+    slots->ctrl = (Uint8 *)(slots->table + num_buckets);
+    SDL_memset(slots->ctrl, CTRL_EMPTY, num_buckets + GROUP_WIDTH);
+    return slots;
+}
+
+static void destroy_all(SDL_HashSlots *slots, SDL_HashDestroyCallback destroy, void *userdata);
+
+static void free_retired_slots(SDL_RetiredNode *node)
+{
+    SDL_HashSlots *slots = (SDL_HashSlots *)node;
+    destroy_all(slots, slots->destroy, slots->userdata);
+    SDL_free(slots);
+}
+
+static void destroy_retired_item(SDL_RetiredNode *node)
+{
+    SDL_RetiredHashItem *retired = (SDL_RetiredHashItem *)node;
+    retired->destroy(retired->userdata, retired->key, retired->value);
+    SDL_free(retired);
+}
+
+// Swap in a new set of slots, freeing the old ones once no reader can be using them.
+static void publish_slots(SDL_HashTable *ht, SDL_HashSlots *slots)
+{
+    SDL_HashSlots *old_slots = ht->slots;
+
+    if (ht->lock) {
+        SDL_SetAtomicPointer((void **)&ht->slots, slots);
+        SDL_RetireForReaders(&old_slots->retired, free_retired_slots);
+    } else {
+        ht->slots = slots;
+        SDL_free(old_slots);
+    }
+}
+
+// Removing an item from a threadsafe table with a destroy callback needs somewhere to keep it until readers are done.
+static bool prepare_delete(const SDL_HashTable *ht, SDL_RetiredHashItem **retired)
+{
+    *retired = NULL;
+    if (ht->lock && ht->destroy) {
+        *retired = (SDL_RetiredHashItem *)SDL_malloc(sizeof(**retired));
+        if (!*retired) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Get the current slots to search, without holding the lock.
+static SDL_INLINE const SDL_HashSlots *get_slots(const SDL_HashTable *ht)
+{
+    const SDL_HashSlots *slots = *(SDL_HashSlots *const volatile *)&ht->slots;
+    SDL_MemoryBarrierAcquire();
+    return slots;
 }
 
 SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_HashCallback hash,
@@ -77,216 +336,322 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
     }
 
     if (threadsafe) {
-        table->lock = SDL_CreateRWLock();
+        table->lock = SDL_CreateMutex();
         if (!table->lock) {
             SDL_DestroyHashTable(table);
             return NULL;
         }
     }
 
-    table->table = (SDL_HashItem *)SDL_calloc(num_buckets, sizeof(SDL_HashItem));
-    if (!table->table) {
+    table->slots = create_slots(num_buckets);
+    if (!table->slots) {
         SDL_DestroyHashTable(table);
         return NULL;
     }
-
-    table->hash_mask = num_buckets - 1;
     table->userdata = userdata;
     table->hash = hash;
     table->keymatch = keymatch;
     table->destroy = destroy;
+
+    if (hash == SDL_HashPointer && keymatch == SDL_KeyMatchPointer) {
+        table->kind = SDL_HASHKEY_POINTER;
+    } else if (hash == SDL_HashString && keymatch == SDL_KeyMatchString) {
+        table->kind = SDL_HASHKEY_STRING;
+    } else if (hash == SDL_HashID && keymatch == SDL_KeyMatchID) {
+        table->kind = SDL_HASHKEY_ID;
+    } else {
+        table->kind = SDL_HASHKEY_GENERIC;
+    }
     return table;
 }
 
+// this is djb's xor hashing function.
+static SDL_INLINE Uint32 hash_string_djbxor(const char *str, size_t len)
+{
+    Uint32 hash = 5381;
+    while (len--) {
+        hash = ((hash << 5) + hash) ^ *(str++);
+    }
+    return hash;
+}
+
+static SDL_INLINE Uint32 hash_pointer(const void *key)
+{
+    // The 64-bit finalizer from MurmurHash3, much cheaper than hashing the pointer's bytes.
+    Uint64 x = (Uint64)(uintptr_t)key;
+    x ^= x >> 33;
+    x *= SDL_UINT64_C(0xFF51AFD7ED558CCD);
+    x ^= x >> 33;
+    return (Uint32)x;
+}
+
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
     const Uint32 BitMixer = 0x9E3779B1u;
-    return table->hash(table->userdata, key) * BitMixer;
+    Uint32 hash;
+
+    switch (table->kind) {
+    case SDL_HASHKEY_POINTER:
+        hash = hash_pointer(key);
+        break;
+    case SDL_HASHKEY_STRING:
+        hash = hash_string_djbxor((const char *)key, SDL_strlen((const char *)key));
+        break;
+    case SDL_HASHKEY_ID:
+        hash = (Uint32)(uintptr_t)key;
+        break;
+    default:
+        hash = table->hash(table->userdata, key);
+        break;
+    }
+    return hash * BitMixer;
 }
 
-static SDL_INLINE Uint32 get_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+// The top 7 bits of the hash are stored in the control byte; the low bits pick the first group to probe.
+#define HASH_H2(hash) ((Uint8)((hash) >> 25))
+
+SDL_FORCE_INLINE bool keys_match(const SDL_HashTable *ht, SDL_HashKeyKind kind, const void *a, const void *b)
 {
-    // returns the probe sequence length from zero_idx to actual_idx
-    if (actual_idx < zero_idx) {
-        return num_buckets - zero_idx + actual_idx;
+    switch (kind) {
+    case SDL_HASHKEY_POINTER:
+    case SDL_HASHKEY_ID:
+        return (a == b);
+    case SDL_HASHKEY_STRING:
+        return SDL_KeyMatchString(NULL, a, b);
+    default:
+        return ht->keymatch(ht->userdata, a, b);
     }
-
-    return actual_idx - zero_idx;
 }
 
-static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+// `kind` is always a constant, so this gets specialized for each kind of key in find_item.
+SDL_FORCE_INLINE SDL_HashItem *find_item_of_kind(const SDL_HashTable *ht, const SDL_HashSlots *slots, SDL_HashKeyKind kind, const void *key, Uint32 hash)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    Uint32 max_probe_len = ht->max_probe_len;
-
-    SDL_HashItem *table = ht->table;
+    const Uint32 hash_mask = slots->hash_mask;
+    const Uint8 h2 = HASH_H2(hash);
+    Uint32 pos = hash & hash_mask;
+    Uint32 stride = 0;
 
     while (true) {
-        SDL_HashItem *item = table + *i;
-        Uint32 item_hash = item->hash;
+        const Uint8 *group = slots->ctrl + pos;
+        GroupMask mask = match_group(group, h2);
 
-        if (!item->live) {
-            return NULL;
+        if (mask && ht->lock) {
+            SDL_MemoryBarrierAcquire();  // a writer might have just published this slot, don't read the item before its control byte.
         }
 
-        if (item_hash == hash && ht->keymatch(ht->userdata, item->key, key)) {
-            return item;
+        for (; mask; mask = NEXT_IN_MASK(mask)) {
+            SDL_HashItem *item = slots->table + ((pos + lowest_slot_in_mask(mask)) & hash_mask);
+            if (keys_match(ht, kind, item->key, key)) {
+                return item;
+            }
         }
 
-        Uint32 item_probe_len = item->probe_len;
-        SDL_assert(item_probe_len == get_probe_length(item_hash & hash_mask, (Uint32)(item - table), hash_mask + 1));
-
-        if (*probe_len > item_probe_len) {
-            return NULL;
+        if (match_group_empty(group)) {
+            return NULL;  // the key would have been inserted here, so it isn't anywhere.
         }
 
-        if (++*probe_len > max_probe_len) {
-            return NULL;
+        stride += GROUP_WIDTH;
+        if (stride > hash_mask) {
+            return NULL;  // we've looked at every group.
         }
+        pos = (pos + stride) & hash_mask;
+    }
+}
 
-        *i = (*i + 1) & hash_mask;
+static SDL_HashItem *find_item(const SDL_HashTable *ht, const SDL_HashSlots *slots, const void *key, Uint32 hash)
+{
+    switch (ht->kind) {
+    case SDL_HASHKEY_POINTER:
+        return find_item_of_kind(ht, slots, SDL_HASHKEY_POINTER, key, hash);
+    case SDL_HASHKEY_STRING:
+        return find_item_of_kind(ht, slots, SDL_HASHKEY_STRING, key, hash);
+    case SDL_HASHKEY_ID:
+        return find_item_of_kind(ht, slots, SDL_HASHKEY_ID, key, hash);
+    default:
+        return find_item_of_kind(ht, slots, SDL_HASHKEY_GENERIC, key, hash);
     }
 }
 
-static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+static SDL_INLINE void set_ctrl(SDL_HashSlots *slots, Uint32 idx, Uint8 value)
 {
-    Uint32 i = hash & ht->hash_mask;
-    Uint32 probe_len = 0;
-    return find_item(ht, key, hash, &i, &probe_len);
+    slots->ctrl[idx] = value;
+    if (idx < GROUP_WIDTH) {
+        slots->ctrl[slots->hash_mask + 1 + idx] = value;  // keep the mirrored copy in sync.
+    }
 }
 
-static SDL_HashItem *insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
+// Find the first free slot in the probe sequence for hash. There must be at least one.
+static Uint32 find_free_slot(const SDL_HashTable *ht, const SDL_HashSlots *slots, Uint32 hash)
 {
-    const Uint32 num_buckets = hash_mask + 1;
-    Uint32 idx = item_to_insert->hash & hash_mask;
-    SDL_HashItem *target = NULL;
-    SDL_HashItem temp_item;
+    const Uint32 hash_mask = slots->hash_mask;
+    Uint32 pos = hash & hash_mask;
+    Uint32 stride = 0;
 
     while (true) {
-        SDL_HashItem *candidate = table + idx;
-
-        if (!candidate->live) {
-            // Found an empty slot. Put it here and we're done.
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            const Uint32 probe_len = get_probe_length(candidate->hash & hash_mask, idx, num_buckets);
-            candidate->probe_len = probe_len;
-
-            if (*max_probe_len_ptr < probe_len) {
-                *max_probe_len_ptr = probe_len;
-            }
-
-            break;
+        // Lock-free readers might still be looking at whatever was in a DELETED slot, so those can't be reused.
+        const GroupMask mask = ht->lock ? match_group_empty(slots->ctrl + pos) : match_group_not_full(slots->ctrl + pos);
+        if (mask) {
+            return (pos + lowest_slot_in_mask(mask)) & hash_mask;
         }
 
-        const Uint32 candidate_probe_len = candidate->probe_len;
-        SDL_assert(candidate_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-        const Uint32 new_probe_len = get_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
-
-        if (candidate_probe_len < new_probe_len) {
-            // Robin Hood hashing: the item at idx has a better probe length than our item would at this position.
-            // Evict it and put our item in its place, then continue looking for a new spot for the displaced item.
-            // This algorithm significantly reduces clustering in the table, making lookups take very few probes.
+        stride += GROUP_WIDTH;
+        SDL_assert(stride <= hash_mask);
+        pos = (pos + stride) & hash_mask;
+    }
+}
 
-            temp_item = *candidate;
-            *candidate = *item_to_insert;
+static void insert_item(SDL_HashTable *ht, SDL_HashSlots *slots, const void *key, const void *value, Uint32 hash)
+{
+    const Uint32 idx = find_free_slot(ht, slots, hash);
 
-            if (target == NULL) {
-                target = candidate;
-            }
+    if (slots->ctrl[idx] == CTRL_DELETED) {
+        ht->num_deleted_slots--;
+    }
+    ht->num_occupied_slots++;
 
-            *item_to_insert = temp_item;
+    slots->table[idx].key = key;
+    slots->table[idx].value = value;
+    if (ht->lock) {
+        SDL_MemoryBarrierRelease();
+    }
+    set_ctrl(slots, idx, HASH_H2(hash));
+}
 
-            SDL_assert(new_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-            candidate->probe_len = new_probe_len;
+// `retired` comes from prepare_delete(), and is used up.
+static void delete_item(SDL_HashTable *ht, SDL_HashItem *item, SDL_RetiredHashItem *retired)
+{
+    SDL_HashSlots *slots = ht->slots;
+    const Uint32 idx = (Uint32)(item - slots->table);
+    const void *key = item->key;
+    const void *value = item->value;
 
-            if (*max_probe_len_ptr < new_probe_len) {
-                *max_probe_len_ptr = new_probe_len;
-            }
-        }
+    SDL_assert(ht->num_occupied_slots > 0);
+    ht->num_occupied_slots--;
 
-        idx = (idx + 1) & hash_mask;
+    // Lookups only continue past a group if it has no empty slots. If every group this slot could be in has one,
+    //  no probe sequence ever continued past this slot, so it doesn't need a tombstone.
+    const GroupMask empty_after = match_group_empty(slots->ctrl + idx);
+    const GroupMask empty_before = match_group_empty(slots->ctrl + ((idx - GROUP_WIDTH) & slots->hash_mask));
+    if (!ht->lock && empty_before && empty_after &&
+        (lowest_slot_in_mask(empty_after) + (GROUP_WIDTH - 1 - highest_slot_in_mask(empty_before))) < GROUP_WIDTH) {
+        set_ctrl(slots, idx, CTRL_EMPTY);
+    } else {
+        set_ctrl(slots, idx, CTRL_DELETED);
+        ht->num_deleted_slots++;
     }
 
-    return target;
+    if (retired) {
+        retired->destroy = ht->destroy;
+        retired->userdata = ht->userdata;
+        retired->key = key;
+        retired->value = value;
+        SDL_RetireForReaders(&retired->retired, destroy_retired_item);
+    } else if (ht->destroy) {
+        ht->destroy(ht->userdata, key, value);
+    }
 }
 
-static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+static bool resize(SDL_HashTable *ht, Uint32 new_size)
 {
-    const Uint32 hash_mask = ht->hash_mask;
-    SDL_HashItem *table = ht->table;
-
-    if (ht->destroy) {
-        ht->destroy(ht->userdata, item->key, item->value);
+    SDL_HashSlots *old_slots = ht->slots;
+    const Uint32 old_size = old_slots->hash_mask + 1;
+    SDL_HashSlots *new_slots = create_slots(new_size);
+    if (!new_slots) {
+        return false;
     }
 
-    SDL_assert(ht->num_occupied_slots > 0);
-    ht->num_occupied_slots--;
-
-    Uint32 idx = (Uint32)(item - ht->table);
+    ht->num_occupied_slots = 0;
+    ht->num_deleted_slots = 0;
+    for (Uint32 i = 0; i < old_size; ++i) {
+        if (CTRL_IS_FULL(old_slots->ctrl[i])) {
+            const SDL_HashItem *item = old_slots->table + i;
+            insert_item(ht, new_slots, item->key, item->value, calc_hash(ht, item->key));
+        }
+    }
 
-    while (true) {
-        idx = (idx + 1) & hash_mask;
-        SDL_HashItem *next_item = table + idx;
+    if (ht->num_cleared_slots) {
+        // Items left behind by SDL_ClearHashTable() running out of memory go away with the old slots.
+        old_slots->destroy = ht->destroy;
+        old_slots->userdata = ht->userdata;
+        old_slots->cleared_only = true;
+        ht->num_cleared_slots = 0;
+    }
 
-        if (next_item->probe_len < 1) {
-            SDL_zerop(item);
-            return;
-        }
+    publish_slots(ht, new_slots);
+    return true;
+}
 
-        *item = *next_item;
-        item->probe_len -= 1;
-        SDL_assert(item->probe_len < ht->max_probe_len);
-        item = next_item;
+// After SDL_ClearHashTable() ran out of memory, try again to get rid of the items it couldn't destroy.
+static void reclaim_cleared(SDL_HashTable *ht)
+{
+    if (ht->num_cleared_slots) {
+        resize(ht, ht->slots->hash_mask + 1);  // if this fails too, the next writer tries again.
     }
 }
 
-static bool resize(SDL_HashTable *ht, Uint32 new_size)
+// Make sure there's room for `additional` more items.
+static bool maybe_resize(SDL_HashTable *ht, Uint32 additional)
 {
-    const Uint32 new_hash_mask = new_size - 1;
-    SDL_HashItem *new_table = SDL_calloc(new_size, sizeof(*new_table));
+    const Uint32 capacity = ht->slots->hash_mask + 1;
+    const Uint32 max_load = capacity - (capacity / 8);  // 87.5%, counting tombstones, since they lengthen probe sequences too.
 
-    if (!new_table) {
-        return false;
+    if (ht->num_occupied_slots + ht->num_deleted_slots + additional <= max_load) {
+        return true;
     }
 
-    SDL_HashItem *old_table = ht->table;
-    const Uint32 old_size = ht->hash_mask + 1;
-
-    ht->max_probe_len = 0;
-    ht->hash_mask = new_hash_mask;
-    ht->table = new_table;
+    // If it's mostly tombstones, rehashing at the same size is enough to clean them out.
+    Uint32 new_size = capacity;
+    while ((new_size < MAX_HASHTABLE_SIZE) && ((Uint64)(ht->num_occupied_slots + additional) * 2 > new_size)) {
+        new_size *= 2;
+    }
 
-    for (Uint32 i = 0; i < old_size; ++i) {
-        SDL_HashItem *item = old_table + i;
-        if (item->live) {
-            insert_item(item, new_table, new_hash_mask, &ht->max_probe_len);
-        }
+    if ((Uint64)(ht->num_occupied_slots + additional) > new_size - (new_size / 8)) {
+        return SDL_SetError("hash table is full");
     }
 
-    SDL_free(old_table);
-    return true;
+    return resize(ht, new_size);
 }
 
-static bool maybe_resize(SDL_HashTable *ht)
+// must hold the lock!
+static bool insert_locked(SDL_HashTable *table, const void *key, const void *value, bool replace)
 {
-    const Uint32 capacity = ht->hash_mask + 1;
+    const Uint32 hash = calc_hash(table, key);
+    SDL_HashItem *item = find_item(table, table->slots, key, hash);
 
-    if (capacity >= MAX_HASHTABLE_SIZE) {
-        return false;
+    if (item) {
+        if (!replace) {
+            return SDL_SetError("key already exists and replace is disabled");
+        }
+
+        // Reuse the slot. The old item is destroyed just like it would be if it was removed.
+        if (!table->lock) {
+            if (table->destroy) {
+                table->destroy(table->userdata, item->key, item->value);
+            }
+            item->key = key;
+            item->value = value;
+            return true;
+        }
     }
 
-    const Uint32 max_load_factor = 217; // range: 0-255; 217 is roughly 85%
-    const Uint32 resize_threshold = (Uint32)((max_load_factor * (Uint64)capacity) >> 8);
+    SDL_RetiredHashItem *retired = NULL;
+    if (item && !prepare_delete(table, &retired)) {
+        return false;
+    }
 
-    if (ht->num_occupied_slots > resize_threshold) {
-        return resize(ht, capacity * 2);
+    if (!maybe_resize(table, 1)) {
+        SDL_free(retired);
+        return false;
     }
 
+    if (item) {
+        // Readers might be looking at the old item, so add the new one before removing it.
+        item = find_item(table, table->slots, key, hash);  // the table might have been rehashed.
+        insert_item(table, table->slots, key, value, hash);
+        delete_item(table, item, retired);
+    } else {
+        insert_item(table, table->slots, key, value, hash);
+    }
     return true;
 }
 
@@ -296,43 +661,40 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
         return SDL_InvalidParamError("table");
     }
 
-    bool result = false;
-
-    SDL_LockRWLockForWriting(table->lock);
-
-    const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    bool do_insert = true;
+    SDL_LockMutex(table->lock);
+    reclaim_cleared(table);
+    const bool result = insert_locked(table, key, value, replace);
+    SDL_UnlockMutex(table->lock);
+    return result;
+}
 
-    if (item) {
-        if (replace) {
-            delete_item(table, item);
-        } else {
-            SDL_SetError("key already exists and replace is disabled");
-            do_insert = false;
-        }
+bool SDL_InsertManyIntoHashTable(SDL_HashTable *table, const void *const *keys, const void *const *values, int count, bool replace)
+{
+    if (!table) {
+        return SDL_InvalidParamError("table");
+    } else if (count < 0) {
+        return SDL_InvalidParamError("count");
+    } else if (count > 0 && (!keys || !values)) {
+        return SDL_InvalidParamError(keys ? "values" : "keys");
     }
 
-    if (do_insert) {
-        SDL_HashItem new_item;
-        new_item.key = key;
-        new_item.value = value;
-        new_item.hash = hash;
-        new_item.live = true;
-        new_item.probe_len = 0;
+    bool result = true;
 
-        table->num_occupied_slots++;
+    SDL_LockMutex(table->lock);
+    reclaim_cleared(table);
 
-        if (!maybe_resize(table)) {
-            table->num_occupied_slots--;
-        } else {
-            // This never returns NULL
-            insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
-            result = true;
+    // Grow once up front instead of as we go. Any duplicates just make this a little bigger than needed.
+    if (!maybe_resize(table, (Uint32)count)) {
+        result = false;
+    } else {
+        for (int i = 0; i < count; ++i) {
+            if (!insert_locked(table, keys[i], values[i], replace)) {
+                result = false;
+            }
         }
     }
 
-    SDL_UnlockRWLock(table->lock);
+    SDL_UnlockMutex(table->lock);
     return result;
 }
 
@@ -345,11 +707,15 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
-
-    bool result = false;
+    // Hash before entering the read section, in case the hash callback does anything that could block.
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *i = find_first_item(table, key, hash);
+    bool result = false;
+
+    if (table->lock) {
+        SDL_EnterReadEpoch();
+    }
+
+    SDL_HashItem *i = find_item(table, get_slots(table), key, hash);
     if (i) {
         if (value) {
             *value = i->value;
@@ -357,28 +723,81 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
         result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    if (table->lock) {
+        SDL_LeaveReadEpoch();
+    }
 
     return result;
 }
 
+int SDL_FindManyInHashTable(const SDL_HashTable *table, const void *const *keys, const void **values, int count)
+{
+    if (!table) {
+        SDL_InvalidParamError("table");
+        return -1;
+    } else if (count < 0) {
+        SDL_InvalidParamError("count");
+        return -1;
+    } else if (count > 0 && (!keys || !values)) {
+        SDL_InvalidParamError(keys ? "values" : "keys");
+        return -1;
+    }
+
+    int found = 0;
+
+    // Hash a batch of keys before probing for any of them, so the memory loads for several lookups can be in flight at once.
+    #define FIND_MANY_BATCH 16
+    Uint32 hashes[FIND_MANY_BATCH];
+    for (int start = 0; start < count; start += FIND_MANY_BATCH) {
+        const int batch = SDL_min(count - start, FIND_MANY_BATCH);
+
+        for (int i = 0; i < batch; ++i) {
+            hashes[i] = calc_hash(table, keys[start + i]);
+        }
+
+        if (table->lock) {
+            SDL_EnterReadEpoch();
+        }
+
+        const SDL_HashSlots *slots = get_slots(table);
+        for (int i = 0; i < batch; ++i) {
+            const SDL_HashItem *item = find_item(table, slots, keys[start + i], hashes[i]);
+            if (item) {
+                values[start + i] = item->value;
+                found++;
+            } else {
+                values[start + i] = NULL;
+            }
+        }
+
+        if (table->lock) {
+            SDL_LeaveReadEpoch();
+        }
+    }
+    #undef FIND_MANY_BATCH
+
+    return found;
+}
+
 bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
     if (!table) {
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForWriting(table->lock);
+    SDL_LockMutex(table->lock);
+    reclaim_cleared(table);
 
     bool result = false;
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    if (item) {
-        delete_item(table, item);
+    SDL_HashItem *item = find_item(table, table->slots, key, hash);
+    SDL_RetiredHashItem *retired;
+    if (item && prepare_delete(table, &retired)) {
+        delete_item(table, item, retired);
         result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    SDL_UnlockMutex(table->lock);
     return result;
 }
 
@@ -390,21 +809,23 @@ bool SDL_IterateHashTable(const SDL_HashTable *table, SDL_HashTableIterateCallba
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockRWLockForReading(table->lock);
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
+    SDL_LockMutex(table->lock);
+    const SDL_HashSlots *slots = table->slots;
+    const Uint32 num_buckets = slots->hash_mask + 1;
     Uint32 num_iterated = 0;
 
-    for (SDL_HashItem *item = table->table; item < end; item++) {
-        if (item->live) {
+    for (Uint32 i = 0; (i < num_buckets) && (num_iterated < table->num_occupied_slots); i += GROUP_WIDTH) {
+        for (GroupMask mask = match_group_full(slots->ctrl + i); mask; mask = NEXT_IN_MASK(mask)) {
+            const SDL_HashItem *item = slots->table + i + lowest_slot_in_mask(mask);
             if (!callback(userdata, table, item->key, item->value)) {
-                break;  // callback requested iteration stop.
-            } else if (++num_iterated >= table->num_occupied_slots) {
-                break;  // we can drop out early because we've seen all the live items.
+                goto done;  // callback requested iteration stop.
             }
+            num_iterated++;
         }
     }
 
-    SDL_UnlockRWLock(table->lock);
+done:
+    SDL_UnlockMutex(table->lock);
     return true;
 }
 
@@ -414,23 +835,22 @@ bool SDL_HashTableEmpty(SDL_HashTable *table)
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
+    SDL_LockMutex(table->lock);
     const bool retval = (table->num_occupied_slots == 0);
-    SDL_UnlockRWLock(table->lock);
+    SDL_UnlockMutex(table->lock);
     return retval;
 }
 
 
-static void destroy_all(SDL_HashTable *table)
+static void destroy_all(SDL_HashSlots *slots, SDL_HashDestroyCallback destroy, void *userdata)
 {
-    SDL_HashDestroyCallback destroy = table->destroy;
-    if (destroy) {
-        void *userdata = table->userdata;
-        SDL_HashItem *end = table->table + (table->hash_mask + 1);
-        for (SDL_HashItem *i = table->table; i < end; ++i) {
-            if (i->live) {
-                i->live = false;
-                destroy(userdata, i->key, i->value);
+    if (destroy && slots) {
+        const Uint32 num_buckets = slots->hash_mask + 1;
+        for (Uint32 i = 0; i < num_buckets; ++i) {
+            const Uint8 ctrl = slots->ctrl[i];
+            if ((CTRL_IS_FULL(ctrl) && !slots->cleared_only) || (ctrl == CTRL_CLEARED)) {
+                set_ctrl(slots, i, CTRL_EMPTY);
+                destroy(userdata, slots->table[i].key, slots->table[i].value);
             }
         }
     }
@@ -439,38 +859,56 @@ static void destroy_all(SDL_HashTable *table)
 void SDL_ClearHashTable(SDL_HashTable *table)
 {
     if (table) {
-        SDL_LockRWLockForWriting(table->lock);
-        {
-            destroy_all(table);
-            SDL_memset(table->table, 0, sizeof(*table->table) * (table->hash_mask + 1));
+        SDL_LockMutex(table->lock);
+        if (table->lock) {
+            // Swap in empty slots, and only destroy the old items once readers are done with them.
+            SDL_HashSlots *old_slots = table->slots;
+            SDL_HashSlots *new_slots = create_slots(old_slots->hash_mask + 1);
+            if (new_slots) {
+                old_slots->destroy = table->destroy;
+                old_slots->userdata = table->userdata;
+                table->num_occupied_slots = 0;
+                table->num_deleted_slots = 0;
+                table->num_cleared_slots = 0;
+                publish_slots(table, new_slots);
+            } else {
+                // Out of memory, so there's nowhere to swap to. Turn every item into a tombstone in place. Readers
+                //  might still be looking at them and waiting for readers here could deadlock, so the items stay in
+                //  their slots until a later write manages to rehash the table and retire these slots with them.
+                const Uint8 tombstone = table->destroy ? CTRL_CLEARED : CTRL_DELETED;
+                for (Uint32 i = 0; i <= old_slots->hash_mask; ++i) {
+                    if (CTRL_IS_FULL(old_slots->ctrl[i])) {
+                        set_ctrl(old_slots, i, tombstone);
+                    }
+                }
+                if (table->destroy) {
+                    table->num_cleared_slots += table->num_occupied_slots;
+                }
+                table->num_deleted_slots += table->num_occupied_slots;
+                table->num_occupied_slots = 0;
+            }
+        } else {
+            destroy_all(table->slots, table->destroy, table->userdata);
+            SDL_memset(table->slots->ctrl, CTRL_EMPTY, table->slots->hash_mask + 1 + GROUP_WIDTH);
             table->num_occupied_slots = 0;
+            table->num_deleted_slots = 0;
         }
-        SDL_UnlockRWLock(table->lock);
+        SDL_UnlockMutex(table->lock);
     }
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
 {
     if (table) {
-        destroy_all(table);
+        destroy_all(table->slots, table->destroy, table->userdata);
         if (table->lock) {
-            SDL_DestroyRWLock(table->lock);
+            SDL_DestroyMutex(table->lock);
         }
-        SDL_free(table->table);
+        SDL_free(table->slots);
         SDL_free(table);
     }
 }
 
-// this is djb's xor hashing function.
-static SDL_INLINE Uint32 hash_string_djbxor(const char *str, size_t len)
-{
-    Uint32 hash = 5381;
-    while (len--) {
-        hash = ((hash << 5) + hash) ^ *(str++);
-    }
-    return hash;
-}
-
 Uint32 SDL_HashPointer(void *unused, const void *key)
 {
     (void)unused;
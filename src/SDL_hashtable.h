@@ -60,12 +60,16 @@
  * iterate through all the items in the table (SDL_IterateHashTable).
  *
  * The underlying hash table implementation is always subject to change, but
- * at the time of writing, it uses open addressing and Robin Hood hashing.
- * The technical details are explained [here](https://github.com/libsdl-org/SDL/pull/10897).
+ * at the time of writing, it uses open addressing with a separate array of
+ * control bytes that are probed 16 at a time with SIMD, in the style of
+ * Abseil's "Swiss tables". Tables that use SDL's own hash and keymatch
+ * functions (SDL_HashString, SDL_HashPointer, SDL_HashID, etc) skip the
+ * callbacks and compare keys inline.
  *
- * Hashtables keep an SDL_RWLock internally, so multiple threads can perform
- * hash lookups in parallel, while changes to the table will safely serialize
- * access between threads.
+ * Hashtables created threadsafe serialize changes with an internal mutex,
+ * but lookups don't lock at all: they never block, even while another thread
+ * is changing the table, and many threads can look things up in parallel
+ * without contending for a shared lock.
  *
  * SDL provides a layer on top of this hash table implementation that might be
  * more pleasant to use. SDL_PropertiesID maps a string to arbitrary data of
@@ -218,9 +222,9 @@ typedef void (SDLCALL *SDL_HashDestroyCallback)(void *userdata, const void *key,
  * \param value the current value being iterated.
  * \returns true to keep iterating, false to stop iteration.
  *
- * \threadsafety A read lock is held during iteration, so other threads can
- *               still access the hash table, but threads attempting to make
- *               changes will be blocked until iteration completes. If this
+ * \threadsafety The table's lock is held during iteration, so other threads can
+ *               still look things up in the hash table, but threads attempting
+ *               to make changes will be blocked until iteration completes. If this
  *               is a concern, do as little in the callback as possible and
  *               finish iteration quickly.
  *
@@ -258,9 +262,14 @@ typedef bool (SDLCALL *SDL_HashTableIterateCallback)(void *userdata, const SDL_H
  * table will start small and reallocate as necessary; often this is the
  * correct thing to do.
  *
- * !!! FIXME: add note about `threadsafe` here. And update `threadsafety` tags.
- * !!! FIXME: note that `threadsafe` tables can't be recursively locked, so
- * !!! FIXME:  you can't use `destroy` callbacks that might end up relocking.
+ * If `threadsafe` is true, the table can be used from several threads at
+ * once. Lookups on such a table don't lock, so the keymatch callback may be
+ * called while another thread is changing the table. Removed or replaced
+ * items aren't destroyed until every lookup that might still see them has
+ * finished, so the destroy callback may run after the change returns, on
+ * another thread, or as late as SDL_Quit(); `userdata` has to stay valid
+ * until then. Removing or replacing an item in such a table can fail if
+ * there's not enough memory to keep track of it until then.
  *
  * Note that SDL provides a higher-level option built on its hash tables:
  * SDL_PropertiesID lets you map strings to various datatypes, and this
@@ -272,7 +281,8 @@ typedef bool (SDLCALL *SDL_HashTableIterateCallback)(void *userdata, const SDL_H
  *
  * \param estimated_capacity the approximate maximum number of items to be held
  *                           in the hash table, or 0 for no estimate.
- * \param threadsafe true to create an internal rwlock for this table.
+ * \param threadsafe true to make this table safe to use from several threads
+ *                   at once.
  * \param hash the function to use to hash keys.
  * \param keymatch the function to use to compare keys.
  * \param destroy the function to use to clean up keys and values, may be NULL.
@@ -337,6 +347,28 @@ extern void SDL_DestroyHashTable(SDL_HashTable *table);
  */
 extern bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value, bool replace);
 
+/**
+ * Add several items to a hash table at once.
+ *
+ * This is the same as calling SDL_InsertIntoHashTable() for each key/value
+ * pair, in order, but it only locks the table once and grows it up front to
+ * fit all the new items.
+ *
+ * \param table the hash table to insert into.
+ * \param keys an array of `count` keys of the new items to insert.
+ * \param values an array of `count` values of the new items to insert.
+ * \param count the number of items to insert.
+ * \param replace true if a duplicate key should replace the previous value.
+ * \returns true if every item was inserted, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_InsertIntoHashTable
+ */
+extern bool SDL_InsertManyIntoHashTable(SDL_HashTable *table, const void *const *keys, const void *const *values, int count, bool replace);
+
 /**
  * Look up an item in a hash table.
  *
@@ -360,6 +392,31 @@ extern bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const
  */
 extern bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value);
 
+/**
+ * Look up several items in a hash table at once.
+ *
+ * On return, `values[i]` holds the value associated with `keys[i]`, or NULL
+ * if that key does not exist in the table.
+ *
+ * This overlaps the work for several keys, so
+ * it is faster than calling SDL_FindInHashTable() for each of them.
+ *
+ * \param table the hash table to search.
+ * \param keys an array of `count` keys to search for in the table.
+ * \param values an array of `count` pointers, filled in with the found
+ *               values.
+ * \param count the number of keys to look up.
+ * \returns the number of keys that exist in the table, or -1 on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FindInHashTable
+ */
+extern int SDL_FindManyInHashTable(const SDL_HashTable *table, const void *const *keys, const void **values, int count);
+
 /**
  * Remove an item from a hash table.
  *
@@ -20,9 +20,27 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_epoch_c.h"
 #include "SDL_hints_c.h"
 #include "SDL_properties_c.h"
 
+// Reading properties usually doesn't take any locks. The property tables are
+// created threadsafe, so lookups are lock-free, and getters bracket both
+// lookups (the properties group, then the property itself) in one read epoch,
+// so neither can be freed out from under them. Properties are never changed
+// once they're in a table, setting one replaces it with a new one, except for
+// the lazily created string_storage, which is set with a compare-and-swap.
+//
+// SDL_LockProperties() promises that other threads wait to read until the
+// group is unlocked, so it bumps lock_sequence to an odd number while it's
+// held. Getters take the lock if the sequence is odd, or if it changed while
+// they were reading. Blocking inside the read epoch is fine, it only delays
+// freeing whatever gets retired in the meantime.
+//
+// Pointer cleanup callbacks run right away, when a property is replaced or
+// cleared or the group is destroyed. Only SDL's own copies of things are
+// retired until readers are done with them.
+
 
 typedef struct
 {
@@ -36,7 +54,7 @@ typedef struct
         bool boolean_value;
     } value;
 
-    char *string_storage;
+    char *string_storage;  // atomic, set once
 
     SDL_CleanupPropertyCallback cleanup;
     void *userdata;
@@ -44,10 +62,21 @@ typedef struct
 
 typedef struct
 {
+    SDL_RetiredNode retired;  // must be first
     SDL_HashTable *props;
     SDL_Mutex *lock;
+    int lock_depth;  // protected by lock
+    SDL_AtomicInt lock_sequence;  // odd while locked by SDL_LockProperties()
 } SDL_Properties;
 
+typedef struct
+{
+    SDL_Properties *properties;
+    int sequence;
+    bool locked;
+    bool retry;
+} SDL_PropertyReader;
+
 static SDL_InitState SDL_properties_init;
 static SDL_HashTable *SDL_properties;
 static SDL_AtomicU32 SDL_last_properties_id;
@@ -76,17 +105,42 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
     SDL_free((void *)value);
 }
 
+// This is the tables' destroy callback, and may run well after the property was removed, so it doesn't call the cleanup.
 static void SDLCALL SDL_FreeProperty(void *data, const void *key, const void *value)
 {
-    SDL_FreePropertyWithCleanup(key, value, data, true);
+    SDL_FreePropertyWithCleanup(key, value, data, false);
+}
+
+static void SDL_CleanupProperty(const SDL_Property *property)
+{
+    if (property && property->type == SDL_PROPERTY_TYPE_POINTER && property->cleanup) {
+        property->cleanup(property->userdata, property->value.pointer_value);
+    }
+}
+
+static bool SDLCALL CleanupOneProperty(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+{
+    SDL_CleanupProperty((const SDL_Property *)value);
+    return true;  // keep iterating.
+}
+
+static void SDL_FreePropertiesMemory(SDL_Properties *properties)
+{
+    SDL_DestroyHashTable(properties->props);
+    SDL_DestroyMutex(properties->lock);
+    SDL_free(properties);
+}
+
+static void SDL_FreeRetiredProperties(SDL_RetiredNode *node)
+{
+    SDL_FreePropertiesMemory((SDL_Properties *)node);
 }
 
 static void SDL_FreeProperties(SDL_Properties *properties)
 {
     if (properties) {
-        SDL_DestroyHashTable(properties->props);
-        SDL_DestroyMutex(properties->lock);
-        SDL_free(properties);
+        SDL_IterateHashTable(properties->props, CleanupOneProperty, NULL);
+        SDL_FreePropertiesMemory(properties);
     }
 }
 
@@ -123,9 +177,9 @@ void SDL_QuitProperties(void)
         SDL_DestroyProperties(props);
     }
 
-    // this can't just DestroyHashTable with SDL_FreeProperties as the destructor, because
-    //  other destructors under this might cause use to attempt a recursive lock on SDL_properties,
-    //  which isn't allowed with rwlocks. So manually iterate and free everything.
+    // this doesn't just DestroyHashTable with SDL_FreeProperties as the destructor, because
+    //  other destructors under this might try to destroy more properties through SDL_properties.
+    //  So take it out of circulation first, then manually iterate and free everything.
     SDL_HashTable *properties = SDL_properties;
     SDL_properties = NULL;
     SDL_IterateHashTable(properties, FreeOneProperties, NULL);
@@ -170,7 +224,7 @@ SDL_PropertiesID SDL_CreateProperties(void)
         return 0;
     }
 
-    properties->props = SDL_CreateHashTable(0, false, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, NULL);
+    properties->props = SDL_CreateHashTable(0, true, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, NULL);
     if (!properties->props) {
         SDL_DestroyMutex(properties->lock);
         SDL_free(properties);
@@ -297,6 +351,9 @@ bool SDL_LockProperties(SDL_PropertiesID props)
     }
 
     SDL_LockMutex(properties->lock);
+    if (properties->lock_depth++ == 0) {
+        SDL_AddAtomicInt(&properties->lock_sequence, 1);
+    }
     return true;
 }
 
@@ -313,6 +370,9 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
+    if (--properties->lock_depth == 0) {
+        SDL_AddAtomicInt(&properties->lock_sequence, 1);
+    }
     SDL_UnlockMutex(properties->lock);
 }
 
@@ -330,25 +390,46 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
         return SDL_InvalidParamError("name");
     }
 
+    // The read epoch keeps the group around if it's destroyed while we wait for its lock.
+    SDL_EnterReadEpoch();
+
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
+        SDL_LeaveReadEpoch();
         SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
         return SDL_InvalidParamError("props");
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_RemoveFromHashTable(properties->props, name);
+        // The old property is only freed once readers are done with it, but its cleanup runs now. Nothing else can
+        //  replace it while we hold the lock, and properties never change, so a copy of it stays good.
+        SDL_Property *old_property = NULL;
+        SDL_Property old_copy;
+        SDL_zero(old_copy);
+        if (SDL_FindInHashTable(properties->props, name, (const void **)&old_property)) {
+            SDL_copyp(&old_copy, old_property);
+        }
+
         if (property) {
+            // Replace rather than remove and insert, so readers never see the property missing.
             char *key = SDL_strdup(name);
-            if (!key || !SDL_InsertIntoHashTable(properties->props, key, property, false)) {
+            if (!key || !SDL_InsertIntoHashTable(properties->props, key, property, true)) {
                 SDL_FreePropertyWithCleanup(key, property, NULL, true);
                 result = false;
             }
+        } else if (old_property) {
+            result = SDL_RemoveFromHashTable(properties->props, name);
+        }
+
+        if (result && old_property) {
+            SDL_CleanupProperty(&old_copy);
         }
     }
     SDL_UnlockMutex(properties->lock);
 
+    SDL_LeaveReadEpoch();
+
     return result;
 }
 
@@ -471,6 +552,65 @@ bool SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, bool value
     return SDL_PrivateSetProperty(props, name, property);
 }
 
+// Find a property to read, waiting if its group is locked. The property is only valid until SDL_EndReadProperty().
+static SDL_Property *SDL_BeginReadProperty(SDL_PropertyReader *reader, SDL_PropertiesID props, const char *name)
+{
+    SDL_Property *property = NULL;
+
+    SDL_EnterReadEpoch();
+
+    reader->properties = NULL;
+    reader->locked = false;
+    if (SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&reader->properties) && reader->properties) {
+        SDL_Properties *properties = reader->properties;
+        reader->sequence = SDL_GetAtomicInt(&properties->lock_sequence);
+        if ((reader->sequence & 1) || reader->retry) {
+            SDL_LockMutex(properties->lock);
+            reader->locked = true;
+        }
+        SDL_FindInHashTable(properties->props, name, (const void **)&property);
+    }
+    return property;
+}
+
+// Returns false if the group was locked while the property was read, and the read has to be done again.
+static bool SDL_EndReadProperty(SDL_PropertyReader *reader)
+{
+    bool result = true;
+
+    if (reader->locked) {
+        SDL_UnlockMutex(reader->properties->lock);
+    } else if (reader->properties) {
+        SDL_MemoryBarrierAcquire();
+        if (SDL_GetAtomicInt(&reader->properties->lock_sequence) != reader->sequence) {
+            reader->retry = true;  // and take the lock this time, so this can't go on forever.
+            result = false;
+        }
+    }
+
+    SDL_LeaveReadEpoch();
+
+    return result;
+}
+
+static const char *SDL_GetPropertyStringStorage(SDL_Property *property)
+{
+    char *storage = (char *)SDL_GetAtomicPointer((void **)&property->string_storage);
+    if (!storage) {
+        if (property->type == SDL_PROPERTY_TYPE_NUMBER) {
+            SDL_asprintf(&storage, "%" SDL_PRIs64, property->value.number_value);
+        } else {
+            SDL_asprintf(&storage, "%f", property->value.float_value);
+        }
+        if (storage && !SDL_CompareAndSwapAtomicPointer((void **)&property->string_storage, NULL, storage)) {
+            // Another thread got there first, use theirs.
+            SDL_free(storage);
+            storage = (char *)SDL_GetAtomicPointer((void **)&property->string_storage);
+        }
+    }
+    return storage;
+}
+
 bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
 {
     return (SDL_GetPropertyType(props, name) != SDL_PROPERTY_TYPE_INVALID);
@@ -478,7 +618,6 @@ bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
 
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
-    SDL_Properties *properties = NULL;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
 
     if (!props) {
@@ -488,26 +627,20 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return SDL_PROPERTY_TYPE_INVALID;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        type = SDL_PROPERTY_TYPE_INVALID;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             type = property->type;
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return type;
 }
 
 void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
 {
-    SDL_Properties *properties = NULL;
     void *value = default_value;
 
     if (!props) {
@@ -517,31 +650,26 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return value;
-    }
-
-    // Note that taking the lock here only guarantees that we won't read the
-    // hashtable while it's being modified. The value itself can easily be
-    // freed from another thread after it is returned here.
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    // Note that the read epoch only guarantees that the property won't be freed
+    // while we're looking at it. The value itself can easily be freed from
+    // another thread after it is returned here, unless the caller holds
+    // the properties lock.
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        value = default_value;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return value;
 }
 
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
 {
-    SDL_Properties *properties = NULL;
     const char *value = default_value;
 
     if (!props) {
@@ -551,39 +679,24 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        value = default_value;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = property->value.string_value;
                 break;
             case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
             case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
+            {
+                const char *storage = SDL_GetPropertyStringStorage(property);
+                if (storage) {
+                    value = storage;
                 }
                 break;
+            }
             case SDL_PROPERTY_TYPE_BOOLEAN:
                 value = property->value.boolean_value ? "true" : "false";
                 break;
@@ -591,15 +704,13 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
                 break;
             }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return value;
 }
 
 Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
 {
-    SDL_Properties *properties = NULL;
     Sint64 value = default_value;
 
     if (!props) {
@@ -609,15 +720,11 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        value = default_value;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
@@ -635,15 +742,13 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
                 break;
             }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return value;
 }
 
 float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
 {
-    SDL_Properties *properties = NULL;
     float value = default_value;
 
     if (!props) {
@@ -653,15 +758,11 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        value = default_value;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -679,15 +780,13 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
                 break;
             }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return value;
 }
 
 bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
 {
-    SDL_Properties *properties = NULL;
     bool value = default_value ? true : false;
 
     if (!props) {
@@ -697,15 +796,11 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    if (!properties) {
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+    SDL_PropertyReader reader = { NULL, 0, false, false };
+    do {
+        value = default_value ? true : false;
+        SDL_Property *property = SDL_BeginReadProperty(&reader, props, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -723,8 +818,7 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
                 break;
             }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+    } while (!SDL_EndReadProperty(&reader));
 
     return value;
 }
@@ -812,13 +906,16 @@ bool SDL_DumpProperties(SDL_PropertiesID props)
 void SDL_DestroyProperties(SDL_PropertiesID props)
 {
     if (props) {
-        // this can't just use RemoveFromHashTable with SDL_FreeProperties as the destructor, because
-        //  other destructors under this might cause use to attempt a recursive lock on SDL_properties,
-        //  which isn't allowed with rwlocks. So manually look it up and remove/free it.
+        // this doesn't use RemoveFromHashTable with SDL_FreeProperties as the destructor, because
+        //  other destructors under this might destroy more properties, and we don't want to hold the
+        //  lock on SDL_properties while they do. So manually look it up and remove/free it.
         SDL_Properties *properties = NULL;
-        if (SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties)) {
-            SDL_FreeProperties(properties);
-            SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
+        if (SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties) &&
+            SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props)) {
+            // Getters that found these before they were removed might still be reading them, so only the
+            //  cleanups run now, and the memory is freed once those getters are done.
+            SDL_IterateHashTable(properties->props, CleanupOneProperty, NULL);
+            SDL_RetireForReaders(&properties->retired, SDL_FreeRetiredProperties);
         }
     }
 }
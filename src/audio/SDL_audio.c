@@ -349,6 +349,8 @@ static void ZombieFlushRecording(SDL_AudioDevice *device)
    They are _not_ destroyed because we are done using them (when we "close" a playing device).
 */
 static void ClosePhysicalAudioDevice(SDL_AudioDevice *device);
+static void StartMixerThreads(void);
+static void StopMixerThreads(void);
 
 
 SDL_COMPILE_TIME_ASSERT(check_lowest_audio_default_value, SDL_AUDIO_DEVICE_DEFAULT_RECORDING < SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK);
@@ -1024,6 +1026,8 @@ bool SDL_InitAudio(const char *driver_name)
 
     CompleteAudioEntryPoints();
 
+    StartMixerThreads();
+
     // Make sure we have a list of devices available at startup...
     SDL_AudioDevice *default_playback = NULL;
     SDL_AudioDevice *default_recording = NULL;
@@ -1103,6 +1107,8 @@ void SDL_QuitAudio(void)
 
     SDL_IterateHashTable(device_hash, DestroyOnePhysicalAudioDevice, NULL);
 
+    StopMixerThreads();
+
     // Free the driver data
     current_audio.impl.Deinitialize();
 
@@ -1125,6 +1131,246 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
 }
 
 
+// Pull a bound stream's data for a playback device iteration, swizzled to the device's channel layout.
+static int GetPlaybackStreamData(SDL_AudioDevice *device, SDL_AudioStream *stream, void *buf, int len, float gain)
+{
+    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+       for iterating here because the binding linked list can only change while the device lock is held.
+       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+       the same stream to different devices at the same time, though.) */
+    const int br = SDL_GetAudioStreamDataAdjustGain(stream, buf, len, gain);
+    if (br > 0) {
+        // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
+        if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
+            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), buf, device->spec.format, device->spec.channels, NULL,
+                         buf, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+        }
+    }
+    return br;
+}
+
+// Pull streams from device->mix_streams until they've all been claimed by someone. Called from the device thread and the mixer threads.
+static void PullMixStreams(SDL_AudioDevice *device)
+{
+    const int len = device->mix_stream_buffer_size;
+    int i;
+
+    while ((i = SDL_AddAtomicInt(&device->mix_next, 1)) < device->num_mix_streams) {
+        Uint8 *buf = device->mix_stream_buffers + ((size_t)i * device->mix_stream_buffer_pitch);
+        device->mix_results[i] = GetPlaybackStreamData(device, device->mix_streams[i], buf, len, device->mix_gains[i]);
+    }
+}
+
+// must hold current_audio.mixer_lock!
+static void RemoveFromMixerQueue(SDL_AudioDevice *device)
+{
+    for (SDL_AudioDevice **i = &current_audio.mixer_queue; *i; i = &(*i)->mixer_queue_next) {
+        if (*i == device) {
+            *i = device->mixer_queue_next;
+            device->mixer_queue_next = NULL;
+            break;
+        }
+    }
+}
+
+static int SDLCALL MixerThread(void *data)
+{
+    SDL_LockMutex(current_audio.mixer_lock);
+    while (!current_audio.mixer_shutdown) {
+        SDL_AudioDevice *device = current_audio.mixer_queue;
+        if (!device) {
+            SDL_WaitCondition(current_audio.mixer_cond, current_audio.mixer_lock);
+            continue;
+        }
+
+        device->mix_active_workers++;
+        SDL_UnlockMutex(current_audio.mixer_lock);
+
+        PullMixStreams(device);
+
+        SDL_LockMutex(current_audio.mixer_lock);
+        RemoveFromMixerQueue(device);  // every stream has been claimed now, don't let other threads pick it up.
+        if (--device->mix_active_workers == 0) {
+            SDL_BroadcastCondition(current_audio.mixer_done_cond);
+        }
+    }
+    SDL_UnlockMutex(current_audio.mixer_lock);
+    return 0;
+}
+
+static void StartMixerThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_MIXER_THREADS);
+    const int num_threads = hint ? SDL_clamp(SDL_atoi(hint), 0, 64) : 0;
+    if (num_threads == 0) {
+        return;
+    }
+
+    current_audio.mixer_lock = SDL_CreateMutex();
+    current_audio.mixer_cond = SDL_CreateCondition();
+    current_audio.mixer_done_cond = SDL_CreateCondition();
+    current_audio.mixer_threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(SDL_Thread *));
+    if (!current_audio.mixer_lock || !current_audio.mixer_cond || !current_audio.mixer_done_cond || !current_audio.mixer_threads) {
+        return;  // we'll clean up in StopMixerThreads. Not fatal, we'll just mix on the device threads.
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        char name[64];
+        SDL_snprintf(name, sizeof(name), "SDLAudioMixer%d", i);
+        current_audio.mixer_threads[i] = SDL_CreateThread(MixerThread, name, NULL);
+        if (!current_audio.mixer_threads[i]) {
+            break;
+        }
+        current_audio.num_mixer_threads++;
+    }
+}
+
+static void StopMixerThreads(void)
+{
+    if (current_audio.mixer_lock) {
+        SDL_LockMutex(current_audio.mixer_lock);
+        current_audio.mixer_shutdown = true;
+        SDL_BroadcastCondition(current_audio.mixer_cond);
+        SDL_UnlockMutex(current_audio.mixer_lock);
+    }
+
+    for (int i = 0; i < current_audio.num_mixer_threads; ++i) {
+        SDL_WaitThread(current_audio.mixer_threads[i], NULL);
+    }
+
+    SDL_free(current_audio.mixer_threads);
+    SDL_DestroyCondition(current_audio.mixer_done_cond);
+    SDL_DestroyCondition(current_audio.mixer_cond);
+    SDL_DestroyMutex(current_audio.mixer_lock);
+    current_audio.mixer_threads = NULL;
+    current_audio.num_mixer_threads = 0;
+    current_audio.mixer_done_cond = NULL;
+    current_audio.mixer_cond = NULL;
+    current_audio.mixer_lock = NULL;
+}
+
+static bool EnsureMixStreamSpace(SDL_AudioDevice *device, int num_streams)
+{
+    if (num_streams > device->mix_streams_allocated) {
+        SDL_AudioStream **streams = (SDL_AudioStream **)SDL_realloc(device->mix_streams, num_streams * sizeof(*streams));
+        if (!streams) {
+            return false;
+        }
+        device->mix_streams = streams;
+
+        float *gains = (float *)SDL_realloc(device->mix_gains, num_streams * sizeof(*gains));
+        if (!gains) {
+            return false;
+        }
+        device->mix_gains = gains;
+
+        int *results = (int *)SDL_realloc(device->mix_results, num_streams * sizeof(*results));
+        if (!results) {
+            return false;
+        }
+        device->mix_results = results;
+
+        device->mix_streams_allocated = num_streams;
+    }
+
+    // a format change can grow work_buffer_size, so the buffers have to be replaced when that changes, too.
+    if ((num_streams > device->mix_stream_buffers_allocated) || (device->mix_stream_buffer_pitch != device->work_buffer_size)) {
+        const int count = SDL_max(num_streams, device->mix_stream_buffers_allocated);
+        Uint8 *buffers = (Uint8 *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), (size_t)count * device->work_buffer_size);
+        if (!buffers) {
+            return false;
+        }
+        SDL_aligned_free(device->mix_stream_buffers);
+        device->mix_stream_buffers = buffers;
+        device->mix_stream_buffers_allocated = count;
+        device->mix_stream_buffer_pitch = device->work_buffer_size;
+    }
+
+    return true;
+}
+
+static void FreeMixStreamSpace(SDL_AudioDevice *device)
+{
+    SDL_free(device->mix_streams);
+    SDL_free(device->mix_gains);
+    SDL_free(device->mix_results);
+    SDL_aligned_free(device->mix_stream_buffers);
+    device->mix_streams = NULL;
+    device->mix_gains = NULL;
+    device->mix_results = NULL;
+    device->mix_stream_buffers = NULL;
+    device->num_mix_streams = 0;
+    device->mix_streams_allocated = 0;
+    device->mix_stream_buffers_allocated = 0;
+    device->mix_stream_buffer_pitch = 0;
+}
+
+// Pull every bound stream of every unpaused logical device, spread across the device thread and the mixer threads.
+//  Each stream gets its own output buffer, so mixing them afterwards in binding order gives the same result as doing it serially.
+//  Returns false if we should pull the streams one at a time on the device thread instead. Must hold device->lock!
+static bool PullPlaybackStreamsInParallel(SDL_AudioDevice *device, int work_buffer_size)
+{
+    if (current_audio.num_mixer_threads == 0) {
+        return false;
+    }
+
+    int num_streams = 0;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (!SDL_GetAtomicInt(&logdev->paused)) {
+            for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                num_streams++;
+            }
+        }
+    }
+
+    if (num_streams < 2) {
+        return false;  // nothing to gain here.
+    } else if (!EnsureMixStreamSpace(device, num_streams)) {
+        return false;  // out of memory? Just do it the slow way.
+    }
+
+    num_streams = 0;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (SDL_GetAtomicInt(&logdev->paused)) {
+            continue;  // paused? Skip this logical device.
+        }
+
+        // every logical device gets its iteration started before any streams are pulled, since they're all pulled at once.
+        if (logdev->iteration_start) {
+            logdev->iteration_start(logdev->iteration_userdata, logdev->instance_id, true);
+        }
+
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            device->mix_streams[num_streams] = stream;
+            device->mix_gains[num_streams] = logdev->gain;
+            num_streams++;
+        }
+    }
+
+    device->num_mix_streams = num_streams;
+    device->mix_stream_buffer_size = work_buffer_size;
+    SDL_SetAtomicInt(&device->mix_next, 0);
+
+    SDL_LockMutex(current_audio.mixer_lock);
+    device->mixer_queue_next = current_audio.mixer_queue;
+    current_audio.mixer_queue = device;
+    SDL_BroadcastCondition(current_audio.mixer_cond);
+    SDL_UnlockMutex(current_audio.mixer_lock);
+
+    PullMixStreams(device);  // help out on this thread, too.
+
+    // Every stream is claimed at this point, wait for any mixer threads to finish with the ones they're working on.
+    SDL_LockMutex(current_audio.mixer_lock);
+    RemoveFromMixerQueue(device);
+    while (device->mix_active_workers > 0) {
+        SDL_WaitCondition(current_audio.mixer_done_cond, current_audio.mixer_lock);
+    }
+    SDL_UnlockMutex(current_audio.mixer_lock);
+
+    return true;
+}
+
+
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
 void SDL_PlaybackAudioThreadSetup(SDL_AudioDevice *device)
@@ -1202,6 +1448,9 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
 
             SDL_memset(final_mix_buffer, '\0', work_buffer_size);  // start with silence.
 
+            const bool parallel = PullPlaybackStreamsInParallel(device, work_buffer_size);
+            int mix_index = 0;
+
             for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
                 if (SDL_GetAtomicInt(&logdev->paused)) {
                     continue;  // paused? Skip this logical device.
@@ -1214,7 +1463,7 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
                 }
 
-                if (logdev->iteration_start) {
+                if (!parallel && logdev->iteration_start) {  // (if parallel, this was already called before the streams were pulled.)
                     logdev->iteration_start(logdev->iteration_userdata, logdev->instance_id, true);
                 }
 
@@ -1222,21 +1471,23 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     // We should have updated this elsewhere if the format changed!
                     SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, NULL, NULL));
 
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
+                    const float *stream_buffer;
+                    int br;
+                    if (parallel) {  // already pulled, we just mix it in now, in binding order, so the result doesn't depend on which thread finished first.
+                        SDL_assert(mix_index < device->num_mix_streams);
+                        SDL_assert(device->mix_streams[mix_index] == stream);
+                        stream_buffer = (const float *) (device->mix_stream_buffers + ((size_t)mix_index * device->mix_stream_buffer_pitch));
+                        br = device->mix_results[mix_index++];
+                    } else {
+                        stream_buffer = (const float *) device->work_buffer;
+                        br = GetPlaybackStreamData(device, stream, device->work_buffer, work_buffer_size, logdev->gain);
+                    }
+
                     if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
                         failed = true;
                         break;
                     } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
-                        if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
-                            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), device->work_buffer, device->spec.format, device->spec.channels, NULL,
-                                         device->work_buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
-                        }
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
+                        MixFloat32Audio(mix_buffer, stream_buffer, br);
                     }
                 }
 
@@ -1667,6 +1918,8 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_aligned_free(device->postmix_buffer);
     device->postmix_buffer = NULL;
 
+    FreeMixStreamSpace(device);
+
     SDL_copyp(&device->spec, &device->default_spec);
     device->sample_frames = 0;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
@@ -96,6 +96,68 @@ static void SDL_TARGETING("sse") SDL_ConvertMonoToStereo_SSE(float *dst, const f
 }
 #endif
 
+#ifdef SDL_AVX2_INTRINSICS
+// Convert from stereo to mono. Average left and right.
+static void SDL_TARGETING("avx2") SDL_ConvertStereoToMono_AVX2(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("stereo", "mono (using AVX2)");
+
+    const __m256 divby2 = _mm256_set1_ps(0.5f);
+    int i = num_frames;
+
+    while (i >= 8) {  // 8 * float32
+        // The horizontal add works within 128-bit lanes, so put the 64-bit halves back in order
+        const __m256 sums = _mm256_hadd_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(src + 8));
+        _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), 0xD8)), divby2));
+        i -= 8;
+        src += 16;
+        dst += 8;
+    }
+
+    // Finish off any leftovers with scalar operations.
+    while (i) {
+        *dst = (src[0] + src[1]) * 0.5f;
+        dst++;
+        i--;
+        src += 2;
+    }
+}
+
+// Convert from mono to stereo. Duplicate to stereo left and right.
+static void SDL_TARGETING("avx2") SDL_ConvertMonoToStereo_AVX2(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("mono", "stereo (using AVX2)");
+
+    // convert backwards, since output is growing in-place.
+    src += (num_frames-8) * 1;
+    dst += (num_frames-8) * 2;
+
+    int i = num_frames;
+    while (i >= 8) {                                              // 8 * float32
+        const __m256 input = _mm256_loadu_ps(src);                // A B C D | E F G H
+        const __m256 lo = _mm256_unpacklo_ps(input, input);       // A A B B | E E F F
+        const __m256 hi = _mm256_unpackhi_ps(input, input);       // C C D D | G G H H
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));      // A A B B C C D D
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));  // E E F F G G H H
+        i -= 8;
+        src -= 8;
+        dst -= 16;
+    }
+
+    // Finish off any leftovers with scalar operations.
+    src += 7;
+    dst += 14;   // adjust for smaller buffers.
+    while (i) {  // convert backwards, since output is growing in-place.
+        const float srcFC = src[0];
+        dst[1] /* FR */ = srcFC;
+        dst[0] /* FL */ = srcFC;
+        i--;
+        src--;
+        dst -= 2;
+    }
+}
+#endif
+
 // Include the autogenerated channel converters...
 #include "SDL_audio_channel_converters.h"
 
@@ -355,10 +417,16 @@ void ConvertAudio(int num_frames,
 
         // swap in some SIMD versions for a few of these.
         if (channel_converter == SDL_ConvertStereoToMono) {
+            #ifdef SDL_AVX2_INTRINSICS
+            if (!override && SDL_HasAVX2()) { override = SDL_ConvertStereoToMono_AVX2; }
+            #endif
             #ifdef SDL_SSE3_INTRINSICS
             if (!override && SDL_HasSSE3()) { override = SDL_ConvertStereoToMono_SSE3; }
             #endif
         } else if (channel_converter == SDL_ConvertMonoToStereo) {
+            #ifdef SDL_AVX2_INTRINSICS
+            if (!override && SDL_HasAVX2()) { override = SDL_ConvertMonoToStereo_AVX2; }
+            #endif
             #ifdef SDL_SSE_INTRINSICS
             if (!override && SDL_HasSSE()) { override = SDL_ConvertMonoToStereo_SSE; }
             #endif
@@ -68,27 +68,47 @@ typedef union Cubic
 
 } Cubic;
 
+static void ResampleConvolve_Generic(const float *src, float *dst, const float *scales, int chans)
+{
+    int i, chan;
+
+    for (chan = 0; chan < chans; ++chan) {
+        float out = 0.0f;
+
+        for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+            out += src[i * chans + chan] * scales[i];
+        }
+
+        dst[chan] = out;
+    }
+}
+
 static void ResampleFrame_Generic(const float *src, float *dst, const Cubic *filter, float frac, int chans)
 {
     const float frac2 = frac * frac;
     const float frac3 = frac * frac2;
 
-    int i, chan;
+    int i;
     float scales[RESAMPLER_SAMPLES_PER_FRAME];
 
     for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i, ++filter) {
         scales[i] = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac2) + (filter->v[3] * frac3);
     }
 
-    for (chan = 0; chan < chans; ++chan) {
-        float out = 0.0f;
+    ResampleConvolve_Generic(src, dst, scales, chans);
+}
 
-        for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
-            out += src[i * chans + chan] * scales[i];
-        }
+// Interpolate between two precomputed filter phases, see GenerateResamplerPhaseTables
+static void ResamplePhase_Generic(const float *src, float *dst, const float *phase0, const float *phase1, float t, int chans)
+{
+    int i;
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
 
-        dst[chan] = out;
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+        scales[i] = phase0[i] + ((phase1[i] - phase0[i]) * t);
     }
+
+    ResampleConvolve_Generic(src, dst, scales, chans);
 }
 
 static void ResampleFrame_Mono(const float *src, float *dst, const Cubic *filter, float frac, int chans)
@@ -133,35 +153,13 @@ static void ResampleFrame_Stereo(const float *src, float *dst, const Cubic *filt
 #ifdef SDL_SSE_INTRINSICS
 #define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // Not-so-fused multiply-add
 
-static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
-{
 #if RESAMPLER_SAMPLES_PER_FRAME != 12
 #error Invalid samples per frame
 #endif
 
-    __m128 f0, f1, f2;
-
-    {
-        const __m128 frac1 = _mm_set1_ps(frac);
-        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
-        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
-
-// Transposed in SetupAudioResampler
-// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
-#define X(out)                                               \
-    out = _mm_load_ps(filter[0].v);                          \
-    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
-    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
-    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
-    filter += 4
-
-        X(f0);
-        X(f1);
-        X(f2);
-
-#undef X
-    }
-
+// Multiply the input by the 12 filter taps in f0, f1 and f2
+SDL_FORCE_INLINE void SDL_TARGETING("sse") ResampleConvolve_SSE(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
+{
     if (chans == 2) {
         // Duplicate each of the filter elements and multiply by the input
         // Use two accumulators to improve throughput
@@ -261,9 +259,202 @@ static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, flo
     }
 }
 
+static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    __m128 f0, f1, f2;
+
+    {
+        const __m128 frac1 = _mm_set1_ps(frac);
+        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
+        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+
+// Transposed in SetupAudioResampler
+// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
+#define X(out)                                               \
+    out = _mm_load_ps(filter[0].v);                          \
+    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
+    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
+    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
+    filter += 4
+
+        X(f0);
+        X(f1);
+        X(f2);
+
+#undef X
+    }
+
+    ResampleConvolve_SSE(src, dst, f0, f1, f2, chans);
+}
+
+static void SDL_TARGETING("sse") ResamplePhase_SSE(const float *src, float *dst, const float *phase0, const float *phase1, float t, int chans)
+{
+    const __m128 t1 = _mm_set1_ps(t);
+
+    // Interpolate between the two phases
+#define X(i) sdl_madd_ps(_mm_loadu_ps(phase0 + i), _mm_sub_ps(_mm_loadu_ps(phase1 + i), _mm_loadu_ps(phase0 + i)), t1)
+    ResampleConvolve_SSE(src, dst, X(0), X(4), X(8), chans);
+#undef X
+}
+
 #undef sdl_madd_ps
 #endif
 
+#ifdef SDL_AVX2_INTRINSICS
+#define sdl_madd_ps(a, b, c)     _mm_add_ps(a, _mm_mul_ps(b, c))       // Not-so-fused multiply-add
+#define sdl_madd256_ps(a, b, c)  _mm256_add_ps(a, _mm256_mul_ps(b, c))
+#define sdl_set_m128(hi, lo)     _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1)
+
+// Multiply the input by the 12 filter taps in f0, f1 and f2, 8 samples at a time
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") ResampleConvolve_AVX2(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
+{
+    if (chans == 2) {
+        // Duplicate each of the filter elements and multiply by the input
+        const __m256 g0 = sdl_set_m128(_mm_unpackhi_ps(f0, f0), _mm_unpacklo_ps(f0, f0));
+        const __m256 g1 = sdl_set_m128(_mm_unpackhi_ps(f1, f1), _mm_unpacklo_ps(f1, f1));
+        const __m256 g2 = sdl_set_m128(_mm_unpackhi_ps(f2, f2), _mm_unpacklo_ps(f2, f2));
+
+        __m256 out = _mm256_mul_ps(_mm256_loadu_ps(src + 0), g0);
+        out = sdl_madd256_ps(out, _mm256_loadu_ps(src + 8), g1);
+        out = sdl_madd256_ps(out, _mm256_loadu_ps(src + 16), g2);
+
+        // Add the 128-bit halves, then the lower and upper pairs together
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(out), _mm256_extractf128_ps(out, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+        _mm_storel_pi((__m64 *)dst, sum);
+        return;
+    }
+
+    if (chans == 1) {
+        // Multiply the filter by the input
+        const __m256 out = _mm256_mul_ps(sdl_set_m128(f1, f0), _mm256_loadu_ps(src));
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(out), _mm256_extractf128_ps(out, 1));
+        sum = sdl_madd_ps(sum, f2, _mm_loadu_ps(src + 8));
+
+        // Horizontal sum
+        __m128 shuf = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1));
+        sum = _mm_add_ps(sum, shuf);
+        sum = _mm_add_ss(sum, _mm_movehl_ps(shuf, sum));
+
+        _mm_store_ss(dst, sum);
+        return;
+    }
+
+    float taps[RESAMPLER_SAMPLES_PER_FRAME] SDL_ALIGNED(16);
+    _mm_store_ps(taps + 0, f0);
+    _mm_store_ps(taps + 4, f1);
+    _mm_store_ps(taps + 8, f2);
+
+    int chan = 0;
+
+    // Process 8 channels at once
+    for (; chan + 8 <= chans; chan += 8) {
+        const float *in = &src[chan];
+        __m256 out0 = _mm256_setzero_ps();
+        __m256 out1 = _mm256_setzero_ps();
+
+#define X(i, out)                                                                     \
+    out = sdl_madd256_ps(out, _mm256_loadu_ps(in), _mm256_broadcast_ss(&taps[i]));    \
+    in += chans
+
+        X(0, out0); X(1, out1); X(2, out0); X(3, out1);
+        X(4, out0); X(5, out1); X(6, out0); X(7, out1);
+        X(8, out0); X(9, out1); X(10, out0); X(11, out1);
+
+#undef X
+
+        _mm256_storeu_ps(&dst[chan], _mm256_add_ps(out0, out1));
+    }
+
+    // Process 4 channels at once. If there are 1-3 channels left over from a frame with
+    // more than 4 channels (5,6,7), finish by redoing the last 4, overlapping the previous ones.
+    while (chan < chans && chans >= 4) {
+        if (chan + 4 > chans) {
+            chan = chans - 4;
+        }
+
+        const float *in = &src[chan];
+        __m128 out0 = _mm_setzero_ps();
+        __m128 out1 = _mm_setzero_ps();
+
+#define X(i, out)                                                               \
+    out = sdl_madd_ps(out, _mm_loadu_ps(in), _mm_broadcast_ss(&taps[i]));       \
+    in += chans
+
+        X(0, out0); X(1, out1); X(2, out0); X(3, out1);
+        X(4, out0); X(5, out1); X(6, out0); X(7, out1);
+        X(8, out0); X(9, out1); X(10, out0); X(11, out1);
+
+#undef X
+
+        _mm_storeu_ps(&dst[chan], _mm_add_ps(out0, out1));
+        chan += 4;
+    }
+
+    // Only 3 channels are left to deal with now, process them one at a time, gathering the input samples.
+    if (chan < chans) {
+        const __m256i stride = _mm256_set1_epi32(chans);
+        const __m256i index0 = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), stride);
+        const __m128i index1 = _mm_mullo_epi32(_mm_setr_epi32(8, 9, 10, 11), _mm256_castsi256_si128(stride));
+        const __m256 f01 = sdl_set_m128(f1, f0);
+
+        for (; chan < chans; ++chan) {
+            const __m256 out = _mm256_mul_ps(f01, _mm256_i32gather_ps(&src[chan], index0, 4));
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(out), _mm256_extractf128_ps(out, 1));
+            sum = sdl_madd_ps(sum, f2, _mm_i32gather_ps(&src[chan], index1, 4));
+
+            // Horizontal sum
+            __m128 shuf = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1));
+            sum = _mm_add_ps(sum, shuf);
+            sum = _mm_add_ss(sum, _mm_movehl_ps(shuf, sum));
+
+            _mm_store_ss(&dst[chan], sum);
+        }
+    }
+}
+
+static void SDL_TARGETING("avx2") ResampleFrame_Generic_AVX2(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    __m128 f0, f1, f2;
+
+    {
+        const __m128 frac1 = _mm_set1_ps(frac);
+        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
+        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+
+// Transposed in SetupAudioResampler
+#define X(out)                                               \
+    out = _mm_load_ps(filter[0].v);                          \
+    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
+    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
+    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
+    filter += 4
+
+        X(f0);
+        X(f1);
+        X(f2);
+
+#undef X
+    }
+
+    ResampleConvolve_AVX2(src, dst, f0, f1, f2, chans);
+}
+
+static void SDL_TARGETING("avx2") ResamplePhase_AVX2(const float *src, float *dst, const float *phase0, const float *phase1, float t, int chans)
+{
+    const __m128 t1 = _mm_set1_ps(t);
+
+    // Interpolate between the two phases
+#define X(i) sdl_madd_ps(_mm_loadu_ps(phase0 + i), _mm_sub_ps(_mm_loadu_ps(phase1 + i), _mm_loadu_ps(phase0 + i)), t1)
+    ResampleConvolve_AVX2(src, dst, X(0), X(4), X(8), chans);
+#undef X
+}
+
+#undef sdl_madd_ps
+#undef sdl_madd256_ps
+#undef sdl_set_m128
+#endif
 #ifdef SDL_NEON_INTRINSICS
 static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic *filter, float frac, int chans)
 {
@@ -513,9 +704,77 @@ static void GenerateResamplerFilter(void)
     }
 }
 
+// Common fixed ratios get a table with the filter precomputed for every output phase.
+// With a ratio of src_rate:dst_rate reduced to M:L, the source position of each output
+// frame is always a multiple of 1/L, so there are only L distinct filters.
+typedef struct ResamplerPhaseTable
+{
+    int src_rate;
+    int dst_rate;
+    Sint64 resample_rate;
+    int num_phases;
+    float (*phases)[RESAMPLER_SAMPLES_PER_FRAME]; // num_phases + 1 entries, the last is the first shifted by one frame
+} ResamplerPhaseTable;
+
+static float ResamplerPhases44100To48000[160 + 1][RESAMPLER_SAMPLES_PER_FRAME];
+static float ResamplerPhases48000To44100[147 + 1][RESAMPLER_SAMPLES_PER_FRAME];
+
+static ResamplerPhaseTable ResamplerPhaseTables[] = {
+    { 44100, 48000, 0, 0, ResamplerPhases44100To48000 },
+    { 48000, 44100, 0, 0, ResamplerPhases48000To44100 },
+};
+
+// Must be called before the filter is transposed
+static void GenerateResamplerPhaseTables(void)
+{
+    int i, j, k;
+
+    for (i = 0; i < (int)SDL_arraysize(ResamplerPhaseTables); ++i) {
+        ResamplerPhaseTable *table = &ResamplerPhaseTables[i];
+        const int num_phases = (int)(table->dst_rate / SDL_CalculateGCD(table->src_rate, table->dst_rate));
+
+        for (j = 0; j <= num_phases; ++j) {
+            const Cubic *filter;
+            float frac;
+
+            if (j < num_phases) {
+                // Round to the nearest position, as the resample rate is rounded up
+                const Uint32 srcfraction = (Uint32)((((Uint64)j << 32) + (num_phases / 2)) / num_phases);
+                filter = ResamplerFilter[srcfraction >> RESAMPLER_FILTER_INTERP_BITS];
+                frac = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+            } else {
+                filter = ResamplerFilter[RESAMPLER_SAMPLES_PER_ZERO_CROSSING - 1];
+                frac = 1.0f;
+            }
+
+            for (k = 0; k < RESAMPLER_SAMPLES_PER_FRAME; ++k, ++filter) {
+                table->phases[j][k] = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac * frac) + (filter->v[3] * frac * frac * frac);
+            }
+        }
+
+        table->resample_rate = SDL_GetResampleRate(table->src_rate, table->dst_rate);
+        table->num_phases = num_phases;
+    }
+}
+
+static const ResamplerPhaseTable *GetResamplerPhaseTable(Sint64 resample_rate)
+{
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(ResamplerPhaseTables); ++i) {
+        if (ResamplerPhaseTables[i].resample_rate == resample_rate) {
+            return &ResamplerPhaseTables[i];
+        }
+    }
+    return NULL;
+}
+
 typedef void (*ResampleFrameFunc)(const float *src, float *dst, const Cubic *filter, float frac, int chans);
 static ResampleFrameFunc ResampleFrame[8];
 
+typedef void (*ResamplePhaseFunc)(const float *src, float *dst, const float *phase0, const float *phase1, float t, int chans);
+static ResamplePhaseFunc ResamplePhase;
+
 // Transpose 4x4 floats
 static void Transpose4x4(Cubic *data)
 {
@@ -537,11 +796,22 @@ static void SetupAudioResampler(void)
 
     GenerateResamplerFilter();
 
+    // There's no NEON version of ResamplePhase, so NEON always interpolates the filter
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        for (i = 0; i < 8; ++i) {
+            ResampleFrame[i] = ResampleFrame_Generic_AVX2;
+        }
+        ResamplePhase = ResamplePhase_AVX2;
+        transpose = true;
+    } else
+#endif
 #ifdef SDL_SSE_INTRINSICS
     if (SDL_HasSSE()) {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_SSE;
         }
+        ResamplePhase = ResamplePhase_SSE;
         transpose = true;
     } else
 #endif
@@ -560,6 +830,11 @@ static void SetupAudioResampler(void)
 
         ResampleFrame[0] = ResampleFrame_Mono;
         ResampleFrame[1] = ResampleFrame_Stereo;
+        ResamplePhase = ResamplePhase_Generic;
+    }
+
+    if (ResamplePhase) {
+        GenerateResamplerPhaseTables();
     }
 
     if (transpose) {
@@ -681,11 +956,38 @@ void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, in
     int i;
     Sint64 srcpos = *inout_resample_offset;
     ResampleFrameFunc resample_frame = ResampleFrame[chans - 1];
+    const ResamplerPhaseTable *table = GetResamplerPhaseTable(resample_rate);
 
     SDL_assert(resample_rate > 0);
 
     src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
 
+    if (table) {
+        const Uint32 num_phases = (Uint32)table->num_phases;
+
+        for (i = 0; i < outframes; ++i) {
+            int srcindex = (int)(Sint32)(srcpos >> 32);
+            Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+            srcpos += resample_rate;
+
+            SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+            // The position is almost always exactly on a phase, but the resample rate
+            // is rounded up, so interpolate the tiny difference to stay in sync.
+            const Uint64 phasepos = (Uint64)srcfraction * num_phases;
+            const int phase = (int)(phasepos >> 32);
+            const float t = (float)(Uint32)(phasepos & 0xFFFFFFFF) * (1.0f / 4294967296.0f);
+
+            const float *frame = &src[srcindex * chans];
+            ResamplePhase(frame, dst, table->phases[phase], table->phases[phase + 1], t, chans);
+
+            dst += chans;
+        }
+
+        *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+        return;
+    }
+
     for (i = 0; i < outframes; ++i) {
         int srcindex = (int)(Sint32)(srcpos >> 32);
         Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
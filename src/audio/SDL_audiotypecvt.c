@@ -205,23 +205,28 @@ static void SDL_Convert_Swap32_Scalar(Uint32 *dst, const Uint32 *src, int num_sa
 
 // end fallback scalar converters
 
+// The alignment of the destination for the 16 sample blocks, minus one.
+// Aligning never skips more than CONVERT_ALIGN samples, so the vector path is only tried when there are more than that.
+// With the default of 15 this is the same `num_samples >= 16` check the SSE2 and NEON converters always used.
+#define CONVERT_ALIGN 15
+
 // Convert forwards, when sizeof(*src) >= sizeof(*dst)
-#define CONVERT_16_FWD(CVT1, CVT16)                          \
-    int i = 0;                                               \
-    if (num_samples >= 16) {                                 \
-        while ((uintptr_t)(&dst[i]) & 15) { CVT1  ++i;     } \
-        while ((i + 16) <= num_samples)   { CVT16 i += 16; } \
-    }                                                        \
-    while (i < num_samples)               { CVT1  ++i;     }
+#define CONVERT_16_FWD(CVT1, CVT16)                                        \
+    int i = 0;                                                             \
+    if (num_samples > CONVERT_ALIGN) {                                     \
+        while ((uintptr_t)(&dst[i]) & CONVERT_ALIGN) { CVT1  ++i;     }    \
+        while ((i + 16) <= num_samples)              { CVT16 i += 16; }    \
+    }                                                                      \
+    while (i < num_samples)                          { CVT1  ++i;     }
 
 // Convert backwards, when sizeof(*src) <= sizeof(*dst)
-#define CONVERT_16_REV(CVT1, CVT16)                          \
-    int i = num_samples;                                     \
-    if (i >= 16) {                                           \
-        while ((uintptr_t)(&dst[i]) & 15) { --i;     CVT1  } \
-        while (i >= 16)                   { i -= 16; CVT16 } \
-    }                                                        \
-    while (i > 0)                         { --i;     CVT1  }
+#define CONVERT_16_REV(CVT1, CVT16)                                        \
+    int i = num_samples;                                                   \
+    if (i > CONVERT_ALIGN) {                                               \
+        while ((uintptr_t)(&dst[i]) & CONVERT_ALIGN) { --i;     CVT1  }    \
+        while (i >= 16)                              { i -= 16; CVT16 }    \
+    }                                                                      \
+    while (i > 0)                                    { --i;     CVT1  }
 
 #ifdef SDL_SSE2_INTRINSICS
 static void SDL_TARGETING("sse2") SDL_Convert_S8_to_F32_SSE2(float *dst, const Sint8 *src, int num_samples)
@@ -530,6 +535,389 @@ static void SDL_TARGETING("ssse3") SDL_Convert_Swap32_SSSE3(Uint32 *dst, const U
 }
 #endif
 
+#ifdef SDL_AVX2_INTRINSICS
+/* The AVX2 and AVX-512 converters work on the sample values directly, which
+ * gives the same results as the scalar bit tricks:
+ * - integer to float conversions scale by an exact power of two
+ * - float to integer conversions scale, clamp, then round to nearest even */
+static void SDL_TARGETING("avx2") SDL_Convert_S8_to_F32_AVX2(float *dst, const Sint8 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / 128.0
+    const __m256 scaler = _mm256_set1_ps(1.0f / 128.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("S8", "F32 (using AVX2)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)src[i] * (1.0f / 128.0f);
+    }, {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)&src[i]);
+
+        const __m256 floats0 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes)), scaler);
+        const __m256 floats1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(bytes, 8))), scaler);
+
+        _mm256_storeu_ps(&dst[i], floats0);
+        _mm256_storeu_ps(&dst[i + 8], floats1);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_U8_to_F32_AVX2(float *dst, const Uint8 *src, int num_samples)
+{
+    // dst[i] = (f32(src[i]) - 128.0) / 128.0
+    const __m256 scaler = _mm256_set1_ps(1.0f / 128.0f);
+    const __m256 offset = _mm256_set1_ps(-1.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("U8", "F32 (using AVX2)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)((int)src[i] - 128) * (1.0f / 128.0f);
+    }, {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)&src[i]);
+
+        const __m256 floats0 = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)), scaler), offset);
+        const __m256 floats1 = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8))), scaler), offset);
+
+        _mm256_storeu_ps(&dst[i], floats0);
+        _mm256_storeu_ps(&dst[i + 8], floats1);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_S16_to_F32_AVX2(float *dst, const Sint16 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / 32768.0
+    const __m256 scaler = _mm256_set1_ps(1.0f / 32768.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("S16", "F32 (using AVX2)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)src[i] * (1.0f / 32768.0f);
+    }, {
+        const __m128i shorts0 = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i shorts1 = _mm_loadu_si128((const __m128i *)&src[i + 8]);
+
+        const __m256 floats0 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(shorts0)), scaler);
+        const __m256 floats1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(shorts1)), scaler);
+
+        _mm256_storeu_ps(&dst[i], floats0);
+        _mm256_storeu_ps(&dst[i + 8], floats1);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_S32_to_F32_AVX2(float *dst, const Sint32 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / f32(0x80000000)
+    const __m256 scaler = _mm256_set1_ps(DIVBY2147483648);
+
+    LOG_DEBUG_AUDIO_CONVERT("S32", "F32 (using AVX2)");
+
+    CONVERT_16_FWD({
+        dst[i] = (float)src[i] * DIVBY2147483648;
+    }, {
+        const __m256i ints0 = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i ints1 = _mm256_loadu_si256((const __m256i *)&src[i + 8]);
+
+        const __m256 floats0 = _mm256_mul_ps(_mm256_cvtepi32_ps(ints0), scaler);
+        const __m256 floats1 = _mm256_mul_ps(_mm256_cvtepi32_ps(ints1), scaler);
+
+        _mm256_storeu_ps(&dst[i], floats0);
+        _mm256_storeu_ps(&dst[i + 8], floats1);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_F32_to_S8_AVX2(Sint8 *dst, const float *src, int num_samples)
+{
+    // dst[i] = i8(round(clamp(src[i] * 128.0, -128.0, 127.0)))
+    const __m256 scaler = _mm256_set1_ps(128.0f);
+    const __m256 minval = _mm256_set1_ps(-128.0f);
+    const __m256 maxval = _mm256_set1_ps(127.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S8 (using AVX2)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm256_castps256_ps128(scaler)), _mm256_castps256_ps128(minval)), _mm256_castps256_ps128(maxval));
+        dst[i] = (Sint8)_mm_cvtss_si32(value);
+    }, {
+        const __m256 floats0 = _mm256_loadu_ps(&src[i]);
+        const __m256 floats1 = _mm256_loadu_ps(&src[i + 8]);
+
+        const __m256i ints0 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats0, scaler), minval), maxval));
+        const __m256i ints1 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats1, scaler), minval), maxval));
+
+        // The packs work within 128-bit lanes, so put the 64-bit halves back in order
+        const __m256i shorts = _mm256_permute4x64_epi64(_mm256_packs_epi32(ints0, ints1), 0xD8);
+        const __m128i bytes = _mm_packs_epi16(_mm256_castsi256_si128(shorts), _mm256_extracti128_si256(shorts, 1));
+
+        _mm_store_si128((__m128i *)&dst[i], bytes);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_F32_to_U8_AVX2(Uint8 *dst, const float *src, int num_samples)
+{
+    // dst[i] = u8(round(clamp(src[i] * 128.0, -128.0, 127.0)) + 128)
+    const __m256 scaler = _mm256_set1_ps(128.0f);
+    const __m256 minval = _mm256_set1_ps(-128.0f);
+    const __m256 maxval = _mm256_set1_ps(127.0f);
+    const __m256i offset = _mm256_set1_epi32(128);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "U8 (using AVX2)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm256_castps256_ps128(scaler)), _mm256_castps256_ps128(minval)), _mm256_castps256_ps128(maxval));
+        dst[i] = (Uint8)(_mm_cvtss_si32(value) + 128);
+    }, {
+        const __m256 floats0 = _mm256_loadu_ps(&src[i]);
+        const __m256 floats1 = _mm256_loadu_ps(&src[i + 8]);
+
+        const __m256i ints0 = _mm256_add_epi32(_mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats0, scaler), minval), maxval)), offset);
+        const __m256i ints1 = _mm256_add_epi32(_mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats1, scaler), minval), maxval)), offset);
+
+        // The packs work within 128-bit lanes, so put the 64-bit halves back in order
+        const __m256i shorts = _mm256_permute4x64_epi64(_mm256_packs_epi32(ints0, ints1), 0xD8);
+        const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(shorts), _mm256_extracti128_si256(shorts, 1));
+
+        _mm_store_si128((__m128i *)&dst[i], bytes);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_F32_to_S16_AVX2(Sint16 *dst, const float *src, int num_samples)
+{
+    // dst[i] = i16(round(clamp(src[i] * 32768.0, -32768.0, 32767.0)))
+    const __m256 scaler = _mm256_set1_ps(32768.0f);
+    const __m256 minval = _mm256_set1_ps(-32768.0f);
+    const __m256 maxval = _mm256_set1_ps(32767.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S16 (using AVX2)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm256_castps256_ps128(scaler)), _mm256_castps256_ps128(minval)), _mm256_castps256_ps128(maxval));
+        dst[i] = (Sint16)_mm_cvtss_si32(value);
+    }, {
+        const __m256 floats0 = _mm256_loadu_ps(&src[i]);
+        const __m256 floats1 = _mm256_loadu_ps(&src[i + 8]);
+
+        const __m256i ints0 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats0, scaler), minval), maxval));
+        const __m256i ints1 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(floats1, scaler), minval), maxval));
+
+        // The packs work within 128-bit lanes, so put the 64-bit halves back in order
+        const __m256i shorts = _mm256_permute4x64_epi64(_mm256_packs_epi32(ints0, ints1), 0xD8);
+
+        _mm256_storeu_si256((__m256i *)&dst[i], shorts);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_F32_to_S32_AVX2(Sint32 *dst, const float *src, int num_samples)
+{
+    /* 1) Scale the float range from [-1.0, 1.0] to [-2147483648.0, 2147483648.0]
+     * 2) Convert to integer (values too small/large become 0x80000000 = -2147483648)
+     * 3) Fixup values which were too large (0x80000000 ^ 0xFFFFFFFF = 2147483647)
+     * dst[i] = i32(src[i] * 2147483648.0) ^ ((src[i] >= 2147483648.0) ? 0xFFFFFFFF : 0x00000000) */
+    const __m256 limit = _mm256_set1_ps(2147483648.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S32 (using AVX2)");
+
+    CONVERT_16_FWD({
+        const __m128 values = _mm_mul_ss(_mm_load_ss(&src[i]), _mm256_castps256_ps128(limit));
+        const __m128i ints = _mm_xor_si128(_mm_cvttps_epi32(values), _mm_castps_si128(_mm_cmpge_ss(values, _mm256_castps256_ps128(limit))));
+        dst[i] = (Sint32)_mm_cvtsi128_si32(ints);
+    }, {
+        const __m256 values0 = _mm256_mul_ps(_mm256_loadu_ps(&src[i]), limit);
+        const __m256 values1 = _mm256_mul_ps(_mm256_loadu_ps(&src[i + 8]), limit);
+
+        const __m256i ints0 = _mm256_xor_si256(_mm256_cvttps_epi32(values0), _mm256_castps_si256(_mm256_cmp_ps(values0, limit, _CMP_GE_OQ)));
+        const __m256i ints1 = _mm256_xor_si256(_mm256_cvttps_epi32(values1), _mm256_castps_si256(_mm256_cmp_ps(values1, limit, _CMP_GE_OQ)));
+
+        _mm256_storeu_si256((__m256i *)&dst[i], ints0);
+        _mm256_storeu_si256((__m256i *)&dst[i + 8], ints1);
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_Swap16_AVX2(Uint16 *dst, const Uint16 *src, int num_samples)
+{
+    const __m256i shuffle = _mm256_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                            14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+    CONVERT_16_FWD({
+        dst[i] = SDL_Swap16(src[i]);
+    }, {
+        const __m256i ints = _mm256_loadu_si256((const __m256i *)&src[i]);
+
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_shuffle_epi8(ints, shuffle));
+    })
+}
+
+static void SDL_TARGETING("avx2") SDL_Convert_Swap32_AVX2(Uint32 *dst, const Uint32 *src, int num_samples)
+{
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                            12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    CONVERT_16_FWD({
+        dst[i] = SDL_Swap32(src[i]);
+    }, {
+        const __m256i ints0 = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i ints1 = _mm256_loadu_si256((const __m256i *)&src[i + 8]);
+
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_shuffle_epi8(ints0, shuffle));
+        _mm256_storeu_si256((__m256i *)&dst[i + 8], _mm256_shuffle_epi8(ints1, shuffle));
+    })
+}
+#endif
+
+#ifdef SDL_AVX512F_INTRINSICS
+// Full vector stores that cross cache lines are expensive, so align to 64 bytes
+#undef CONVERT_ALIGN
+#define CONVERT_ALIGN 63
+
+static void SDL_TARGETING("avx512f") SDL_Convert_S8_to_F32_AVX512F(float *dst, const Sint8 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / 128.0
+    const __m512 scaler = _mm512_set1_ps(1.0f / 128.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("S8", "F32 (using AVX-512F)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)src[i] * (1.0f / 128.0f);
+    }, {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)&src[i]);
+
+        _mm512_storeu_ps(&dst[i], _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(bytes)), scaler));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_U8_to_F32_AVX512F(float *dst, const Uint8 *src, int num_samples)
+{
+    // dst[i] = (f32(src[i]) - 128.0) / 128.0
+    const __m512 scaler = _mm512_set1_ps(1.0f / 128.0f);
+    const __m512 offset = _mm512_set1_ps(-1.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("U8", "F32 (using AVX-512F)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)((int)src[i] - 128) * (1.0f / 128.0f);
+    }, {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)&src[i]);
+
+        _mm512_storeu_ps(&dst[i], _mm512_add_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(bytes)), scaler), offset));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_S16_to_F32_AVX512F(float *dst, const Sint16 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / 32768.0
+    const __m512 scaler = _mm512_set1_ps(1.0f / 32768.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("S16", "F32 (using AVX-512F)");
+
+    CONVERT_16_REV({
+        dst[i] = (float)src[i] * (1.0f / 32768.0f);
+    }, {
+        const __m256i shorts = _mm256_loadu_si256((const __m256i *)&src[i]);
+
+        _mm512_storeu_ps(&dst[i], _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(shorts)), scaler));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_S32_to_F32_AVX512F(float *dst, const Sint32 *src, int num_samples)
+{
+    // dst[i] = f32(src[i]) / f32(0x80000000)
+    const __m512 scaler = _mm512_set1_ps(DIVBY2147483648);
+
+    LOG_DEBUG_AUDIO_CONVERT("S32", "F32 (using AVX-512F)");
+
+    CONVERT_16_FWD({
+        dst[i] = (float)src[i] * DIVBY2147483648;
+    }, {
+        const __m512i ints = _mm512_loadu_si512((const void *)&src[i]);
+
+        _mm512_storeu_ps(&dst[i], _mm512_mul_ps(_mm512_cvtepi32_ps(ints), scaler));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_F32_to_S8_AVX512F(Sint8 *dst, const float *src, int num_samples)
+{
+    // dst[i] = i8(round(clamp(src[i] * 128.0, -128.0, 127.0)))
+    const __m512 scaler = _mm512_set1_ps(128.0f);
+    const __m512 minval = _mm512_set1_ps(-128.0f);
+    const __m512 maxval = _mm512_set1_ps(127.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S8 (using AVX-512F)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm512_castps512_ps128(scaler)), _mm512_castps512_ps128(minval)), _mm512_castps512_ps128(maxval));
+        dst[i] = (Sint8)_mm_cvtss_si32(value);
+    }, {
+        const __m512 floats = _mm512_loadu_ps(&src[i]);
+        const __m512i ints = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(floats, scaler), minval), maxval));
+
+        _mm_store_si128((__m128i *)&dst[i], _mm512_cvtepi32_epi8(ints));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_F32_to_U8_AVX512F(Uint8 *dst, const float *src, int num_samples)
+{
+    // dst[i] = u8(round(clamp(src[i] * 128.0, -128.0, 127.0)) + 128)
+    const __m512 scaler = _mm512_set1_ps(128.0f);
+    const __m512 minval = _mm512_set1_ps(-128.0f);
+    const __m512 maxval = _mm512_set1_ps(127.0f);
+    const __m512i offset = _mm512_set1_epi32(128);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "U8 (using AVX-512F)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm512_castps512_ps128(scaler)), _mm512_castps512_ps128(minval)), _mm512_castps512_ps128(maxval));
+        dst[i] = (Uint8)(_mm_cvtss_si32(value) + 128);
+    }, {
+        const __m512 floats = _mm512_loadu_ps(&src[i]);
+        const __m512i ints = _mm512_add_epi32(_mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(floats, scaler), minval), maxval)), offset);
+
+        _mm_store_si128((__m128i *)&dst[i], _mm512_cvtepi32_epi8(ints));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_F32_to_S16_AVX512F(Sint16 *dst, const float *src, int num_samples)
+{
+    // dst[i] = i16(round(clamp(src[i] * 32768.0, -32768.0, 32767.0)))
+    const __m512 scaler = _mm512_set1_ps(32768.0f);
+    const __m512 minval = _mm512_set1_ps(-32768.0f);
+    const __m512 maxval = _mm512_set1_ps(32767.0f);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S16 (using AVX-512F)");
+
+    CONVERT_16_FWD({
+        const __m128 value = _mm_min_ss(_mm_max_ss(_mm_mul_ss(_mm_load_ss(&src[i]), _mm512_castps512_ps128(scaler)), _mm512_castps512_ps128(minval)), _mm512_castps512_ps128(maxval));
+        dst[i] = (Sint16)_mm_cvtss_si32(value);
+    }, {
+        const __m512 floats = _mm512_loadu_ps(&src[i]);
+        const __m512i ints = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(floats, scaler), minval), maxval));
+
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm512_cvtepi32_epi16(ints));
+    })
+}
+
+static void SDL_TARGETING("avx512f") SDL_Convert_F32_to_S32_AVX512F(Sint32 *dst, const float *src, int num_samples)
+{
+    /* 1) Scale the float range from [-1.0, 1.0] to [-2147483648.0, 2147483648.0]
+     * 2) Convert to integer (values too small/large become 0x80000000 = -2147483648)
+     * 3) Fixup values which were too large to 2147483647 */
+    const __m512 limit = _mm512_set1_ps(2147483648.0f);
+    const __m512i maxval = _mm512_set1_epi32(0x7FFFFFFF);
+
+    LOG_DEBUG_AUDIO_CONVERT("F32", "S32 (using AVX-512F)");
+
+    CONVERT_16_FWD({
+        const __m128 values = _mm_mul_ss(_mm_load_ss(&src[i]), _mm512_castps512_ps128(limit));
+        const __m128i ints = _mm_xor_si128(_mm_cvttps_epi32(values), _mm_castps_si128(_mm_cmpge_ss(values, _mm512_castps512_ps128(limit))));
+        dst[i] = (Sint32)_mm_cvtsi128_si32(ints);
+    }, {
+        const __m512 values = _mm512_mul_ps(_mm512_loadu_ps(&src[i]), limit);
+        const __mmask16 overflow = _mm512_cmp_ps_mask(values, limit, _CMP_GE_OQ);
+
+        _mm512_storeu_si512((void *)&dst[i], _mm512_mask_mov_epi32(_mm512_cvttps_epi32(values), overflow, maxval));
+    })
+}
+
+#undef CONVERT_ALIGN
+#define CONVERT_ALIGN 15
+#endif
+
 #ifdef SDL_NEON_INTRINSICS
 
 // C99 requires that all code modifying floating point environment should
@@ -826,6 +1214,7 @@ static void SDL_Convert_Swap32_NEON(Uint32 *dst, const Uint32 *src, int num_samp
 
 #endif
 
+#undef CONVERT_ALIGN
 #undef CONVERT_16_FWD
 #undef CONVERT_16_REV
 
@@ -936,6 +1325,11 @@ void SDL_ChooseAudioConverters(void)
     SDL_Convert_Swap16 = SDL_Convert_Swap16_##fntype; \
     SDL_Convert_Swap32 = SDL_Convert_Swap32_##fntype;
 
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_CONVERTER_FUNCS(AVX2);
+    } else
+#endif
 #ifdef SDL_SSE4_1_INTRINSICS
     if (SDL_HasSSE41()) {
         SET_CONVERTER_FUNCS(SSSE3);
@@ -962,6 +1356,16 @@ void SDL_ChooseAudioConverters(void)
     SDL_Convert_F32_to_S16 = SDL_Convert_F32_to_S16_##fntype; \
     SDL_Convert_F32_to_S32 = SDL_Convert_F32_to_S32_##fntype; \
 
+#ifdef SDL_AVX512F_INTRINSICS
+    if (SDL_HasAVX512F()) {
+        SET_CONVERTER_FUNCS(AVX512F);
+    } else
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_CONVERTER_FUNCS(AVX2);
+    } else
+#endif
 #ifdef SDL_SSE2_INTRINSICS
     if (SDL_HasSSE2()) {
         SET_CONVERTER_FUNCS(SSE2);
@@ -82,7 +82,83 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / MIX_MAXVOLUME) + 128))
 
-// !!! FIXME: This needs some SIMD magic.
+#ifdef SDL_AVX_INTRINSICS
+static Uint32 SDL_TARGETING("avx") MixFloat32_AVX(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+    const __m256 volume = _mm256_set1_ps(fvolume);
+    const __m256 max_audioval = _mm256_set1_ps(1.0f);
+    const __m256 min_audioval = _mm256_set1_ps(-1.0f);
+    Uint32 i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        const __m256 sum = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), volume), _mm256_loadu_ps(dst + i));
+        // min/max return their second operand if either is NaN, so this lets NaNs through like the scalar version does.
+        _mm256_storeu_ps(dst + i, _mm256_min_ps(max_audioval, _mm256_max_ps(min_audioval, sum)));
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_SSE_INTRINSICS
+static Uint32 SDL_TARGETING("sse") MixFloat32_SSE(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+    const __m128 volume = _mm_set1_ps(fvolume);
+    const __m128 max_audioval = _mm_set1_ps(1.0f);
+    const __m128 min_audioval = _mm_set1_ps(-1.0f);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        const __m128 sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), volume), _mm_loadu_ps(dst + i));
+        // min/max return their second operand if either is NaN, so this lets NaNs through like the scalar version does.
+        _mm_storeu_ps(dst + i, _mm_min_ps(max_audioval, _mm_max_ps(min_audioval, sum)));
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static Uint32 MixFloat32_NEON(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+    const float32x4_t volume = vdupq_n_f32(fvolume);
+    const float32x4_t max_audioval = vdupq_n_f32(1.0f);
+    const float32x4_t min_audioval = vdupq_n_f32(-1.0f);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        // Not using vmlaq_f32, it might be fused, which would round differently than the scalar version.
+        const float32x4_t sum = vaddq_f32(vmulq_f32(vld1q_f32(src + i), volume), vld1q_f32(dst + i));
+        vst1q_f32(dst + i, vminq_f32(max_audioval, vmaxq_f32(min_audioval, sum)));
+    }
+
+    return i;
+}
+#endif
+
+// Mix as many native-endian float samples as possible with SIMD, returns the number of samples mixed.
+//  This does the same math in the same order as the scalar version below.
+static Uint32 MixFloat32_SIMD(float *dst, const float *src, Uint32 num_samples, float fvolume)
+{
+#ifdef SDL_AVX_INTRINSICS
+    if (SDL_HasAVX()) {
+        return MixFloat32_AVX(dst, src, num_samples, fvolume);
+    }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        return MixFloat32_SSE(dst, src, num_samples, fvolume);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return MixFloat32_NEON(dst, src, num_samples, fvolume);
+    }
+#endif
+    return 0;
+}
+
+// !!! FIXME: The integer formats need some SIMD magic.
 // !!! FIXME: Add fast-path for volume = 1
 // !!! FIXME: Use larger scales for 16-bit/32-bit integers
 
@@ -242,6 +318,14 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         const float min_audioval = -1.0f;
 
         len /= 4;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        {
+            const Uint32 mixed = MixFloat32_SIMD(dst32, src32, len, fvolume);
+            src32 += mixed;
+            dst32 += mixed;
+            len -= mixed;
+        }
+#endif
         while (len--) {
             src1 = SDL_SwapFloatLE(*src32) * fvolume;
             src2 = SDL_SwapFloatLE(*dst32);
@@ -267,6 +351,14 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         const float min_audioval = -1.0f;
 
         len /= 4;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        {
+            const Uint32 mixed = MixFloat32_SIMD(dst32, src32, len, fvolume);
+            src32 += mixed;
+            dst32 += mixed;
+            len -= mixed;
+        }
+#endif
         while (len--) {
             src1 = SDL_SwapFloatBE(*src32) * fvolume;
             src2 = SDL_SwapFloatBE(*dst32);
@@ -195,6 +195,15 @@ typedef struct SDL_AudioDriver
     SDL_AtomicInt playback_device_count;
     SDL_AtomicInt recording_device_count;
     SDL_AtomicInt shutting_down;  // non-zero during SDL_Quit, so we known not to accept any last-minute device hotplugs.
+
+    // Worker threads that pull bound streams for playback devices in parallel (see SDL_HINT_AUDIO_MIXER_THREADS).
+    SDL_Thread **mixer_threads;
+    int num_mixer_threads;
+    SDL_Mutex *mixer_lock;  // protects mixer_queue, mixer_shutdown and each device's mix_active_workers.
+    SDL_Condition *mixer_cond;  // signaled when a device is added to mixer_queue, or when shutting down.
+    SDL_Condition *mixer_done_cond;  // signaled when a mixer thread is done working on a device.
+    struct SDL_AudioDevice *mixer_queue;  // devices with streams waiting to be pulled.
+    bool mixer_shutdown;
 } SDL_AudioDriver;
 
 struct SDL_AudioQueue; // forward decl.
@@ -348,6 +357,20 @@ struct SDL_AudioDevice
     // Size of work_buffer (and mix_buffer) in bytes.
     int work_buffer_size;
 
+    // Bound streams being pulled in parallel on the mixer threads, and a work buffer for each of them.
+    SDL_AudioStream **mix_streams;
+    float *mix_gains;
+    int *mix_results;
+    Uint8 *mix_stream_buffers;
+    int num_mix_streams;
+    int mix_streams_allocated;
+    int mix_stream_buffers_allocated;
+    int mix_stream_buffer_pitch;  // bytes between each stream's buffer in mix_stream_buffers, the work_buffer_size they were allocated for.
+    int mix_stream_buffer_size;  // bytes requested from each stream this iteration.
+    SDL_AtomicInt mix_next;  // index of the next stream in mix_streams to pull.
+    int mix_active_workers;  // mixer threads currently pulling streams for this device. Protected by current_audio.mixer_lock.
+    struct SDL_AudioDevice *mixer_queue_next;
+
     // A thread to feed the audio device
     SDL_Thread *thread;
 
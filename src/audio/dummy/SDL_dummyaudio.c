@@ -29,10 +29,49 @@
 #include <emscripten/emscripten.h>
 #endif
 
+static void DUMMYAUDIO_UpdateIODelay(SDL_AudioDevice *device)
+{
+    device->hidden->io_delay = ((device->sample_frames * 1000) / device->spec.freq);
+
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DUMMY_TIMESCALE);
+    if (hint) {
+        double scale = SDL_atof(hint);
+        if (scale >= 0.0) {
+            device->hidden->io_delay = (Uint32)SDL_round(device->hidden->io_delay * scale);
+        }
+    }
+}
+
+// Act like the hardware changed its buffer size if the app asked for that, to test format changes.
+static bool DUMMYAUDIO_CheckSampleFrames(SDL_AudioDevice *device)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES);
+    const int sample_frames = hint ? SDL_atoi(hint) : 0;
+    if ((sample_frames <= 0) || (sample_frames == device->sample_frames)) {
+        return true;
+    }
+
+    SDL_AudioSpec spec;
+    SDL_copyp(&spec, &device->spec);
+    if (!SDL_AudioDeviceFormatChanged(device, &spec, sample_frames)) {
+        return false;
+    }
+
+    if (device->hidden->mixbuf) {
+        Uint8 *mixbuf = (Uint8 *) SDL_realloc(device->hidden->mixbuf, device->buffer_size);
+        if (!mixbuf) {
+            return false;
+        }
+        device->hidden->mixbuf = mixbuf;
+    }
+    DUMMYAUDIO_UpdateIODelay(device);
+    return true;
+}
+
 static bool DUMMYAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
     SDL_Delay(device->hidden->io_delay);
-    return true;
+    return DUMMYAUDIO_CheckSampleFrames(device);
 }
 
 static bool DUMMYAUDIO_OpenDevice(SDL_AudioDevice *device)
@@ -49,15 +88,7 @@ static bool DUMMYAUDIO_OpenDevice(SDL_AudioDevice *device)
         }
     }
 
-    device->hidden->io_delay = ((device->sample_frames * 1000) / device->spec.freq);
-
-    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DUMMY_TIMESCALE);
-    if (hint) {
-        double scale = SDL_atof(hint);
-        if (scale >= 0.0) {
-            device->hidden->io_delay = (Uint32)SDL_round(device->hidden->io_delay * scale);
-        }
-    }
+    DUMMYAUDIO_UpdateIODelay(device);
 
     // on Emscripten without threads, we just fire a repeating timer to consume audio.
     #if defined(SDL_PLATFORM_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
@@ -24,4 +24,7 @@
 
 extern void SDL_QuitCPUInfo(void);
 
+// AVX-512 byte and word instructions, for internal SIMD code paths
+extern bool SDL_HasAVX512BW(void);
+
 #endif // SDL_cpuinfo_c_h_
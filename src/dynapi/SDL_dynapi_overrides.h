@@ -1279,3 +1279,21 @@
 #define SDL_SetAudioIterationCallbacks SDL_SetAudioIterationCallbacks_REAL
 #define SDL_GetEventDescription SDL_GetEventDescription_REAL
 #define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
+#define SDL_DrainEvents SDL_DrainEvents_REAL
+#define SDL_AddTimerWithProperties SDL_AddTimerWithProperties_REAL
+#define SDL_GetTimerStatistics SDL_GetTimerStatistics_REAL
+#define SDL_RenderTextures SDL_RenderTextures_REAL
+#define SDL_LoadFileNoCopy SDL_LoadFileNoCopy_REAL
+#define SDL_CopyFileAsync SDL_CopyFileAsync_REAL
+#define SDL_SetIOBufferSize SDL_SetIOBufferSize_REAL
+#define SDL_ReadU16LEArray SDL_ReadU16LEArray_REAL
+#define SDL_ReadU16BEArray SDL_ReadU16BEArray_REAL
+#define SDL_ReadU32LEArray SDL_ReadU32LEArray_REAL
+#define SDL_ReadU32BEArray SDL_ReadU32BEArray_REAL
+#define SDL_ReadU64LEArray SDL_ReadU64LEArray_REAL
+#define SDL_ReadU64BEArray SDL_ReadU64BEArray_REAL
+#define SDL_CreateAsyncIOQueueWithProperties SDL_CreateAsyncIOQueueWithProperties_REAL
+#define SDL_BeginAsyncIOBatch SDL_BeginAsyncIOBatch_REAL
+#define SDL_EndAsyncIOBatch SDL_EndAsyncIOBatch_REAL
+#define SDL_RegisterAsyncIOBuffer SDL_RegisterAsyncIOBuffer_REAL
+#define SDL_UnregisterAsyncIOBuffer SDL_UnregisterAsyncIOBuffer_REAL
@@ -1287,3 +1287,21 @@ SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamPlanarData,(SDL_AudioStream *a,const void
 SDL_DYNAPI_PROC(bool,SDL_SetAudioIterationCallbacks,(SDL_AudioDeviceID a,SDL_AudioIterationCallback b,SDL_AudioIterationCallback c,void *d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(int,SDL_GetEventDescription,(const SDL_Event *a,char *b,int c),(a,b,c),return)
 SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamDataNoCopy,(SDL_AudioStream *a,const void *b,int c,SDL_AudioStreamDataCompleteCallback d,void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_DrainEvents,(SDL_Event *a,int b,const Uint32 *c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTimerStatistics,(SDL_TimerStatistics *a,bool b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_RenderTextures,(SDL_Renderer *a,SDL_Texture *b,const SDL_FRect *c,const SDL_FRect *d,const SDL_FColor *e,const double *f,const SDL_FlipMode *g,int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(const void*,SDL_LoadFileNoCopy,(const char *a,size_t *b,SDL_ReleaseFileDataCallback *c,void **d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_CopyFileAsync,(const char *a,const char *b,SDL_AsyncIOQueue *c,void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_SetIOBufferSize,(SDL_IOStream *a,size_t b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU16LEArray,(SDL_IOStream *a,Uint16 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU16BEArray,(SDL_IOStream *a,Uint16 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU32LEArray,(SDL_IOStream *a,Uint32 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU32BEArray,(SDL_IOStream *a,Uint32 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU64LEArray,(SDL_IOStream *a,Uint64 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadU64BEArray,(SDL_IOStream *a,Uint64 *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOQueue*,SDL_CreateAsyncIOQueueWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_BeginAsyncIOBatch,(SDL_AsyncIOQueue *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_EndAsyncIOBatch,(SDL_AsyncIOQueue *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_RegisterAsyncIOBuffer,(SDL_AsyncIOQueue *a,void *b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_UnregisterAsyncIOBuffer,(SDL_AsyncIOQueue *a,void *b),(a,b),return)
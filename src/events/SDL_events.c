@@ -131,10 +131,66 @@ typedef struct SDL_EventEntry
 {
     SDL_Event event;
     SDL_TemporaryMemory *memory;
+    Uint64 sequence;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
+    struct SDL_EventEntry *type_prev;
+    struct SDL_EventEntry *type_next;
 } SDL_EventEntry;
 
+/* Queued events are also linked into a queue per event type, so looking for
+   a few types costs O(matches) instead of a walk over the whole queue. These
+   are allocated in blocks of 256 types, like SDL_disabled_events, and types
+   past SDL_EVENT_LAST share the last queue. */
+typedef struct SDL_EventTypeQueue
+{
+    SDL_EventEntry *head;
+    SDL_EventEntry *tail;
+} SDL_EventTypeQueue;
+
+typedef struct SDL_EventTypeBlock
+{
+    int count;
+    SDL_EventTypeQueue queues[256];
+} SDL_EventTypeBlock;
+
+static SDL_EventTypeBlock *SDL_event_types[256];
+
+// The most type queues merged by a cursor before it walks the whole queue instead
+#define SDL_MAX_CURSOR_QUEUES 16
+
+typedef struct SDL_EventCursor
+{
+    Uint32 minType;
+    Uint32 maxType;
+    const Uint32 *types;
+    int numtypes;
+    int num_queues; // -1 to walk the whole queue
+    SDL_EventEntry *next;
+    SDL_EventEntry *queues[SDL_MAX_CURSOR_QUEUES];
+} SDL_EventCursor;
+
+/* When SDL_HINT_EVENT_QUEUE_LOCKFREE is enabled, producers add events to a
+   bounded ring without taking SDL_EventQ.lock, and the ring is drained into
+   the main queue by whoever holds the lock next. This is Dmitry Vyukov's
+   bounded MPMC queue, used with a single consumer (the lock holder). */
+#define SDL_EVENT_RING_SIZE 1024 // must be a power of two
+#define SDL_EVENT_RING_MASK (SDL_EVENT_RING_SIZE - 1)
+
+typedef struct SDL_EventRingCell
+{
+    SDL_AtomicU32 sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingCell;
+
+typedef struct SDL_EventRing
+{
+    SDL_AtomicU32 enqueue_pos;
+    Uint8 padding[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicU32)]; // keep producers off the consumer's cache line
+    Uint32 dequeue_pos;
+    SDL_EventRingCell cells[SDL_EVENT_RING_SIZE];
+} SDL_EventRing;
+
 static struct
 {
     SDL_Mutex *lock;
@@ -144,7 +200,11 @@ static struct
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
+    Uint64 sequence;
+    SDL_EventRing *ring;
+    SDL_AtomicInt ring_enabled;
+    SDL_AtomicInt ring_producers;
+} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL, 0, NULL, { 0 }, { 0 } };
 
 
 static void SDL_CleanupTemporaryMemory(void *data)
@@ -913,6 +973,504 @@ static void SDL_LogEvent(const SDL_Event *event)
     }
 }
 
+// Get an unused event entry -- called with the queue locked
+static SDL_EventEntry *SDL_AllocEventEntry(void)
+{
+    SDL_EventEntry *entry;
+
+    if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+    return entry;
+}
+
+static SDL_EventTypeQueue *SDL_GetEventTypeQueue(Uint32 type, bool create)
+{
+    const Uint32 bucket = SDL_min(type, SDL_EVENT_LAST);
+    const Uint8 hi = (Uint8)((bucket >> 8) & 0xff);
+    const Uint8 lo = (Uint8)(bucket & 0xff);
+
+    if (!SDL_event_types[hi]) {
+        if (!create) {
+            return NULL;
+        }
+        SDL_event_types[hi] = (SDL_EventTypeBlock *)SDL_calloc(1, sizeof(SDL_EventTypeBlock));
+        if (!SDL_event_types[hi]) {
+            return NULL;
+        }
+    }
+    return &SDL_event_types[hi]->queues[lo];
+}
+
+// Append an entry to the end of the event queue -- called with the queue locked
+static bool SDL_LinkEventEntry(SDL_EventEntry *entry)
+{
+    SDL_EventTypeQueue *queue = SDL_GetEventTypeQueue(entry->event.type, true);
+
+    if (!queue) {
+        return false;
+    }
+
+    entry->sequence = SDL_EventQ.sequence++;
+
+    entry->type_prev = queue->tail;
+    entry->type_next = NULL;
+    if (queue->tail) {
+        queue->tail->type_next = entry;
+    } else {
+        queue->head = entry;
+    }
+    queue->tail = entry;
+    ++SDL_event_types[(SDL_min(entry->event.type, SDL_EVENT_LAST) >> 8) & 0xff]->count;
+
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+    return true;
+}
+
+// Remove an entry from its type queue -- called with the queue locked
+static void SDL_UnlinkEventEntryType(SDL_EventEntry *entry)
+{
+    const Uint32 bucket = SDL_min(entry->event.type, SDL_EVENT_LAST);
+    SDL_EventTypeBlock *block = SDL_event_types[(bucket >> 8) & 0xff];
+    SDL_EventTypeQueue *queue = &block->queues[bucket & 0xff];
+
+    if (entry->type_prev) {
+        entry->type_prev->type_next = entry->type_next;
+    } else {
+        SDL_assert(queue->head == entry);
+        queue->head = entry->type_next;
+    }
+    if (entry->type_next) {
+        entry->type_next->type_prev = entry->type_prev;
+    } else {
+        SDL_assert(queue->tail == entry);
+        queue->tail = entry->type_prev;
+    }
+    SDL_assert(block->count > 0);
+    --block->count;
+}
+
+static bool SDL_CursorAddQueue(SDL_EventCursor *cursor, SDL_EventEntry *head)
+{
+    for (int i = 0; i < cursor->num_queues; ++i) {
+        if (cursor->queues[i] == head) {
+            return true; // already added, e.g. a type listed twice
+        }
+    }
+    if (cursor->num_queues == (int)SDL_arraysize(cursor->queues)) {
+        return false;
+    }
+    cursor->queues[cursor->num_queues++] = head;
+    return true;
+}
+
+// Set up a cursor over queued events with type in [minType, maxType] -- called with the queue locked
+static void SDL_StartEventCursor(SDL_EventCursor *cursor, Uint32 minType, Uint32 maxType)
+{
+    const Uint32 first = SDL_min(minType, SDL_EVENT_LAST);
+    const Uint32 last = SDL_min(maxType, SDL_EVENT_LAST);
+    int matches = 0;
+
+    SDL_zerop(cursor);
+    cursor->minType = minType;
+    cursor->maxType = maxType;
+    cursor->next = SDL_EventQ.head;
+
+    if (minType > maxType) {
+        return;
+    }
+
+    for (Uint32 hi = (first >> 8); hi <= (last >> 8); ++hi) {
+        if (SDL_event_types[hi]) {
+            matches += SDL_event_types[hi]->count;
+        }
+    }
+    if (matches == SDL_GetAtomicInt(&SDL_EventQ.count)) {
+        // Everything queued is in range, the queue itself is the cheapest walk
+        cursor->num_queues = -1;
+        return;
+    }
+
+    for (Uint32 hi = (first >> 8); hi <= (last >> 8); ++hi) {
+        SDL_EventTypeBlock *block = SDL_event_types[hi];
+        if (!block || !block->count) {
+            continue;
+        }
+        const Uint32 lo_first = (hi == (first >> 8)) ? (first & 0xff) : 0;
+        const Uint32 lo_last = (hi == (last >> 8)) ? (last & 0xff) : 0xff;
+        for (Uint32 lo = lo_first; lo <= lo_last; ++lo) {
+            if (block->queues[lo].head && !SDL_CursorAddQueue(cursor, block->queues[lo].head)) {
+                cursor->num_queues = -1;
+                return;
+            }
+        }
+    }
+}
+
+// Set up a cursor over queued events with one of the given types -- called with the queue locked
+static void SDL_StartEventCursorForTypes(SDL_EventCursor *cursor, const Uint32 *types, int numtypes)
+{
+    SDL_zerop(cursor);
+    cursor->minType = SDL_EVENT_FIRST;
+    cursor->maxType = SDL_MAX_UINT32;
+    cursor->types = types;
+    cursor->numtypes = numtypes;
+    cursor->next = SDL_EventQ.head;
+
+    for (int i = 0; i < numtypes; ++i) {
+        SDL_EventTypeQueue *queue = SDL_GetEventTypeQueue(types[i], false);
+        if (queue && queue->head && !SDL_CursorAddQueue(cursor, queue->head)) {
+            cursor->num_queues = -1;
+            return;
+        }
+    }
+}
+
+static bool SDL_CursorMatchesEvent(const SDL_EventCursor *cursor, const SDL_EventEntry *entry)
+{
+    const Uint32 type = entry->event.type;
+
+    if (type < cursor->minType || type > cursor->maxType) {
+        return false;
+    }
+    if (cursor->types) {
+        for (int i = 0; i < cursor->numtypes; ++i) {
+            if (cursor->types[i] == type) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+/* Get the next matching event in queue order, merging the type queues by sequence number.
+   The cursor moves past the entry before returning it, so it's safe to cut the entry. */
+static SDL_EventEntry *SDL_NextEventInCursor(SDL_EventCursor *cursor)
+{
+    SDL_EventEntry *entry;
+
+    for (;;) {
+        if (cursor->num_queues < 0) {
+            entry = cursor->next;
+            if (!entry) {
+                return NULL;
+            }
+            cursor->next = entry->next;
+        } else {
+            int best = -1;
+            for (int i = 0; i < cursor->num_queues; ++i) {
+                if (cursor->queues[i] && (best < 0 || cursor->queues[i]->sequence < cursor->queues[best]->sequence)) {
+                    best = i;
+                }
+            }
+            if (best < 0) {
+                return NULL;
+            }
+            entry = cursor->queues[best];
+            cursor->queues[best] = entry->type_next;
+        }
+
+        if (SDL_CursorMatchesEvent(cursor, entry)) {
+            return entry;
+        }
+    }
+}
+
+static void SDL_UpdateMaxEventsSeen(void)
+{
+    const int count = SDL_GetAtomicInt(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+}
+
+/**
+ * Motion coalescing as defined in SDL_HINT_EVENT_COALESCE_MOTION:
+ *  - 0: (default) no coalescing
+ *  - 1: merge consecutive motion events
+ *  - 2: as above, plus keep the merged events in the samples array
+ */
+static int SDL_CoalesceMotion = 0;
+
+// The most samples kept for a merged event, after this a new event is started
+#define SDL_MAX_MOTION_SAMPLES 1024
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_CoalesceMotion = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 2) : 0;
+}
+
+static void SDL_GetMotionSample(const SDL_Event *event, SDL_MotionSample *sample)
+{
+    sample->timestamp = event->common.timestamp;
+    if (event->type == SDL_EVENT_MOUSE_MOTION) {
+        sample->x = event->motion.x;
+        sample->y = event->motion.y;
+        sample->xrel = event->motion.xrel;
+        sample->yrel = event->motion.yrel;
+    } else {
+        sample->x = event->pmotion.x;
+        sample->y = event->pmotion.y;
+        sample->xrel = 0.0f;
+        sample->yrel = 0.0f;
+    }
+}
+
+// Append a sample to the history of a queued motion event, creating it if needed
+static bool SDL_AddMotionSample(SDL_EventEntry *entry, const SDL_MotionSample **samples_field, int *num_samples_field, const SDL_Event *event)
+{
+    SDL_TemporaryMemory *memory = NULL;
+    SDL_MotionSample *samples;
+    int num_samples = *samples_field ? *num_samples_field : 0;
+
+    if (num_samples >= SDL_MAX_MOTION_SAMPLES) {
+        return false;
+    }
+
+    if (*samples_field) {
+        for (memory = entry->memory; memory; memory = memory->next) {
+            if (memory->memory == *samples_field) {
+                break;
+            }
+        }
+        if (!memory) {
+            return false; // this isn't a history we created, probably an application event
+        }
+    }
+
+    // Grow in powers of two, the first merge needs room for the original event and the new one.
+    // The old array isn't reallocated, it stays with the event until it leaves the queue, so the
+    // samples of an event returned by SDL_PeepEvents() with SDL_PEEKEVENT remain valid.
+    if (num_samples == 0 || (num_samples & (num_samples - 1)) == 0) {
+        const int new_size = (num_samples == 0) ? 2 : (num_samples * 2);
+        SDL_TemporaryMemory *grown = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*grown));
+        if (!grown) {
+            return false;
+        }
+        samples = (SDL_MotionSample *)SDL_malloc(new_size * sizeof(*samples));
+        if (!samples) {
+            SDL_free(grown);
+            return false;
+        }
+        if (memory) {
+            SDL_memcpy(samples, memory->memory, num_samples * sizeof(*samples));
+        } else {
+            SDL_GetMotionSample(&entry->event, &samples[num_samples++]);
+        }
+        grown->memory = samples;
+        grown->prev = NULL;
+        grown->next = entry->memory;
+        entry->memory = grown;
+    } else {
+        samples = (SDL_MotionSample *)memory->memory;
+    }
+
+    SDL_GetMotionSample(event, &samples[num_samples++]);
+    *samples_field = samples;
+    *num_samples_field = num_samples;
+    return true;
+}
+
+// Merge a motion event into the matching motion event at the end of the queue -- called with the queue locked
+static bool SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *tail = SDL_EventQ.tail;
+
+    if (!SDL_CoalesceMotion || !tail || tail->event.type != event->type) {
+        return false;
+    }
+
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+    {
+        SDL_MouseMotionEvent *motion = &tail->event.motion;
+        if (motion->windowID != event->motion.windowID ||
+            motion->which != event->motion.which ||
+            motion->state != event->motion.state) {
+            return false;
+        }
+        if (SDL_CoalesceMotion > 1 && !SDL_AddMotionSample(tail, &motion->samples, &motion->num_samples, event)) {
+            return false;
+        }
+        motion->timestamp = event->motion.timestamp;
+        motion->x = event->motion.x;
+        motion->y = event->motion.y;
+        motion->xrel += event->motion.xrel;
+        motion->yrel += event->motion.yrel;
+        return true;
+    }
+    case SDL_EVENT_PEN_MOTION:
+    {
+        SDL_PenMotionEvent *pmotion = &tail->event.pmotion;
+        if (pmotion->windowID != event->pmotion.windowID ||
+            pmotion->which != event->pmotion.which ||
+            pmotion->pen_state != event->pmotion.pen_state) {
+            return false;
+        }
+        if (SDL_CoalesceMotion > 1 && !SDL_AddMotionSample(tail, &pmotion->samples, &pmotion->num_samples, event)) {
+            return false;
+        }
+        pmotion->timestamp = event->pmotion.timestamp;
+        pmotion->x = event->pmotion.x;
+        pmotion->y = event->pmotion.y;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static SDL_EventRing *SDL_CreateEventRing(void)
+{
+    SDL_EventRing *ring = (SDL_EventRing *)SDL_calloc(1, sizeof(*ring));
+    if (ring) {
+        for (Uint32 i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+            SDL_SetAtomicU32(&ring->cells[i].sequence, i);
+        }
+    }
+    return ring;
+}
+
+// Move events published by lock-free producers into the event queue -- called with the queue locked
+// If wait_for_writers is true, this waits for producers that are still writing cells reserved before
+// this was called, so that an event added to the queue next can't overtake them.
+static void SDL_DrainEventRing(bool wait_for_writers)
+{
+    SDL_EventRing *ring = SDL_EventQ.ring;
+    Uint32 end;
+
+    if (!ring) {
+        return;
+    }
+
+    end = SDL_GetAtomicU32(&ring->enqueue_pos);
+    for (;;) {
+        const Uint32 pos = ring->dequeue_pos;
+        SDL_EventRingCell *cell = &ring->cells[pos & SDL_EVENT_RING_MASK];
+        SDL_EventEntry *entry;
+
+        if (SDL_GetAtomicU32(&cell->sequence) != (pos + 1)) {
+            if (wait_for_writers && (Sint32)(end - pos) > 0) {
+                // The cell is reserved but its producer is still copying into it, which never blocks
+                SDL_CPUPauseInstruction();
+                continue;
+            }
+            break; // empty, or the producer hasn't finished writing this cell yet
+        }
+
+        if (!cell->entry.memory && SDL_CoalesceMotionEvent(&cell->entry.event)) {
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+            ring->dequeue_pos = pos + 1;
+            SDL_SetAtomicU32(&cell->sequence, pos + SDL_EVENT_RING_SIZE);
+            continue;
+        }
+
+        entry = SDL_AllocEventEntry();
+        if (!entry) {
+            break; // leave it in the ring and try again later
+        }
+        SDL_copyp(&entry->event, &cell->entry.event);
+        if (!SDL_LinkEventEntry(entry)) {
+            entry->next = SDL_EventQ.free;
+            SDL_EventQ.free = entry;
+            break;
+        }
+        entry->memory = cell->entry.memory;
+
+        ring->dequeue_pos = pos + 1;
+        SDL_SetAtomicU32(&cell->sequence, pos + SDL_EVENT_RING_SIZE);
+    }
+
+    SDL_UpdateMaxEventsSeen();
+}
+
+// Add events to the ring without locking the queue, returns false if there isn't room for all of them
+static bool SDL_AddEventsToRing(SDL_Event *events, int numevents)
+{
+    SDL_EventRing *ring = SDL_EventQ.ring;
+    Uint32 pos;
+    int i;
+
+    if (!ring || numevents <= 0 || numevents > SDL_EVENT_RING_SIZE) {
+        return false;
+    }
+    if (SDL_GetAtomicInt(&SDL_EventQ.count) + numevents > SDL_MAX_QUEUED_EVENTS) {
+        return false; // let the locked path report the error and add what fits
+    }
+
+    // Reserve a run of consecutive cells, so a batch from one producer stays together
+    for (;;) {
+        pos = SDL_GetAtomicU32(&ring->enqueue_pos);
+        for (i = 0; i < numevents; ++i) {
+            const Uint32 sequence = SDL_GetAtomicU32(&ring->cells[(pos + i) & SDL_EVENT_RING_MASK].sequence);
+            const Sint32 diff = (Sint32)(sequence - (pos + i));
+            if (diff < 0) {
+                return false; // the ring is full
+            } else if (diff > 0) {
+                break; // another producer got here first
+            }
+        }
+        if (i == numevents && SDL_CompareAndSwapAtomicU32(&ring->enqueue_pos, pos, pos + numevents)) {
+            break;
+        }
+        SDL_CPUPauseInstruction();
+    }
+
+    for (i = 0; i < numevents; ++i) {
+        SDL_EventEntry *entry = &ring->cells[(pos + i) & SDL_EVENT_RING_MASK].entry;
+        SDL_Event *event = &events[i];
+
+        if (SDL_EventLoggingVerbosity > 0) {
+            SDL_LogEvent(event);
+        }
+
+        SDL_copyp(&entry->event, event);
+        if (event->type == SDL_EVENT_POLL_SENTINEL) {
+            SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+        }
+        entry->memory = NULL;
+        SDL_TransferTemporaryMemoryToEvent(entry);
+    }
+
+    // Count the events before publishing them, so they're never removed before they've been counted
+    SDL_AddAtomicInt(&SDL_EventQ.count, numevents);
+
+    for (i = 0; i < numevents; ++i) {
+        SDL_SetAtomicU32(&ring->cells[(pos + i) & SDL_EVENT_RING_MASK].sequence, pos + i + 1);
+    }
+    return true;
+}
+
+static void SDLCALL SDL_EventQueueLockFreeChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    const bool enabled = SDL_GetStringBoolean(hint, false);
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        // The ring stays allocated until the event loop stops, in case a producer is still writing to it
+        if (enabled && !SDL_EventQ.ring) {
+            SDL_EventQ.ring = SDL_CreateEventRing();
+        }
+        SDL_SetAtomicInt(&SDL_EventQ.ring_enabled, (enabled && SDL_EventQ.ring) ? 1 : 0);
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
@@ -923,6 +1481,16 @@ void SDL_StopEventLoop(void)
 
     SDL_EventQ.active = false;
 
+    // Stop new lock-free producers, wait for any that already got past the check, and pick up
+    // what they pushed so its temporary memory is released below
+    SDL_SetAtomicInt(&SDL_EventQ.ring_enabled, 0);
+    while (SDL_GetAtomicInt(&SDL_EventQ.ring_producers) > 0) {
+        SDL_CPUPauseInstruction();
+    }
+    SDL_DrainEventRing(false);
+    SDL_free(SDL_EventQ.ring);
+    SDL_EventQ.ring = NULL;
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d",
                 SDL_EventQ.max_events_seen);
@@ -948,6 +1516,11 @@ void SDL_StopEventLoop(void)
     SDL_EventQ.free = NULL;
     SDL_SetAtomicInt(&SDL_sentinel_pending, 0);
 
+    for (i = 0; i < SDL_arraysize(SDL_event_types); ++i) {
+        SDL_free(SDL_event_types[i]);
+        SDL_event_types[i] = NULL;
+    }
+
     // Clear disabled event state
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
         SDL_free(SDL_disabled_events[i]);
@@ -1010,51 +1583,52 @@ static int SDL_AddEvent(SDL_Event *event)
 {
     SDL_EventEntry *entry;
     const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
 
     if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
         SDL_SetError("Event queue is full (%d events)", initial_count);
         return 0;
     }
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    if (SDL_CoalesceMotionEvent(event)) {
+        // Claim any temporary memory for the merged event, so it's released along with the event it was merged into
+        SDL_EventEntry merged;
+        SDL_zero(merged);
+        SDL_copyp(&merged.event, event);
+        SDL_TransferTemporaryMemoryToEvent(&merged);
+        if (merged.memory) {
+            SDL_TemporaryMemory *last = merged.memory;
+            while (last->next) {
+                last = last->next;
+            }
+            last->next = SDL_EventQ.tail->memory;
+            SDL_EventQ.tail->memory = merged.memory;
         }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
+        return 1;
     }
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
+    entry = SDL_AllocEventEntry();
+    if (entry == NULL) {
+        return 0;
     }
 
     SDL_copyp(&entry->event, event);
+    if (!SDL_LinkEventEntry(entry)) {
+        entry->next = SDL_EventQ.free;
+        SDL_EventQ.free = entry;
+        return 0;
+    }
     if (event->type == SDL_EVENT_POLL_SENTINEL) {
         SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
     }
     entry->memory = NULL;
     SDL_TransferTemporaryMemoryToEvent(entry);
 
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
-    }
-
-    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
-    }
+    SDL_AddAtomicInt(&SDL_EventQ.count, 1);
+    SDL_UpdateMaxEventsSeen();
 
     ++SDL_last_event_id;
 
@@ -1066,6 +1640,8 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
 {
     SDL_TransferTemporaryMemoryFromEvent(entry);
 
+    SDL_UnlinkEventEntryType(entry);
+
     if (entry->prev) {
         entry->prev->next = entry->next;
     }
@@ -1110,11 +1686,65 @@ static void SDL_SendWakeupEvent(void)
 #endif
 }
 
+// Peek at or get the events matched by a cursor -- called with the queue locked
+static int SDL_PeepEventsFromCursor(SDL_Event *events, int numevents, SDL_EventAction action,
+                                    SDL_EventCursor *cursor, bool include_sentinel)
+{
+    SDL_EventEntry *entry;
+    Uint32 type;
+    int used = 0, sentinels_expected = 0;
+
+    while ((events == NULL || used < numevents) && (entry = SDL_NextEventInCursor(cursor)) != NULL) {
+        type = entry->event.type;
+        if (events) {
+            SDL_copyp(&events[used], &entry->event);
+
+            if (action == SDL_GETEVENT) {
+                SDL_CutEvent(entry);
+            }
+        }
+        if (type == SDL_EVENT_POLL_SENTINEL) {
+            // Special handling for the sentinel event
+            if (!include_sentinel) {
+                // Skip it, we don't want to include it
+                continue;
+            }
+            if (events == NULL || action != SDL_GETEVENT) {
+                ++sentinels_expected;
+            }
+            if (SDL_GetAtomicInt(&SDL_sentinel_pending) > sentinels_expected) {
+                // Skip it, there's another one pending
+                continue;
+            }
+        }
+        ++used;
+    }
+    return used;
+}
+
 // Lock the event queue, take a peep at it, and unlock it
 static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAction action,
                                   Uint32 minType, Uint32 maxType, bool include_sentinel)
 {
-    int i, used, sentinels_expected = 0;
+    int i, used;
+
+    // Try to add the events without locking the queue
+    if (action == SDL_ADDEVENT && events && SDL_GetAtomicInt(&SDL_EventQ.ring_enabled)) {
+        bool added = false;
+
+        // Announce ourselves and check the flag again, so SDL_StopEventLoop() can wait for us before freeing the ring
+        SDL_AddAtomicInt(&SDL_EventQ.ring_producers, 1);
+        if (SDL_GetAtomicInt(&SDL_EventQ.ring_enabled)) {
+            added = SDL_AddEventsToRing(events, numevents);
+        }
+        SDL_AddAtomicInt(&SDL_EventQ.ring_producers, -1);
+
+        if (added) {
+            SDL_SendWakeupEvent();
+            return numevents;
+        }
+        // The ring is disabled or full, fall back to the locked queue
+    }
 
     // Lock the event queue
     used = 0;
@@ -1130,6 +1760,8 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
+        // Events this thread added to the ring earlier have to stay ahead of the ones it's adding now
+        SDL_DrainEventRing(action == SDL_ADDEVENT);
         if (action == SDL_ADDEVENT) {
             if (!events) {
                 SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1139,37 +1771,10 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                 used += SDL_AddEvent(&events[i]);
             }
         } else {
-            SDL_EventEntry *entry, *next;
-            Uint32 type;
-
-            for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        SDL_copyp(&events[used], &entry->event);
-
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
-                    }
-                    if (type == SDL_EVENT_POLL_SENTINEL) {
-                        // Special handling for the sentinel event
-                        if (!include_sentinel) {
-                            // Skip it, we don't want to include it
-                            continue;
-                        }
-                        if (events == NULL || action != SDL_GETEVENT) {
-                            ++sentinels_expected;
-                        }
-                        if (SDL_GetAtomicInt(&SDL_sentinel_pending) > sentinels_expected) {
-                            // Skip it, there's another one pending
-                            continue;
-                        }
-                    }
-                    ++used;
-                }
-            }
+            SDL_EventCursor cursor;
+
+            SDL_StartEventCursor(&cursor, minType, maxType);
+            used = SDL_PeepEventsFromCursor(events, numevents, action, &cursor, include_sentinel);
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1198,13 +1803,11 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         if (SDL_EventQ.active) {
-            for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
-                const Uint32 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    found = true;
-                    break;
-                }
-            }
+            SDL_EventCursor cursor;
+
+            SDL_DrainEventRing(false);
+            SDL_StartEventCursor(&cursor, minType, maxType);
+            found = (SDL_NextEventInCursor(&cursor) != NULL);
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1219,8 +1822,8 @@ void SDL_FlushEvent(Uint32 type)
 
 void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 {
-    SDL_EventEntry *entry, *next;
-    Uint32 type;
+    SDL_EventCursor cursor;
+    SDL_EventEntry *entry;
 
     // Make sure the events are current
 #if 0
@@ -1238,17 +1841,49 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
-            }
+        SDL_DrainEventRing(false);
+        SDL_StartEventCursor(&cursor, minType, maxType);
+        while ((entry = SDL_NextEventInCursor(&cursor)) != NULL) {
+            SDL_CutEvent(entry);
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 }
 
+int SDL_DrainEvents(SDL_Event *events, int numevents, const Uint32 *types, int numtypes)
+{
+    SDL_EventCursor cursor;
+    int used;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    if (!types) {
+        SDL_InvalidParamError("types");
+        return -1;
+    }
+    if (numevents <= 0 || numtypes <= 0) {
+        return 0;
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        // Don't look after we've quit
+        if (!SDL_EventQ.active) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            SDL_SetError("The event system has been shut down");
+            return -1;
+        }
+        SDL_DrainEventRing(false);
+        SDL_StartEventCursorForTypes(&cursor, types, numtypes);
+        used = SDL_PeepEventsFromCursor(events, numevents, SDL_GETEVENT, &cursor, false);
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return used;
+}
+
 typedef enum
 {
     SDL_MAIN_CALLBACK_WAITING,
@@ -1765,6 +2400,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing(false);
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1812,6 +2448,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing(false);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1969,6 +2606,9 @@ bool SDL_InitEvents(void)
         return false;
     }
 
+    SDL_AddHintCallback(SDL_HINT_EVENT_QUEUE_LOCKFREE, SDL_EventQueueLockFreeChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
+
     SDL_InitQuit();
 
     return true;
@@ -1977,6 +2617,8 @@ bool SDL_InitEvents(void)
 void SDL_QuitEvents(void)
 {
     SDL_QuitQuit();
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_QUEUE_LOCKFREE, SDL_EventQueueLockFreeChanged, NULL);
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
@@ -35,10 +35,21 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <fcntl.h>
+
 #ifdef SDL_PLATFORM_ANDROID
 #include "../../core/android/SDL_android.h"
 #endif
 
+#ifdef SDL_PLATFORM_LINUX
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(SDL_PLATFORM_MACOS)
+#include <copyfile.h>
+#endif
+
 bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback cb, void *userdata)
 {
     char *pathwithsep = NULL;
@@ -107,13 +118,88 @@ bool SDL_SYS_RenamePath(const char *oldpath, const char *newpath)
     return true;
 }
 
+// Files are streamed through this much memory when the kernel can't copy them for us.
+#define COPY_BUFFER_SIZE (1024 * 1024)
+
+// Let the kernel copy the data between two files without bouncing it through userspace.
+// Returns 1 if everything was copied, 0 if the caller should copy the rest itself, and -1 on error.
+static int KernelCopyFile(int infd, int outfd)
+{
+    struct stat statbuf;
+    if ((fstat(infd, &statbuf) < 0) || !S_ISREG(statbuf.st_mode)) {
+        return 0;  // pipes and device files report sizes we can't trust, just read them until EOF.
+    }
+
+#if defined(SDL_PLATFORM_LINUX)
+#ifdef FICLONE
+    // on filesystems with reflinks (btrfs, xfs, etc) the copy can share the existing blocks and finish instantly.
+    if (ioctl(outfd, FICLONE, infd) == 0) {
+        return 1;
+    }
+#endif
+
+    const off_t total = statbuf.st_size;
+    const size_t chunk = 0x40000000;  // 1 GB per call, so large files don't overflow the return value on 32-bit platforms.
+    off_t copied = 0;
+
+#ifdef __NR_copy_file_range
+    // copy_file_range works within the kernel (or even the storage device) and can cross filesystems on newer kernels.
+    while (copied < total) {
+        const ssize_t rc = syscall(__NR_copy_file_range, infd, NULL, outfd, NULL, chunk, 0);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if ((errno == ENOSYS) || (errno == EXDEV) || (errno == EINVAL) || (errno == EOPNOTSUPP) || (errno == EBADF)) {
+                break;  // not supported for these files, try something else from where we left off.
+            }
+            SDL_SetError("Can't copy file: %s", strerror(errno));
+            return -1;
+        } else if (rc == 0) {
+            break;  // some filesystems (procfs, etc) report EOF here, so let something else double-check.
+        }
+        copied += rc;
+    }
+#endif
+
+    // sendfile still avoids the userspace copy on kernels that predate copy_file_range.
+    while (copied < total) {
+        const ssize_t rc = sendfile(outfd, infd, NULL, chunk);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if ((errno == ENOSYS) || (errno == EINVAL)) {
+                break;
+            }
+            SDL_SetError("Can't copy file: %s", strerror(errno));
+            return -1;
+        } else if (rc == 0) {
+            break;
+        }
+        copied += rc;
+    }
+
+    if (copied < total) {
+        return 0;
+    }
+    return 1;
+#elif defined(SDL_PLATFORM_MACOS)
+    if (fcopyfile(infd, outfd, NULL, COPYFILE_DATA) < 0) {
+        return 0;
+    }
+    return 1;
+#else
+    return 0;
+#endif
+}
+
 bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
 {
     char *buffer = NULL;
     SDL_IOStream *input = NULL;
     SDL_IOStream *output = NULL;
-    const size_t maxlen = 4096;
+    const size_t maxlen = COPY_BUFFER_SIZE;
     size_t len;
+    int infd, outfd;
     bool result = false;
 
     input = SDL_IOFromFile(oldpath, "rb");
@@ -126,7 +212,24 @@ bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
         goto done;
     }
 
-    buffer = (char *)SDL_malloc(maxlen);
+    // Both streams are untouched, so if they are backed by real files, the kernel can do the copy from the start.
+    infd = (int)SDL_GetNumberProperty(SDL_GetIOProperties(input), SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, -1);
+    outfd = (int)SDL_GetNumberProperty(SDL_GetIOProperties(output), SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, -1);
+    if ((infd >= 0) && (outfd >= 0)) {
+        const int rc = KernelCopyFile(infd, outfd);
+        if (rc < 0) {
+            goto done;
+        } else if (rc > 0) {
+            SDL_CloseIO(input);
+            input = NULL;
+            goto flush;
+        }
+#ifdef HAVE_POSIX_FADVISE
+        posix_fadvise(infd, 0, 0, POSIX_FADV_SEQUENTIAL);  // ask for aggressive read-ahead, we'll be streaming the whole thing.
+#endif
+    }
+
+    buffer = (char *)SDL_aligned_alloc(4096, maxlen);
     if (!buffer) {
         goto done;
     }
@@ -143,6 +246,7 @@ bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
     SDL_CloseIO(input);
     input = NULL;
 
+flush:
     if (!SDL_FlushIO(output)) {
         goto done;
     }
@@ -157,7 +261,7 @@ done:
     if (input) {
         SDL_CloseIO(input);
     }
-    SDL_free(buffer);
+    SDL_aligned_free(buffer);
 
     return result;
 }
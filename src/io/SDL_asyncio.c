@@ -183,12 +183,13 @@ bool SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, bool flush, SDL_AsyncIOQueue *queue,
     return (task != NULL);
 }
 
-SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueueWithProperties(SDL_PropertiesID props)
 {
     SDL_AsyncIOQueue *queue = SDL_calloc(1, sizeof (*queue));
     if (queue) {
         SDL_SetAtomicInt(&queue->tasks_inflight, 0);
-        if (!SDL_SYS_CreateAsyncIOQueue(queue)) {
+        SDL_SetAtomicInt(&queue->batch_depth, 0);
+        if (!SDL_SYS_CreateAsyncIOQueue(queue, props)) {
             SDL_free(queue);
             return NULL;
         }
@@ -196,6 +197,70 @@ SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
     return queue;
 }
 
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
+{
+    return SDL_CreateAsyncIOQueueWithProperties(0);
+}
+
+bool SDL_BeginAsyncIOBatch(SDL_AsyncIOQueue *queue)
+{
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    SDL_AddAtomicInt(&queue->batch_depth, 1);
+    return true;
+}
+
+bool SDL_EndAsyncIOBatch(SDL_AsyncIOQueue *queue)
+{
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    int depth;
+    do {
+        depth = SDL_GetAtomicInt(&queue->batch_depth);
+        if (depth <= 0) {
+            return SDL_SetError("No async I/O batch in progress");
+        }
+    } while (!SDL_CompareAndSwapAtomicInt(&queue->batch_depth, depth, depth - 1));
+
+    if ((depth == 1) && queue->iface.submit) {
+        return queue->iface.submit(queue->userdata);
+    }
+    return true;
+}
+
+bool SDL_RegisterAsyncIOBuffer(SDL_AsyncIOQueue *queue, void *buffer, size_t size)
+{
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!buffer) {
+        return SDL_InvalidParamError("buffer");
+    } else if (size == 0) {
+        return SDL_InvalidParamError("size");
+    }
+
+    if (!queue->iface.register_buffer) {
+        return true;  // nothing to do on this backend, operations will just use the memory directly.
+    }
+    return queue->iface.register_buffer(queue->userdata, buffer, size);
+}
+
+bool SDL_UnregisterAsyncIOBuffer(SDL_AsyncIOQueue *queue, void *buffer)
+{
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!buffer) {
+        return SDL_InvalidParamError("buffer");
+    }
+
+    if (!queue->iface.unregister_buffer) {
+        return true;
+    }
+    return queue->iface.unregister_buffer(queue->userdata, buffer);
+}
+
 static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
 {
     if (!task || !outcome) {
@@ -205,7 +270,7 @@ static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *out
     SDL_AsyncIO *asyncio = task->asyncio;
 
     SDL_zerop(outcome);
-    outcome->asyncio = asyncio->oneshot ? NULL : asyncio;
+    outcome->asyncio = (asyncio && !asyncio->oneshot) ? asyncio : NULL;
     outcome->result = task->result;
     outcome->type = task->type;
     outcome->buffer = task->buffer;
@@ -214,31 +279,34 @@ static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *out
     outcome->bytes_transferred = task->result_size;
     outcome->userdata = task->app_userdata;
 
-    // Take the completed task out of the SDL_AsyncIO that created it.
-    SDL_LockMutex(asyncio->lock);
-    LINKED_LIST_UNLINK(task, asyncio);
-    // see if it's time to queue a pending close request (close requested and no other pending tasks)
-    SDL_AsyncIOTask *closing = asyncio->closing;
-    if (closing && (task != closing) && (LINKED_LIST_START(asyncio->tasks, asyncio) == NULL)) {
-        LINKED_LIST_PREPEND(closing, asyncio->tasks, asyncio);
-        SDL_AddAtomicInt(&closing->queue->tasks_inflight, 1);
-        const bool async_close_task_was_queued = asyncio->iface.close(asyncio->userdata, closing);
-        SDL_assert(async_close_task_was_queued);  // !!! FIXME: if this fails to queue the task, we're leaking resources!
-        if (!async_close_task_was_queued) {
-            SDL_AddAtomicInt(&closing->queue->tasks_inflight, -1);
+    bool retval = true;
+
+    if (asyncio) {  // tasks like SDL_CopyFileAsync aren't attached to an SDL_AsyncIO.
+        // Take the completed task out of the SDL_AsyncIO that created it.
+        SDL_LockMutex(asyncio->lock);
+        LINKED_LIST_UNLINK(task, asyncio);
+        // see if it's time to queue a pending close request (close requested and no other pending tasks)
+        SDL_AsyncIOTask *closing = asyncio->closing;
+        if (closing && (task != closing) && (LINKED_LIST_START(asyncio->tasks, asyncio) == NULL)) {
+            LINKED_LIST_PREPEND(closing, asyncio->tasks, asyncio);
+            SDL_AddAtomicInt(&closing->queue->tasks_inflight, 1);
+            const bool async_close_task_was_queued = asyncio->iface.close(asyncio->userdata, closing);
+            SDL_assert(async_close_task_was_queued);  // !!! FIXME: if this fails to queue the task, we're leaking resources!
+            if (!async_close_task_was_queued) {
+                SDL_AddAtomicInt(&closing->queue->tasks_inflight, -1);
+            }
         }
-    }
-    SDL_UnlockMutex(task->asyncio->lock);
+        SDL_UnlockMutex(task->asyncio->lock);
 
-    // was this the result of a closing task? Finally destroy the asyncio.
-    bool retval = true;
-    if (closing && (task == closing)) {
-        if (asyncio->oneshot) {
-            retval = false;  // don't send the close task results on to the app, just the read task for these.
+        // was this the result of a closing task? Finally destroy the asyncio.
+        if (closing && (task == closing)) {
+            if (asyncio->oneshot) {
+                retval = false;  // don't send the close task results on to the app, just the read task for these.
+            }
+            asyncio->iface.destroy(asyncio->userdata);
+            SDL_DestroyMutex(asyncio->lock);
+            SDL_free(asyncio);
         }
-        asyncio->iface.destroy(asyncio->userdata);
-        SDL_DestroyMutex(asyncio->lock);
-        SDL_free(asyncio);
     }
 
     SDL_AddAtomicInt(&task->queue->tasks_inflight, -1);
@@ -277,7 +345,7 @@ void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
         while (SDL_GetAtomicInt(&queue->tasks_inflight) > 0) {
             SDL_AsyncIOTask *task = queue->iface.wait_results(queue->userdata, -1);
             if (task) {
-                if (task->asyncio->oneshot) {
+                if (task->asyncio && task->asyncio->oneshot) {
                     SDL_free(task->buffer);  // throw away the buffer from SDL_LoadFileAsync that will never be consumed/freed by app.
                     task->buffer = NULL;
                 }
@@ -329,3 +397,83 @@ bool SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata
     return retval;
 }
 
+
+typedef struct CopyFileAsyncData
+{
+    SDL_AsyncIOTask *task;
+    char *oldpath;
+    char *newpath;
+} CopyFileAsyncData;
+
+static int SDLCALL CopyFileAsyncThread(void *userdata)
+{
+    CopyFileAsyncData *data = (CopyFileAsyncData *) userdata;
+    SDL_AsyncIOTask *task = data->task;
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    if (SDL_CopyFile(data->oldpath, data->newpath)) {
+        SDL_PathInfo info;
+        task->result = SDL_ASYNCIO_COMPLETE;
+        task->result_size = SDL_GetPathInfo(data->newpath, &info) ? info.size : task->requested_size;
+    } else {
+        task->result = SDL_ASYNCIO_FAILURE;
+    }
+
+    SDL_free(data->oldpath);
+    SDL_free(data->newpath);
+    SDL_free(data);
+
+    queue->iface.complete_task(queue->userdata, task);  // the queue owns the task now, and the app gets it from there.
+    return 0;
+}
+
+bool SDL_CopyFileAsync(const char *oldpath, const char *newpath, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    if (!oldpath) {
+        return SDL_InvalidParamError("oldpath");
+    } else if (!newpath) {
+        return SDL_InvalidParamError("newpath");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    SDL_PathInfo info;
+    if (!SDL_GetPathInfo(oldpath, &info)) {
+        return false;
+    } else if (info.type != SDL_PATHTYPE_FILE) {
+        return SDL_SetError("Can't copy '%s', it isn't a file", oldpath);
+    }
+
+    CopyFileAsyncData *data = (CopyFileAsyncData *) SDL_calloc(1, sizeof (*data));
+    if (!data) {
+        return false;
+    }
+
+    data->task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*data->task));
+    data->oldpath = SDL_strdup(oldpath);
+    data->newpath = SDL_strdup(newpath);
+    if (!data->task || !data->oldpath || !data->newpath) {
+        SDL_free(data->task);
+        SDL_free(data->oldpath);
+        SDL_free(data->newpath);
+        SDL_free(data);
+        return false;
+    }
+
+    SDL_AsyncIOTask *task = data->task;
+    task->type = SDL_ASYNCIO_TASK_COPY;
+    task->requested_size = info.size;
+    task->app_userdata = userdata;
+    task->queue = queue;
+
+    SDL_AddAtomicInt(&queue->tasks_inflight, 1);
+
+    // Copies are long-running and mostly wait on the kernel, so each gets its own thread instead of tying up a backend's workers.
+    SDL_Thread *thread = SDL_CreateThread(CopyFileAsyncThread, "SDLcopyfile", data);
+    if (thread) {
+        SDL_DetachThread(thread);
+    } else {
+        CopyFileAsyncThread(data);  // oh well, no threads. The result is still delivered through the queue.
+    }
+    return true;
+}
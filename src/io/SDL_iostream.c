@@ -39,6 +39,16 @@
 #include <fcntl.h>
 #endif
 
+// Read-only files can be memory mapped
+#if defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#define HAVE_FILE_MAPPING
+#elif (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HAVE_FILE_MAPPING
+#endif
+
 #include "SDL_iostream_c.h"
 
 /* This file provides a general interface for SDL to read and write
@@ -51,6 +61,11 @@ struct SDL_IOStream
     void *userdata;
     SDL_IOStatus status;
     SDL_PropertiesID props;
+    Uint8 *buffer;        // optional userspace buffer, see SDL_SetIOBufferSize().
+    size_t buffer_size;
+    size_t buffer_pos;    // next unread byte in the buffer.
+    size_t buffer_len;    // bytes of read-ahead data, or of pending writes if buffer_writing is set.
+    bool buffer_writing;
 };
 
 #ifdef SDL_PLATFORM_3DS
@@ -783,6 +798,121 @@ static bool SDLCALL mem_close(void *userdata)
     return true;
 }
 
+#ifdef HAVE_FILE_MAPPING
+
+// Functions to read memory mapped files
+
+// Map a whole file for reading, returns NULL if the file can't be mapped
+static void *MapFile(const char *file, size_t *size)
+{
+    void *mem = NULL;
+
+#ifdef SDL_PLATFORM_WINDOWS
+    LARGE_INTEGER file_size;
+    HANDLE handle = windows_file_open(file, "rb");
+    if (handle == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (GetFileType(handle) == FILE_TYPE_DISK && GetFileSizeEx(handle, &file_size) &&
+        file_size.QuadPart > 0 && (Uint64)file_size.QuadPart < SDL_SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            // The view keeps the mapping and the file open
+            mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(handle);
+    if (mem) {
+        *size = (size_t)file_size.QuadPart;
+    }
+#else
+    struct stat st;
+    int fd;
+
+#ifdef SDL_PLATFORM_ANDROID
+    // Relative paths are looked up in internal storage and assets
+    if (*file != '/') {
+        return NULL;
+    }
+#endif
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+        st.st_size > 0 && (Uint64)st.st_size < SDL_SIZE_MAX) {
+        mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mem == MAP_FAILED) {
+            mem = NULL;
+        } else {
+            *size = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+#endif // SDL_PLATFORM_WINDOWS
+
+    return mem;
+}
+
+static void UnmapFile(void *mem, size_t size)
+{
+#ifdef SDL_PLATFORM_WINDOWS
+    UnmapViewOfFile(mem);
+#else
+    munmap(mem, size);
+#endif
+}
+
+static bool SDLCALL mapped_file_close(void *userdata)
+{
+    IOStreamMemData *iodata = (IOStreamMemData *) userdata;
+    UnmapFile(iodata->base, (size_t)(iodata->stop - iodata->base));
+    SDL_free(iodata);
+    return true;
+}
+
+static SDL_IOStream *IOFromMappedFile(const char *file)
+{
+    size_t size = 0;
+    void *mem = MapFile(file, &size);
+    if (!mem) {
+        return NULL;
+    }
+
+    IOStreamMemData *iodata = (IOStreamMemData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        UnmapFile(mem, size);
+        return NULL;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = mem_size;
+    iface.seek = mem_seek;
+    iface.read = mem_read;
+    // leave iface.write as NULL.
+    iface.close = mapped_file_close;
+
+    iodata->base = (Uint8 *)mem;
+    iodata->here = iodata->base;
+    iodata->stop = iodata->base + size;
+
+    SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        iface.close(iodata);
+    } else {
+        const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
+        if (props) {
+            SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, mem);
+            SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, size);
+        }
+    }
+    return iostr;
+}
+#endif // HAVE_FILE_MAPPING
+
 // Functions to create SDL_IOStream structures from various data sources
 
 #if defined(HAVE_STDIO_H) && !defined(SDL_PLATFORM_WINDOWS)
@@ -812,6 +942,30 @@ SDL_IOStream *SDL_IOFromFile(const char *file, const char *mode)
         return NULL;
     }
 
+    if (SDL_strchr(mode, 'm')) {
+        // Try to map read-only files, falling back to regular file access
+        char *unmapped_mode, *c;
+
+#ifdef HAVE_FILE_MAPPING
+        if (*mode == 'r' && !SDL_strchr(mode, '+')) {
+            iostr = IOFromMappedFile(file);
+            if (iostr) {
+                return iostr;
+            }
+        }
+#endif
+        unmapped_mode = SDL_strdup(mode);
+        if (!unmapped_mode) {
+            return NULL;
+        }
+        for (c = unmapped_mode; (c = SDL_strchr(c, 'm')) != NULL;) {
+            SDL_memmove(c, c + 1, SDL_strlen(c));
+        }
+        iostr = SDL_IOFromFile(file, unmapped_mode);
+        SDL_free(unmapped_mode);
+        return iostr;
+    }
+
 #ifdef SDL_PLATFORM_ANDROID
 #ifdef HAVE_STDIO_H
     // Try to open the file on the filesystem first
@@ -1124,12 +1278,91 @@ SDL_IOStream *SDL_OpenIO(const SDL_IOStreamInterface *iface, void *userdata)
     return iostr;
 }
 
+// Write out anything sitting in the buffer. Data that couldn't be written stays at the front of the buffer.
+static bool FlushIOBuffer(SDL_IOStream *context)
+{
+    size_t written = 0;
+
+    SDL_assert(context->buffer_writing);
+
+    while (written < context->buffer_len) {
+        const size_t bytes = context->iface.write(context->userdata, context->buffer + written, context->buffer_len - written, &context->status);
+        if (bytes == 0) {
+            if (context->status == SDL_IO_STATUS_READY) {
+                context->status = SDL_IO_STATUS_ERROR;
+            }
+            SDL_memmove(context->buffer, context->buffer + written, context->buffer_len - written);
+            context->buffer_len -= written;
+            return false;
+        }
+        written += bytes;
+    }
+    context->buffer_len = 0;
+    return true;
+}
+
+// Throw away read-ahead data, moving the stream back to where the app thinks it is.
+static bool DiscardIOBuffer(SDL_IOStream *context)
+{
+    const size_t unread = context->buffer_len - context->buffer_pos;
+
+    SDL_assert(!context->buffer_writing);
+
+    context->buffer_pos = context->buffer_len = 0;
+    if (unread > 0) {
+        if (!context->iface.seek) {
+            return SDL_Unsupported();
+        } else if (context->iface.seek(context->userdata, -(Sint64)unread, SDL_IO_SEEK_CUR) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool SyncIOBuffer(SDL_IOStream *context)
+{
+    if (context->buffer_writing) {
+        return FlushIOBuffer(context);
+    }
+    return DiscardIOBuffer(context);
+}
+
+bool SDL_SetIOBufferSize(SDL_IOStream *context, size_t size)
+{
+    if (!context) {
+        return SDL_InvalidParamError("context");
+    }
+
+    if (!SyncIOBuffer(context)) {
+        return false;
+    }
+
+    if (size != context->buffer_size) {
+        Uint8 *buffer = NULL;
+        if (size > 0) {
+            buffer = (Uint8 *)SDL_malloc(size);
+            if (!buffer) {
+                return false;
+            }
+        }
+        SDL_free(context->buffer);
+        context->buffer = buffer;
+        context->buffer_size = size;
+    }
+    context->buffer_writing = false;
+    return true;
+}
+
 bool SDL_CloseIO(SDL_IOStream *iostr)
 {
     bool result = true;
     if (iostr) {
+        if (iostr->buffer_writing && !FlushIOBuffer(iostr)) {
+            result = false;
+        }
+        SDL_free(iostr->buffer);
         if (iostr->iface.close) {
-            result = iostr->iface.close(iostr->userdata);
+            result = iostr->iface.close(iostr->userdata) && result;
         }
         SDL_DestroyProperties(iostr->props);
         SDL_free(iostr);
@@ -1221,6 +1454,63 @@ void *SDL_LoadFile(const char *file, size_t *datasize)
     return SDL_LoadFile_IO(stream, datasize, true);
 }
 
+#ifdef HAVE_FILE_MAPPING
+static void SDLCALL ReleaseMappedFile(void *userdata, const void *data)
+{
+    UnmapFile((void *)data, (size_t)(uintptr_t)userdata);
+}
+#endif
+
+static void SDLCALL ReleaseLoadedFile(void *userdata, const void *data)
+{
+    SDL_free((void *)data);
+}
+
+const void *SDL_LoadFileNoCopy(const char *file, size_t *datasize, SDL_ReleaseFileDataCallback *release, void **userdata)
+{
+    void *data;
+    size_t size = 0;
+
+    if (datasize) {
+        *datasize = 0;
+    }
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+    if (!release) {
+        SDL_InvalidParamError("release");
+        return NULL;
+    }
+    if (!userdata) {
+        SDL_InvalidParamError("userdata");
+        return NULL;
+    }
+
+#ifdef HAVE_FILE_MAPPING
+    data = MapFile(file, &size);
+    if (data) {
+        // The size is all munmap() needs to release the mapping
+        *release = ReleaseMappedFile;
+        *userdata = (void *)(uintptr_t)size;
+        if (datasize) {
+            *datasize = size;
+        }
+        return data;
+    }
+#endif
+
+    data = SDL_LoadFile(file, &size);
+    if (data) {
+        *release = ReleaseLoadedFile;
+        *userdata = NULL;
+        if (datasize) {
+            *datasize = size;
+        }
+    }
+    return data;
+}
+
 bool SDL_SaveFile_IO(SDL_IOStream *src, const void *data, size_t datasize, bool closeio)
 {
     size_t size_written = 0;
@@ -1303,6 +1593,9 @@ Sint64 SDL_GetIOSize(SDL_IOStream *context)
         SDL_SeekIO(context, pos, SDL_IO_SEEK_SET);
         return size;
     }
+    if (context->buffer_writing && !FlushIOBuffer(context)) {
+        return -1;  // pending writes might grow the stream.
+    }
     return context->iface.size(context->userdata);
 }
 
@@ -1315,6 +1608,29 @@ Sint64 SDL_SeekIO(SDL_IOStream *context, Sint64 offset, SDL_IOWhence whence)
         SDL_Unsupported();
         return -1;
     }
+
+    if (context->buffer_len > 0) {
+        if (context->buffer_writing) {
+            if (!FlushIOBuffer(context)) {
+                return -1;
+            }
+        } else if (whence == SDL_IO_SEEK_CUR) {
+            // The stream is ahead of the app by the unread bytes. Seeks that land inside the buffer (including SDL_TellIO()) keep it.
+            const Sint64 unread = (Sint64)(context->buffer_len - context->buffer_pos);
+            if ((offset >= -(Sint64)context->buffer_pos) && (offset <= unread)) {
+                const Sint64 position = context->iface.seek(context->userdata, 0, SDL_IO_SEEK_CUR);
+                if (position < 0) {
+                    return -1;
+                }
+                context->buffer_pos = (size_t)((Sint64)context->buffer_pos + offset);
+                return position - (Sint64)(context->buffer_len - context->buffer_pos);
+            }
+            offset -= unread;
+            context->buffer_pos = context->buffer_len = 0;
+        } else {
+            context->buffer_pos = context->buffer_len = 0;
+        }
+    }
     return context->iface.seek(context->userdata, offset, whence);
 }
 
@@ -1323,6 +1639,53 @@ Sint64 SDL_TellIO(SDL_IOStream *context)
     return SDL_SeekIO(context, 0, SDL_IO_SEEK_CUR);
 }
 
+static size_t ReadIOBuffered(SDL_IOStream *context, void *ptr, size_t size)
+{
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    if (context->buffer_writing) {
+        if ((context->buffer_len > 0) && !FlushIOBuffer(context)) {
+            return 0;
+        }
+        context->buffer_writing = false;
+    }
+
+    while (size > 0) {
+        size_t available = context->buffer_len - context->buffer_pos;
+        if (available == 0) {
+            size_t bytes;
+            if (size >= context->buffer_size) {
+                // Reads at least as large as the buffer go straight to the destination.
+                bytes = context->iface.read(context->userdata, dst, size, &context->status);
+                if (bytes == 0) {
+                    break;
+                }
+                dst += bytes;
+                size -= bytes;
+                total += bytes;
+                continue;
+            }
+
+            bytes = context->iface.read(context->userdata, context->buffer, context->buffer_size, &context->status);
+            context->buffer_pos = 0;
+            context->buffer_len = bytes;
+            if (bytes == 0) {
+                break;
+            }
+            available = bytes;
+        }
+
+        const size_t amount = SDL_min(available, size);
+        SDL_memcpy(dst, context->buffer + context->buffer_pos, amount);
+        context->buffer_pos += amount;
+        dst += amount;
+        size -= amount;
+        total += amount;
+    }
+    return total;
+}
+
 size_t SDL_ReadIO(SDL_IOStream *context, void *ptr, size_t size)
 {
     size_t bytes;
@@ -1343,7 +1706,11 @@ size_t SDL_ReadIO(SDL_IOStream *context, void *ptr, size_t size)
         return 0;
     }
 
-    bytes = context->iface.read(context->userdata, ptr, size, &context->status);
+    if (context->buffer) {
+        bytes = ReadIOBuffered(context, ptr, size);
+    } else {
+        bytes = context->iface.read(context->userdata, ptr, size, &context->status);
+    }
     if (bytes == 0 && context->status == SDL_IO_STATUS_READY) {
         if (*SDL_GetError()) {
             context->status = SDL_IO_STATUS_ERROR;
@@ -1354,6 +1721,30 @@ size_t SDL_ReadIO(SDL_IOStream *context, void *ptr, size_t size)
     return bytes;
 }
 
+static size_t WriteIOBuffered(SDL_IOStream *context, const void *ptr, size_t size)
+{
+    if (!context->buffer_writing) {
+        if (!DiscardIOBuffer(context)) {
+            return 0;
+        }
+        context->buffer_writing = true;
+    }
+
+    if ((context->buffer_len + size) > context->buffer_size) {
+        if (!FlushIOBuffer(context)) {
+            return 0;
+        }
+        if (size >= context->buffer_size) {
+            // Writes at least as large as the buffer go straight to the stream.
+            return context->iface.write(context->userdata, ptr, size, &context->status);
+        }
+    }
+
+    SDL_memcpy(context->buffer + context->buffer_len, ptr, size);
+    context->buffer_len += size;
+    return size;
+}
+
 size_t SDL_WriteIO(SDL_IOStream *context, const void *ptr, size_t size)
 {
     size_t bytes;
@@ -1374,7 +1765,11 @@ size_t SDL_WriteIO(SDL_IOStream *context, const void *ptr, size_t size)
         return 0;
     }
 
-    bytes = context->iface.write(context->userdata, ptr, size, &context->status);
+    if (context->buffer) {
+        bytes = WriteIOBuffered(context, ptr, size);
+    } else {
+        bytes = context->iface.write(context->userdata, ptr, size, &context->status);
+    }
     if ((bytes == 0) && (context->status == SDL_IO_STATUS_READY)) {
         context->status = SDL_IO_STATUS_ERROR;
     }
@@ -1427,6 +1822,9 @@ bool SDL_FlushIO(SDL_IOStream *context)
     context->status = SDL_IO_STATUS_READY;
     SDL_ClearError();
 
+    if (context->buffer_writing && !FlushIOBuffer(context)) {
+        return false;
+    }
     if (context->iface.flush) {
         result = context->iface.flush(context->userdata, &context->status);
     }
@@ -1438,12 +1836,35 @@ bool SDL_FlushIO(SDL_IOStream *context)
 
 // Functions for dynamically reading and writing endian-specific values
 
+// When the whole value is already in the read buffer (or fits in the write buffer), skip the full SDL_ReadIO()/SDL_WriteIO() path.
+static SDL_INLINE bool ReadIOValue(SDL_IOStream *src, void *ptr, size_t size)
+{
+    if (src && !src->buffer_writing && ((src->buffer_len - src->buffer_pos) >= size)) {
+        SDL_memcpy(ptr, src->buffer + src->buffer_pos, size);
+        src->buffer_pos += size;
+        src->status = SDL_IO_STATUS_READY;
+        return true;
+    }
+    return (SDL_ReadIO(src, ptr, size) == size);
+}
+
+static SDL_INLINE bool WriteIOValue(SDL_IOStream *dst, const void *ptr, size_t size)
+{
+    if (dst && dst->buffer_writing && ((dst->buffer_size - dst->buffer_len) >= size)) {
+        SDL_memcpy(dst->buffer + dst->buffer_len, ptr, size);
+        dst->buffer_len += size;
+        dst->status = SDL_IO_STATUS_READY;
+        return true;
+    }
+    return (SDL_WriteIO(dst, ptr, size) == size);
+}
+
 bool SDL_ReadU8(SDL_IOStream *src, Uint8 *value)
 {
     Uint8 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1457,7 +1878,7 @@ bool SDL_ReadS8(SDL_IOStream *src, Sint8 *value)
     Sint8 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1471,7 +1892,7 @@ bool SDL_ReadU16LE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1490,7 +1911,7 @@ bool SDL_ReadU16BE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1509,7 +1930,7 @@ bool SDL_ReadU32LE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1528,7 +1949,7 @@ bool SDL_ReadU32BE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1547,7 +1968,7 @@ bool SDL_ReadU64LE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1566,7 +1987,7 @@ bool SDL_ReadU64BE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1580,20 +2001,138 @@ bool SDL_ReadS64BE(SDL_IOStream *src, Sint64 *value)
     return SDL_ReadU64BE(src, (Uint64 *)value);
 }
 
+// Byte swap arrays in place after a bulk read. The SIMD versions return how many values they handled.
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static size_t SDL_TARGETING("sse4.1") SwapArray_SSE41(Uint8 *values, size_t count, size_t size)
+{
+    const __m128i shuffle16 = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    const __m128i shuffle32 = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m128i shuffle64 = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i shuffle = (size == 2) ? shuffle16 : (size == 4) ? shuffle32 : shuffle64;
+    const size_t total = count * size;
+    size_t i;
+
+    for (i = 0; (i + 16) <= total; i += 16) {
+        const __m128i data = _mm_loadu_si128((const __m128i *)&values[i]);
+        _mm_storeu_si128((__m128i *)&values[i], _mm_shuffle_epi8(data, shuffle));
+    }
+    return i / size;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static size_t SwapArray_NEON(Uint8 *values, size_t count, size_t size)
+{
+    const size_t total = count * size;
+    size_t i;
+
+    for (i = 0; (i + 16) <= total; i += 16) {
+        uint8x16_t data = vld1q_u8(&values[i]);
+        data = (size == 2) ? vrev16q_u8(data) : (size == 4) ? vrev32q_u8(data) : vrev64q_u8(data);
+        vst1q_u8(&values[i], data);
+    }
+    return i / size;
+}
+#endif
+
+static void SwapArray(void *values, size_t count, size_t size)
+{
+    size_t i = 0;
+
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        i = SwapArray_SSE41((Uint8 *)values, count, size);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = SwapArray_NEON((Uint8 *)values, count, size);
+    }
+#endif
+
+    if (size == 2) {
+        Uint16 *values16 = (Uint16 *)values;
+        for (; i < count; ++i) {
+            values16[i] = SDL_Swap16(values16[i]);
+        }
+    } else if (size == 4) {
+        Uint32 *values32 = (Uint32 *)values;
+        for (; i < count; ++i) {
+            values32[i] = SDL_Swap32(values32[i]);
+        }
+    } else {
+        Uint64 *values64 = (Uint64 *)values;
+        for (; i < count; ++i) {
+            values64[i] = SDL_Swap64(values64[i]);
+        }
+    }
+}
+
+static bool ReadIOArray(SDL_IOStream *src, void *values, size_t count, size_t size, bool swap)
+{
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    } else if (!values && count > 0) {
+        return SDL_InvalidParamError("values");
+    } else if (count > (SDL_SIZE_MAX / size)) {
+        return SDL_SetError("Array is too large");
+    }
+
+    const size_t total = count * size;
+    if (SDL_ReadIO(src, values, total) != total) {
+        return false;
+    }
+    if (swap) {
+        SwapArray(values, count, size);
+    }
+    return true;
+}
+
+bool SDL_ReadU16LEArray(SDL_IOStream *src, Uint16 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_BIG_ENDIAN));
+}
+
+bool SDL_ReadU16BEArray(SDL_IOStream *src, Uint16 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_LIL_ENDIAN));
+}
+
+bool SDL_ReadU32LEArray(SDL_IOStream *src, Uint32 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_BIG_ENDIAN));
+}
+
+bool SDL_ReadU32BEArray(SDL_IOStream *src, Uint32 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_LIL_ENDIAN));
+}
+
+bool SDL_ReadU64LEArray(SDL_IOStream *src, Uint64 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_BIG_ENDIAN));
+}
+
+bool SDL_ReadU64BEArray(SDL_IOStream *src, Uint64 *values, size_t count)
+{
+    return ReadIOArray(src, values, count, sizeof(*values), (SDL_BYTEORDER == SDL_LIL_ENDIAN));
+}
+
 bool SDL_WriteU8(SDL_IOStream *dst, Uint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return WriteIOValue(dst, &value, sizeof(value));
 }
 
 bool SDL_WriteS8(SDL_IOStream *dst, Sint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return WriteIOValue(dst, &value, sizeof(value));
 }
 
 bool SDL_WriteU16LE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
@@ -1604,7 +2143,7 @@ bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
 bool SDL_WriteU16BE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
@@ -1615,7 +2154,7 @@ bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
 bool SDL_WriteU32LE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
@@ -1626,7 +2165,7 @@ bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
 bool SDL_WriteU32BE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
@@ -1637,7 +2176,7 @@ bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
 bool SDL_WriteU64LE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
@@ -1648,7 +2187,7 @@ bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
 bool SDL_WriteU64BE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOValue(dst, &swapped, sizeof(swapped));
 }
 
 bool SDL_WriteS64BE(SDL_IOStream *dst, Sint64 value)
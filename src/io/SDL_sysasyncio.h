@@ -84,12 +84,17 @@ struct SDL_AsyncIOTask
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, asyncio);
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, queue);      // the generic backend uses this, so I've added it here to avoid the extra allocation.
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, threadpool); // the generic backend uses this, so I've added it here to avoid the extra allocation.
+    int threadpool_worker;  // the generic backend uses this to find which worker's task list holds this task.
 };
 
 typedef struct SDL_AsyncIOQueueInterface
 {
     bool (*queue_task)(void *userdata, SDL_AsyncIOTask *task);
     void (*cancel_task)(void *userdata, SDL_AsyncIOTask *task);
+    void (*complete_task)(void *userdata, SDL_AsyncIOTask *task);  // hand over a task that finished its work outside of the backend, like a file copy. This can't fail, the app is waiting on it.
+    bool (*submit)(void *userdata);  // optional: push everything queued during a batch to the OS. NULL if the backend doesn't batch.
+    bool (*register_buffer)(void *userdata, void *buffer, size_t size);  // optional: NULL if the backend doesn't support registered buffers.
+    bool (*unregister_buffer)(void *userdata, void *buffer);  // optional: NULL if the backend doesn't support registered buffers.
     SDL_AsyncIOTask * (*get_results)(void *userdata);
     SDL_AsyncIOTask * (*wait_results)(void *userdata, Sint32 timeoutMS);
     void (*signal)(void *userdata);
@@ -101,6 +106,7 @@ struct SDL_AsyncIOQueue
     SDL_AsyncIOQueueInterface iface;
     void *userdata;
     SDL_AtomicInt tasks_inflight;
+    SDL_AtomicInt batch_depth;  // backends that support batching don't submit new tasks while this is > 0.
 };
 
 // this interface is kept per-object, even though generally it's going to decide
@@ -129,15 +135,15 @@ struct SDL_AsyncIO
 // This is implemented for various platforms; param validation is done before calling this. Open file, fill in iface and userdata.
 extern bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio);
 
-// This is implemented for various platforms. Call SDL_OpenAsyncIOQueue from in here.
-extern bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue);
+// This is implemented for various platforms. Call SDL_OpenAsyncIOQueue from in here. `props` may be 0.
+extern bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue, SDL_PropertiesID props);
 
 // This is called during SDL_QuitAsyncIO, after all tasks have completed and all files are closed, to let the platform clean up global backend details.
 extern void SDL_SYS_QuitAsyncIO(void);
 
 // the "generic" version is always available, since it is almost always needed as a fallback even on platforms that might offer something better.
 extern bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_AsyncIO *asyncio);
-extern bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue);
+extern bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue, SDL_PropertiesID props);
 extern void SDL_SYS_QuitAsyncIO_Generic(void);
 
 #endif
@@ -42,6 +42,7 @@ typedef struct GenericAsyncIOQueueData
     SDL_Mutex *lock;
     SDL_Condition *condition;
     SDL_AsyncIOTask completed_tasks;
+    int priority;  // an SDL_AsyncIOPriority; the threadpool starts higher priority work first.
 } GenericAsyncIOQueueData;
 
 typedef struct GenericAsyncIOData
@@ -84,20 +85,27 @@ static void SynchronousIO(SDL_AsyncIOTask *task)
         task->result = okay ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
     } else if (SDL_SeekIO(io, (Sint64) task->offset, SDL_IO_SEEK_SET) < 0) {
         task->result = SDL_ASYNCIO_FAILURE;
+    } else if (task->type == SDL_ASYNCIO_TASK_WRITE) {
+        task->result_size = (Uint64) SDL_WriteIO(io, ptr, size);
+        task->result = (task->result_size == task->requested_size) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
     } else {
-        const bool writing = (task->type == SDL_ASYNCIO_TASK_WRITE);
-        task->result_size = (Uint64) (writing ? SDL_WriteIO(io, ptr, size) : SDL_ReadIO(io, ptr, size));
-        if (task->result_size == task->requested_size) {
-            task->result = SDL_ASYNCIO_COMPLETE;
-        } else {
-            if (writing) {
-                task->result = SDL_ASYNCIO_FAILURE;  // it's always a failure on short writes.
-            } else {
-                const SDL_IOStatus status = SDL_GetIOStatus(io);
-                SDL_assert(status != SDL_IO_STATUS_READY);  // this should have either failed or been EOF.
+        // a short read that isn't at EOF yet leaves the status as READY, so keep going until we get everything or an answer.
+        SDL_IOStatus status = SDL_IO_STATUS_READY;
+        size_t got = 0;
+        while (got < size) {
+            const size_t br = SDL_ReadIO(io, (Uint8 *) ptr + got, size - got);
+            if (br == 0) {
+                status = SDL_GetIOStatus(io);
                 SDL_assert(status != SDL_IO_STATUS_NOT_READY);  // these should not be non-blocking reads!
-                task->result = (status == SDL_IO_STATUS_EOF) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+                break;
             }
+            got += br;
+        }
+        task->result_size = (Uint64) got;
+        if (got == size) {
+            task->result = SDL_ASYNCIO_COMPLETE;
+        } else {
+            task->result = (status == SDL_IO_STATUS_EOF) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
         }
     }
     SDL_UnlockMutex(data->lock);
@@ -106,52 +114,248 @@ static void SynchronousIO(SDL_AsyncIOTask *task)
 }
 
 #if SDL_ASYNCIO_USE_THREADPOOL
+#define MAX_THREADPOOL_THREADS 8  // 8 is probably more than enough.
+#define NUM_ASYNCIO_PRIORITIES (SDL_ASYNCIO_PRIORITY_HIGH + 1)
+
+// queued reads that continue exactly where another read on the same file ends are merged into one read, up to these limits.
+#define MAX_COALESCED_BYTES (256 * 1024)
+#define MAX_COALESCED_TASKS 16
+#define COALESCE_SEARCH_DEPTH 8  // how far down a task list to look for the next piece; adjacent reads are usually queued back to back.
+
+// Each threadpool thread services a worker with its own task lists (one per priority class), so
+// queueing and picking up tasks doesn't funnel through a single lock. Tasks for a given file
+// go to the same worker, and threads that run out of work steal from the other workers.
+typedef struct AsyncIOWorker
+{
+    SDL_Mutex *lock;
+    SDL_AsyncIOTask tasks[NUM_ASYNCIO_PRIORITIES];  // new tasks go on the end, so each list runs in order.
+    SDL_AsyncIOTask *tails[NUM_ASYNCIO_PRIORITIES];
+    SDL_AtomicInt num_tasks;  // so other threads can skip this worker without taking its lock.
+    bool active;  // true while a thread is assigned to this worker.
+    Uint8 *coalesce_buffer;  // only touched by the thread assigned to this worker.
+} AsyncIOWorker;
+
 static SDL_InitState threadpool_init;
-static SDL_Mutex *threadpool_lock = NULL;
-static bool stop_threadpool = false;
-static SDL_AsyncIOTask threadpool_tasks;
+static SDL_Mutex *threadpool_lock = NULL;  // this only covers threads going to sleep, waking up, starting and stopping; tasks live in the workers.
 static SDL_Condition *threadpool_condition = NULL;
+static SDL_AtomicInt stop_threadpool;
+static AsyncIOWorker threadpool_workers[MAX_THREADPOOL_THREADS];
 static int max_threadpool_threads = 0;
-static int running_threadpool_threads = 0;
-static int idle_threadpool_threads = 0;
+static SDL_AtomicInt running_threadpool_threads;
+static SDL_AtomicInt idle_threadpool_threads;
+static SDL_AtomicInt pending_threadpool_tasks;
+static SDL_AtomicInt pending_priority_tasks[NUM_ASYNCIO_PRIORITIES];
 static int threadpool_threads_spun = 0;
 
-static int SDLCALL AsyncIOThreadpoolWorker(void *data)
+static int GetTaskPriority(const SDL_AsyncIOTask *task)
 {
-    SDL_LockMutex(threadpool_lock);
+    const GenericAsyncIOQueueData *data = (const GenericAsyncIOQueueData *) task->queue->userdata;
+    return data->priority;
+}
 
-    while (!stop_threadpool) {
-        SDL_AsyncIOTask *task = LINKED_LIST_START(threadpool_tasks, threadpool);
-        if (!task) {
-            // if we go 30 seconds without a new task, terminate unless we're the only thread left.
-            idle_threadpool_threads++;
-            const bool rc = SDL_WaitConditionTimeout(threadpool_condition, threadpool_lock, 30000);
-            idle_threadpool_threads--;
+// you must hold worker->lock when calling this!
+static void AppendWorkerTask(AsyncIOWorker *worker, SDL_AsyncIOTask *task)
+{
+    const int priority = GetTaskPriority(task);
+    SDL_AsyncIOTask *last = worker->tails[priority] ? worker->tails[priority] : &worker->tasks[priority];
+    task->threadpoolprev = last;
+    task->threadpoolnext = NULL;
+    last->threadpoolnext = task;
+    worker->tails[priority] = task;
+    SDL_AddAtomicInt(&worker->num_tasks, 1);
+    SDL_AddAtomicInt(&pending_priority_tasks[priority], 1);
+    SDL_AddAtomicInt(&pending_threadpool_tasks, 1);
+}
 
-            if (!rc) {
-                // decide if we have too many idle threads, and if so, quit to let thread pool shrink when not busy.
-                if (idle_threadpool_threads) {
-                    break;
-                }
+// you must hold worker->lock when calling this!
+static void RemoveWorkerTask(AsyncIOWorker *worker, SDL_AsyncIOTask *task)
+{
+    const int priority = GetTaskPriority(task);
+    if (worker->tails[priority] == task) {
+        SDL_AsyncIOTask *prev = LINKED_LIST_PREV(task, threadpool);
+        worker->tails[priority] = (prev == &worker->tasks[priority]) ? NULL : prev;
+    }
+    LINKED_LIST_UNLINK(task, threadpool);
+    SDL_AddAtomicInt(&worker->num_tasks, -1);
+    SDL_AddAtomicInt(&pending_priority_tasks[priority], -1);
+    SDL_AddAtomicInt(&pending_threadpool_tasks, -1);
+}
+
+// you must hold worker->lock when calling this! Takes `first` and any queued reads that continue it, returns the number of tasks taken.
+static int TakeWorkerTasks(AsyncIOWorker *worker, SDL_AsyncIOTask *first, SDL_AsyncIOTask **tasks)
+{
+    const int priority = GetTaskPriority(first);
+    Uint64 total = first->requested_size;
+    int count = 0;
+
+    RemoveWorkerTask(worker, first);
+    tasks[count++] = first;
+
+    if (first->type != SDL_ASYNCIO_TASK_READ) {
+        return count;
+    }
+
+    bool found = true;
+    while (found && (count < MAX_COALESCED_TASKS)) {
+        found = false;
+        int searched = 0;
+        for (SDL_AsyncIOTask *task = LINKED_LIST_START(worker->tasks[priority], threadpool); task && (searched < COALESCE_SEARCH_DEPTH); task = LINKED_LIST_NEXT(task, threadpool), searched++) {
+            if ((task->asyncio == first->asyncio) && (task->type == SDL_ASYNCIO_TASK_READ) &&
+                (task->offset == (first->offset + total)) && ((total + task->requested_size) <= MAX_COALESCED_BYTES)) {
+                RemoveWorkerTask(worker, task);
+                tasks[count++] = task;
+                total += task->requested_size;
+                found = true;
+                break;
             }
+        }
+    }
+
+    return count;
+}
 
+// find the next thing to do: highest priority first, checking our own worker before stealing from the others.
+static int GetNextTasks(AsyncIOWorker *self, SDL_AsyncIOTask **tasks)
+{
+    if (SDL_GetAtomicInt(&pending_threadpool_tasks) <= 0) {
+        return 0;  // don't touch any locks if there's nothing to find.
+    }
+
+    const int self_index = (int) (self - threadpool_workers);
+    for (int priority = NUM_ASYNCIO_PRIORITIES - 1; priority >= 0; priority--) {
+        if (SDL_GetAtomicInt(&pending_priority_tasks[priority]) <= 0) {
             continue;
         }
+        for (int i = 0; i < max_threadpool_threads; i++) {
+            AsyncIOWorker *worker = &threadpool_workers[(self_index + i) % max_threadpool_threads];
+            if (SDL_GetAtomicInt(&worker->num_tasks) <= 0) {
+                continue;
+            }
+            SDL_LockMutex(worker->lock);
+            SDL_AsyncIOTask *task = LINKED_LIST_START(worker->tasks[priority], threadpool);
+            const int count = task ? TakeWorkerTasks(worker, task, tasks) : 0;
+            SDL_UnlockMutex(worker->lock);
+            if (count > 0) {
+                return count;
+            }
+        }
+    }
+    return 0;
+}
+
+// several reads that follow each other in the same file: do one seek and one read, then hand each task its piece.
+static void CoalescedRead(AsyncIOWorker *self, SDL_AsyncIOTask **tasks, int count)
+{
+    if (!self->coalesce_buffer) {
+        self->coalesce_buffer = (Uint8 *) SDL_malloc(MAX_COALESCED_BYTES);
+        if (!self->coalesce_buffer) {  // oh well, do them one at a time.
+            for (int i = 0; i < count; i++) {
+                SynchronousIO(tasks[i]);
+            }
+            return;
+        }
+    }
 
-        LINKED_LIST_UNLINK(task, threadpool);
+    GenericAsyncIOData *data = (GenericAsyncIOData *) tasks[0]->asyncio->userdata;
+    SDL_IOStatus status = SDL_IO_STATUS_READY;
+    Uint64 total = 0;
+    Uint64 got = 0;
 
-        SDL_UnlockMutex(threadpool_lock);
+    for (int i = 0; i < count; i++) {
+        SDL_assert(tasks[i]->result != SDL_ASYNCIO_CANCELED);  // shouldn't have gotten in here if canceled!
+        total += tasks[i]->requested_size;
+    }
 
-        // bookkeeping is done, so we drop the mutex and fire the work.
-        SynchronousIO(task);
+    SDL_LockMutex(data->lock);
+    if (SDL_SeekIO(data->io, (Sint64) tasks[0]->offset, SDL_IO_SEEK_SET) < 0) {
+        status = SDL_IO_STATUS_ERROR;
+    } else {
+        // a short read that isn't at EOF yet leaves the status as READY, so keep going until we get everything or an answer.
+        while (got < total) {
+            const size_t br = SDL_ReadIO(data->io, self->coalesce_buffer + got, (size_t) (total - got));
+            if (br == 0) {
+                status = SDL_GetIOStatus(data->io);
+                SDL_assert(status != SDL_IO_STATUS_NOT_READY);  // these should not be non-blocking reads!
+                break;
+            }
+            got += br;
+        }
+    }
+    SDL_UnlockMutex(data->lock);
 
-        SDL_LockMutex(threadpool_lock);  // take the lock again and see if there's another task (if not, we'll wait on the Condition).
+    Uint64 pos = 0;
+    for (int i = 0; i < count; i++) {
+        SDL_AsyncIOTask *task = tasks[i];
+        const Uint64 available = (got > pos) ? SDL_min(got - pos, task->requested_size) : 0;
+        SDL_memcpy(task->buffer, self->coalesce_buffer + pos, (size_t) available);
+        task->result_size = available;
+        if (available == task->requested_size) {
+            task->result = SDL_ASYNCIO_COMPLETE;
+        } else {
+            task->result = (status == SDL_IO_STATUS_EOF) ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+        }
+        pos += task->requested_size;
+        AsyncIOTaskComplete(task);
     }
+}
 
-    running_threadpool_threads--;
+static int SDLCALL AsyncIOThreadpoolWorker(void *data)
+{
+    AsyncIOWorker *self = (AsyncIOWorker *) data;
+    SDL_AsyncIOTask *tasks[MAX_COALESCED_TASKS];
+
+    while (true) {
+        const int count = GetNextTasks(self, tasks);
+        if (count == 1) {
+            SynchronousIO(tasks[0]);
+            continue;
+        } else if (count > 1) {
+            CoalescedRead(self, tasks, count);
+            continue;
+        }
+
+        SDL_LockMutex(threadpool_lock);
+        if (SDL_GetAtomicInt(&stop_threadpool)) {
+            break;  // still holding threadpool_lock!
+        }
+
+        // QueueAsyncIOTask adds to pending_threadpool_tasks before it checks for idle threads, and we mark ourselves idle
+        // before checking pending_threadpool_tasks, so one side or the other will notice and nothing gets stranded.
+        bool timed_out = false;
+        SDL_AddAtomicInt(&idle_threadpool_threads, 1);
+        if (SDL_GetAtomicInt(&pending_threadpool_tasks) <= 0) {
+            // if we go 30 seconds without a new task, terminate unless we're the only thread left.
+            timed_out = !SDL_WaitConditionTimeout(threadpool_condition, threadpool_lock, 30000);
+        }
+        SDL_AddAtomicInt(&idle_threadpool_threads, -1);
+
+        // decide if we have too many idle threads, and if so, quit to let thread pool shrink when not busy.
+        if (timed_out && (SDL_GetAtomicInt(&idle_threadpool_threads) > 0) && !SDL_GetAtomicInt(&stop_threadpool)) {
+            bool empty = true;
+            SDL_LockMutex(self->lock);
+            for (int i = 0; i < NUM_ASYNCIO_PRIORITIES; i++) {
+                if (LINKED_LIST_START(self->tasks[i], threadpool)) {
+                    empty = false;
+                    break;
+                }
+            }
+            if (empty) {
+                self->active = false;  // new tasks will go to other workers now.
+            }
+            SDL_UnlockMutex(self->lock);
+
+            if (empty) {
+                break;  // still holding threadpool_lock!
+            }
+        }
+
+        SDL_UnlockMutex(threadpool_lock);
+    }
+
+    SDL_AddAtomicInt(&running_threadpool_threads, -1);
 
     // this is kind of a hack, but this lets us reuse threadpool_condition to block on shutdown until all threads have exited.
-    if (stop_threadpool) {
+    if (SDL_GetAtomicInt(&stop_threadpool)) {
         SDL_BroadcastCondition(threadpool_condition);
     }
 
@@ -160,44 +364,101 @@ static int SDLCALL AsyncIOThreadpoolWorker(void *data)
     return 0;
 }
 
+// you must hold threadpool_lock when calling this!
 static bool MaybeSpinNewWorkerThread(void)
 {
     // if all existing threads are busy and the pool of threads isn't maxed out, make a new one.
-    if ((idle_threadpool_threads == 0) && (running_threadpool_threads < max_threadpool_threads)) {
+    if ((SDL_GetAtomicInt(&idle_threadpool_threads) == 0) && (SDL_GetAtomicInt(&running_threadpool_threads) < max_threadpool_threads)) {
+        AsyncIOWorker *worker = NULL;
+        for (int i = 0; (i < max_threadpool_threads) && !worker; i++) {
+            SDL_LockMutex(threadpool_workers[i].lock);
+            if (!threadpool_workers[i].active) {
+                threadpool_workers[i].active = true;
+                worker = &threadpool_workers[i];
+            }
+            SDL_UnlockMutex(threadpool_workers[i].lock);
+        }
+
+        if (!worker) {
+            return true;  // every worker still has a thread (one might be on its way out), that's fine.
+        }
+
         char threadname[32];
         SDL_snprintf(threadname, sizeof (threadname), "SDLasyncio%d", threadpool_threads_spun);
-        SDL_Thread *thread = SDL_CreateThread(AsyncIOThreadpoolWorker, threadname, NULL);
+        SDL_Thread *thread = SDL_CreateThread(AsyncIOThreadpoolWorker, threadname, worker);
         if (thread == NULL) {
+            SDL_LockMutex(worker->lock);
+            worker->active = false;
+            SDL_UnlockMutex(worker->lock);
             return false;
         }
         SDL_DetachThread(thread);  // these terminate themselves when idle too long, so we never WaitThread.
-        running_threadpool_threads++;
+        SDL_AddAtomicInt(&running_threadpool_threads, 1);
         threadpool_threads_spun++;
     }
     return true;
 }
 
+// get idle threads going on newly-queued tasks, or start a new thread if everything is busy.
+static void WakeThreadpool(bool all)
+{
+    // only take the global lock if there's an idle thread to wake or room for a new one.
+    if (SDL_GetAtomicInt(&idle_threadpool_threads) > 0) {
+        SDL_LockMutex(threadpool_lock);
+        if (all) {
+            SDL_BroadcastCondition(threadpool_condition);
+        } else {
+            SDL_SignalCondition(threadpool_condition);
+        }
+        SDL_UnlockMutex(threadpool_lock);
+    } else if (SDL_GetAtomicInt(&running_threadpool_threads) < max_threadpool_threads) {
+        SDL_LockMutex(threadpool_lock);
+        MaybeSpinNewWorkerThread();  // okay if this fails or the thread pool is maxed out. Something will get there eventually.
+        SDL_UnlockMutex(threadpool_lock);
+    }
+}
+
 static void QueueAsyncIOTask(SDL_AsyncIOTask *task)
 {
     SDL_assert(task != NULL);
 
-    SDL_LockMutex(threadpool_lock);
-
-    if (stop_threadpool) {  // just in case.
+    if (SDL_GetAtomicInt(&stop_threadpool)) {  // just in case.
         task->result = SDL_ASYNCIO_CANCELED;
         AsyncIOTaskComplete(task);
-    } else {
-        LINKED_LIST_PREPEND(task, threadpool_tasks, threadpool);
-        MaybeSpinNewWorkerThread();  // okay if this fails or the thread pool is maxed out. Something will get there eventually.
+        return;
+    }
 
-        // tell idle threads to get to work.
-        // This is a broadcast because we want someone from the thread pool to wake up, but
-        // also shutdown might also be blocking on this. One of the threads will grab
-        // it, the others will go back to sleep.
-        SDL_BroadcastCondition(threadpool_condition);
+    // keep each file on one worker, so adjacent reads end up in the same list where they can be coalesced. If that
+    // worker has no thread right now, try the next one; if none do, park it anyhow and a new thread will steal it.
+    const int first = (int) ((((uintptr_t) task->asyncio) / sizeof (SDL_AsyncIO)) % (uintptr_t) max_threadpool_threads);
+    AsyncIOWorker *worker = NULL;
+    for (int i = 0; i < max_threadpool_threads; i++) {
+        worker = &threadpool_workers[(first + i) % max_threadpool_threads];
+        SDL_LockMutex(worker->lock);
+        if (worker->active || (i == (max_threadpool_threads - 1))) {
+            break;  // still holding worker->lock!
+        }
+        SDL_UnlockMutex(worker->lock);
     }
 
-    SDL_UnlockMutex(threadpool_lock);
+    task->threadpool_worker = (int) (worker - threadpool_workers);
+    AppendWorkerTask(worker, task);
+    SDL_UnlockMutex(worker->lock);
+
+    // during a batch, let tasks pile up so adjacent reads can be coalesced; SDL_EndAsyncIOBatch wakes everyone.
+    // (threads that are already awake will still pick these up, which is fine.)
+    if (SDL_GetAtomicInt(&task->queue->batch_depth) == 0) {
+        WakeThreadpool(false);
+    }
+}
+
+static void DestroyThreadpoolWorkers(void)
+{
+    for (int i = 0; i < MAX_THREADPOOL_THREADS; i++) {
+        SDL_DestroyMutex(threadpool_workers[i].lock);
+        SDL_free(threadpool_workers[i].coalesce_buffer);
+    }
+    SDL_zeroa(threadpool_workers);
 }
 
 // We don't initialize async i/o at all until it's used, so
@@ -208,11 +469,26 @@ static bool PrepareThreadpool(void)
     bool okay = true;
     if (SDL_ShouldInit(&threadpool_init)) {
         max_threadpool_threads = (SDL_GetNumLogicalCPUCores() * 2) + 1;  // !!! FIXME: this should probably have a hint to override.
-        max_threadpool_threads = SDL_clamp(max_threadpool_threads, 1, 8);  // 8 is probably more than enough.
+        max_threadpool_threads = SDL_clamp(max_threadpool_threads, 1, MAX_THREADPOOL_THREADS);
+
+        SDL_SetAtomicInt(&stop_threadpool, 0);
+        SDL_SetAtomicInt(&running_threadpool_threads, 0);
+        SDL_SetAtomicInt(&idle_threadpool_threads, 0);
+        SDL_SetAtomicInt(&pending_threadpool_tasks, 0);
+        for (int i = 0; i < NUM_ASYNCIO_PRIORITIES; i++) {
+            SDL_SetAtomicInt(&pending_priority_tasks[i], 0);
+        }
 
+        for (int i = 0; okay && (i < max_threadpool_threads); i++) {
+            okay = ((threadpool_workers[i].lock = SDL_CreateMutex()) != NULL);
+        }
         okay = (okay && ((threadpool_lock = SDL_CreateMutex()) != NULL));
         okay = (okay && ((threadpool_condition = SDL_CreateCondition()) != NULL));
-        okay = (okay && MaybeSpinNewWorkerThread());  // make sure at least one thread is going, since we'll need it.
+        if (okay) {
+            SDL_LockMutex(threadpool_lock);
+            okay = MaybeSpinNewWorkerThread();  // make sure at least one thread is going, since we'll need it.
+            SDL_UnlockMutex(threadpool_lock);
+        }
 
         if (!okay) {
             if (threadpool_condition) {
@@ -223,6 +499,7 @@ static bool PrepareThreadpool(void)
                 SDL_DestroyMutex(threadpool_lock);
                 threadpool_lock = NULL;
             }
+            DestroyThreadpoolWorkers();
         }
 
         SDL_SetInitialized(&threadpool_init, okay);
@@ -236,17 +513,24 @@ static void ShutdownThreadpool(void)
         SDL_LockMutex(threadpool_lock);
 
         // cancel anything that's still pending.
-        SDL_AsyncIOTask *task;
-        while ((task = LINKED_LIST_START(threadpool_tasks, threadpool)) != NULL) {
-            LINKED_LIST_UNLINK(task, threadpool);
-            task->result = SDL_ASYNCIO_CANCELED;
-            AsyncIOTaskComplete(task);
+        for (int i = 0; i < max_threadpool_threads; i++) {
+            AsyncIOWorker *worker = &threadpool_workers[i];
+            SDL_LockMutex(worker->lock);
+            for (int priority = 0; priority < NUM_ASYNCIO_PRIORITIES; priority++) {
+                SDL_AsyncIOTask *task;
+                while ((task = LINKED_LIST_START(worker->tasks[priority], threadpool)) != NULL) {
+                    RemoveWorkerTask(worker, task);
+                    task->result = SDL_ASYNCIO_CANCELED;
+                    AsyncIOTaskComplete(task);
+                }
+            }
+            SDL_UnlockMutex(worker->lock);
         }
 
-        stop_threadpool = true;
+        SDL_SetAtomicInt(&stop_threadpool, 1);
         SDL_BroadcastCondition(threadpool_condition);  // tell the whole threadpool to wake up and quit.
 
-        while (running_threadpool_threads > 0) {
+        while (SDL_GetAtomicInt(&running_threadpool_threads) > 0) {
             // each threadpool thread will broadcast this condition before it terminates if stop_threadpool is set.
             // we can't just join the threads because they are detached, so the thread pool can automatically shrink as necessary.
             SDL_WaitCondition(threadpool_condition, threadpool_lock);
@@ -258,10 +542,17 @@ static void ShutdownThreadpool(void)
         threadpool_lock = NULL;
         SDL_DestroyCondition(threadpool_condition);
         threadpool_condition = NULL;
+        DestroyThreadpoolWorkers();
+
+        max_threadpool_threads = threadpool_threads_spun = 0;
+        SDL_SetAtomicInt(&running_threadpool_threads, 0);
+        SDL_SetAtomicInt(&idle_threadpool_threads, 0);
+        SDL_SetAtomicInt(&pending_threadpool_tasks, 0);
+        for (int i = 0; i < NUM_ASYNCIO_PRIORITIES; i++) {
+            SDL_SetAtomicInt(&pending_priority_tasks[i], 0);
+        }
 
-        max_threadpool_threads = running_threadpool_threads = idle_threadpool_threads = threadpool_threads_spun = 0;
-
-        stop_threadpool = false;
+        SDL_SetAtomicInt(&stop_threadpool, 0);
         SDL_SetInitialized(&threadpool_init, false);
     }
 }
@@ -297,6 +588,14 @@ static bool generic_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *tas
     return true;
 }
 
+static bool generic_asyncioqueue_submit(void *userdata)
+{
+    #if SDL_ASYNCIO_USE_THREADPOOL
+    WakeThreadpool(true);
+    #endif
+    return true;
+}
+
 static void generic_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
 {
     #if !SDL_ASYNCIO_USE_THREADPOOL  // in theory, this was all synchronous and should never call this, but just in case.
@@ -304,16 +603,22 @@ static void generic_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *ta
     AsyncIOTaskComplete(task);
     #else
     // we can't stop i/o that's in-flight, but we _can_ just refuse to start it if the threadpool hadn't picked it up yet.
-    SDL_LockMutex(threadpool_lock);
+    AsyncIOWorker *worker = &threadpool_workers[task->threadpool_worker];
+    SDL_LockMutex(worker->lock);
     if (LINKED_LIST_PREV(task, threadpool) != NULL) {  // still in the queue waiting to be run? Take it out.
-        LINKED_LIST_UNLINK(task, threadpool);
+        RemoveWorkerTask(worker, task);
         task->result = SDL_ASYNCIO_CANCELED;
         AsyncIOTaskComplete(task);
     }
-    SDL_UnlockMutex(threadpool_lock);
+    SDL_UnlockMutex(worker->lock);
     #endif
 }
 
+static void generic_asyncioqueue_complete_task(void *userdata, SDL_AsyncIOTask *task)
+{
+    AsyncIOTaskComplete(task);
+}
+
 static SDL_AsyncIOTask *generic_asyncioqueue_get_results(void *userdata)
 {
     GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *) userdata;
@@ -358,7 +663,7 @@ static void generic_asyncioqueue_destroy(void *userdata)
     SDL_free(data);
 }
 
-bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
+bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
     #if SDL_ASYNCIO_USE_THREADPOOL
     if (!PrepareThreadpool()) {
@@ -384,9 +689,16 @@ bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
         return false;
     }
 
+    data->priority = (int) SDL_GetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_PRIORITY_NUMBER, SDL_ASYNCIO_PRIORITY_NORMAL);
+    data->priority = SDL_clamp(data->priority, SDL_ASYNCIO_PRIORITY_LOW, SDL_ASYNCIO_PRIORITY_HIGH);
+
     static const SDL_AsyncIOQueueInterface SDL_AsyncIOQueue_Generic = {
         generic_asyncioqueue_queue_task,
         generic_asyncioqueue_cancel_task,
+        generic_asyncioqueue_complete_task,
+        generic_asyncioqueue_submit,
+        NULL,  // register_buffer
+        NULL,  // unregister_buffer
         generic_asyncioqueue_get_results,
         generic_asyncioqueue_wait_results,
         generic_asyncioqueue_signal,
@@ -452,9 +764,9 @@ bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *as
     return SDL_SYS_AsyncIOFromFile_Generic(file, mode, asyncio);
 }
 
-bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
+bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
-    return SDL_SYS_CreateAsyncIOQueue_Generic(queue);
+    return SDL_SYS_CreateAsyncIOQueue_Generic(queue, props);
 }
 
 void SDL_SYS_QuitAsyncIO(void)
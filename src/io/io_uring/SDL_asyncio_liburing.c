@@ -32,12 +32,13 @@
 #include <liburing.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <string.h>  // for strerror()
 
 static SDL_InitState liburing_init;
 
 // We could add a whole bootstrap thing like the audio/video/etc subsystems use, but let's keep this simple for now.
-static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue);
+static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue, SDL_PropertiesID props);
 static void (*QuitAsyncIO)(void);
 static bool (*AsyncIOFromFile)(const char *file, const char *mode, SDL_AsyncIO *asyncio);
 
@@ -69,29 +70,65 @@ static void *liburing_handle = NULL;
     SDL_LIBURING_FUNC(void, io_uring_cqe_seen, (struct io_uring *ring, struct io_uring_cqe *cqe)) \
     SDL_LIBURING_FUNC(void, io_uring_queue_exit, (struct io_uring *ring)) \
 
+// these are only needed for SQPOLL and registered files/buffers, so we still use liburing if an older build lacks them.
+#define SDL_LIBURING_OPTIONAL_FUNCS \
+    SDL_LIBURING_FUNC(int, io_uring_queue_init_params, (unsigned entries, struct io_uring *ring, struct io_uring_params *p)) \
+    SDL_LIBURING_FUNC(int, io_uring_register_files_sparse, (struct io_uring *ring, unsigned nr)) \
+    SDL_LIBURING_FUNC(int, io_uring_register_files_update, (struct io_uring *ring, unsigned off, const int *files, unsigned nr_files)) \
+    SDL_LIBURING_FUNC(int, io_uring_register_buffers_sparse, (struct io_uring *ring, unsigned nr)) \
+    SDL_LIBURING_FUNC(int, io_uring_register_buffers_update_tag, (struct io_uring *ring, unsigned off, const struct iovec *iovecs, const __u64 *tags, unsigned nr)) \
+    SDL_LIBURING_FUNC(void, io_uring_prep_read_fixed, (struct io_uring_sqe *sqe, int fd, void *buf, unsigned nbytes, __u64 offset, int buf_index)) \
+    SDL_LIBURING_FUNC(void, io_uring_prep_write_fixed, (struct io_uring_sqe *sqe, int fd, const void *buf, unsigned nbytes, __u64 offset, int buf_index)) \
+
 
 #define SDL_LIBURING_FUNC(ret, fn, args) typedef ret (*SDL_fntype_##fn) args;
 SDL_LIBURING_FUNCS
+SDL_LIBURING_OPTIONAL_FUNCS
 #undef SDL_LIBURING_FUNC
 
 typedef struct SDL_LibUringFunctions
 {
     #define SDL_LIBURING_FUNC(ret, fn, args) SDL_fntype_##fn fn;
     SDL_LIBURING_FUNCS
+    SDL_LIBURING_OPTIONAL_FUNCS
     #undef SDL_LIBURING_FUNC
 } SDL_LibUringFunctions;
 
 static SDL_LibUringFunctions liburing;
 
 
+typedef struct LibUringAsyncIOFileData LibUringAsyncIOFileData;
+
 typedef struct LibUringAsyncIOQueueData
 {
     SDL_Mutex *sqe_lock;
     SDL_Mutex *cqe_lock;
     struct io_uring ring;
     SDL_AtomicInt num_waiting;
+    SDL_AsyncIOTask completed_tasks;  // tasks that finished outside the ring, protected by cqe_lock.
+    int num_file_slots;
+    LibUringAsyncIOFileData **registered_files;  // protected by registration_lock.
+    int num_buffer_slots;
+    struct iovec *registered_buffers;  // protected by sqe_lock.
 } LibUringAsyncIOQueueData;
 
+// a file can hold a registered slot in a few queues at once; past that, it just uses its plain file descriptor.
+#define MAX_FILE_REGISTRATIONS 4
+
+struct LibUringAsyncIOFileData
+{
+    int fd;
+    int num_registrations;
+    struct
+    {
+        LibUringAsyncIOQueueData *queuedata;
+        int slot;
+    } registrations[MAX_FILE_REGISTRATIONS];  // protected by registration_lock.
+};
+
+// registered files link files and queues in both directions, so they share a global lock.
+static SDL_Mutex *registration_lock = NULL;
+
 
 static void UnloadLibUringLibrary(void)
 {
@@ -112,6 +149,10 @@ static bool LoadLibUringSyms(void)
     }
     SDL_LIBURING_FUNCS
     #undef SDL_LIBURING_FUNC
+
+    #define SDL_LIBURING_FUNC(ret, fn, args) liburing.fn = (SDL_fntype_##fn) SDL_LoadFunction(liburing_handle, #fn);
+    SDL_LIBURING_OPTIONAL_FUNCS
+    #undef SDL_LIBURING_FUNC
     return true;
 }
 
@@ -170,9 +211,9 @@ static bool liburing_SetError(const char *what, int err)
 
 static Sint64 liburing_asyncio_size(void *userdata)
 {
-    const int fd = (int) (intptr_t) userdata;
+    const LibUringAsyncIOFileData *filedata = (const LibUringAsyncIOFileData *) userdata;
     struct stat statbuf;
-    if (fstat(fd, &statbuf) < 0) {
+    if (fstat(filedata->fd, &statbuf) < 0) {
         SDL_SetError("fstat failed: %s", strerror(errno));
         return -1;
     }
@@ -180,13 +221,41 @@ static Sint64 liburing_asyncio_size(void *userdata)
 }
 
 // you must hold sqe_lock when calling this!
-static bool liburing_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
+static struct io_uring_sqe *GetSQE(LibUringAsyncIOQueueData *queuedata)
+{
+    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    if (!sqe) {  // probably a large batch filled the submission queue; hand what we have to the kernel and try again.
+        liburing.io_uring_submit(&queuedata->ring);
+        sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    }
+    return sqe;
+}
+
+// you must hold sqe_lock when calling this!
+static bool SubmitSQEs(LibUringAsyncIOQueueData *queuedata)
 {
-    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
     const int rc = liburing.io_uring_submit(&queuedata->ring);
     return (rc < 0) ? liburing_SetError("io_uring_submit", rc) : true;
 }
 
+// you must hold sqe_lock when calling this!
+static bool liburing_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
+{
+    if (SDL_GetAtomicInt(&task->queue->batch_depth) > 0) {
+        return true;  // the sqe is ready in the ring; SDL_EndAsyncIOBatch will submit it with the rest.
+    }
+    return SubmitSQEs((LibUringAsyncIOQueueData *) userdata);
+}
+
+static bool liburing_asyncioqueue_submit(void *userdata)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    SDL_LockMutex(queuedata->sqe_lock);
+    const bool retval = SubmitSQEs(queuedata);
+    SDL_UnlockMutex(queuedata->sqe_lock);
+    return retval;
+}
+
 static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
 {
     SDL_AsyncIOTask *cancel_task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*cancel_task));
@@ -198,7 +267,7 @@ static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *t
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = GetSQE(queuedata);
     if (!sqe) {
         SDL_UnlockMutex(queuedata->sqe_lock);
         SDL_free(cancel_task);  // oh well, the task can just finish on its own.
@@ -208,8 +277,168 @@ static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *t
     cancel_task->app_userdata = task;
     liburing.io_uring_prep_cancel(sqe, task, 0);
     liburing.io_uring_sqe_set_data(sqe, cancel_task);
-    liburing_asyncioqueue_queue_task(userdata, task);
+    SubmitSQEs(queuedata);  // cancels don't wait for the app's batch to end.
+    SDL_UnlockMutex(queuedata->sqe_lock);
+}
+
+static void liburing_asyncioqueue_complete_task(void *userdata, SDL_AsyncIOTask *task)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+
+    // the ring might not have room to carry this, so keep it on the side, where get_results will find it first.
+    SDL_LockMutex(queuedata->cqe_lock);
+    LINKED_LIST_PREPEND(task, queuedata->completed_tasks, queue);
+    SDL_UnlockMutex(queuedata->cqe_lock);
+
+    // then push an empty NOP through the ring to wake anything blocked on it. If the ring is full, it's busy and will
+    //  wake waiters on its own soon, but keep at it while someone is waiting, in case this is the last thing they get.
+    while (true) {
+        SDL_LockMutex(queuedata->sqe_lock);
+        struct io_uring_sqe *sqe = GetSQE(queuedata);
+        if (sqe) {
+            liburing.io_uring_prep_nop(sqe);
+            liburing.io_uring_sqe_set_data(sqe, NULL);
+            SubmitSQEs(queuedata);  // if this fails, the NOP stays in the ring and goes out with the next submit.
+        }
+        SDL_UnlockMutex(queuedata->sqe_lock);
+
+        if (sqe || (SDL_GetAtomicInt(&queuedata->num_waiting) == 0)) {
+            break;
+        }
+        SDL_Delay(1);
+    }
+}
+
+static bool liburing_asyncioqueue_register_buffer(void *userdata, void *buffer, size_t size)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    if (queuedata->num_buffer_slots == 0) {
+        return true;  // queue wasn't created with buffer slots, operations will just use the memory directly.
+    }
+
+    bool retval = false;
+    SDL_LockMutex(queuedata->sqe_lock);
+    int slot = -1;
+    for (int i = 0; i < queuedata->num_buffer_slots; i++) {
+        if (!queuedata->registered_buffers[i].iov_base) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot < 0) {
+        SDL_SetError("io_uring: all registered buffer slots are in use");
+    } else {
+        const struct iovec iov = { buffer, size };
+        const __u64 tag = 0;
+        const int rc = liburing.io_uring_register_buffers_update_tag(&queuedata->ring, (unsigned) slot, &iov, &tag, 1);
+        if (rc < 0) {
+            liburing_SetError("io_uring_register_buffers_update_tag", rc);
+        } else {
+            queuedata->registered_buffers[slot] = iov;
+            retval = true;
+        }
+    }
+    SDL_UnlockMutex(queuedata->sqe_lock);
+    return retval;
+}
+
+static bool liburing_asyncioqueue_unregister_buffer(void *userdata, void *buffer)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    if (queuedata->num_buffer_slots == 0) {
+        return true;  // nothing was registered to begin with.
+    }
+
+    bool retval = false;
+    SDL_LockMutex(queuedata->sqe_lock);
+    int slot = -1;
+    for (int i = 0; i < queuedata->num_buffer_slots; i++) {
+        if (queuedata->registered_buffers[i].iov_base == buffer) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot < 0) {
+        SDL_SetError("io_uring: buffer isn't registered");
+    } else {
+        const struct iovec iov = { NULL, 0 };  // an empty iovec clears the slot; in-flight operations keep their own reference.
+        const __u64 tag = 0;
+        const int rc = liburing.io_uring_register_buffers_update_tag(&queuedata->ring, (unsigned) slot, &iov, &tag, 1);
+        if (rc < 0) {
+            liburing_SetError("io_uring_register_buffers_update_tag", rc);
+        } else {
+            SDL_zero(queuedata->registered_buffers[slot]);
+            retval = true;
+        }
+    }
     SDL_UnlockMutex(queuedata->sqe_lock);
+    return retval;
+}
+
+// you must hold sqe_lock when calling this! Returns the registered buffer index, or -1 if the memory isn't entirely inside one.
+static int FindRegisteredBuffer(LibUringAsyncIOQueueData *queuedata, const void *buffer, Uint64 size)
+{
+    const Uint8 *ptr = (const Uint8 *) buffer;
+    for (int i = 0; i < queuedata->num_buffer_slots; i++) {
+        const Uint8 *base = (const Uint8 *) queuedata->registered_buffers[i].iov_base;
+        if (base && (ptr >= base) && (size <= (Uint64) queuedata->registered_buffers[i].iov_len) &&
+            ((Uint64) (ptr - base) <= ((Uint64) queuedata->registered_buffers[i].iov_len - size))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// you must hold sqe_lock when calling this! Returns the registered file index to use with IOSQE_FIXED_FILE, or -1 to use the plain fd.
+static int GetFixedFileSlot(LibUringAsyncIOQueueData *queuedata, LibUringAsyncIOFileData *filedata)
+{
+    if (queuedata->num_file_slots == 0) {
+        return -1;
+    }
+
+    int slot = -1;
+    SDL_LockMutex(registration_lock);
+    for (int i = 0; i < filedata->num_registrations; i++) {
+        if (filedata->registrations[i].queuedata == queuedata) {
+            slot = filedata->registrations[i].slot;
+            break;
+        }
+    }
+
+    // not registered with this queue yet? Take the first free slot, if there is one.
+    if ((slot < 0) && (filedata->num_registrations < MAX_FILE_REGISTRATIONS)) {
+        for (int i = 0; i < queuedata->num_file_slots; i++) {
+            if (!queuedata->registered_files[i]) {
+                if (liburing.io_uring_register_files_update(&queuedata->ring, (unsigned) i, &filedata->fd, 1) == 1) {
+                    queuedata->registered_files[i] = filedata;
+                    filedata->registrations[filedata->num_registrations].queuedata = queuedata;
+                    filedata->registrations[filedata->num_registrations].slot = i;
+                    filedata->num_registrations++;
+                    slot = i;
+                }
+                break;
+            }
+        }
+    }
+    SDL_UnlockMutex(registration_lock);
+
+    return slot;
+}
+
+static void UnregisterFile(LibUringAsyncIOFileData *filedata)
+{
+    SDL_LockMutex(registration_lock);
+    for (int i = 0; i < filedata->num_registrations; i++) {
+        LibUringAsyncIOQueueData *queuedata = filedata->registrations[i].queuedata;
+        const int slot = filedata->registrations[i].slot;
+        const int empty = -1;
+        liburing.io_uring_register_files_update(&queuedata->ring, (unsigned) slot, &empty, 1);
+        queuedata->registered_files[slot] = NULL;
+    }
+    filedata->num_registrations = 0;
+    SDL_UnlockMutex(registration_lock);
 }
 
 static SDL_AsyncIOTask *ProcessCQE(LibUringAsyncIOQueueData *queuedata, struct io_uring_cqe *cqe)
@@ -259,6 +488,13 @@ static SDL_AsyncIOTask *liburing_asyncioqueue_get_results(void *userdata)
 
     // have to hold a lock because otherwise two threads will get the same cqe until we mark it "seen". Copy and mark it right away, then process further.
     SDL_LockMutex(queuedata->cqe_lock);
+    SDL_AsyncIOTask *task = LINKED_LIST_START(queuedata->completed_tasks, queue);
+    if (task) {
+        LINKED_LIST_UNLINK(task, queue);
+        SDL_UnlockMutex(queuedata->cqe_lock);
+        return task;
+    }
+
     struct io_uring_cqe *cqe = NULL;
     const int rc = liburing.io_uring_peek_cqe(&queuedata->ring, &cqe);
     if (rc != 0) {
@@ -280,15 +516,24 @@ static SDL_AsyncIOTask *liburing_asyncioqueue_wait_results(void *userdata, Sint3
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
     struct io_uring_cqe *cqe = NULL;
 
+    // a task completed on the side doesn't leave anything in the ring to wait for, so check for those first. We count
+    //  as waiting before checking, so complete_task keeps trying to wake us if it lands right after this.
     SDL_AddAtomicInt(&queuedata->num_waiting, 1);
-    if (timeoutMS < 0) {
-        liburing.io_uring_wait_cqe(&queuedata->ring, &cqe);
-    } else {
-        struct __kernel_timespec ts = { (Sint64) timeoutMS / SDL_MS_PER_SECOND, (Sint64) SDL_MS_TO_NS(timeoutMS % SDL_MS_PER_SECOND) };
-        liburing.io_uring_wait_cqe_timeout(&queuedata->ring, &cqe, &ts);
+    SDL_AsyncIOTask *task = liburing_asyncioqueue_get_results(userdata);
+    if (!task) {
+        if (timeoutMS < 0) {
+            liburing.io_uring_wait_cqe(&queuedata->ring, &cqe);
+        } else {
+            struct __kernel_timespec ts = { (Sint64) timeoutMS / SDL_MS_PER_SECOND, (Sint64) SDL_MS_TO_NS(timeoutMS % SDL_MS_PER_SECOND) };
+            liburing.io_uring_wait_cqe_timeout(&queuedata->ring, &cqe, &ts);
+        }
     }
     SDL_AddAtomicInt(&queuedata->num_waiting, -1);
 
+    if (task) {
+        return task;
+    }
+
     // (we don't care if the wait failed for any reason, as the upcoming peek_cqe will report valid information. We just wanted the wait operation to block.)
 
     // each thing that peeks or waits for a completion _gets the same cqe_ until we mark it as seen. So when we wake up from the wait, lock the mutex and
@@ -318,13 +563,34 @@ static void liburing_asyncioqueue_signal(void *userdata)
 static void liburing_asyncioqueue_destroy(void *userdata)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+
+    if (queuedata->registered_files) {
+        // files still registered here have to forget about this queue. The kernel side of the registrations goes away with the ring.
+        SDL_LockMutex(registration_lock);
+        for (int i = 0; i < queuedata->num_file_slots; i++) {
+            LibUringAsyncIOFileData *filedata = queuedata->registered_files[i];
+            if (filedata) {
+                for (int j = 0; j < filedata->num_registrations; j++) {
+                    if (filedata->registrations[j].queuedata == queuedata) {
+                        filedata->num_registrations--;
+                        filedata->registrations[j] = filedata->registrations[filedata->num_registrations];
+                        break;
+                    }
+                }
+            }
+        }
+        SDL_UnlockMutex(registration_lock);
+    }
+
     liburing.io_uring_queue_exit(&queuedata->ring);
     SDL_DestroyMutex(queuedata->sqe_lock);
     SDL_DestroyMutex(queuedata->cqe_lock);
+    SDL_free(queuedata->registered_files);
+    SDL_free(queuedata->registered_buffers);
     SDL_free(queuedata);
 }
 
-static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
+static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) SDL_calloc(1, sizeof (*queuedata));
     if (!queuedata) {
@@ -346,8 +612,21 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
         return false;
     }
 
-    // !!! FIXME: no idea how large the queue should be. Is 128 overkill or too small?
-    const int rc = liburing.io_uring_queue_init(128, &queuedata->ring, 0);
+    // !!! FIXME: no idea how large the queue should be by default. Is 128 overkill or too small?
+    const unsigned entries = (unsigned) SDL_clamp(SDL_GetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER, 128), 1, 32768);
+    int rc = -EINVAL;
+    if (SDL_GetBooleanProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_SQPOLL_BOOLEAN, false) && liburing.io_uring_queue_init_params) {
+        struct io_uring_params params;
+        SDL_zero(params);
+        params.flags = IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = 1000;  // milliseconds without work before the kernel thread goes to sleep.
+        rc = liburing.io_uring_queue_init_params(entries, &queuedata->ring, &params);
+    }
+
+    if (rc != 0) {  // SQPOLL wasn't requested, or the kernel refused it (older kernels want extra privileges), so make a normal ring.
+        rc = liburing.io_uring_queue_init(entries, &queuedata->ring, 0);
+    }
+
     if (rc != 0) {
         SDL_DestroyMutex(queuedata->sqe_lock);
         SDL_DestroyMutex(queuedata->cqe_lock);
@@ -355,9 +634,43 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
         return liburing_SetError("io_uring_queue_init", rc);
     }
 
+    // Registered files and buffers are optimizations; if the kernel won't give us the tables, carry on without them.
+    const Sint64 num_files = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_FILES_NUMBER, 0);
+    if ((num_files > 0) && registration_lock && liburing.io_uring_register_files_sparse && liburing.io_uring_register_files_update) {
+        const int num_slots = (int) SDL_min(num_files, 32768);
+        queuedata->registered_files = (LibUringAsyncIOFileData **) SDL_calloc(num_slots, sizeof (*queuedata->registered_files));
+        if (queuedata->registered_files) {
+            if (liburing.io_uring_register_files_sparse(&queuedata->ring, (unsigned) num_slots) == 0) {
+                queuedata->num_file_slots = num_slots;
+            } else {
+                SDL_free(queuedata->registered_files);
+                queuedata->registered_files = NULL;
+            }
+        }
+    }
+
+    const Sint64 num_buffers = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER, 0);
+    if ((num_buffers > 0) && liburing.io_uring_register_buffers_sparse && liburing.io_uring_register_buffers_update_tag &&
+        liburing.io_uring_prep_read_fixed && liburing.io_uring_prep_write_fixed) {
+        const int num_slots = (int) SDL_min(num_buffers, 16384);  // IORING_MAX_REG_BUFFERS
+        queuedata->registered_buffers = (struct iovec *) SDL_calloc(num_slots, sizeof (*queuedata->registered_buffers));
+        if (queuedata->registered_buffers) {
+            if (liburing.io_uring_register_buffers_sparse(&queuedata->ring, (unsigned) num_slots) == 0) {
+                queuedata->num_buffer_slots = num_slots;
+            } else {
+                SDL_free(queuedata->registered_buffers);
+                queuedata->registered_buffers = NULL;
+            }
+        }
+    }
+
     static const SDL_AsyncIOQueueInterface SDL_AsyncIOQueue_liburing = {
         liburing_asyncioqueue_queue_task,
         liburing_asyncioqueue_cancel_task,
+        liburing_asyncioqueue_complete_task,
+        liburing_asyncioqueue_submit,
+        liburing_asyncioqueue_register_buffer,
+        liburing_asyncioqueue_unregister_buffer,
         liburing_asyncioqueue_get_results,
         liburing_asyncioqueue_wait_results,
         liburing_asyncioqueue_signal,
@@ -370,10 +683,9 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
 }
 
 
-static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
+static bool liburing_asyncio_readwrite(LibUringAsyncIOFileData *filedata, SDL_AsyncIOTask *task, bool writing)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
-    const int fd = (int) (intptr_t) userdata;
 
     // !!! FIXME: `unsigned` is likely smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
     // !!! FIXME:  and make a note in the task that there are several in sequence.
@@ -384,11 +696,32 @@ static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = GetSQE(queuedata);
     if (!sqe) {
         retval = SDL_SetError("io_uring: submission queue is full");
     } else {
-        liburing.io_uring_prep_read(sqe, fd, task->buffer, (unsigned) task->requested_size, task->offset);
+        const int slot = GetFixedFileSlot(queuedata, filedata);
+        const int fd = (slot >= 0) ? slot : filedata->fd;  // with IOSQE_FIXED_FILE, the "fd" is an index into the registered file table.
+        const int buf_index = FindRegisteredBuffer(queuedata, task->buffer, task->requested_size);
+        const unsigned nbytes = (unsigned) task->requested_size;
+
+        if (writing) {
+            if (buf_index >= 0) {
+                liburing.io_uring_prep_write_fixed(sqe, fd, task->buffer, nbytes, task->offset, buf_index);
+            } else {
+                liburing.io_uring_prep_write(sqe, fd, task->buffer, nbytes, task->offset);
+            }
+        } else {
+            if (buf_index >= 0) {
+                liburing.io_uring_prep_read_fixed(sqe, fd, task->buffer, nbytes, task->offset, buf_index);
+            } else {
+                liburing.io_uring_prep_read(sqe, fd, task->buffer, nbytes, task->offset);
+            }
+        }
+
+        if (slot >= 0) {
+            liburing.io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+        }
         liburing.io_uring_sqe_set_data(sqe, task);
         retval = task->queue->iface.queue_task(task->queue->userdata, task);
     }
@@ -396,47 +729,32 @@ static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
     return retval;
 }
 
-static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
+static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
 {
-    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
-    const int fd = (int) (intptr_t) userdata;
-
-    // !!! FIXME: `unsigned` is likely smaller than requested_size's Uint64. If we overflow it, we could try submitting multiple SQEs
-    // !!! FIXME:  and make a note in the task that there are several in sequence.
-    if (task->requested_size > ((Uint64) ~((unsigned) 0))) {
-        return SDL_SetError("io_uring: i/o task is too large");
-    }
+    return liburing_asyncio_readwrite((LibUringAsyncIOFileData *) userdata, task, false);
+}
 
-    // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
-    SDL_LockMutex(queuedata->sqe_lock);
-    bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
-    if (!sqe) {
-        retval = SDL_SetError("io_uring: submission queue is full");
-    } else {
-        liburing.io_uring_prep_write(sqe, fd, task->buffer, (unsigned) task->requested_size, task->offset);
-        liburing.io_uring_sqe_set_data(sqe, task);
-        retval = task->queue->iface.queue_task(task->queue->userdata, task);
-    }
-    SDL_UnlockMutex(queuedata->sqe_lock);
-    return retval;
+static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
+{
+    return liburing_asyncio_readwrite((LibUringAsyncIOFileData *) userdata, task, true);
 }
 
 static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
-    const int fd = (int) (intptr_t) userdata;
+    LibUringAsyncIOFileData *filedata = (LibUringAsyncIOFileData *) userdata;
+    const int fd = filedata->fd;
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = GetSQE(queuedata);
     if (!sqe) {
         retval = SDL_SetError("io_uring: submission queue is full");
     } else {
         if (task->flush) {
             struct io_uring_sqe *flush_sqe = sqe;
-            sqe = liburing.io_uring_get_sqe(&queuedata->ring);  // this will be our actual close task.
+            sqe = GetSQE(queuedata);  // this will be our actual close task.
             if (!sqe) {
                 liburing.io_uring_prep_nop(flush_sqe);  // we already have the first sqe, just make it a NOP.
                 liburing.io_uring_sqe_set_data(flush_sqe, NULL);
@@ -449,6 +767,7 @@ static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
             liburing.io_uring_sqe_set_flags(flush_sqe, IOSQE_IO_HARDLINK);  // must complete before next sqe starts, and next sqe should run even if this fails.
         }
 
+        UnregisterFile(filedata);  // a registered slot holds its own reference to the file, which would keep it open.
         liburing.io_uring_prep_close(sqe, fd);
         liburing.io_uring_sqe_set_data(sqe, task);
 
@@ -460,7 +779,8 @@ static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
 
 static void liburing_asyncio_destroy(void *userdata)
 {
-    // this is only a Unix file descriptor, should have been closed elsewhere.
+    // the Unix file descriptor itself should have been closed elsewhere.
+    SDL_free(userdata);
 }
 
 static int PosixOpenModeFromString(const char *mode)
@@ -490,6 +810,13 @@ static bool SDL_SYS_AsyncIOFromFile_liburing(const char *file, const char *mode,
         return SDL_SetError("open failed: %s", strerror(errno));
     }
 
+    LibUringAsyncIOFileData *filedata = (LibUringAsyncIOFileData *) SDL_calloc(1, sizeof (*filedata));
+    if (!filedata) {
+        close(fd);
+        return false;
+    }
+    filedata->fd = fd;
+
     static const SDL_AsyncIOInterface SDL_AsyncIOFile_liburing = {
         liburing_asyncio_size,
         liburing_asyncio_read,
@@ -499,12 +826,14 @@ static bool SDL_SYS_AsyncIOFromFile_liburing(const char *file, const char *mode,
     };
 
     SDL_copyp(&asyncio->iface, &SDL_AsyncIOFile_liburing);
-    asyncio->userdata = (void *) (intptr_t) fd;
+    asyncio->userdata = filedata;
     return true;
 }
 
 static void SDL_SYS_QuitAsyncIO_liburing(void)
 {
+    SDL_DestroyMutex(registration_lock);
+    registration_lock = NULL;
     UnloadLibUringLibrary();
 }
 
@@ -512,6 +841,7 @@ static void MaybeInitializeLibUring(void)
 {
     if (SDL_ShouldInit(&liburing_init)) {
         if (LoadLibUring()) {
+            registration_lock = SDL_CreateMutex();  // if this fails, queues just won't register files.
             CreateAsyncIOQueue = SDL_SYS_CreateAsyncIOQueue_liburing;
             QuitAsyncIO = SDL_SYS_QuitAsyncIO_liburing;
             AsyncIOFromFile = SDL_SYS_AsyncIOFromFile_liburing;
@@ -524,10 +854,10 @@ static void MaybeInitializeLibUring(void)
     }
 }
 
-bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
+bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
     MaybeInitializeLibUring();
-    return CreateAsyncIOQueue(queue);
+    return CreateAsyncIOQueue(queue, props);
 }
 
 bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
@@ -37,7 +37,7 @@
 static SDL_InitState ioring_init;
 
 // We could add a whole bootstrap thing like the audio/video/etc subsystems use, but let's keep this simple for now.
-static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue);
+static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue, SDL_PropertiesID props);
 static void (*QuitAsyncIO)(void);
 static bool (*AsyncIOFromFile)(const char *file, const char *mode, SDL_AsyncIO *asyncio);
 
@@ -80,6 +80,7 @@ typedef struct WinIoRingAsyncIOQueueData
     HANDLE event;
     HIORING ring;
     SDL_AtomicInt num_waiting;
+    SDL_AsyncIOTask completed_tasks;  // tasks that finished outside the IoRing, protected by cqe_lock.
 } WinIoRingAsyncIOQueueData;
 
 
@@ -146,13 +147,21 @@ static Sint64 ioring_asyncio_size(void *userdata)
 }
 
 // you must hold sqe_lock when calling this!
-static bool ioring_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
+static bool ioring_asyncioqueue_submit(void *userdata)
 {
     WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) userdata;
     const HRESULT hr = ioring.SubmitIoRing(queuedata->ring, 0, 0, NULL);
     return (FAILED(hr) ? WIN_SetErrorFromHRESULT("SubmitIoRing", hr) : true);
 }
 
+static bool ioring_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
+{
+    if (SDL_GetAtomicInt(&task->queue->batch_depth) > 0) {
+        return true;  // the request is built and waiting in the ring; SDL_EndAsyncIOBatch will submit it with the rest.
+    }
+    return ioring_asyncioqueue_submit(userdata);
+}
+
 static void ioring_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
 {
     if (!task->asyncio || !task->asyncio->userdata) {
@@ -178,10 +187,20 @@ static void ioring_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *tas
     }
 
     cancel_task->app_userdata = task;
-    ioring_asyncioqueue_queue_task(userdata, task);
+    ioring_asyncioqueue_submit(userdata);  // cancels don't wait for the app's batch to end.
     SDL_UnlockMutex(queuedata->sqe_lock);
 }
 
+static void ioring_asyncioqueue_complete_task(void *userdata, SDL_AsyncIOTask *task)
+{
+    // IoRing has no NOP request to carry this through the ring, so keep it on the side and wake a waiting thread.
+    WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) userdata;
+    SDL_LockMutex(queuedata->cqe_lock);
+    LINKED_LIST_PREPEND(task, queuedata->completed_tasks, queue);
+    SDL_UnlockMutex(queuedata->cqe_lock);
+    SetEvent(queuedata->event);
+}
+
 static SDL_AsyncIOTask *ProcessCQE(WinIoRingAsyncIOQueueData *queuedata, IORING_CQE *cqe)
 {
     if (!cqe) {
@@ -235,6 +254,12 @@ static SDL_AsyncIOTask *ioring_asyncioqueue_get_results(void *userdata)
 
     // unlike liburing's io_uring_peek_cqe(), it's possible PopIoRingCompletion() is thread safe, but for now we wrap it in a mutex just in case.
     SDL_LockMutex(queuedata->cqe_lock);
+    SDL_AsyncIOTask *task = LINKED_LIST_START(queuedata->completed_tasks, queue);
+    if (task) {
+        LINKED_LIST_UNLINK(task, queue);
+        SDL_UnlockMutex(queuedata->cqe_lock);
+        return task;
+    }
     IORING_CQE cqe;
     const HRESULT hr = ioring.PopIoRingCompletion(queuedata->ring, &cqe);
     SDL_UnlockMutex(queuedata->cqe_lock);
@@ -283,7 +308,7 @@ static void ioring_asyncioqueue_destroy(void *userdata)
     SDL_free(queuedata);
 }
 
-static bool SDL_SYS_CreateAsyncIOQueue_ioring(SDL_AsyncIOQueue *queue)
+static bool SDL_SYS_CreateAsyncIOQueue_ioring(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
     WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) SDL_calloc(1, sizeof (*queuedata));
     if (!queuedata) {
@@ -311,10 +336,11 @@ static bool SDL_SYS_CreateAsyncIOQueue_ioring(SDL_AsyncIOQueue *queue)
         goto failed;
     }
 
-    // !!! FIXME: no idea how large the queue should be. Is 128 overkill or too small?
+    // !!! FIXME: no idea how large the queue should be by default. Is 128 overkill or too small?
+    const UINT32 entries = (UINT32) SDL_clamp(SDL_GetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER, 128), 1, 32768);
     flags.Required = IORING_CREATE_REQUIRED_FLAGS_NONE;
     flags.Advisory = IORING_CREATE_ADVISORY_FLAGS_NONE;
-    hr = ioring.CreateIoRing(SDL_REQUIRED_IORING_VERSION, flags, 128, 128, &queuedata->ring);
+    hr = ioring.CreateIoRing(SDL_REQUIRED_IORING_VERSION, flags, entries, entries, &queuedata->ring);
     if (FAILED(hr)) {
         WIN_SetErrorFromHRESULT("CreateIoRing", hr);
         goto failed;
@@ -344,6 +370,10 @@ static bool SDL_SYS_CreateAsyncIOQueue_ioring(SDL_AsyncIOQueue *queue)
     static const SDL_AsyncIOQueueInterface SDL_AsyncIOQueue_ioring = {
         ioring_asyncioqueue_queue_task,
         ioring_asyncioqueue_cancel_task,
+        ioring_asyncioqueue_complete_task,
+        ioring_asyncioqueue_submit,
+        NULL,  // register_buffer   !!! FIXME: BuildIoRingRegisterBuffers could back these.
+        NULL,  // unregister_buffer
         ioring_asyncioqueue_get_results,
         ioring_asyncioqueue_wait_results,
         ioring_asyncioqueue_signal,
@@ -523,10 +553,10 @@ static void MaybeInitializeWinIoRing(void)
     }
 }
 
-bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
+bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue, SDL_PropertiesID props)
 {
     MaybeInitializeWinIoRing();
-    return CreateAsyncIOQueue(queue);
+    return CreateAsyncIOQueue(queue, props);
 }
 
 bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
@@ -1392,6 +1392,311 @@ static SDL_PixelFormat GetClosestSupportedFormat(SDL_Renderer *renderer, SDL_Pix
     return renderer->texture_formats[0];
 }
 
+/* Small static textures created with SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN are
+ * packed onto shared pages with a shelf packer, so that drawing them one after
+ * another goes to the backend as draws with the same texture, which it can merge.
+ */
+#define SDL_ATLAS_PAGE_SIZE     1024
+#define SDL_ATLAS_PADDING       1   // Edge pixels repeated around each texture, so filtering doesn't sample its neighbors
+
+typedef struct SDL_TextureAtlasShelf
+{
+    int y;
+    int h;
+    int x;  // The start of the free space on the shelf
+} SDL_TextureAtlasShelf;
+
+struct SDL_TextureAtlasPage
+{
+    SDL_Texture *texture;
+    SDL_TextureAtlasShelf *shelves;
+    int num_shelves;
+    int num_textures;
+    int used_pixels;
+    SDL_TextureAtlasPage *next;
+};
+
+static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying);
+
+static void UpdateAtlasProperties(SDL_Renderer *renderer)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_TextureAtlasPage *page;
+    Sint64 num_pages = 0;
+    Sint64 used_pixels = 0;
+    Sint64 total_pixels = 0;
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        ++num_pages;
+        used_pixels += page->used_pixels;
+        total_pixels += (Sint64)page->texture->w * page->texture->h;
+    }
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_ATLAS_PAGES_NUMBER, num_pages);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_ATLAS_USED_PIXELS_NUMBER, used_pixels);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_ATLAS_TOTAL_PIXELS_NUMBER, total_pixels);
+}
+
+static int GetAtlasPageSize(SDL_Renderer *renderer)
+{
+    int max_texture_size = (int)SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (max_texture_size > 0 && max_texture_size < SDL_ATLAS_PAGE_SIZE) {
+        return max_texture_size;
+    }
+    return SDL_ATLAS_PAGE_SIZE;
+}
+
+static bool CanAtlasTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    // Textures bigger than this would fill pages too quickly to be worth sharing
+    const int max_size = GetAtlasPageSize(renderer) / 4 - 2 * SDL_ATLAS_PADDING;
+
+    if (texture->access != SDL_TEXTUREACCESS_STATIC ||
+        SDL_ISPIXELFORMAT_FOURCC(texture->format) ||
+        SDL_ISPIXELFORMAT_INDEXED(texture->format) ||
+        !IsSupportedFormat(renderer, texture->format)) {
+        return false;
+    }
+    if (texture->w > max_size || texture->h > max_size) {
+        return false;
+    }
+    return true;
+}
+
+static bool PlaceTextureOnAtlasPage(SDL_TextureAtlasPage *page, SDL_Texture *texture)
+{
+    const int w = texture->w + 2 * SDL_ATLAS_PADDING;
+    const int h = texture->h + 2 * SDL_ATLAS_PADDING;
+    const int page_w = page->texture->w;
+    const int page_h = page->texture->h;
+    SDL_TextureAtlasShelf *shelf = NULL;
+    int i;
+
+    // Use the shelf that wastes the least height
+    for (i = 0; i < page->num_shelves; ++i) {
+        SDL_TextureAtlasShelf *candidate = &page->shelves[i];
+        if (h <= candidate->h && candidate->x + w <= page_w) {
+            if (!shelf || candidate->h < shelf->h) {
+                shelf = candidate;
+            }
+        }
+    }
+
+    // Start a new shelf if the best one is more than twice as tall as needed
+    if (!shelf || shelf->h > 2 * h) {
+        int y = 0;
+        if (page->num_shelves > 0) {
+            const SDL_TextureAtlasShelf *last = &page->shelves[page->num_shelves - 1];
+            y = last->y + last->h;
+        }
+        if (y + h <= page_h) {
+            SDL_TextureAtlasShelf *shelves = (SDL_TextureAtlasShelf *)SDL_realloc(page->shelves, (page->num_shelves + 1) * sizeof(*shelves));
+            if (!shelves) {
+                return false;
+            }
+            page->shelves = shelves;
+            shelf = &shelves[page->num_shelves++];
+            shelf->y = y;
+            shelf->h = h;
+            shelf->x = 0;
+        }
+    }
+    if (!shelf) {
+        return false;
+    }
+
+    texture->atlas = page;
+    texture->atlas_rect.x = shelf->x + SDL_ATLAS_PADDING;
+    texture->atlas_rect.y = shelf->y + SDL_ATLAS_PADDING;
+    texture->atlas_rect.w = texture->w;
+    texture->atlas_rect.h = texture->h;
+    shelf->x += w;
+    ++page->num_textures;
+    page->used_pixels += texture->w * texture->h;
+    return true;
+}
+
+static bool AddTextureToAtlas(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_TextureAtlasPage *page;
+    SDL_PropertiesID props;
+    const int page_size = GetAtlasPageSize(renderer);
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        const SDL_Texture *page_texture = page->texture;
+        if (page_texture->format == texture->format &&
+            page_texture->colorspace == texture->colorspace &&
+            page_texture->SDR_white_point == texture->SDR_white_point &&
+            page_texture->HDR_headroom == texture->HDR_headroom &&
+            PlaceTextureOnAtlasPage(page, texture)) {
+            UpdateAtlasProperties(renderer);
+            return true;
+        }
+    }
+
+    page = (SDL_TextureAtlasPage *)SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        return false;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, texture->format);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, texture->colorspace);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, page_size);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, page_size);
+    SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT, texture->SDR_white_point);
+    SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
+    page->texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    if (!page->texture) {
+        SDL_free(page);
+        return false;
+    }
+
+    if (!PlaceTextureOnAtlasPage(page, texture)) {
+        SDL_DestroyTextureInternal(page->texture, false);
+        SDL_free(page);
+        return false;
+    }
+
+    // Swap textures to have texture before the page in the list, so it's destroyed first
+    page->texture->next = texture->next;
+    if (page->texture->next) {
+        page->texture->next->prev = page->texture;
+    }
+    texture->prev = page->texture->prev;
+    if (texture->prev) {
+        texture->prev->next = texture;
+    }
+    page->texture->prev = texture;
+    texture->next = page->texture;
+    renderer->textures = texture;
+
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    UpdateAtlasProperties(renderer);
+    return true;
+}
+
+static void RemoveTextureFromAtlas(SDL_Texture *texture, bool is_destroying)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_TextureAtlasPage *page = texture->atlas;
+    int i;
+
+    texture->atlas = NULL;
+    if (renderer->atlas_last_texture == texture) {
+        renderer->atlas_last_texture = NULL;
+    }
+
+    page->used_pixels -= texture->w * texture->h;
+    if (--page->num_textures == 0) {
+        SDL_TextureAtlasPage **prev = &renderer->atlas_pages;
+        while (*prev != page) {
+            prev = &(*prev)->next;
+        }
+        *prev = page->next;
+
+        SDL_DestroyTextureInternal(page->texture, is_destroying);
+        SDL_free(page->shelves);
+        SDL_free(page);
+    } else {
+        // Give the space back if this was the last texture on its shelf
+        for (i = 0; i < page->num_shelves; ++i) {
+            SDL_TextureAtlasShelf *shelf = &page->shelves[i];
+            if (shelf->y == texture->atlas_rect.y - SDL_ATLAS_PADDING) {
+                if (shelf->x == texture->atlas_rect.x + texture->atlas_rect.w + SDL_ATLAS_PADDING) {
+                    shelf->x = texture->atlas_rect.x - SDL_ATLAS_PADDING;
+                }
+                break;
+            }
+        }
+        while (page->num_shelves > 0 && page->shelves[page->num_shelves - 1].x == 0) {
+            --page->num_shelves;
+        }
+    }
+
+    if (!is_destroying) {
+        UpdateAtlasProperties(renderer);
+    }
+}
+
+static bool UpdateAtlasTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    const int left = (rect->x == 0) ? SDL_ATLAS_PADDING : 0;
+    const int right = (rect->x + rect->w == texture->w) ? SDL_ATLAS_PADDING : 0;
+    const int top = (rect->y == 0) ? SDL_ATLAS_PADDING : 0;
+    const int bottom = (rect->y + rect->h == texture->h) ? SDL_ATLAS_PADDING : 0;
+    SDL_Rect page_rect;
+    Uint8 *temp_pixels;
+    int temp_pitch;
+    int x, y;
+    bool result;
+
+    page_rect.x = texture->atlas_rect.x + rect->x - left;
+    page_rect.y = texture->atlas_rect.y + rect->y - top;
+    page_rect.w = rect->w + left + right;
+    page_rect.h = rect->h + top + bottom;
+
+    if (!left && !right && !top && !bottom) {
+        return SDL_UpdateTexture(texture->atlas->texture, &page_rect, pixels, pitch);
+    }
+
+    // Repeat the edge pixels into the padding around the texture
+    temp_pitch = page_rect.w * bpp;
+    temp_pixels = (Uint8 *)SDL_malloc((size_t)temp_pitch * page_rect.h);
+    if (!temp_pixels) {
+        return false;
+    }
+    for (y = 0; y < page_rect.h; ++y) {
+        const int src_y = SDL_clamp(y - top, 0, rect->h - 1);
+        const Uint8 *src = (const Uint8 *)pixels + src_y * pitch;
+        Uint8 *dst = temp_pixels + y * temp_pitch;
+
+        for (x = 0; x < left; ++x) {
+            SDL_memcpy(dst, src, bpp);
+            dst += bpp;
+        }
+        SDL_memcpy(dst, src, (size_t)rect->w * bpp);
+        dst += rect->w * bpp;
+        for (x = 0; x < right; ++x) {
+            SDL_memcpy(dst, src + (rect->w - 1) * bpp, bpp);
+            dst += bpp;
+        }
+    }
+    result = SDL_UpdateTexture(texture->atlas->texture, &page_rect, temp_pixels, temp_pitch);
+    SDL_free(temp_pixels);
+    return result;
+}
+
+// Get the atlas page to draw instead of texture, moving srcrect into page coordinates
+static SDL_Texture *GetAtlasPageForDraw(SDL_Renderer *renderer, SDL_Texture *texture, SDL_FRect *srcrect)
+{
+    SDL_Texture *page = texture->atlas->texture;
+    const SDL_RenderCommand *cmd = renderer->render_commands_tail;
+
+    if (cmd && texture != renderer->atlas_last_texture &&
+        (cmd->command == SDL_RENDERCMD_COPY ||
+         cmd->command == SDL_RENDERCMD_COPY_EX ||
+         cmd->command == SDL_RENDERCMD_GEOMETRY) &&
+        cmd->data.draw.texture == page) {
+        ++renderer->atlas_batches_saved;
+    }
+    renderer->atlas_last_texture = texture;
+
+    if (srcrect) {
+        srcrect->x += texture->atlas_rect.x;
+        srcrect->y += texture->atlas_rect.y;
+    }
+
+    // The page is drawn with the state of the texture it stands in for
+    page->color = texture->color;
+    page->blendMode = texture->blendMode;
+    page->scaleMode = texture->scaleMode;
+    return page;
+}
+
 SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
     SDL_Texture *texture;
@@ -1472,7 +1777,10 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     // FOURCC format cannot be used directly by renderer back-ends for target texture
     texture_is_fourcc_and_target = (access == SDL_TEXTUREACCESS_TARGET && SDL_ISPIXELFORMAT_FOURCC(format));
 
-    if (!texture_is_fourcc_and_target && IsSupportedFormat(renderer, format)) {
+    if (SDL_GetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN, false) &&
+        CanAtlasTexture(renderer, texture) && AddTextureToAtlas(renderer, texture)) {
+        // The texture lives on an atlas page, there's nothing for the backend to create
+    } else if (!texture_is_fourcc_and_target && IsSupportedFormat(renderer, format)) {
         if (!renderer->CreateTexture(renderer, texture, props)) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -2167,6 +2475,8 @@ bool SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *p
 #endif
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, &real_rect, pixels, pitch);
+    } else if (texture->atlas) {
+        return UpdateAtlasTexture(texture, &real_rect, pixels, pitch);
     } else {
         SDL_Renderer *renderer = texture->renderer;
         if (!FlushRenderCommandsIfTextureNeeded(texture)) {
@@ -4004,6 +4314,8 @@ bool SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_F
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = GetAtlasPageForDraw(renderer, texture, &real_srcrect);
     }
 
     texture->last_command_generation = renderer->render_command_generation;
@@ -4049,6 +4361,8 @@ bool SDL_RenderTextureAffine(SDL_Renderer *renderer, SDL_Texture *texture,
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = GetAtlasPageForDraw(renderer, texture, &real_srcrect);
     }
 
     texture->last_command_generation = renderer->render_command_generation;
@@ -4177,6 +4491,8 @@ bool SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = GetAtlasPageForDraw(renderer, texture, &real_srcrect);
     }
 
     if (center) {
@@ -4280,6 +4596,259 @@ bool SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
     return result;
 }
 
+/* Sprites per geometry command from SDL_RenderTextures(), which bounds the scratch buffers
+ * and keeps the index math well inside an int.
+ */
+#define SDL_RENDER_BATCH_SPRITES 1024
+
+static void FreeRenderBatch(SDL_Renderer *renderer)
+{
+    SDL_free(renderer->batch_vertices);
+    renderer->batch_vertices = NULL;
+    SDL_free(renderer->batch_indices);
+    renderer->batch_indices = NULL;
+    renderer->batch_allocation = 0;
+}
+
+static bool GrowRenderBatch(SDL_Renderer *renderer, int count)
+{
+    size_t vertices_size, indices_size;
+    SDL_Vertex *vertices;
+    int *indices;
+    int i;
+
+    SDL_assert(count <= SDL_RENDER_BATCH_SPRITES);
+
+    renderer->batch_used = true;
+    if (count <= renderer->batch_allocation) {
+        return true;
+    }
+
+    vertices_size = (size_t)count * 4 * sizeof(*vertices);
+    indices_size = (size_t)count * 6 * sizeof(*indices);
+
+    vertices = (SDL_Vertex *)SDL_realloc(renderer->batch_vertices, vertices_size);
+    if (!vertices) {
+        return false;
+    }
+    renderer->batch_vertices = vertices;
+
+    indices = (int *)SDL_realloc(renderer->batch_indices, indices_size);
+    if (!indices) {
+        return false;
+    }
+    renderer->batch_indices = indices;
+
+    // The index pattern is the same for every batch, so only fill in the new part
+    for (i = renderer->batch_allocation; i < count; ++i) {
+        int j;
+        for (j = 0; j < 6; ++j) {
+            indices[i * 6 + j] = i * 4 + rect_index_order[j];
+        }
+    }
+    renderer->batch_allocation = count;
+    return true;
+}
+
+// texture is drawn from draw_texture, which is its atlas page if it has one
+static bool SDL_RenderTexturesGeometry(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Texture *draw_texture,
+                                       const SDL_FRect *srcrects, const SDL_FRect *dstrects,
+                                       const SDL_FColor *colors, const double *angles,
+                                       const SDL_FlipMode *flips, int count)
+{
+    const SDL_RenderViewState *view = renderer->view;
+    const float scale_x = view->current_scale.x;
+    const float scale_y = view->current_scale.y;
+    const SDL_FRect texture_rect = { 0.0f, 0.0f, (float)texture->w, (float)texture->h };
+    float offset_x = 0.0f, offset_y = 0.0f;
+    SDL_Vertex *vertices;
+    int num_sprites = 0;
+    int i;
+
+    if (!GrowRenderBatch(renderer, count)) {
+        return false;
+    }
+
+    if (draw_texture != texture) {
+        // Move the source rectangles into page coordinates
+        offset_x = (float)texture->atlas_rect.x;
+        offset_y = (float)texture->atlas_rect.y;
+    }
+    draw_texture->last_command_generation = renderer->render_command_generation;
+
+    vertices = renderer->batch_vertices;
+    for (i = 0; i < count; ++i) {
+        const SDL_FRect *dstrect = &dstrects[i];
+        const SDL_FlipMode flip = flips ? flips[i] : SDL_FLIP_NONE;
+        SDL_Vertex *v = &vertices[num_sprites * 4];
+        SDL_FRect srcrect = texture_rect;
+        SDL_FColor color = texture->color;
+        float minu, minv, maxu, maxv;
+        float minx, miny, maxx, maxy;
+
+        if (srcrects && !SDL_GetRectIntersectionFloat(&srcrects[i], &texture_rect, &srcrect)) {
+            continue;
+        }
+
+        if (colors) {
+            color.r *= colors[i].r;
+            color.g *= colors[i].g;
+            color.b *= colors[i].b;
+            color.a *= colors[i].a;
+        }
+
+        minu = (offset_x + srcrect.x) / draw_texture->w;
+        minv = (offset_y + srcrect.y) / draw_texture->h;
+        maxu = (offset_x + srcrect.x + srcrect.w) / draw_texture->w;
+        maxv = (offset_y + srcrect.y + srcrect.h) / draw_texture->h;
+
+        if (flip & SDL_FLIP_HORIZONTAL) {
+            minx = dstrect->x + dstrect->w;
+            maxx = dstrect->x;
+        } else {
+            minx = dstrect->x;
+            maxx = dstrect->x + dstrect->w;
+        }
+
+        if (flip & SDL_FLIP_VERTICAL) {
+            miny = dstrect->y + dstrect->h;
+            maxy = dstrect->y;
+        } else {
+            miny = dstrect->y;
+            maxy = dstrect->y + dstrect->h;
+        }
+
+        if (angles && (int)(angles[i] / 360) != angles[i] / 360) {
+            const float radian_angle = (float)((SDL_PI_D * angles[i]) / 180.0);
+            const float s = SDL_sinf(radian_angle);
+            const float c = SDL_cosf(radian_angle);
+            const float centerx = dstrect->x + dstrect->w / 2.0f;
+            const float centery = dstrect->y + dstrect->h / 2.0f;
+
+            minx -= centerx;
+            miny -= centery;
+            maxx -= centerx;
+            maxy -= centery;
+
+            v[0].position.x = (c * minx - s * miny) + centerx;
+            v[0].position.y = (s * minx + c * miny) + centery;
+            v[1].position.x = (c * maxx - s * miny) + centerx;
+            v[1].position.y = (s * maxx + c * miny) + centery;
+            v[2].position.x = (c * maxx - s * maxy) + centerx;
+            v[2].position.y = (s * maxx + c * maxy) + centery;
+            v[3].position.x = (c * minx - s * maxy) + centerx;
+            v[3].position.y = (s * minx + c * maxy) + centery;
+        } else {
+            v[0].position.x = minx;
+            v[0].position.y = miny;
+            v[1].position.x = maxx;
+            v[1].position.y = miny;
+            v[2].position.x = maxx;
+            v[2].position.y = maxy;
+            v[3].position.x = minx;
+            v[3].position.y = maxy;
+        }
+
+        v[0].tex_coord.x = minu;
+        v[0].tex_coord.y = minv;
+        v[1].tex_coord.x = maxu;
+        v[1].tex_coord.y = minv;
+        v[2].tex_coord.x = maxu;
+        v[2].tex_coord.y = maxv;
+        v[3].tex_coord.x = minu;
+        v[3].tex_coord.y = maxv;
+
+        v[0].color = color;
+        v[1].color = color;
+        v[2].color = color;
+        v[3].color = color;
+
+        ++num_sprites;
+    }
+
+    if (num_sprites == 0) {
+        return true;
+    }
+
+    return QueueCmdGeometry(renderer, draw_texture,
+                            &vertices->position.x, sizeof(*vertices),
+                            &vertices->color, sizeof(*vertices),
+                            &vertices->tex_coord.x, sizeof(*vertices),
+                            num_sprites * 4, renderer->batch_indices, num_sprites * 6, 4,
+                            scale_x, scale_y, SDL_TEXTURE_ADDRESS_CLAMP, SDL_TEXTURE_ADDRESS_CLAMP);
+}
+
+bool SDL_RenderTextures(SDL_Renderer *renderer, SDL_Texture *texture,
+                        const SDL_FRect *srcrects, const SDL_FRect *dstrects,
+                        const SDL_FColor *colors, const double *angles,
+                        const SDL_FlipMode *flips, int count)
+{
+    SDL_Texture *native;
+    SDL_FColor texture_color;
+    bool result = true;
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if ((angles || flips) && !renderer->QueueCopyEx && !renderer->QueueGeometry) {
+        return SDL_SetError("Renderer does not support RenderCopyEx");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
+    if (count == 0) {
+        return true;
+    }
+
+    native = texture->native ? texture->native : texture;
+
+    if (!renderer->QueueCopy) {
+        // An atlased texture has nothing to draw from itself, all of its batches come from its page
+        SDL_Texture *draw_texture = native->atlas ? GetAtlasPageForDraw(renderer, native, NULL) : native;
+
+        for (i = 0; i < count && result; i += SDL_RENDER_BATCH_SPRITES) {
+            result = SDL_RenderTexturesGeometry(renderer, native, draw_texture,
+                                                srcrects ? &srcrects[i] : NULL, &dstrects[i],
+                                                colors ? &colors[i] : NULL, angles ? &angles[i] : NULL,
+                                                flips ? &flips[i] : NULL, SDL_min(count - i, SDL_RENDER_BATCH_SPRITES));
+        }
+        return result;
+    }
+
+    // The backend draws copies itself, so hand it the sprites one at a time,
+    // applying the per-sprite color to the texture while it is queued.
+    texture_color = native->color;
+    for (i = 0; i < count && result; ++i) {
+        if (colors) {
+            native->color.r = texture_color.r * colors[i].r;
+            native->color.g = texture_color.g * colors[i].g;
+            native->color.b = texture_color.b * colors[i].b;
+            native->color.a = texture_color.a * colors[i].a;
+        }
+        result = SDL_RenderTextureRotated(renderer, texture,
+                                          srcrects ? &srcrects[i] : NULL, &dstrects[i],
+                                          angles ? angles[i] : 0.0, NULL,
+                                          flips ? flips[i] : SDL_FLIP_NONE);
+    }
+    native->color = texture_color;
+    return result;
+}
+
 static bool SDL_RenderTextureTiled_Wrap(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect)
 {
     float xy[8];
@@ -4428,15 +4997,16 @@ bool SDL_RenderTextureTiled(SDL_Renderer *renderer, SDL_Texture *texture, const
 
     if (texture->native) {
         texture = texture->native;
+    } else if (texture->atlas) {
+        texture = GetAtlasPageForDraw(renderer, texture, &real_srcrect);
     }
 
     texture->last_command_generation = renderer->render_command_generation;
 
-    // See if we can use geometry with repeating texture coordinates
+    // See if we can use geometry with repeating texture coordinates (never true for atlas pages)
     if (!renderer->software &&
-        (!srcrect ||
-         (real_srcrect.x == 0.0f && real_srcrect.y == 0.0f &&
-          real_srcrect.w == (float)texture->w && real_srcrect.h == (float)texture->h))) {
+        real_srcrect.x == 0.0f && real_srcrect.y == 0.0f &&
+        real_srcrect.w == (float)texture->w && real_srcrect.h == (float)texture->h) {
         return SDL_RenderTextureTiled_Wrap(renderer, texture, &real_srcrect, scale, dstrect);
     } else {
         return SDL_RenderTextureTiled_Iterate(renderer, texture, &real_srcrect, scale, dstrect);
@@ -5120,6 +5690,9 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
     int count = indices ? num_indices : num_vertices;
     SDL_TextureAddressMode texture_address_mode_u;
     SDL_TextureAddressMode texture_address_mode_v;
+    float *atlas_uv = NULL;
+    bool isstack = false;
+    bool result;
 
     CHECK_RENDERER_MAGIC(renderer, false);
 
@@ -5224,6 +5797,29 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         }
     }
 
+    if (texture && texture->atlas) {
+        // Move the texture coordinates onto the atlas page
+        const SDL_Rect *rect = &texture->atlas_rect;
+
+        if (texture_address_mode_u != SDL_TEXTURE_ADDRESS_CLAMP ||
+            texture_address_mode_v != SDL_TEXTURE_ADDRESS_CLAMP) {
+            return SDL_SetError("Atlased textures can't use wrapping texture coordinates");
+        }
+
+        texture = GetAtlasPageForDraw(renderer, texture, NULL);
+        atlas_uv = SDL_small_alloc(float, 2 * num_vertices, &isstack);
+        if (!atlas_uv) {
+            return false;
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            const float *uv_ = (const float *)((const char *)uv + i * uv_stride);
+            atlas_uv[i * 2 + 0] = (rect->x + uv_[0] * rect->w) / texture->w;
+            atlas_uv[i * 2 + 1] = (rect->y + uv_[1] * rect->h) / texture->h;
+        }
+        uv = atlas_uv;
+        uv_stride = 2 * sizeof(float);
+    }
+
     if (texture) {
         texture->last_command_generation = renderer->render_command_generation;
     }
@@ -5233,18 +5829,21 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
     if (renderer->software &&
         texture_address_mode_u == SDL_TEXTURE_ADDRESS_CLAMP &&
         texture_address_mode_v == SDL_TEXTURE_ADDRESS_CLAMP) {
-        return SDL_SW_RenderGeometryRaw(renderer, texture,
-                                        xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
-                                        indices, num_indices, size_indices);
-    }
+        result = SDL_SW_RenderGeometryRaw(renderer, texture,
+                                          xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices,
+                                          indices, num_indices, size_indices);
+    } else
 #endif
-
-    const SDL_RenderViewState *view = renderer->view;
-    return QueueCmdGeometry(renderer, texture,
-                            xy, xy_stride, color, color_stride, uv, uv_stride,
-                            num_vertices, indices, num_indices, size_indices,
-                            view->current_scale.x, view->current_scale.y,
-                            texture_address_mode_u, texture_address_mode_v);
+    {
+        const SDL_RenderViewState *view = renderer->view;
+        result = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, color, color_stride, uv, uv_stride,
+                                  num_vertices, indices, num_indices, size_indices,
+                                  view->current_scale.x, view->current_scale.y,
+                                  texture_address_mode_u, texture_address_mode_v);
+    }
+    SDL_small_free(atlas_uv, isstack);
+    return result;
 }
 
 bool SDL_SetRenderTextureAddressMode(SDL_Renderer *renderer, SDL_TextureAddressMode u_mode, SDL_TextureAddressMode v_mode)
@@ -5395,6 +5994,15 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
 
     FlushRenderCommands(renderer); // time to send everything to the GPU!
 
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_ATLAS_BATCHES_SAVED_NUMBER, renderer->atlas_batches_saved);
+    renderer->atlas_batches_saved = 0;
+
+    // The sprite batch scratch buffers are only kept while SDL_RenderTextures() is in use
+    if (!renderer->batch_used) {
+        FreeRenderBatch(renderer);
+    }
+    renderer->batch_used = false;
+
 #if DONT_DRAW_WHILE_HIDDEN
     // Don't present while we're hidden
     if (renderer->hidden) {
@@ -5450,7 +6058,11 @@ static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying)
 #endif
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas) {
+        RemoveTextureFromAtlas(texture, is_destroying);
+    } else {
+        renderer->DestroyTexture(renderer, texture);
+    }
 
     SDL_DestroySurface(texture->locked_surface);
     texture->locked_surface = NULL;
@@ -5540,6 +6152,7 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_free(renderer->vertex_data);
         renderer->vertex_data = NULL;
     }
+    FreeRenderBatch(renderer);
     if (renderer->texture_formats) {
         SDL_free(renderer->texture_formats);
         renderer->texture_formats = NULL;
@@ -5915,6 +6528,15 @@ bool SDL_SetDefaultTextureScaleMode(SDL_Renderer *renderer, SDL_ScaleMode scale_
 {
     CHECK_RENDERER_MAGIC(renderer, false);
 
+    switch (scale_mode) {
+    case SDL_SCALEMODE_NEAREST:
+    case SDL_SCALEMODE_LINEAR:
+    case SDL_SCALEMODE_PIXELART:
+        break;
+    default:
+        return SDL_InvalidParamError("scale_mode");
+    }
+
     renderer->scale_mode = scale_mode;
 
     return true;
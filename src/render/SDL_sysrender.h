@@ -46,6 +46,7 @@ typedef struct SDL_DRect
 // The SDL 2D rendering system
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
+typedef struct SDL_TextureAtlasPage SDL_TextureAtlasPage;
 
 // Rendering view state
 typedef struct SDL_RenderViewState
@@ -100,6 +101,10 @@ struct SDL_Texture
     SDL_Rect locked_rect;
     SDL_Surface *locked_surface; // Locked region exposed as a SDL surface
 
+    // Support for textures packed into a shared atlas page
+    SDL_TextureAtlasPage *atlas;
+    SDL_Rect atlas_rect;
+
     Uint32 last_command_generation; // last command queue generation this texture was in.
 
     SDL_PropertiesID props;
@@ -326,6 +331,17 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    // Scratch buffers for SDL_RenderTextures()
+    SDL_Vertex *batch_vertices;
+    int *batch_indices;
+    int batch_allocation;
+    bool batch_used;  // SDL_RenderTextures() was called since the last present
+
+    // Shared pages for textures created with SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN
+    SDL_TextureAtlasPage *atlas_pages;
+    SDL_Texture *atlas_last_texture;
+    Sint64 atlas_batches_saved;
+
     // Shaped window support
     bool transparent_window;
     SDL_Surface *shape_surface;
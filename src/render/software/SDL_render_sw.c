@@ -45,10 +45,70 @@ typedef struct
     SDL_Color color;
 } SW_DrawStateCache;
 
+// The target is split into tiles this size when drawing on more than one thread
+#define SW_TILE_SIZE 64
+
+// One queued command, or one rect or triangle of it, waiting to be drawn into every tile it touches
+typedef struct
+{
+    const SDL_RenderCommand *cmd;
+    void *verts;    // the first vertex to draw, with the viewport already applied
+    int count;      // the number of points, rects or triangle vertices to draw
+    SDL_Rect clip;  // where the command may draw, already clipped to the target
+    SDL_Color color;
+    Uint32 pixel;   // color, mapped for the target
+} SW_TileOp;
+
+typedef struct
+{
+    int *ops;
+    int num_ops;
+    int max_ops;
+} SW_TileBin;
+
+// The state a texture was prepared with by the ops waiting in the bins
+typedef struct
+{
+    SDL_Surface *surface;
+    SDL_Color color;
+    SDL_BlendMode blend;
+} SW_TileTexture;
+
+#define SW_MAX_TILE_TEXTURES 64
+
+// The areas of the window drawn since the last present are kept as this many non-overlapping rects at most
+#define SW_MAX_DIRTY_RECTS 8
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    // What the next present has to send to the window
+    bool present_all;
+    SDL_Rect dirty_rects[SW_MAX_DIRTY_RECTS];
+    int num_dirty_rects;
+
+    // Tiled drawing, see SDL_HINT_RENDER_SOFTWARE_THREADS
+    SDL_Thread **tile_threads;
+    int num_tile_threads;
+    SDL_Mutex *tile_lock;
+    SDL_Condition *tile_cond;
+    SDL_Condition *tile_done_cond;
+    Uint32 tile_generation;
+    int tile_active_workers;
+    bool tile_shutdown;
+    SDL_AtomicInt next_tile;
+    SDL_Surface *tile_target;
+    int tiles_x;
+    int tiles_y;
+    SW_TileBin *bins;
+    int max_bins;
+    SW_TileOp *ops;
+    int num_ops;
+    int max_ops;
+    SW_TileTexture textures[SW_MAX_TILE_TEXTURES];
+    int num_textures;
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -62,6 +122,7 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->present_all = true;
         }
     }
     return data->surface;
@@ -74,6 +135,9 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED) {
+        // The window system may have lost what we presented
+        data->present_all = true;
     }
 }
 
@@ -117,10 +181,13 @@ static bool SW_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_P
     SDL_SetSurfaceBlendMode(surface, texture->blendMode);
 
     /* Only RLE encode textures without an alpha channel since the RLE coder
-     * discards the color values of pixels with an alpha value of zero.
+     * only approximates alpha blending.
      */
     if (texture->access == SDL_TEXTUREACCESS_STATIC && !SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
         SDL_SetSurfaceRLE(surface, 1);
+    } else if (texture->access != SDL_TEXTUREACCESS_STATIC) {
+        // Streaming and target textures are written without locking the surface
+        SDL_SetSurfaceRLE(surface, 0);
     }
 
     return true;
@@ -150,7 +217,7 @@ static bool SW_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
         dst += surface->pitch;
     }
     if (SDL_MUSTLOCK(surface)) {
-        SDL_UnlockSurface(surface);
+        SDL_UnlockSurfaceRows(surface, rect->y, rect->h);
     }
     return true;
 }
@@ -350,7 +417,7 @@ static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Te
     src_clone = SDL_CreateSurfaceFrom(src->w, src->h, src->format, src->pixels, src->pitch);
     if (!src_clone) {
         if (SDL_MUSTLOCK(src)) {
-            SDL_UnlockSurface(src);
+            SDL_UnlockSurfaceRows(src, 0, 0);
         }
         return false;
     }
@@ -502,7 +569,7 @@ static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Te
     }
 
     if (SDL_MUSTLOCK(src)) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceRows(src, 0, 0);
     }
     if (mask) {
         SDL_DestroySurface(mask);
@@ -639,24 +706,29 @@ static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+static void GetDrawClipRect(const SW_DrawStateCache *drawstate, SDL_Rect *clip_rect)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
+
+    if (cliprect && viewport) {
+        clip_rect->x = cliprect->x + viewport->x;
+        clip_rect->y = cliprect->y + viewport->y;
+        clip_rect->w = cliprect->w;
+        clip_rect->h = cliprect->h;
+        SDL_GetRectIntersection(viewport, clip_rect, clip_rect);
+    } else {
+        *clip_rect = *viewport;
+    }
+}
+
 static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
-        const SDL_Rect *viewport = drawstate->viewport;
-        const SDL_Rect *cliprect = drawstate->cliprect;
-        SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
-
-        if (cliprect && viewport) {
-            SDL_Rect clip_rect;
-            clip_rect.x = cliprect->x + viewport->x;
-            clip_rect.y = cliprect->y + viewport->y;
-            clip_rect.w = cliprect->w;
-            clip_rect.h = cliprect->h;
-            SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
-        } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
-        }
+        SDL_Rect clip_rect;
+        GetDrawClipRect(drawstate, &clip_rect);
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = false;
     }
 }
@@ -667,47 +739,746 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 }
 
 
-static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+static void SW_RunCommand(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    switch (cmd->command) {
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+    {
+        drawstate->color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        break;
+    }
 
-    if (!SDL_SurfaceValid(surface)) {
-        return false;
+    case SDL_RENDERCMD_SETVIEWPORT:
+    {
+        drawstate->viewport = &cmd->data.viewport.rect;
+        drawstate->surface_cliprect_dirty = true;
+        break;
     }
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = true;
-    drawstate.color.r = 0;
-    drawstate.color.g = 0;
-    drawstate.color.b = 0;
-    drawstate.color.a = 0;
+    case SDL_RENDERCMD_SETCLIPRECT:
+    {
+        drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+        drawstate->surface_cliprect_dirty = true;
+        break;
+    }
 
-    while (cmd) {
-        switch (cmd->command) {
-        case SDL_RENDERCMD_SETDRAWCOLOR:
-        {
-            drawstate.color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+    case SDL_RENDERCMD_CLEAR:
+    {
+        const Uint8 r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        // By definition the clear ignores the clip rect
+        SDL_SetSurfaceClipRect(surface, NULL);
+        SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        drawstate->surface_cliprect_dirty = true;
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_Rect *srcrect = verts;
+        SDL_Rect *dstrect = verts + 1;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        SDL_Surface *src = (SDL_Surface *)texture->internal;
+
+        SetDrawState(surface, drawstate);
+
+        PrepTextureForCopy(cmd, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            dstrect->x += drawstate->viewport->x;
+            dstrect->y += drawstate->viewport->y;
+        }
+
+        if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
+            SDL_BlitSurface(src, srcrect, surface, dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+
+            // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
+            if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
+                SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
+                // Scale to an intermediate surface, then blit
+                if (tmp) {
+                    SDL_Rect r;
+                    SDL_BlendMode blendmode;
+                    Uint8 alphaMod, rMod, gMod, bMod;
+
+                    SDL_GetSurfaceBlendMode(src, &blendmode);
+                    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+                    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+                    r.x = 0;
+                    r.y = 0;
+                    r.w = dstrect->w;
+                    r.h = dstrect->h;
+
+                    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                    SDL_SetSurfaceAlphaMod(src, 255);
+
+                    SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, cmd->data.draw.texture_scale_mode);
+
+                    SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
+                    SDL_SetSurfaceAlphaMod(tmp, alphaMod);
+                    SDL_SetSurfaceBlendMode(tmp, blendmode);
+
+                    SDL_BlitSurface(tmp, NULL, surface, dstrect);
+                    SDL_DestroySurface(tmp);
+                    // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
+                }
+            } else {
+                SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, cmd->data.draw.texture_scale_mode);
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY_EX:
+    {
+        CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        SetDrawState(surface, drawstate);
+        PrepTextureForCopy(cmd, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            copydata->dstrect.x += drawstate->viewport->x;
+            copydata->dstrect.y += drawstate->viewport->y;
+        }
+
+        SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+                        &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                        copydata->scale_x, copydata->scale_y, cmd->data.draw.texture_scale_mode);
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        int i;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const int count = (int)cmd->data.draw.count;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+
+        SetDrawState(surface, drawstate);
+
+        if (texture) {
+            SDL_Surface *src = (SDL_Surface *)texture->internal;
+
+            GeometryCopyData *ptr = (GeometryCopyData *)verts;
+
+            PrepTextureForCopy(cmd, drawstate);
+
+            // Apply viewport
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_BlitTriangle(
+                    src,
+                    &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
+                    surface,
+                    &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                    ptr[0].color, ptr[1].color, ptr[2].color,
+                    cmd->data.draw.texture_address_mode_u,
+                    cmd->data.draw.texture_address_mode_v,
+                    NULL);
+            }
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)verts;
+
+            // Apply viewport
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color, NULL);
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_NO_OP:
+        break;
+    }
+}
+
+static void DrawTilePoints(SDL_Surface *surface, const SW_TileOp *op, const SDL_Point *points, int count)
+{
+    const SDL_BlendMode blend = op->cmd->data.draw.blend;
+
+    if (blend == SDL_BLENDMODE_NONE) {
+        SDL_DrawPoints(surface, points, count, op->pixel);
+    } else {
+        SDL_BlendPoints(surface, points, count, blend, op->color.r, op->color.g, op->color.b, op->color.a);
+    }
+}
+
+// Draw the part of an op that's inside one tile. The target's own clip rect must cover the whole surface.
+static void DrawTileOp(SDL_Surface *surface, const SW_TileOp *op, const SDL_Rect *tile)
+{
+    const SDL_RenderCommand *cmd = op->cmd;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    SDL_Rect clip;
+    int i;
+
+    if (!SDL_GetRectIntersection(&op->clip, tile, &clip)) {
+        return;
+    }
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_CLEAR:
+    {
+        SDL_FillSurfaceRect(surface, &clip, op->pixel);
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        const SDL_Point *points = (const SDL_Point *)op->verts;
+        SDL_Point visible[64];
+        int num_visible = 0;
+
+        for (i = 0; i < op->count; i++) {
+            if (SDL_PointInRect(&points[i], &clip)) {
+                visible[num_visible++] = points[i];
+                if (num_visible == SDL_arraysize(visible)) {
+                    DrawTilePoints(surface, op, visible, num_visible);
+                    num_visible = 0;
+                }
+            }
+        }
+        if (num_visible > 0) {
+            DrawTilePoints(surface, op, visible, num_visible);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)op->verts;
+        SDL_Rect rect;
+
+        for (i = 0; i < op->count; i++) {
+            if (SDL_GetRectIntersection(&rects[i], &clip, &rect)) {
+                if (blend == SDL_BLENDMODE_NONE) {
+                    SDL_FillSurfaceRect(surface, &rect, op->pixel);
+                } else {
+                    SDL_BlendFillRect(surface, &rect, blend, op->color.r, op->color.g, op->color.b, op->color.a);
+                }
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        // This is the clipping SDL_BlitSurface() does, with the tile instead of the target's clip rect
+        const SDL_Rect *srcrect = (const SDL_Rect *)op->verts;
+        const SDL_Rect *dstrect = srcrect + 1;
+        SDL_Surface *src = (SDL_Surface *)cmd->data.draw.texture->internal;
+        SDL_Rect full_rect, r_src, r_dst, rect;
+
+        full_rect.x = 0;
+        full_rect.y = 0;
+        full_rect.w = src->w;
+        full_rect.h = src->h;
+        if (!SDL_GetRectIntersection(srcrect, &full_rect, &r_src)) {
             break;
         }
+        r_dst.x = dstrect->x + (r_src.x - srcrect->x);
+        r_dst.y = dstrect->y + (r_src.y - srcrect->y);
+        r_dst.w = r_src.w;
+        r_dst.h = r_src.h;
 
-        case SDL_RENDERCMD_SETVIEWPORT:
-        {
-            drawstate.viewport = &cmd->data.viewport.rect;
-            drawstate.surface_cliprect_dirty = true;
+        if (!SDL_GetRectIntersection(&r_dst, &clip, &rect)) {
             break;
         }
+        r_src.x += rect.x - r_dst.x;
+        r_src.y += rect.y - r_dst.y;
+        r_src.w = rect.w;
+        r_src.h = rect.h;
 
-        case SDL_RENDERCMD_SETCLIPRECT:
-        {
-            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-            drawstate.surface_cliprect_dirty = true;
+        // The map was validated when the op was queued
+        src->map.blit(src, &r_src, surface, &rect);
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        SDL_Texture *texture = cmd->data.draw.texture;
+
+        if (texture) {
+            SDL_Surface *src = (SDL_Surface *)texture->internal;
+            GeometryCopyData *ptr = (GeometryCopyData *)op->verts;
+
+            for (i = 0; i < op->count; i += 3, ptr += 3) {
+                // SDL_SW_BlitTriangle() adjusts the texture coordinates, so every tile needs its own copy
+                SDL_Point s0 = ptr[0].src;
+                SDL_Point s1 = ptr[1].src;
+                SDL_Point s2 = ptr[2].src;
+
+                SDL_SW_BlitTriangle(
+                    src,
+                    &s0, &s1, &s2,
+                    surface,
+                    &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                    ptr[0].color, ptr[1].color, ptr[2].color,
+                    cmd->data.draw.texture_address_mode_u,
+                    cmd->data.draw.texture_address_mode_v,
+                    &clip);
+            }
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)op->verts;
+
+            for (i = 0; i < op->count; i += 3, ptr += 3) {
+                SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color, &clip);
+            }
+        }
+        break;
+    }
+
+    default:
+        SDL_assert(!"Unexpected tiled render command");
+        break;
+    }
+}
+
+// next_tile is parked here between batches, so a worker that wakes up late doesn't find anything to do
+#define SW_NO_MORE_TILES (SDL_MAX_SINT32 / 2)
+
+static void DrawTiles(SW_RenderData *data)
+{
+    while (true) {
+        const int tile = SDL_AddAtomicInt(&data->next_tile, 1);
+        const SW_TileBin *bin;
+        SDL_Rect rect;
+        int i;
+
+        // The tile count is only safe to look at once we know there's a batch running
+        if (tile >= data->tiles_x * data->tiles_y) {
+            break;
+        }
+
+        bin = &data->bins[tile];
+        rect.x = (tile % data->tiles_x) * SW_TILE_SIZE;
+        rect.y = (tile / data->tiles_x) * SW_TILE_SIZE;
+        rect.w = SW_TILE_SIZE;
+        rect.h = SW_TILE_SIZE;
+        for (i = 0; i < bin->num_ops; i++) {
+            DrawTileOp(data->tile_target, &data->ops[bin->ops[i]], &rect);
+        }
+    }
+}
+
+static int SDLCALL SW_TileThread(void *ptr)
+{
+    SW_RenderData *data = (SW_RenderData *)ptr;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(data->tile_lock);
+    while (!data->tile_shutdown) {
+        if (data->tile_generation == generation) {
+            SDL_WaitCondition(data->tile_cond, data->tile_lock);
+            continue;
+        }
+        generation = data->tile_generation;
+
+        data->tile_active_workers++;
+        SDL_UnlockMutex(data->tile_lock);
+
+        DrawTiles(data);
+
+        SDL_LockMutex(data->tile_lock);
+        if (--data->tile_active_workers == 0) {
+            SDL_BroadcastCondition(data->tile_done_cond);
+        }
+    }
+    SDL_UnlockMutex(data->tile_lock);
+    return 0;
+}
+
+static void StartTileThreads(SW_RenderData *data)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    const int num_threads = hint ? SDL_clamp(SDL_atoi(hint), 0, 64) : 0;
+    if (num_threads == 0) {
+        return;
+    }
+
+    data->tile_lock = SDL_CreateMutex();
+    data->tile_cond = SDL_CreateCondition();
+    data->tile_done_cond = SDL_CreateCondition();
+    data->tile_threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(SDL_Thread *));
+    SDL_SetAtomicInt(&data->next_tile, SW_NO_MORE_TILES);
+    if (!data->tile_lock || !data->tile_cond || !data->tile_done_cond || !data->tile_threads) {
+        return;  // we'll clean up in StopTileThreads. Not fatal, we'll just draw everything on one thread.
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        char name[64];
+        SDL_snprintf(name, sizeof(name), "SDLRenderTile%d", i);
+        data->tile_threads[i] = SDL_CreateThread(SW_TileThread, name, data);
+        if (!data->tile_threads[i]) {
+            break;
+        }
+        data->num_tile_threads++;
+    }
+}
+
+static void StopTileThreads(SW_RenderData *data)
+{
+    int i;
+
+    if (data->tile_lock) {
+        SDL_LockMutex(data->tile_lock);
+        data->tile_shutdown = true;
+        SDL_BroadcastCondition(data->tile_cond);
+        SDL_UnlockMutex(data->tile_lock);
+    }
+
+    for (i = 0; i < data->num_tile_threads; ++i) {
+        SDL_WaitThread(data->tile_threads[i], NULL);
+    }
+
+    for (i = 0; i < data->max_bins; ++i) {
+        SDL_free(data->bins[i].ops);
+    }
+    SDL_free(data->bins);
+    SDL_free(data->ops);
+    SDL_free(data->tile_threads);
+    SDL_DestroyCondition(data->tile_done_cond);
+    SDL_DestroyCondition(data->tile_cond);
+    SDL_DestroyMutex(data->tile_lock);
+}
+
+// Draw everything that's been binned so far, on all threads, and wait for it to finish
+static void FlushTiles(SW_RenderData *data)
+{
+    int i;
+
+    data->num_textures = 0;
+    if (data->num_ops == 0) {
+        return;
+    }
+
+    SDL_SetSurfaceClipRect(data->tile_target, NULL);
+    SDL_SetAtomicInt(&data->next_tile, 0);
+
+    SDL_LockMutex(data->tile_lock);
+    data->tile_generation++;
+    SDL_BroadcastCondition(data->tile_cond);
+    SDL_UnlockMutex(data->tile_lock);
+
+    DrawTiles(data);
+
+    SDL_LockMutex(data->tile_lock);
+    while (data->tile_active_workers > 0) {
+        SDL_WaitCondition(data->tile_done_cond, data->tile_lock);
+    }
+    SDL_UnlockMutex(data->tile_lock);
+    SDL_SetAtomicInt(&data->next_tile, SW_NO_MORE_TILES);
+
+    for (i = 0; i < data->tiles_x * data->tiles_y; ++i) {
+        data->bins[i].num_ops = 0;
+    }
+    data->num_ops = 0;
+}
+
+static bool AddOpToBin(SW_TileBin *bin, int index)
+{
+    if (bin->num_ops == bin->max_ops) {
+        const int max_ops = bin->max_ops ? (bin->max_ops * 2) : 16;
+        int *ops = (int *)SDL_realloc(bin->ops, max_ops * sizeof(*ops));
+        if (!ops) {
+            return false;
+        }
+        bin->ops = ops;
+        bin->max_ops = max_ops;
+    }
+    bin->ops[bin->num_ops++] = index;
+    return true;
+}
+
+static bool BinTileOp(SW_RenderData *data, const SW_TileOp *op, const SDL_Rect *area)
+{
+    const int index = data->num_ops;
+    const int x0 = area->x / SW_TILE_SIZE;
+    const int y0 = area->y / SW_TILE_SIZE;
+    const int x1 = (area->x + area->w - 1) / SW_TILE_SIZE;
+    const int y1 = (area->y + area->h - 1) / SW_TILE_SIZE;
+    int x, y;
+
+    if (data->num_ops == data->max_ops) {
+        const int max_ops = data->max_ops ? (data->max_ops * 2) : 256;
+        SW_TileOp *ops = (SW_TileOp *)SDL_realloc(data->ops, max_ops * sizeof(*ops));
+        if (!ops) {
+            return false;
+        }
+        data->ops = ops;
+        data->max_ops = max_ops;
+    }
+    data->ops[index] = *op;
+
+    for (y = y0; y <= y1; ++y) {
+        for (x = x0; x <= x1; ++x) {
+            if (!AddOpToBin(&data->bins[y * data->tiles_x + x], index)) {
+                // Take it back out of the bins it already went into
+                for (y = y0; y <= y1; ++y) {
+                    for (x = x0; x <= x1; ++x) {
+                        SW_TileBin *bin = &data->bins[y * data->tiles_x + x];
+                        if (bin->num_ops > 0 && bin->ops[bin->num_ops - 1] == index) {
+                            bin->num_ops--;
+                        }
+                    }
+                }
+                return false;
+            }
+        }
+    }
+    data->num_ops++;
+    return true;
+}
+
+// Queue an op that can only touch pixels inside bounds
+static void QueueTileOp(SW_RenderData *data, const SW_TileOp *op, const SDL_Rect *bounds)
+{
+    SDL_Rect area;
+
+    if (!SDL_GetRectIntersection(bounds, &op->clip, &area)) {
+        return;  // it can't draw anything
+    }
+
+    if (!BinTileOp(data, op, &area)) {
+        // Out of memory, draw everything up to here, then this, on this thread
+        SDL_Rect full_rect;
+        FlushTiles(data);
+        full_rect.x = 0;
+        full_rect.y = 0;
+        full_rect.w = data->tile_target->w;
+        full_rect.h = data->tile_target->h;
+        SDL_SetSurfaceClipRect(data->tile_target, NULL);
+        DrawTileOp(data->tile_target, op, &full_rect);
+    }
+}
+
+// Prepare a texture for a command without changing the state that binned ops will draw it with
+static void PrepTileTexture(SW_RenderData *data, const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+{
+    SDL_Surface *surface = (SDL_Surface *)cmd->data.draw.texture->internal;
+    const SDL_Color color = drawstate->color;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    SW_TileTexture *texture;
+    int i;
+
+    for (i = 0; i < data->num_textures; ++i) {
+        texture = &data->textures[i];
+        if (texture->surface == surface) {
+            if (texture->blend == blend &&
+                texture->color.r == color.r && texture->color.g == color.g &&
+                texture->color.b == color.b && texture->color.a == color.a) {
+                return;  // already prepared this way
+            }
+            FlushTiles(data);
             break;
         }
+    }
+
+    if (data->num_textures == SW_MAX_TILE_TEXTURES) {
+        FlushTiles(data);
+    }
+    texture = &data->textures[data->num_textures++];
+    texture->surface = surface;
+    texture->color = color;
+    texture->blend = blend;
+
+    PrepTextureForCopy(cmd, drawstate);
+}
+
+static void GetTileClipRect(SDL_Surface *surface, const SW_DrawStateCache *drawstate, SDL_Rect *clip_rect)
+{
+    SDL_Rect full_rect;
+
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = surface->w;
+    full_rect.h = surface->h;
+    GetDrawClipRect(drawstate, clip_rect);
+    if (!SDL_GetRectIntersection(clip_rect, &full_rect, clip_rect)) {
+        SDL_zerop(clip_rect);
+    }
+}
+
+static bool PrepareTiles(SW_RenderData *data, SDL_Surface *surface)
+{
+    const int tiles_x = (surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    const int tiles_y = (surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+
+    if (data->num_tile_threads == 0) {
+        return false;
+    }
+
+    // Tiles have to be able to write their pixels without locking the target or touching their neighbors' bytes
+    if (SDL_MUSTLOCK(surface) || (surface->flags & SDL_SURFACE_LOCKED) || SDL_BITSPERPIXEL(surface->format) < 8) {
+        return false;
+    }
+
+    if (tiles_x * tiles_y > data->max_bins) {
+        SW_TileBin *bins = (SW_TileBin *)SDL_realloc(data->bins, tiles_x * tiles_y * sizeof(*bins));
+        if (!bins) {
+            return false;
+        }
+        SDL_memset(bins + data->max_bins, 0, (tiles_x * tiles_y - data->max_bins) * sizeof(*bins));
+        data->bins = bins;
+        data->max_bins = tiles_x * tiles_y;
+    }
+
+    data->tile_target = surface;
+    data->tiles_x = tiles_x;
+    data->tiles_y = tiles_y;
+    return true;
+}
+
+/* Bin the commands that can be split exactly along tile edges, and draw them
+ * a batch at a time on the tile threads. Anything else ends the batch and is
+ * drawn the usual way on this thread. Every tile draws its ops in queue order,
+ * so the result is the same as drawing the commands one after another.
+ */
+static void SW_RunCommandQueueTiled(SDL_Renderer *renderer, SW_RenderData *data, SDL_Surface *surface,
+                                    SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
+{
+    SDL_Rect full_rect;
+    SW_TileOp op;
+    int i;
+
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = surface->w;
+    full_rect.h = surface->h;
+
+    while (cmd) {
+        bool tiled = false;
+
+        SDL_zero(op);
+        op.cmd = cmd;
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_NO_OP:
+            SW_RunCommand(renderer, surface, cmd, vertices, drawstate);
+            tiled = true;
+            break;
 
         case SDL_RENDERCMD_CLEAR:
         {
@@ -716,93 +1487,66 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
             const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
             // By definition the clear ignores the clip rect
-            SDL_SetSurfaceClipRect(surface, NULL);
-            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            drawstate.surface_cliprect_dirty = true;
+            op.clip = full_rect;
+            op.pixel = SDL_MapSurfaceRGBA(surface, r, g, b, a);
+            QueueTileOp(data, &op, &full_rect);
+            tiled = true;
             break;
         }
 
         case SDL_RENDERCMD_DRAW_POINTS:
         {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
             const int count = (int)cmd->data.draw.count;
             SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+            SDL_Rect bounds;
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+            if (count <= 0) {
+                tiled = true;
+                break;
             }
-            break;
-        }
-
-        case SDL_RENDERCMD_DRAW_LINES:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    verts[i].x += drawstate->viewport->x;
+                    verts[i].y += drawstate->viewport->y;
                 }
             }
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-            }
+            SDL_GetRectEnclosingPoints(verts, count, NULL, &bounds);
+
+            op.verts = verts;
+            op.count = count;
+            GetTileClipRect(surface, drawstate, &op.clip);
+            op.color = drawstate->color;
+            op.pixel = SDL_MapSurfaceRGBA(surface, op.color.r, op.color.g, op.color.b, op.color.a);
+            QueueTileOp(data, &op, &bounds);
+            tiled = true;
             break;
         }
 
         case SDL_RENDERCMD_FILL_RECTS:
         {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
             const int count = (int)cmd->data.draw.count;
             SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    verts[i].x += drawstate->viewport->x;
+                    verts[i].y += drawstate->viewport->y;
                 }
             }
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+            op.count = 1;
+            GetTileClipRect(surface, drawstate, &op.clip);
+            op.color = drawstate->color;
+            op.pixel = SDL_MapSurfaceRGBA(surface, op.color.r, op.color.g, op.color.b, op.color.a);
+            for (i = 0; i < count; i++) {
+                op.verts = &verts[i];
+                QueueTileOp(data, &op, &verts[i]);
             }
+            tiled = true;
             break;
         }
 
@@ -811,148 +1555,337 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_Rect *srcrect = verts;
             SDL_Rect *dstrect = verts + 1;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->internal;
+            SDL_Surface *src = (SDL_Surface *)cmd->data.draw.texture->internal;
 
-            SetDrawState(surface, &drawstate);
+            if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+                break;  // scaled copies aren't split along tile edges exactly
+            }
 
-            PrepTextureForCopy(cmd, &drawstate);
+            PrepTileTexture(data, cmd, drawstate);
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
+            // Switch back to a fast blit if we were previously stretching, like SDL_BlitSurface() does
+            if (src->map.info.flags & SDL_COPY_NEAREST) {
+                src->map.info.flags &= ~SDL_COPY_NEAREST;
+                SDL_InvalidateMap(&src->map);
             }
-
-            if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
-                SDL_BlitSurface(src, srcrect, surface, dstrect);
-            } else {
-                /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                 * to avoid potentially frequent RLE encoding/decoding.
-                 */
-                SDL_SetSurfaceRLE(surface, 0);
-
-                // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
-                if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                    SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                    // Scale to an intermediate surface, then blit
-                    if (tmp) {
-                        SDL_Rect r;
-                        SDL_BlendMode blendmode;
-                        Uint8 alphaMod, rMod, gMod, bMod;
-
-                        SDL_GetSurfaceBlendMode(src, &blendmode);
-                        SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                        SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                        r.x = 0;
-                        r.y = 0;
-                        r.w = dstrect->w;
-                        r.h = dstrect->h;
-
-                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                        SDL_SetSurfaceAlphaMod(src, 255);
-
-                        SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, cmd->data.draw.texture_scale_mode);
-
-                        SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                        SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                        SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                        SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                        SDL_DestroySurface(tmp);
-                        // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
-                    }
-                } else {
-                    SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, cmd->data.draw.texture_scale_mode);
-                }
+            if ((src->flags & SDL_SURFACE_LOCKED) || !SDL_ValidateMap(src, surface)) {
+                break;
+            }
+            if (SDL_MUSTLOCK(src) && !(src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
+                break;  // the blit would lock the texture
             }
-            break;
-        }
-
-        case SDL_RENDERCMD_COPY_EX:
-        {
-            CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                dstrect->x += drawstate->viewport->x;
+                dstrect->y += drawstate->viewport->y;
             }
 
-            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
-                            copydata->scale_x, copydata->scale_y, cmd->data.draw.texture_scale_mode);
+            op.verts = verts;
+            op.count = 1;
+            GetTileClipRect(surface, drawstate, &op.clip);
+            QueueTileOp(data, &op, dstrect);
+            tiled = true;
             break;
         }
 
         case SDL_RENDERCMD_GEOMETRY:
         {
-            int i;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
             const int count = (int)cmd->data.draw.count;
             SDL_Texture *texture = cmd->data.draw.texture;
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-
-            SetDrawState(surface, &drawstate);
+            SDL_Point vp;
+            SDL_Rect bounds;
 
             if (texture) {
                 SDL_Surface *src = (SDL_Surface *)texture->internal;
 
-                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                PrepTileTexture(data, cmd, drawstate);
+                if (SDL_MUSTLOCK(src) || (src->flags & SDL_SURFACE_LOCKED)) {
+                    break;  // drawing would lock the texture
+                }
+            }
+
+            vp.x = drawstate->viewport ? drawstate->viewport->x : 0;
+            vp.y = drawstate->viewport ? drawstate->viewport->y : 0;
+            trianglepoint_2_fixedpoint(&vp);
 
-                PrepTextureForCopy(cmd, &drawstate);
+            op.count = 3;
+            GetTileClipRect(surface, drawstate, &op.clip);
+            if (texture) {
+                GeometryCopyData *ptr = (GeometryCopyData *)verts;
 
                 // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
                 }
-
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_BlitTriangle(
-                        src,
-                        &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
-                        surface,
-                        &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
-                        ptr[0].color, ptr[1].color, ptr[2].color,
-                        cmd->data.draw.texture_address_mode_u,
-                        cmd->data.draw.texture_address_mode_v);
+                for (i = 0; i + 3 <= count; i += 3, ptr += 3) {
+                    op.verts = ptr;
+                    SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &bounds);
+                    QueueTileOp(data, &op, &bounds);
                 }
             } else {
                 GeometryFillData *ptr = (GeometryFillData *)verts;
 
                 // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
                 }
+                for (i = 0; i + 3 <= count; i += 3, ptr += 3) {
+                    op.verts = ptr;
+                    SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &bounds);
+                    QueueTileOp(data, &op, &bounds);
+                }
+            }
+            tiled = true;
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        if (!tiled) {
+            // Lines, scaled and rotated copies, and anything that has to lock a texture are drawn in order on this thread
+            FlushTiles(data);
+            drawstate->surface_cliprect_dirty = true;
+            SW_RunCommand(renderer, surface, cmd, vertices, drawstate);
+        }
+
+        cmd = cmd->next;
+    }
+
+    FlushTiles(data);
+}
+
+
+// Take the dirty rects that overlap a new one out of the list and merge them into it, so no pixel is presented twice
+static void MergeDirtyRects(SW_RenderData *data, SDL_Rect *dirty)
+{
+    int i = 0;
+
+    while (i < data->num_dirty_rects) {
+        if (SDL_HasRectIntersection(dirty, &data->dirty_rects[i])) {
+            SDL_GetRectUnion(dirty, &data->dirty_rects[i], dirty);
+            data->dirty_rects[i] = data->dirty_rects[--data->num_dirty_rects];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Add an area that will be drawn to the ones the next present sends to the window
+static void AddDirtyRect(SW_RenderData *data, const SDL_Rect *rect, const SDL_Rect *clip)
+{
+    SDL_Rect dirty;
+    int i;
+
+    if (!SDL_GetRectIntersection(rect, clip, &dirty)) {
+        return;
+    }
+
+    MergeDirtyRects(data, &dirty);
+
+    if (data->num_dirty_rects == SW_MAX_DIRTY_RECTS) {
+        // Out of room, merge it with the rect that grows the least
+        Sint64 best_growth = SDL_MAX_SINT64;
+        int best = 0;
+
+        for (i = 0; i < data->num_dirty_rects; ++i) {
+            const SDL_Rect *other = &data->dirty_rects[i];
+            SDL_Rect merged;
+            Sint64 growth;
+
+            SDL_GetRectUnion(&dirty, other, &merged);
+            growth = (Sint64)merged.w * merged.h - (Sint64)dirty.w * dirty.h - (Sint64)other->w * other->h;
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        SDL_GetRectUnion(&dirty, &data->dirty_rects[best], &dirty);
+        data->dirty_rects[best] = data->dirty_rects[--data->num_dirty_rects];
+
+        // The bigger rect might overlap others now
+        MergeDirtyRects(data, &dirty);
+    }
+
+    data->dirty_rects[data->num_dirty_rects++] = dirty;
+}
+
+/* Work out which parts of the window the commands are going to draw, before
+ * they're run and the viewport is applied to their vertices. The bounds are
+ * the same ones the commands clip themselves to, so nothing drawn is missed.
+ */
+static void SW_TrackDirtyRects(SW_RenderData *data, SDL_Surface *surface, const SDL_RenderCommand *cmd, const void *vertices)
+{
+    SW_DrawStateCache drawstate;
+    SDL_Rect clip, bounds;
+    int vp_x = 0, vp_y = 0;
+    int i;
+
+    SDL_zero(drawstate);
+
+    for (; cmd && !data->present_all; cmd = cmd->next) {
+        const void *verts = ((const Uint8 *)vertices) + cmd->data.draw.first;
+        const int count = (int)cmd->data.draw.count;
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+            drawstate.viewport = &cmd->data.viewport.rect;
+            vp_x = drawstate.viewport->x;
+            vp_y = drawstate.viewport->y;
+            continue;
+
+        case SDL_RENDERCMD_SETCLIPRECT:
+            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            continue;
+
+        case SDL_RENDERCMD_CLEAR:
+            // This covers the whole window, there's nothing more to track
+            data->present_all = true;
+            continue;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            break;
+
+        default:
+            continue;
+        }
+
+        if (!drawstate.viewport) {
+            continue;  // the higher level always sets a viewport before drawing
+        }
+        GetTileClipRect(surface, &drawstate, &clip);
+        if (SDL_RectEmpty(&clip)) {
+            continue;
+        }
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+            if (count > 0 && SDL_GetRectEnclosingPoints((const SDL_Point *)verts, count, NULL, &bounds)) {
+                bounds.x += vp_x;
+                bounds.y += vp_y;
+                AddDirtyRect(data, &bounds, &clip);
+            }
+            break;
+
+        case SDL_RENDERCMD_FILL_RECTS:
+        {
+            const SDL_Rect *rects = (const SDL_Rect *)verts;
+            for (i = 0; i < count; ++i) {
+                bounds = rects[i];
+                bounds.x += vp_x;
+                bounds.y += vp_y;
+                AddDirtyRect(data, &bounds, &clip);
+            }
+            break;
+        }
 
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+        case SDL_RENDERCMD_COPY:
+            bounds = ((const SDL_Rect *)verts)[1];
+            bounds.x += vp_x;
+            bounds.y += vp_y;
+            AddDirtyRect(data, &bounds, &clip);
+            break;
+
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            // This is where SW_RenderCopyEx() puts the rotated texture
+            const CopyExData *copydata = (const CopyExData *)verts;
+            SDL_Rect rotated;
+            double cangle, sangle;
+
+            SDLgfx_rotozoomSurfaceSizeTrig(copydata->dstrect.w, copydata->dstrect.h, copydata->angle, &copydata->center,
+                                           &rotated, &cangle, &sangle);
+            bounds.x = copydata->dstrect.x + vp_x + rotated.x;
+            bounds.y = copydata->dstrect.y + vp_y + rotated.y;
+            bounds.w = rotated.w;
+            bounds.h = rotated.h;
+            if (copydata->scale_x != 1.0f || copydata->scale_y != 1.0f) {
+                bounds.x = (int)((float)bounds.x * copydata->scale_x);
+                bounds.y = (int)((float)bounds.y * copydata->scale_y);
+                bounds.w = (int)((float)bounds.w * copydata->scale_x);
+                bounds.h = (int)((float)bounds.h * copydata->scale_y);
+            }
+            AddDirtyRect(data, &bounds, &clip);
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            SDL_Rect triangle;
+            bool empty = true;
+
+            // The triangles of one command are usually close together, so they're tracked as one area
+            for (i = 0; i + 3 <= count; i += 3) {
+                if (cmd->data.draw.texture) {
+                    const GeometryCopyData *ptr = (const GeometryCopyData *)verts + i;
+                    SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &triangle);
+                } else {
+                    const GeometryFillData *ptr = (const GeometryFillData *)verts + i;
+                    SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &triangle);
+                }
+                if (empty) {
+                    bounds = triangle;
+                    empty = false;
+                } else {
+                    SDL_GetRectUnion(&bounds, &triangle, &bounds);
                 }
             }
+            if (!empty) {
+                bounds.x += vp_x;
+                bounds.y += vp_y;
+                AddDirtyRect(data, &bounds, &clip);
+            }
             break;
         }
 
-        case SDL_RENDERCMD_NO_OP:
+        default:
             break;
         }
+    }
+}
+
+
+static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return false;
+    }
+
+    if (surface == data->window && renderer->window) {
+        SW_TrackDirtyRects(data, surface, cmd, vertices);
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = true;
+    drawstate.color.r = 0;
+    drawstate.color.g = 0;
+    drawstate.color.b = 0;
+    drawstate.color.a = 0;
+
+    if (PrepareTiles(data, surface)) {
+        SW_RunCommandQueueTiled(renderer, data, surface, cmd, vertices, &drawstate);
+        return true;
+    }
+
+    while (cmd) {
+        SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
 
         cmd = cmd->next;
     }
@@ -988,12 +1921,35 @@ static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
 
 static bool SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Window *window = renderer->window;
+    Sint64 presented = 0;
+    bool result;
+    int i;
 
     if (!window) {
         return false;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    if (data->present_all || !data->window) {
+        result = SDL_UpdateWindowSurface(window);
+        if (data->window) {
+            presented = (Sint64)data->window->w * data->window->h;
+        }
+    } else {
+        // Only send what was drawn since the last present, the window still has the rest
+        result = SDL_UpdateWindowSurfaceRects(window, data->dirty_rects, data->num_dirty_rects);
+        for (i = 0; i < data->num_dirty_rects; ++i) {
+            presented += (Sint64)data->dirty_rects[i].w * data->dirty_rects[i].h;
+        }
+    }
+    if (result) {
+        data->present_all = false;
+        data->num_dirty_rects = 0;
+    }
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_SOFTWARE_PRESENTED_PIXELS_NUMBER, presented);
+
+    return result;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -1008,6 +1964,7 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     SDL_Window *window = renderer->window;
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
+    StopTileThreads(data);
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
@@ -1125,6 +2082,8 @@ bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, S
     }
     data->surface = surface;
     data->window = surface;
+    data->present_all = true;
+    StartTileThreads(data);
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -149,6 +149,11 @@ static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, con
     r->h = (max_y - min_y) >> FP_BITS;
 }
 
+void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect)
+{
+    bounding_rect_fixedpoint(d0, d1, d2, rect);
+}
+
 // bounding rect of three points
 static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
@@ -186,25 +191,21 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
 #define TRIANGLE_GET_TEXTCOORD                                                          \
     int srcx = (int)(((Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x) / area); \
     int srcy = (int)(((Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y) / area); \
-    if (texture_address_mode_u == SDL_TEXTURE_ADDRESS_WRAP) {                           \
-        srcx %= src_surface->w;                                                         \
-        if (srcx < 0) {                                                                 \
-            srcx += (src_surface->w - 1);                                               \
-        }                                                                               \
-    }                                                                                   \
-    if (texture_address_mode_v == SDL_TEXTURE_ADDRESS_WRAP) {                           \
-        srcy %= src_surface->h;                                                         \
-        if (srcy < 0) {                                                                 \
-            srcy += (src_surface->h - 1);                                               \
-        }                                                                               \
-    }
-
-#define TRIANGLE_GET_MAPPED_COLOR                                                      \
-    Uint8 r = (Uint8)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    Uint8 g = (Uint8)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    Uint8 b = (Uint8)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    Uint8 a = (Uint8)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area); \
-    Uint32 color = SDL_MapRGBA(format, palette, r, g, b, a);
+    TRIANGLE_WRAP_TEXTCOORD
+
+#define TRIANGLE_WRAP_TEXTCOORD                                 \
+    if (texture_address_mode_u == SDL_TEXTURE_ADDRESS_WRAP) {   \
+        srcx %= src_surface->w;                                 \
+        if (srcx < 0) {                                         \
+            srcx += (src_surface->w - 1);                       \
+        }                                                       \
+    }                                                           \
+    if (texture_address_mode_v == SDL_TEXTURE_ADDRESS_WRAP) {   \
+        srcy %= src_surface->h;                                 \
+        if (srcy < 0) {                                         \
+            srcy += (src_surface->h - 1);                       \
+        }                                                       \
+    }
 
 #define TRIANGLE_GET_COLOR                                                             \
     int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
@@ -227,7 +228,357 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     }                     \
     }
 
-bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
+/* Restrict [*first, *last] to the pixels where the edge function w + x * step is not negative.
+ * This is the same test TRIANGLE_BEGIN_LOOP does for each pixel, done once per row.
+ */
+static SDL_INLINE bool clip_span_edge(Sint64 w, int step, int *first, int *last)
+{
+    if (step > 0) {
+        if (w < 0) {
+            const Sint64 x = (-w + step - 1) / step;
+            if (x > *last) {
+                return false;
+            }
+            if (x > *first) {
+                *first = (int)x;
+            }
+        }
+    } else if (step < 0) {
+        const Sint64 x = (w < 0) ? -1 : (w / -step);
+        if (x < *first) {
+            return false;
+        }
+        if (x < *last) {
+            *last = (int)x;
+        }
+    } else if (w < 0) {
+        return false;
+    }
+    return *first <= *last;
+}
+
+/* Walks the rows of the bounding rect, and only runs the body on the span
+ * of pixels inside the triangle: [x_first, x_first + count)
+ */
+#define TRIANGLE_BEGIN_SPAN_LOOP                                                 \
+    {                                                                            \
+        int y;                                                                   \
+        for (y = 0; y < dstrect.h; y++, w0_row += d1d2_x, w1_row += d2d0_x,      \
+                                   w2_row += d0d1_x, dst_ptr += dst_pitch) {     \
+            int x_first = 0;                                                     \
+            int x_last = dstrect.w - 1;                                          \
+            int count;                                                           \
+            Uint8 *dptr;                                                         \
+            if (!clip_span_edge(w0_row + bias_w0, d2d1_y, &x_first, &x_last) ||  \
+                !clip_span_edge(w1_row + bias_w1, d0d2_y, &x_first, &x_last) ||  \
+                !clip_span_edge(w2_row + bias_w2, d1d0_y, &x_first, &x_last)) {  \
+                continue;                                                        \
+            }                                                                    \
+            count = x_last - x_first + 1;                                        \
+            dptr = (Uint8 *)dst_ptr + x_first * dstbpp;
+
+#define TRIANGLE_END_SPAN_LOOP \
+    }                          \
+    }
+
+// Barycentric weights of the first pixel of the span
+#define TRIANGLE_SPAN_W0 (w0_row + (Sint64)x_first * d2d1_y)
+#define TRIANGLE_SPAN_W1 (w1_row + (Sint64)x_first * d0d2_y)
+#define TRIANGLE_SPAN_W2 (w2_row + (Sint64)x_first * d1d0_y)
+
+/* Steps numerator / area along a span without a division per pixel.
+ * The numerator must stay positive, so that it rounds like the division does.
+ */
+typedef struct
+{
+    Sint64 q;
+    Sint64 r;
+    Sint64 dq;
+    Sint64 dr;
+} TriangleStepper;
+
+static void stepper_init(TriangleStepper *stepper, Sint64 n, Sint64 dn, Sint64 area)
+{
+    stepper->q = n / area;
+    stepper->r = n % area;
+    stepper->dq = dn / area;
+    stepper->dr = dn % area;
+    if (stepper->dr < 0) {
+        stepper->dr += area;
+        stepper->dq--;
+    }
+}
+
+static SDL_INLINE void stepper_next(TriangleStepper *stepper, Sint64 area)
+{
+    stepper->q += stepper->dq;
+    stepper->r += stepper->dr;
+    if (stepper->r >= area) {
+        stepper->r -= area;
+        stepper->q++;
+    }
+}
+
+// Colors are always stepped, the weights are never negative inside the triangle
+#define TRIANGLE_INIT_COLOR(stepper, c)                                                              \
+    stepper_init(&(stepper),                                                                         \
+                 TRIANGLE_SPAN_W0 * c0.c + TRIANGLE_SPAN_W1 * c1.c + TRIANGLE_SPAN_W2 * c2.c,        \
+                 (Sint64)d2d1_y * c0.c + (Sint64)d0d2_y * c1.c + (Sint64)d1d0_y * c2.c, area)
+
+typedef struct
+{
+    bool stepped;
+    TriangleStepper x, y;
+    Sint64 nx, ny;
+    Sint64 dnx, dny;
+} TriangleTextcoord;
+
+// Texture coordinates can go negative with wrapping, those spans keep dividing
+static void textcoord_init(TriangleTextcoord *tc, Sint64 nx, Sint64 dnx, Sint64 ny, Sint64 dny, int count, Sint64 area)
+{
+    const Sint64 last = count - 1;
+
+    tc->nx = nx;
+    tc->ny = ny;
+    tc->dnx = dnx;
+    tc->dny = dny;
+    tc->stepped = (nx >= 0 && nx + last * dnx >= 0 && ny >= 0 && ny + last * dny >= 0);
+    if (tc->stepped) {
+        stepper_init(&tc->x, nx, dnx, area);
+        stepper_init(&tc->y, ny, dny, area);
+    }
+}
+
+static SDL_INLINE void textcoord_next(TriangleTextcoord *tc, Sint64 area, int *srcx, int *srcy)
+{
+    if (tc->stepped) {
+        *srcx = (int)tc->x.q;
+        *srcy = (int)tc->y.q;
+        stepper_next(&tc->x, area);
+        stepper_next(&tc->y, area);
+    } else {
+        *srcx = (int)(tc->nx / area);
+        *srcy = (int)(tc->ny / area);
+        tc->nx += tc->dnx;
+        tc->ny += tc->dny;
+    }
+}
+
+#define TRIANGLE_INIT_TEXTCOORD(tc)                                                         \
+    textcoord_init(&(tc),                                                                   \
+                   TRIANGLE_SPAN_W0 * s2s0_x + TRIANGLE_SPAN_W1 * s2s1_x + s2_x_area.x,     \
+                   (Sint64)d2d1_y * s2s0_x + (Sint64)d0d2_y * s2s1_x,                       \
+                   TRIANGLE_SPAN_W0 * s2s0_y + TRIANGLE_SPAN_W1 * s2s1_y + s2_x_area.y,     \
+                   (Sint64)d2d1_y * s2s0_y + (Sint64)d0d2_y * s2s1_y, count, area)
+
+// 8 bits per channel in a 32-bit pixel, which the AVX2 spans work on
+static bool is_8888(const SDL_PixelFormatDetails *fmt)
+{
+    return fmt->bytes_per_pixel == 4 && fmt->Rbits == 8 && fmt->Gbits == 8 && fmt->Bbits == 8 &&
+           (fmt->Abits == 8 || fmt->Abits == 0);
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+// Loads the state of 8 consecutive pixels, and the step over 8 pixels
+static void SDL_TARGETING("avx2") stepper_lanes_AVX2(const TriangleStepper *stepper, int area, __m256i *q, __m256i *r, __m256i *dq, __m256i *dr)
+{
+    TriangleStepper tmp = *stepper;
+    Sint32 lanes_q[8], lanes_r[8];
+    const Sint64 dr8 = tmp.dr * 8;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        lanes_q[i] = (Sint32)tmp.q;
+        lanes_r[i] = (Sint32)tmp.r;
+        stepper_next(&tmp, area);
+    }
+    *q = _mm256_loadu_si256((const __m256i *)lanes_q);
+    *r = _mm256_loadu_si256((const __m256i *)lanes_r);
+    *dq = _mm256_set1_epi32((Sint32)(tmp.dq * 8 + dr8 / area));
+    *dr = _mm256_set1_epi32((Sint32)(dr8 % area));
+}
+
+#define STEPPER_NEXT_AVX2(q, r, dq, dr)                              \
+    {                                                                \
+        __m256i carry;                                               \
+        q = _mm256_add_epi32(q, dq);                                 \
+        r = _mm256_add_epi32(r, dr);                                 \
+        carry = _mm256_cmpgt_epi32(r, area_minus_one);               \
+        r = _mm256_sub_epi32(r, _mm256_and_si256(carry, area_v));    \
+        q = _mm256_sub_epi32(q, carry);                              \
+    }
+
+// x / 255 for x in [0, 255 * 255]
+#define DIV255_AVX2(x) _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_srli_epi32(x, 8)), 8)
+
+// Products of two values up to 255 fit in the low 16 bits of each lane
+#define MUL_DIV255_AVX2(x, y) DIV255_AVX2(_mm256_mullo_epi16(x, y))
+
+#define CHANNEL_AVX2(pixel, shift) _mm256_and_si256(_mm256_srl_epi32(pixel, shift), _mm256_set1_epi32(0xFF))
+
+static void SDL_TARGETING("avx2") FillSpan8888AVX2(Uint32 *dst, int count, const TriangleStepper channels[4], int area, const SDL_PixelFormatDetails *fmt)
+{
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i area_v = _mm256_set1_epi32(area);
+    const __m256i area_minus_one = _mm256_set1_epi32(area - 1);
+    const __m128i shifts[4] = {
+        _mm_cvtsi32_si128(fmt->Rshift), _mm_cvtsi32_si128(fmt->Gshift),
+        _mm_cvtsi32_si128(fmt->Bshift), _mm_cvtsi32_si128(fmt->Ashift)
+    };
+    const int num_channels = fmt->Amask ? 4 : 3;
+    __m256i q[4], r[4], dq[4], dr[4];
+    int i;
+
+    for (i = 0; i < num_channels; ++i) {
+        stepper_lanes_AVX2(&channels[i], area, &q[i], &r[i], &dq[i], &dr[i]);
+    }
+
+    while (count > 0) {
+        __m256i pixel = _mm256_setzero_si256();
+        for (i = 0; i < num_channels; ++i) {
+            pixel = _mm256_or_si256(pixel, _mm256_sll_epi32(q[i], shifts[i]));
+            STEPPER_NEXT_AVX2(q[i], r[i], dq[i], dr[i]);
+        }
+        if (count >= 8) {
+            _mm256_storeu_si256((__m256i *)dst, pixel);
+        } else {
+            _mm256_maskstore_epi32((int *)dst, _mm256_cmpgt_epi32(_mm256_set1_epi32(count), lane), pixel);
+        }
+        dst += 8;
+        count -= 8;
+    }
+}
+
+// Byte offsets of the texels for the next 8 pixels, with the mask of those in the span
+#define GATHER_TEXELS_AVX2(texels)                                                                         \
+    {                                                                                                      \
+        const __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(qy, pitch), _mm256_slli_epi32(qx, 2)); \
+        if (count >= 8) {                                                                                  \
+            texels = _mm256_i32gather_epi32((const int *)src, offsets, 1);                                 \
+        } else {                                                                                           \
+            mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(count), lane);                                     \
+            texels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)src, offsets, mask, 1); \
+        }                                                                                                  \
+        STEPPER_NEXT_AVX2(qx, rx, dqx, drx);                                                               \
+        STEPPER_NEXT_AVX2(qy, ry, dqy, dry);                                                               \
+    }
+
+static void SDL_TARGETING("avx2") BlitSpan32AVX2(Uint32 *dst, int count, const Uint8 *src, int src_pitch, const TriangleTextcoord *tc, int area)
+{
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i area_v = _mm256_set1_epi32(area);
+    const __m256i area_minus_one = _mm256_set1_epi32(area - 1);
+    const __m256i pitch = _mm256_set1_epi32(src_pitch);
+    __m256i qx, rx, dqx, drx, qy, ry, dqy, dry;
+    __m256i mask = _mm256_setzero_si256();
+
+    stepper_lanes_AVX2(&tc->x, area, &qx, &rx, &dqx, &drx);
+    stepper_lanes_AVX2(&tc->y, area, &qy, &ry, &dqy, &dry);
+
+    while (count > 0) {
+        __m256i texels;
+        GATHER_TEXELS_AVX2(texels);
+        if (count >= 8) {
+            _mm256_storeu_si256((__m256i *)dst, texels);
+        } else {
+            _mm256_maskstore_epi32((int *)dst, mask, texels);
+        }
+        dst += 8;
+        count -= 8;
+    }
+}
+
+/* SDL_BlitTriangle_Slow for 8888 formats with color and alpha modulation and blending.
+ * Gives the same result, the divisions by 255 are exact for products of bytes.
+ */
+static void SDL_TARGETING("avx2") BlitSpan8888AVX2(Uint32 *dst, int count, const Uint8 *src, int src_pitch, const TriangleTextcoord *tc,
+                                                   const TriangleStepper *channels, const SDL_BlitInfo *info, int area)
+{
+    const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
+    const int flags = info->flags;
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i area_v = _mm256_set1_epi32(area);
+    const __m256i area_minus_one = _mm256_set1_epi32(area - 1);
+    const __m256i pitch = _mm256_set1_epi32(src_pitch);
+    const __m256i opaque = _mm256_set1_epi32(0xFF);
+    const __m128i src_rshift = _mm_cvtsi32_si128(src_fmt->Rshift);
+    const __m128i src_gshift = _mm_cvtsi32_si128(src_fmt->Gshift);
+    const __m128i src_bshift = _mm_cvtsi32_si128(src_fmt->Bshift);
+    const __m128i src_ashift = _mm_cvtsi32_si128(src_fmt->Ashift);
+    const __m128i dst_rshift = _mm_cvtsi32_si128(dst_fmt->Rshift);
+    const __m128i dst_gshift = _mm_cvtsi32_si128(dst_fmt->Gshift);
+    const __m128i dst_bshift = _mm_cvtsi32_si128(dst_fmt->Bshift);
+    const __m128i dst_ashift = _mm_cvtsi32_si128(dst_fmt->Ashift);
+    __m256i qx, rx, dqx, drx, qy, ry, dqy, dry;
+    __m256i mod_q[4], mod_r[4], mod_dq[4], mod_dr[4];
+    __m256i mask = _mm256_setzero_si256();
+    int i;
+
+    stepper_lanes_AVX2(&tc->x, area, &qx, &rx, &dqx, &drx);
+    stepper_lanes_AVX2(&tc->y, area, &qy, &ry, &dqy, &dry);
+    if (channels) {
+        for (i = 0; i < 4; ++i) {
+            stepper_lanes_AVX2(&channels[i], area, &mod_q[i], &mod_r[i], &mod_dq[i], &mod_dr[i]);
+        }
+    } else {
+        mod_q[0] = _mm256_set1_epi32(info->r);
+        mod_q[1] = _mm256_set1_epi32(info->g);
+        mod_q[2] = _mm256_set1_epi32(info->b);
+        mod_q[3] = _mm256_set1_epi32(info->a);
+    }
+
+    while (count > 0) {
+        __m256i texels, srcR, srcG, srcB, srcA, pixel;
+
+        GATHER_TEXELS_AVX2(texels);
+        srcR = CHANNEL_AVX2(texels, src_rshift);
+        srcG = CHANNEL_AVX2(texels, src_gshift);
+        srcB = CHANNEL_AVX2(texels, src_bshift);
+        srcA = src_fmt->Amask ? CHANNEL_AVX2(texels, src_ashift) : opaque;
+
+        if (flags & SDL_COPY_MODULATE_COLOR) {
+            srcR = MUL_DIV255_AVX2(srcR, mod_q[0]);
+            srcG = MUL_DIV255_AVX2(srcG, mod_q[1]);
+            srcB = MUL_DIV255_AVX2(srcB, mod_q[2]);
+        }
+        if (flags & SDL_COPY_MODULATE_ALPHA) {
+            srcA = MUL_DIV255_AVX2(srcA, mod_q[3]);
+        }
+        if (channels) {
+            for (i = 0; i < 4; ++i) {
+                STEPPER_NEXT_AVX2(mod_q[i], mod_r[i], mod_dq[i], mod_dr[i]);
+            }
+        }
+
+        if (flags & SDL_COPY_BLEND) {
+            const __m256i inv_srcA = _mm256_sub_epi32(opaque, srcA);
+            const __m256i dstpixels = (count >= 8) ? _mm256_loadu_si256((const __m256i *)dst) : _mm256_maskload_epi32((const int *)dst, mask);
+            srcR = _mm256_add_epi32(MUL_DIV255_AVX2(srcR, srcA), MUL_DIV255_AVX2(inv_srcA, CHANNEL_AVX2(dstpixels, dst_rshift)));
+            srcG = _mm256_add_epi32(MUL_DIV255_AVX2(srcG, srcA), MUL_DIV255_AVX2(inv_srcA, CHANNEL_AVX2(dstpixels, dst_gshift)));
+            srcB = _mm256_add_epi32(MUL_DIV255_AVX2(srcB, srcA), MUL_DIV255_AVX2(inv_srcA, CHANNEL_AVX2(dstpixels, dst_bshift)));
+            if (dst_fmt->Amask) {
+                srcA = _mm256_add_epi32(srcA, MUL_DIV255_AVX2(inv_srcA, CHANNEL_AVX2(dstpixels, dst_ashift)));
+            }
+        }
+
+        pixel = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi32(srcR, dst_rshift), _mm256_sll_epi32(srcG, dst_gshift)),
+                                _mm256_sll_epi32(srcB, dst_bshift));
+        if (dst_fmt->Amask) {
+            pixel = _mm256_or_si256(pixel, _mm256_sll_epi32(srcA, dst_ashift));
+        }
+        if (count >= 8) {
+            _mm256_storeu_si256((__m256i *)dst, pixel);
+        } else {
+            _mm256_maskstore_epi32((int *)dst, mask, pixel);
+        }
+        dst += 8;
+        count -= 8;
+    }
+}
+#endif // SDL_AVX2_INTRINSICS
+
+bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2, const SDL_Rect *cliprect)
 {
     bool result = true;
     int dst_locked = 0;
@@ -287,8 +638,14 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
     {
         // Clip triangle with surface clip rect
         SDL_Rect rect;
-        SDL_GetSurfaceClipRect(dst, &rect);
-        SDL_GetRectIntersection(&dstrect, &rect, &dstrect);
+        if (cliprect) {
+            rect = *cliprect;
+        } else {
+            SDL_GetSurfaceClipRect(dst, &rect);
+        }
+        if (!SDL_GetRectIntersection(&dstrect, &rect, &dstrect)) {
+            goto end;
+        }
     }
 
     if (blend != SDL_BLENDMODE_NONE) {
@@ -313,6 +670,9 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
 
         SDL_SetSurfaceBlendMode(tmp, blend);
 
+        // Don't let SDL_HINT_SURFACE_AUTO_RLE encode it, the RLE blitter only approximates alpha blending
+        SDL_SetSurfaceRLE(tmp, false);
+
         dstbpp = tmp->fmt->bytes_per_pixel;
         dst_ptr = (Uint8 *)tmp->pixels;
         dst_pitch = tmp->pitch;
@@ -379,36 +739,43 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
         }
 
         if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPAN_LOOP
             {
-                *(Uint32 *)dptr = color;
+                SDL_memset4(dptr, color, count);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPAN_LOOP
         } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPAN_LOOP
             {
-                Uint8 *s = (Uint8 *)&color;
-                dptr[0] = s[0];
-                dptr[1] = s[1];
-                dptr[2] = s[2];
+                const Uint8 *s = (const Uint8 *)&color;
+                for (; count > 0; --count, dptr += 3) {
+                    dptr[0] = s[0];
+                    dptr[1] = s[1];
+                    dptr[2] = s[2];
+                }
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPAN_LOOP
         } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPAN_LOOP
             {
-                *(Uint16 *)dptr = (Uint16)color;
+                for (; count > 0; --count, dptr += 2) {
+                    *(Uint16 *)dptr = (Uint16)color;
+                }
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPAN_LOOP
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPAN_LOOP
             {
-                *dptr = (Uint8)color;
+                SDL_memset(dptr, (Uint8)color, count);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPAN_LOOP
         }
     } else {
         const SDL_PixelFormatDetails *format;
         SDL_Palette *palette;
+#ifdef SDL_AVX2_INTRINSICS
+        bool use_avx2;
+#endif
         if (tmp) {
             format = tmp->fmt;
             palette = tmp->palette;
@@ -416,38 +783,49 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
             format = dst->fmt;
             palette = dst->palette;
         }
-        if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                TRIANGLE_GET_MAPPED_COLOR
-                *(Uint32 *)dptr = color;
-            }
-            TRIANGLE_END_LOOP
-        } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                TRIANGLE_GET_MAPPED_COLOR
-                Uint8 *s = (Uint8 *)&color;
-                dptr[0] = s[0];
-                dptr[1] = s[1];
-                dptr[2] = s[2];
-            }
-            TRIANGLE_END_LOOP
-        } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                TRIANGLE_GET_MAPPED_COLOR
-                *(Uint16 *)dptr = (Uint16)color;
+#ifdef SDL_AVX2_INTRINSICS
+        use_avx2 = is_8888(format) && area < (1 << 30) && SDL_HasAVX2();
+#endif
+        TRIANGLE_BEGIN_SPAN_LOOP
+        {
+            TriangleStepper channels[4];
+            TRIANGLE_INIT_COLOR(channels[0], r);
+            TRIANGLE_INIT_COLOR(channels[1], g);
+            TRIANGLE_INIT_COLOR(channels[2], b);
+            TRIANGLE_INIT_COLOR(channels[3], a);
+#ifdef SDL_AVX2_INTRINSICS
+            if (use_avx2) {
+                FillSpan8888AVX2((Uint32 *)dptr, count, channels, (int)area, format);
+                continue;
             }
-            TRIANGLE_END_LOOP
-        } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                TRIANGLE_GET_MAPPED_COLOR
-                *dptr = (Uint8)color;
+#endif
+            for (; count > 0; --count, dptr += dstbpp) {
+                const Uint32 color = SDL_MapRGBA(format, palette, (Uint8)channels[0].q, (Uint8)channels[1].q, (Uint8)channels[2].q, (Uint8)channels[3].q);
+                switch (dstbpp) {
+                case 4:
+                    *(Uint32 *)dptr = color;
+                    break;
+                case 3:
+                {
+                    const Uint8 *s = (const Uint8 *)&color;
+                    dptr[0] = s[0];
+                    dptr[1] = s[1];
+                    dptr[2] = s[2];
+                } break;
+                case 2:
+                    *(Uint16 *)dptr = (Uint16)color;
+                    break;
+                default:
+                    *dptr = (Uint8)color;
+                    break;
+                }
+                stepper_next(&channels[0], area);
+                stepper_next(&channels[1], area);
+                stepper_next(&channels[2], area);
+                stepper_next(&channels[3], area);
             }
-            TRIANGLE_END_LOOP
         }
+        TRIANGLE_END_SPAN_LOOP
     }
 
     if (tmp) {
@@ -470,7 +848,8 @@ bool SDL_SW_BlitTriangle(
     SDL_Point *d0, SDL_Point *d1, SDL_Point *d2,
     SDL_Color c0, SDL_Color c1, SDL_Color c2,
     SDL_TextureAddressMode texture_address_mode_u,
-    SDL_TextureAddressMode texture_address_mode_v)
+    SDL_TextureAddressMode texture_address_mode_v,
+    const SDL_Rect *cliprect)
 {
     bool result = true;
     SDL_Surface *src_surface = src;
@@ -588,8 +967,14 @@ bool SDL_SW_BlitTriangle(
     {
         // Clip triangle with surface clip rect
         SDL_Rect rect;
-        SDL_GetSurfaceClipRect(dst, &rect);
-        SDL_GetRectIntersection(&dstrect, &rect, &dstrect);
+        if (cliprect) {
+            rect = *cliprect;
+        } else {
+            SDL_GetSurfaceClipRect(dst, &rect);
+        }
+        if (!SDL_GetRectIntersection(&dstrect, &rect, &dstrect)) {
+            goto end;
+        }
     }
 
     // Set destination pointer
@@ -730,40 +1115,48 @@ bool SDL_SW_BlitTriangle(
         goto end;
     }
 
-    if (dstbpp == 4) {
-        TRIANGLE_BEGIN_LOOP
-        {
-            TRIANGLE_GET_TEXTCOORD
-            Uint32 *sptr = (Uint32 *)((Uint8 *)src_ptr + srcy * src_pitch);
-            *(Uint32 *)dptr = sptr[srcx];
-        }
-        TRIANGLE_END_LOOP
-    } else if (dstbpp == 3) {
-        TRIANGLE_BEGIN_LOOP
-        {
-            TRIANGLE_GET_TEXTCOORD
-            Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
-            dptr[0] = sptr[3 * srcx];
-            dptr[1] = sptr[3 * srcx + 1];
-            dptr[2] = sptr[3 * srcx + 2];
-        }
-        TRIANGLE_END_LOOP
-    } else if (dstbpp == 2) {
-        TRIANGLE_BEGIN_LOOP
-        {
-            TRIANGLE_GET_TEXTCOORD
-            Uint16 *sptr = (Uint16 *)((Uint8 *)src_ptr + srcy * src_pitch);
-            *(Uint16 *)dptr = sptr[srcx];
-        }
-        TRIANGLE_END_LOOP
-    } else if (dstbpp == 1) {
-        TRIANGLE_BEGIN_LOOP
+    {
+#ifdef SDL_AVX2_INTRINSICS
+        const bool use_avx2 = dstbpp == 4 && area < (1 << 30) &&
+                              texture_address_mode_u != SDL_TEXTURE_ADDRESS_WRAP &&
+                              texture_address_mode_v != SDL_TEXTURE_ADDRESS_WRAP &&
+                              SDL_HasAVX2();
+#endif
+        TRIANGLE_BEGIN_SPAN_LOOP
         {
-            TRIANGLE_GET_TEXTCOORD
-            Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
-            *dptr = sptr[srcx];
+            TriangleTextcoord tc;
+            TRIANGLE_INIT_TEXTCOORD(tc);
+#ifdef SDL_AVX2_INTRINSICS
+            if (use_avx2 && tc.stepped) {
+                BlitSpan32AVX2((Uint32 *)dptr, count, (const Uint8 *)src_ptr, src_pitch, &tc, (int)area);
+                continue;
+            }
+#endif
+            for (; count > 0; --count, dptr += dstbpp) {
+                int srcx, srcy;
+                const Uint8 *sptr;
+                textcoord_next(&tc, area, &srcx, &srcy);
+                TRIANGLE_WRAP_TEXTCOORD
+                sptr = (const Uint8 *)src_ptr + srcy * src_pitch + srcx * dstbpp;
+                switch (dstbpp) {
+                case 4:
+                    *(Uint32 *)dptr = *(const Uint32 *)sptr;
+                    break;
+                case 3:
+                    dptr[0] = sptr[0];
+                    dptr[1] = sptr[1];
+                    dptr[2] = sptr[2];
+                    break;
+                case 2:
+                    *(Uint16 *)dptr = *(const Uint16 *)sptr;
+                    break;
+                default:
+                    *dptr = *sptr;
+                    break;
+                }
+            }
         }
-        TRIANGLE_END_LOOP
+        TRIANGLE_END_SPAN_LOOP
     }
 
 end:
@@ -771,7 +1164,7 @@ end:
         SDL_UnlockSurface(dst);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceRows(src, 0, 0);
     }
 
     return result;
@@ -793,20 +1186,12 @@ static int detect_format(const SDL_PixelFormatDetails *pf)
     }
 }
 
-static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
-                                  SDL_Point s2_x_area, SDL_Rect dstrect, int area, int bias_w0, int bias_w1, int bias_w2,
-                                  int d2d1_y, int d1d2_x, int d0d2_y, int d2d0_x, int d1d0_y, int d0d1_x,
-                                  int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y, int w0_row, int w1_row, int w2_row,
-                                  SDL_Color c0, SDL_Color c1, SDL_Color c2, bool is_uniform,
-                                  SDL_TextureAddressMode texture_address_mode_u,
-                                  SDL_TextureAddressMode texture_address_mode_v)
+// Returns false if the pixel was skipped by the colorkey
+static SDL_INLINE bool SDL_BlitTrianglePixel(const SDL_BlitInfo *info, Uint8 *src, Uint8 *dst,
+                                             int srcfmt_val, int dstfmt_val,
+                                             Uint32 modulateR, Uint32 modulateG, Uint32 modulateB, Uint32 modulateA)
 {
-    SDL_Surface *src_surface = info->src_surface;
     const int flags = info->flags;
-    Uint32 modulateR = info->r;
-    Uint32 modulateG = info->g;
-    Uint32 modulateB = info->b;
-    Uint32 modulateA = info->a;
     Uint32 srcpixel;
     Uint32 srcR, srcG, srcB, srcA;
     Uint32 dstpixel;
@@ -815,142 +1200,206 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
-    int srcfmt_val;
-    int dstfmt_val;
     Uint32 rgbmask = ~src_fmt->Amask;
     Uint32 ckey = info->colorkey & rgbmask;
 
-    Uint8 *dst_ptr = info->dst;
-    int dst_pitch = info->dst_pitch;
-
-    srcfmt_val = detect_format(src_fmt);
-    dstfmt_val = detect_format(dst_fmt);
-
-    TRIANGLE_BEGIN_LOOP
-    {
-        Uint8 *src;
-        Uint8 *dst = dptr;
-        TRIANGLE_GET_TEXTCOORD
-        src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
-        if (FORMAT_HAS_ALPHA(srcfmt_val)) {
-            DISEMBLE_RGBA(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB, srcA);
-        } else if (FORMAT_HAS_NO_ALPHA(srcfmt_val)) {
-            DISEMBLE_RGB(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB);
-            srcA = 0xFF;
-        } else {
-            // SDL_PIXELFORMAT_ARGB2101010
-            srcpixel = *((Uint32 *)(src));
-            RGBA_FROM_ARGB2101010(srcpixel, srcR, srcG, srcB, srcA);
-        }
-        if (flags & SDL_COPY_COLORKEY) {
-            // srcpixel isn't set for 24 bpp
-            if (srcbpp == 3) {
-                srcpixel = (srcR << src_fmt->Rshift) |
-                           (srcG << src_fmt->Gshift) | (srcB << src_fmt->Bshift);
-            }
-            if ((srcpixel & rgbmask) == ckey) {
-                continue;
-            }
+    if (FORMAT_HAS_ALPHA(srcfmt_val)) {
+        DISEMBLE_RGBA(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB, srcA);
+    } else if (FORMAT_HAS_NO_ALPHA(srcfmt_val)) {
+        DISEMBLE_RGB(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB);
+        srcA = 0xFF;
+    } else {
+        // SDL_PIXELFORMAT_ARGB2101010
+        srcpixel = *((Uint32 *)(src));
+        RGBA_FROM_ARGB2101010(srcpixel, srcR, srcG, srcB, srcA);
+    }
+    if (flags & SDL_COPY_COLORKEY) {
+        // srcpixel isn't set for 24 bpp
+        if (srcbpp == 3) {
+            srcpixel = (srcR << src_fmt->Rshift) |
+                       (srcG << src_fmt->Gshift) | (srcB << src_fmt->Bshift);
         }
-        if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-            if (FORMAT_HAS_ALPHA(dstfmt_val)) {
-                DISEMBLE_RGBA(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB, dstA);
-            } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
-                DISEMBLE_RGB(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB);
-                dstA = 0xFF;
-            } else {
-                // SDL_PIXELFORMAT_ARGB2101010
-                dstpixel = *((Uint32 *) (dst));
-                RGBA_FROM_ARGB2101010(dstpixel, dstR, dstG, dstB, dstA);
-            }
+        if ((srcpixel & rgbmask) == ckey) {
+            return false;
+        }
+    }
+    if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
+        if (FORMAT_HAS_ALPHA(dstfmt_val)) {
+            DISEMBLE_RGBA(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB, dstA);
+        } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
+            DISEMBLE_RGB(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB);
+            dstA = 0xFF;
         } else {
-            // don't care
-            dstR = dstG = dstB = dstA = 0;
+            // SDL_PIXELFORMAT_ARGB2101010
+            dstpixel = *((Uint32 *) (dst));
+            RGBA_FROM_ARGB2101010(dstpixel, dstR, dstG, dstB, dstA);
         }
+    } else {
+        // don't care
+        dstR = dstG = dstB = dstA = 0;
+    }
 
-        if (!is_uniform) {
-            TRIANGLE_GET_COLOR
-            modulateR = r;
-            modulateG = g;
-            modulateB = b;
-            modulateA = a;
+    if (flags & SDL_COPY_MODULATE_COLOR) {
+        srcR = (srcR * modulateR) / 255;
+        srcG = (srcG * modulateG) / 255;
+        srcB = (srcB * modulateB) / 255;
+    }
+    if (flags & SDL_COPY_MODULATE_ALPHA) {
+        srcA = (srcA * modulateA) / 255;
+    }
+    if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+        // This goes away if we ever use premultiplied alpha
+        if (srcA < 255) {
+            srcR = (srcR * srcA) / 255;
+            srcG = (srcG * srcA) / 255;
+            srcB = (srcB * srcA) / 255;
         }
-
-        if (flags & SDL_COPY_MODULATE_COLOR) {
-            srcR = (srcR * modulateR) / 255;
-            srcG = (srcG * modulateG) / 255;
-            srcB = (srcB * modulateB) / 255;
+    }
+    switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+    case 0:
+        dstR = srcR;
+        dstG = srcG;
+        dstB = srcB;
+        dstA = srcA;
+        break;
+    case SDL_COPY_BLEND:
+        dstR = srcR + ((255 - srcA) * dstR) / 255;
+        dstG = srcG + ((255 - srcA) * dstG) / 255;
+        dstB = srcB + ((255 - srcA) * dstB) / 255;
+        dstA = srcA + ((255 - srcA) * dstA) / 255;
+        break;
+    case SDL_COPY_ADD:
+        dstR = srcR + dstR;
+        if (dstR > 255) {
+            dstR = 255;
         }
-        if (flags & SDL_COPY_MODULATE_ALPHA) {
-            srcA = (srcA * modulateA) / 255;
-        }
-        if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
-            // This goes away if we ever use premultiplied alpha
-            if (srcA < 255) {
-                srcR = (srcR * srcA) / 255;
-                srcG = (srcG * srcA) / 255;
-                srcB = (srcB * srcA) / 255;
-            }
+        dstG = srcG + dstG;
+        if (dstG > 255) {
+            dstG = 255;
         }
-        switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
-        case 0:
-            dstR = srcR;
-            dstG = srcG;
-            dstB = srcB;
-            dstA = srcA;
-            break;
-        case SDL_COPY_BLEND:
-            dstR = srcR + ((255 - srcA) * dstR) / 255;
-            dstG = srcG + ((255 - srcA) * dstG) / 255;
-            dstB = srcB + ((255 - srcA) * dstB) / 255;
-            dstA = srcA + ((255 - srcA) * dstA) / 255;
-            break;
-        case SDL_COPY_ADD:
-            dstR = srcR + dstR;
-            if (dstR > 255) {
-                dstR = 255;
-            }
-            dstG = srcG + dstG;
-            if (dstG > 255) {
-                dstG = 255;
+        dstB = srcB + dstB;
+        if (dstB > 255) {
+            dstB = 255;
+        }
+        break;
+    case SDL_COPY_MOD:
+        dstR = (srcR * dstR) / 255;
+        dstG = (srcG * dstG) / 255;
+        dstB = (srcB * dstB) / 255;
+        break;
+    case SDL_COPY_MUL:
+        dstR = ((srcR * dstR) + (dstR * (255 - srcA))) / 255;
+        if (dstR > 255) {
+            dstR = 255;
+        }
+        dstG = ((srcG * dstG) + (dstG * (255 - srcA))) / 255;
+        if (dstG > 255) {
+            dstG = 255;
+        }
+        dstB = ((srcB * dstB) + (dstB * (255 - srcA))) / 255;
+        if (dstB > 255) {
+            dstB = 255;
+        }
+        break;
+    }
+    if (FORMAT_HAS_ALPHA(dstfmt_val)) {
+        ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
+    } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
+        ASSEMBLE_RGB(dst, dstbpp, dst_fmt, dstR, dstG, dstB);
+    } else {
+        // SDL_PIXELFORMAT_ARGB2101010
+        Uint32 pixelvalue;
+        ARGB2101010_FROM_RGBA(pixelvalue, dstR, dstG, dstB, dstA);
+        *(Uint32 *)dst = pixelvalue;
+    }
+    return true;
+}
+
+static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
+                                  SDL_Point s2_x_area, SDL_Rect dstrect, int area, int bias_w0, int bias_w1, int bias_w2,
+                                  int d2d1_y, int d1d2_x, int d0d2_y, int d2d0_x, int d1d0_y, int d0d1_x,
+                                  int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y, int w0_row, int w1_row, int w2_row,
+                                  SDL_Color c0, SDL_Color c1, SDL_Color c2, bool is_uniform,
+                                  SDL_TextureAddressMode texture_address_mode_u,
+                                  SDL_TextureAddressMode texture_address_mode_v)
+{
+    SDL_Surface *src_surface = info->src_surface;
+    const int flags = info->flags;
+    const int srcbpp = info->src_fmt->bytes_per_pixel;
+    const int dstbpp = info->dst_fmt->bytes_per_pixel;
+    const int srcfmt_val = detect_format(info->src_fmt);
+    const int dstfmt_val = detect_format(info->dst_fmt);
+
+    Uint8 *dst_ptr = info->dst;
+    int dst_pitch = info->dst_pitch;
+
+    if (flags & SDL_COPY_COLORKEY) {
+        // Keep the original per-pixel loop, skipped pixels don't advance the weights
+        TRIANGLE_BEGIN_LOOP
+        {
+            Uint32 modulateR = info->r;
+            Uint32 modulateG = info->g;
+            Uint32 modulateB = info->b;
+            Uint32 modulateA = info->a;
+            TRIANGLE_GET_TEXTCOORD
+            if (!is_uniform) {
+                TRIANGLE_GET_COLOR
+                modulateR = r;
+                modulateG = g;
+                modulateB = b;
+                modulateA = a;
             }
-            dstB = srcB + dstB;
-            if (dstB > 255) {
-                dstB = 255;
+            if (!SDL_BlitTrianglePixel(info, info->src + (srcy * info->src_pitch) + (srcx * srcbpp), dptr,
+                                       srcfmt_val, dstfmt_val, modulateR, modulateG, modulateB, modulateA)) {
+                continue;
             }
-            break;
-        case SDL_COPY_MOD:
-            dstR = (srcR * dstR) / 255;
-            dstG = (srcG * dstG) / 255;
-            dstB = (srcB * dstB) / 255;
-            break;
-        case SDL_COPY_MUL:
-            dstR = ((srcR * dstR) + (dstR * (255 - srcA))) / 255;
-            if (dstR > 255) {
-                dstR = 255;
+        }
+        TRIANGLE_END_LOOP
+    } else {
+#ifdef SDL_AVX2_INTRINSICS
+        const bool use_avx2 = is_8888(info->src_fmt) && is_8888(info->dst_fmt) &&
+                              !(flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) &&
+                              area < (1 << 30) &&
+                              texture_address_mode_u != SDL_TEXTURE_ADDRESS_WRAP &&
+                              texture_address_mode_v != SDL_TEXTURE_ADDRESS_WRAP &&
+                              SDL_HasAVX2();
+#endif
+        TRIANGLE_BEGIN_SPAN_LOOP
+        {
+            TriangleTextcoord tc;
+            TriangleStepper channels[4];
+            TRIANGLE_INIT_TEXTCOORD(tc);
+            if (!is_uniform) {
+                TRIANGLE_INIT_COLOR(channels[0], r);
+                TRIANGLE_INIT_COLOR(channels[1], g);
+                TRIANGLE_INIT_COLOR(channels[2], b);
+                TRIANGLE_INIT_COLOR(channels[3], a);
             }
-            dstG = ((srcG * dstG) + (dstG * (255 - srcA))) / 255;
-            if (dstG > 255) {
-                dstG = 255;
+#ifdef SDL_AVX2_INTRINSICS
+            if (use_avx2 && tc.stepped) {
+                BlitSpan8888AVX2((Uint32 *)dptr, count, info->src, info->src_pitch, &tc, is_uniform ? NULL : channels, info, area);
+                continue;
             }
-            dstB = ((srcB * dstB) + (dstB * (255 - srcA))) / 255;
-            if (dstB > 255) {
-                dstB = 255;
+#endif
+            for (; count > 0; --count, dptr += dstbpp) {
+                int srcx, srcy;
+                textcoord_next(&tc, area, &srcx, &srcy);
+                TRIANGLE_WRAP_TEXTCOORD
+                if (is_uniform) {
+                    SDL_BlitTrianglePixel(info, info->src + (srcy * info->src_pitch) + (srcx * srcbpp), dptr,
+                                          srcfmt_val, dstfmt_val, info->r, info->g, info->b, info->a);
+                } else {
+                    SDL_BlitTrianglePixel(info, info->src + (srcy * info->src_pitch) + (srcx * srcbpp), dptr,
+                                          srcfmt_val, dstfmt_val, (Uint32)channels[0].q, (Uint32)channels[1].q, (Uint32)channels[2].q, (Uint32)channels[3].q);
+                    stepper_next(&channels[0], area);
+                    stepper_next(&channels[1], area);
+                    stepper_next(&channels[2], area);
+                    stepper_next(&channels[3], area);
+                }
             }
-            break;
-        }
-        if (FORMAT_HAS_ALPHA(dstfmt_val)) {
-            ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
-        } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
-            ASSEMBLE_RGB(dst, dstbpp, dst_fmt, dstR, dstG, dstB);
-        } else {
-            // SDL_PIXELFORMAT_ARGB2101010
-            Uint32 pixelvalue;
-            ARGB2101010_FROM_RGBA(pixelvalue, dstR, dstG, dstB, dstA);
-            *(Uint32 *)dst = pixelvalue;
         }
+        TRIANGLE_END_SPAN_LOOP
     }
-    TRIANGLE_END_LOOP
 }
 
 #endif // SDL_VIDEO_RENDER_SW
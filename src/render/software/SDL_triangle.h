@@ -24,9 +24,12 @@
 
 #include "SDL_internal.h"
 
+// If cliprect is NULL, the triangles are clipped to the destination's clip rectangle instead.
+
 extern bool SDL_SW_FillTriangle(SDL_Surface *dst,
                                 SDL_Point *d0, SDL_Point *d1, SDL_Point *d2,
-                                SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2);
+                                SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2,
+                                const SDL_Rect *cliprect);
 
 extern bool SDL_SW_BlitTriangle(SDL_Surface *src,
                                 SDL_Point *s0, SDL_Point *s1, SDL_Point *s2,
@@ -34,7 +37,11 @@ extern bool SDL_SW_BlitTriangle(SDL_Surface *src,
                                 SDL_Point *d0, SDL_Point *d1, SDL_Point *d2,
                                 SDL_Color c0, SDL_Color c1, SDL_Color c2,
                                 SDL_TextureAddressMode texture_address_mode_u,
-                                SDL_TextureAddressMode texture_address_mode_v);
+                                SDL_TextureAddressMode texture_address_mode_v,
+                                const SDL_Rect *cliprect);
+
+// The pixels a triangle with these (fixed point) corners can touch, before clipping.
+extern void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect);
 
 extern void trianglepoint_2_fixedpoint(SDL_Point *a);
 
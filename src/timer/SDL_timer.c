@@ -22,6 +22,7 @@
 
 #include "SDL_timer_c.h"
 #include "../thread/SDL_systhread.h"
+#include "../SDL_hashtable.h"
 
 // #define DEBUG_TIMERS
 
@@ -35,24 +36,30 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 sequence;
+    Uint64 dispatched;
+    int worker;
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
+// A thread that runs timer callbacks handed to it by the timer thread
+typedef struct SDL_TimerWorker
 {
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
+    SDL_Thread *thread;
+    SDL_Timer *head;
+    SDL_Timer *tail;
+} SDL_TimerWorker;
 
-// The timers are kept in a sorted list
+// The timers are kept in a binary min-heap, ordered by scheduling time
 typedef struct
 {
     // Data used by the main thread
     SDL_InitState init;
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_TimerWorker *workers;
+    int num_workers;
+    SDL_HashTable *timermap; // SDL_TimerID -> SDL_Timer *
     SDL_Mutex *timermap_lock;
 
     // Padding to separate cache lines between threads
@@ -65,36 +72,217 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    // List of timers - this is only touched by the timer thread
-    SDL_Timer *timers;
+    // Timers waiting for a worker, protected by worker_lock
+    SDL_Mutex *worker_lock;
+    SDL_Condition *worker_cond;
+    SDL_TimerWorker dispatch;
+
+    // Callback timing statistics, protected by stats_lock
+    SDL_SpinLock stats_lock;
+    SDL_TimerStatistics stats;
+
+    // Heap of timers - this is only touched by the timer thread
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
 
+#define SDL_MAX_TIMER_WORKERS 64
+
 /* The idea here is that any thread might add a timer, but a single
  * thread manages the active timer queue, sorted by scheduling time.
  *
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+// Timers scheduled for the same time fire in the order they were added
+static bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
+{
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
+
+static bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    int i;
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? (data->max_timers * 2) : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return false;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    // Sift up from the end of the heap
+    i = data->num_timers++;
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, data->timers[parent])) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return true;
+}
 
-    // Insert the timer here!
-    if (prev) {
-        prev->next = timer;
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers[0];
+    SDL_Timer *last = data->timers[--data->num_timers];
+    const int count = data->num_timers;
+    int i = 0;
+
+    // Sift the last timer down from the top of the heap
+    while (count > 0) {
+        int child = (2 * i) + 1;
+        if (child >= count) {
+            break;
+        }
+        if ((child + 1) < count && SDL_TimerBefore(data->timers[child + 1], data->timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(data->timers[child], last)) {
+            break;
+        }
+        data->timers[i] = data->timers[child];
+        i = child;
+    }
+    if (count > 0) {
+        data->timers[i] = last;
+    }
+    return first;
+}
+
+static Uint64 SDL_RunTimerCallback(SDL_TimerData *data, SDL_Timer *timer)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 lateness = (now > timer->scheduled) ? (now - timer->scheduled) : 0;
+
+    SDL_LockSpinlock(&data->stats_lock);
+    ++data->stats.num_callbacks;
+    data->stats.total_lateness += lateness;
+    if (lateness > data->stats.max_lateness) {
+        data->stats.max_lateness = lateness;
+    }
+    SDL_UnlockSpinlock(&data->stats_lock);
+
+    if (timer->callback_ms) {
+        return SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
     } else {
-        data->timers = timer;
+        return timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
     }
-    timer->next = curr;
+}
+
+// Forget the ID of a timer that won't fire again, before its structure goes back on the free list
+static void SDL_RetireTimer(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_SetAtomicInt(&timer->canceled, 1);
+
+    SDL_LockMutex(data->timermap_lock);
+    SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
+    SDL_UnlockMutex(data->timermap_lock);
+}
+
+static void SDL_QueueTimer(SDL_TimerWorker *queue, SDL_Timer *timer)
+{
+    timer->next = NULL;
+    if (queue->tail) {
+        queue->tail->next = timer;
+    } else {
+        queue->head = timer;
+    }
+    queue->tail = timer;
+}
+
+static SDL_Timer *SDL_DequeueTimer(SDL_TimerWorker *queue)
+{
+    SDL_Timer *timer = queue->head;
+    if (timer) {
+        queue->head = timer->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+    }
+    return timer;
+}
+
+// Hand an expired timer to the worker pool, called on the timer thread
+static void SDL_DispatchTimer(SDL_TimerData *data, SDL_Timer *timer, Uint64 tick)
+{
+    timer->dispatched = tick;
+
+    SDL_LockMutex(data->worker_lock);
+    if (timer->worker >= 0) {
+        SDL_QueueTimer(&data->workers[timer->worker], timer);
+        SDL_BroadcastCondition(data->worker_cond);
+    } else {
+        SDL_QueueTimer(&data->dispatch, timer);
+        SDL_SignalCondition(data->worker_cond);
+    }
+    SDL_UnlockMutex(data->worker_lock);
+}
+
+static int SDLCALL SDL_TimerWorkerThread(void *_worker)
+{
+    SDL_TimerWorker *worker = (SDL_TimerWorker *)_worker;
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_Timer *timer;
+    Uint64 interval;
+
+    SDL_LockMutex(data->worker_lock);
+    while (SDL_GetAtomicInt(&data->active)) {
+        timer = SDL_DequeueTimer(worker);
+        if (!timer) {
+            timer = SDL_DequeueTimer(&data->dispatch);
+        }
+        if (!timer) {
+            SDL_WaitCondition(data->worker_cond, data->worker_lock);
+            continue;
+        }
+        SDL_UnlockMutex(data->worker_lock);
+
+        if (SDL_GetAtomicInt(&timer->canceled)) {
+            interval = 0;
+        } else {
+            interval = SDL_RunTimerCallback(data, timer);
+        }
+
+        // Give the timer back to the timer thread, either to reschedule or to reuse
+        if (interval == 0) {
+            SDL_RetireTimer(data, timer);
+        }
+        SDL_LockSpinlock(&data->lock);
+        if (interval > 0) {
+            timer->interval = interval;
+            timer->scheduled = timer->dispatched + interval;
+            timer->next = data->pending;
+            data->pending = timer;
+        } else {
+            timer->next = data->freelist;
+            data->freelist = timer;
+        }
+        SDL_UnlockSpinlock(&data->lock);
+
+        if (interval > 0) {
+            SDL_SignalSemaphore(data->sem);
+        }
+
+        SDL_LockMutex(data->worker_lock);
+    }
+    SDL_UnlockMutex(data->worker_lock);
+    return 0;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -127,54 +315,70 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        // Sort the pending timers into our list
+        // Sort the pending timers into our heap
         while (pending) {
             current = pending;
+            if (!SDL_AddTimerInternal(data, current)) {
+                break;
+            }
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
         }
         freelist_head = NULL;
         freelist_tail = NULL;
 
+        if (pending) {
+            // We're out of memory, put the rest back and try again shortly
+            SDL_LockSpinlock(&data->lock);
+            current = pending;
+            while (current->next) {
+                current = current->next;
+            }
+            current->next = data->pending;
+            data->pending = pending;
+            SDL_UnlockSpinlock(&data->lock);
+        }
+
         // Check to see if we're still running, after maintenance
         if (!SDL_GetAtomicInt(&data->active)) {
             break;
         }
 
         // Initial delay if there are no timers
-        delay = (Uint64)-1;
+        delay = pending ? SDL_NS_PER_MS : (Uint64)-1;
 
         tick = SDL_GetTicksNS();
 
         // Process all the pending timers for this tick
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 // Scheduled for the future, wait a bit
-                delay = (current->scheduled - tick);
+                delay = SDL_min(delay, current->scheduled - tick);
                 break;
             }
 
             // We're going to do something with this timer
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
             if (SDL_GetAtomicInt(&current->canceled)) {
                 interval = 0;
+            } else if (data->num_workers > 0) {
+                // A worker will run the callback and give the timer back to us
+                SDL_DispatchTimer(data, current, tick);
+                continue;
             } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
-                } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
-                }
+                interval = SDL_RunTimerCallback(data, current);
             }
 
             if (interval > 0) {
-                // Reschedule this timer
+                // Reschedule this timer, we just removed it so there's room in the heap
                 current->interval = interval;
                 current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
             } else {
+                SDL_RetireTimer(data, current);
+
                 if (!freelist_head) {
                     freelist_head = current;
                 }
@@ -182,8 +386,6 @@ static int SDLCALL SDL_TimerThread(void *_data)
                     freelist_tail->next = current;
                 }
                 freelist_tail = current;
-
-                SDL_SetAtomicInt(&current->canceled, 1);
             }
         }
 
@@ -209,6 +411,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
 bool SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
+    const char *hint;
+    int i, num_workers;
 
     if (!SDL_ShouldInit(&data->init)) {
         return true;
@@ -219,13 +423,47 @@ bool SDL_InitTimers(void)
         goto error;
     }
 
+    data->timermap = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    if (!data->timermap) {
+        goto error;
+    }
+
     data->sem = SDL_CreateSemaphore(0);
     if (!data->sem) {
         goto error;
     }
 
+    SDL_zero(data->stats);
+
     SDL_SetAtomicInt(&data->active, true);
 
+    hint = SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS);
+    num_workers = hint ? SDL_clamp(SDL_atoi(hint), 0, SDL_MAX_TIMER_WORKERS) : 0;
+    if (num_workers > 0) {
+        data->worker_lock = SDL_CreateMutex();
+        if (!data->worker_lock) {
+            goto error;
+        }
+        data->worker_cond = SDL_CreateCondition();
+        if (!data->worker_cond) {
+            goto error;
+        }
+        data->workers = (SDL_TimerWorker *)SDL_calloc(num_workers, sizeof(*data->workers));
+        if (!data->workers) {
+            goto error;
+        }
+        for (i = 0; i < num_workers; ++i) {
+            char name[64];
+
+            SDL_snprintf(name, sizeof(name), "SDLTimerWorker%d", i);
+            data->workers[i].thread = SDL_CreateThread(SDL_TimerWorkerThread, name, &data->workers[i]);
+            if (!data->workers[i].thread) {
+                goto error;
+            }
+            ++data->num_workers;
+        }
+    }
+
     // Timer threads use a callback into the app, so we can't set a limited stack size here.
     data->thread = SDL_CreateThread(SDL_TimerThread, "SDLTimer", data);
     if (!data->thread) {
@@ -245,7 +483,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (!SDL_ShouldQuit(&data->init)) {
         return;
@@ -260,15 +498,49 @@ void SDL_QuitTimers(void)
         data->thread = NULL;
     }
 
+    // Shutdown the worker threads
+    if (data->workers) {
+        SDL_LockMutex(data->worker_lock);
+        SDL_BroadcastCondition(data->worker_cond);
+        SDL_UnlockMutex(data->worker_lock);
+
+        for (i = 0; i < data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i].thread, NULL);
+            while ((timer = SDL_DequeueTimer(&data->workers[i])) != NULL) {
+                SDL_free(timer);
+            }
+        }
+        SDL_free(data->workers);
+        data->workers = NULL;
+        data->num_workers = 0;
+    }
+    while ((timer = SDL_DequeueTimer(&data->dispatch)) != NULL) {
+        SDL_free(timer);
+    }
+    if (data->worker_cond) {
+        SDL_DestroyCondition(data->worker_cond);
+        data->worker_cond = NULL;
+    }
+    if (data->worker_lock) {
+        SDL_DestroyMutex(data->worker_lock);
+        data->worker_lock = NULL;
+    }
+
     if (data->sem) {
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
     }
 
     // Clean up the timer entries
-    while (data->timers) {
-        timer = data->timers;
-        data->timers = timer->next;
+    while (data->num_timers > 0) {
+        SDL_free(data->timers[--data->num_timers]);
+    }
+    SDL_free(data->timers);
+    data->timers = NULL;
+    data->max_timers = 0;
+    while (data->pending) {
+        timer = data->pending;
+        data->pending = timer->next;
         SDL_free(timer);
     }
     while (data->freelist) {
@@ -276,11 +548,8 @@ void SDL_QuitTimers(void)
         data->freelist = timer->next;
         SDL_free(timer);
     }
-    while (data->timermap) {
-        entry = data->timermap;
-        data->timermap = entry->next;
-        SDL_free(entry);
-    }
+    SDL_DestroyHashTable(data->timermap);
+    data->timermap = NULL;
 
     if (data->timermap_lock) {
         SDL_DestroyMutex(data->timermap_lock);
@@ -295,11 +564,11 @@ static bool SDL_CheckInitTimers(void)
     return SDL_InitTimers();
 }
 
-static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata, int worker)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    bool added;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -317,9 +586,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     }
     SDL_UnlockSpinlock(&data->lock);
 
-    if (timer) {
-        SDL_RemoveTimer(timer->timerID);
-    } else {
+    if (!timer) {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
         if (!timer) {
             return 0;
@@ -331,20 +598,16 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->userdata = userdata;
     timer->interval = interval;
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
+    timer->worker = (worker >= 0 && data->num_workers > 0) ? (worker % data->num_workers) : -1;
     SDL_SetAtomicInt(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer, false);
+    SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     // Add the timer to the pending list for the timer thread
     SDL_LockSpinlock(&data->lock);
@@ -355,23 +618,50 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     // Wake up the timer thread if necessary
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata);
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata, -1);
 }
 
 SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(interval, NULL, callback, userdata);
+    return SDL_CreateTimer(interval, NULL, callback, userdata, -1);
+}
+
+SDL_TimerID SDL_AddTimerWithProperties(SDL_PropertiesID props)
+{
+    const Uint64 interval = (Uint64)SDL_GetNumberProperty(props, SDL_PROP_TIMER_CREATE_INTERVAL_NUMBER, 0);
+    SDL_NSTimerCallback callback = (SDL_NSTimerCallback)SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_CALLBACK_POINTER, NULL);
+    void *userdata = SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_USERDATA_POINTER, NULL);
+    const int worker = (int)SDL_GetNumberProperty(props, SDL_PROP_TIMER_CREATE_WORKER_NUMBER, -1);
+
+    return SDL_CreateTimer(interval, NULL, callback, userdata, worker);
+}
+
+bool SDL_GetTimerStatistics(SDL_TimerStatistics *stats, bool reset)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&data->stats_lock);
+    SDL_copyp(stats, &data->stats);
+    if (reset) {
+        SDL_zero(data->stats);
+    }
+    SDL_UnlockSpinlock(&data->stats_lock);
+    return true;
 }
 
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer = NULL;
     bool canceled = false;
 
     if (!id) {
@@ -380,25 +670,16 @@ bool SDL_RemoveTimer(SDL_TimerID id)
 
     // Find the timer
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
+    if (data->timermap && SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_GetAtomicInt(&entry->timer->canceled)) {
-            SDL_SetAtomicInt(&entry->timer->canceled, 1);
+    if (timer) {
+        if (!SDL_GetAtomicInt(&timer->canceled)) {
+            SDL_SetAtomicInt(&timer->canceled, 1);
             canceled = true;
         }
-        SDL_free(entry);
     }
     if (canceled) {
         return true;
@@ -502,6 +783,20 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
     return SDL_CreateTimer(interval, NULL, callback, userdata);
 }
 
+SDL_TimerID SDL_AddTimerWithProperties(SDL_PropertiesID props)
+{
+    const Uint64 interval = (Uint64)SDL_GetNumberProperty(props, SDL_PROP_TIMER_CREATE_INTERVAL_NUMBER, 0);
+    SDL_NSTimerCallback callback = (SDL_NSTimerCallback)SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_CALLBACK_POINTER, NULL);
+    void *userdata = SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_USERDATA_POINTER, NULL);
+
+    return SDL_CreateTimer(interval, NULL, callback, userdata);
+}
+
+bool SDL_GetTimerStatistics(SDL_TimerStatistics *stats, bool reset)
+{
+    return SDL_Unsupported();
+}
+
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -57,14 +57,11 @@
  *   where they are 16 bit. This makes the pixel data aligned at all times.
  *   Segments never wrap around from one scan line to the next.
  *
- *   The end of the sequence is marked by a zero <skip>,<run> pair at the *
+ *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of a line.
  *
  * Encoding of surfaces with per-pixel alpha:
  *
- *   The sequence begins with an SDL_PixelFormat value describing the target
- *   pixel format, to provide reliable un-encoding.
- *
  *   Each scan line is encoded twice: First all completely opaque pixels,
  *   encoded in the target format as described above, and then all
  *   partially transparent (translucent) pixels (where 1 <= alpha <= 254),
@@ -85,12 +82,40 @@
  *
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of an opaque line.
+ *
+ * The offset of each scan line in the sequence is kept alongside it, so
+ * clipped blits can start at any line, and the original pixels are kept
+ * while the surface is encoded. Locking the surface is then free, and when
+ * it is unlocked only the lines that were changed are encoded again and
+ * spliced into the sequence.
  */
 
 #include "SDL_sysvideo.h"
+#include "SDL_pixels_c.h"
 #include "SDL_surface_c.h"
 #include "SDL_RLEaccel_c.h"
 
+typedef struct SDL_RLELine
+{
+    size_t offset; // offset of the line in the encoded runs
+    int skipped;   // number of transparent pixels in the line
+    int segments;  // number of <skip> <run> pairs in the line
+} SDL_RLELine;
+
+typedef struct SDL_RLEData
+{
+    SDL_PixelFormat dst_format; // the format the runs were encoded for
+    bool alpha;                 // per-pixel alpha encoding instead of colorkey
+    bool automatic;             // encoded by SDL_AutoRLESurface()
+    Uint8 *runs;
+    size_t size;
+    SDL_RLELine *lines; // one per line, plus the end of the sequence
+    Sint64 skipped;
+    Sint64 segments;
+    int dirty_top;    // first line changed since the last encoding
+    int dirty_bottom; // one past the last line changed since the last encoding
+} SDL_RLEData;
+
 #define PIXEL_COPY(to, from, len, bpp) \
     SDL_memcpy(to, from, (size_t)(len) * (bpp))
 
@@ -445,6 +470,7 @@ static void RLEClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
 static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
                                 SDL_Surface *surf_dst, const SDL_Rect *dstrect)
 {
+    const SDL_RLEData *data = (const SDL_RLEData *)surf_src->map.data;
     Uint8 *dstbuf;
     Uint8 *srcbuf;
     int x, y;
@@ -462,50 +488,7 @@ static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *)surf_dst->pixels + y * surf_dst->pitch + x * surf_src->fmt->bytes_per_pixel;
-    srcbuf = (Uint8 *)surf_src->map.data + sizeof(SDL_PixelFormat);
-
-    {
-        // skip lines at the top if necessary
-        int vskip = srcrect->y;
-        int ofs = 0;
-        if (vskip) {
-
-#define RLESKIP(bpp, Type)          \
-    for (;;) {                      \
-        int run;                    \
-        ofs += *(Type *)srcbuf;     \
-        run = ((Type *)srcbuf)[1];  \
-        srcbuf += sizeof(Type) * 2; \
-        if (run) {                  \
-            srcbuf += run * bpp;    \
-            ofs += run;             \
-        } else if (!ofs)            \
-            goto done;              \
-        if (ofs == w) {             \
-            ofs = 0;                \
-            if (!--vskip)           \
-                break;              \
-        }                           \
-    }
-
-            switch (surf_src->fmt->bytes_per_pixel) {
-            case 1:
-                RLESKIP(1, Uint8);
-                break;
-            case 2:
-                RLESKIP(2, Uint8);
-                break;
-            case 3:
-                RLESKIP(3, Uint8);
-                break;
-            case 4:
-                RLESKIP(4, Uint16);
-                break;
-            }
-
-#undef RLESKIP
-        }
-    }
+    srcbuf = data->runs + data->lines[srcrect->y].offset;
 
     alpha = surf_src->map.info.a;
     // if left or right edge clipping needed, call clip blit
@@ -543,10 +526,9 @@ static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
 #undef RLEBLIT
     }
 
-done:
     // Unlock the destination if necessary
     if (SDL_MUSTLOCK(surf_dst)) {
-        SDL_UnlockSurface(surf_dst);
+        SDL_UnlockSurfaceRows(surf_dst, dstrect->y, srcrect->h);
     }
     return true;
 }
@@ -700,6 +682,7 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
 static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
                                      SDL_Surface *surf_dst, const SDL_Rect *dstrect)
 {
+    const SDL_RLEData *data = (const SDL_RLEData *)surf_src->map.data;
     int x, y;
     int w = surf_src->w;
     Uint8 *srcbuf, *dstbuf;
@@ -715,65 +698,7 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *)surf_dst->pixels + y * surf_dst->pitch + x * df->bytes_per_pixel;
-    srcbuf = (Uint8 *)surf_src->map.data + sizeof(SDL_PixelFormat);
-
-    {
-        // skip lines at the top if necessary
-        int vskip = srcrect->y;
-        if (vskip) {
-            int ofs;
-            if (df->bytes_per_pixel == 2) {
-                // the 16/32 interleaved format
-                do {
-                    // skip opaque line
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += srcbuf[0];
-                        run = srcbuf[1];
-                        srcbuf += 2;
-                        if (run) {
-                            srcbuf += 2 * run;
-                            ofs += run;
-                        } else if (ofs == 0) {
-                            goto done;
-                        }
-                    } while (ofs < w);
-
-                    // skip padding
-                    srcbuf += (uintptr_t)srcbuf & 2;
-
-                    // skip translucent line
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *)srcbuf)[0];
-                        run = ((Uint16 *)srcbuf)[1];
-                        srcbuf += 4 * (run + 1);
-                        ofs += run;
-                    } while (ofs < w);
-                } while (--vskip);
-            } else {
-                // the 32/32 interleaved format
-                vskip <<= 1; // opaque and translucent have same format
-                do {
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *)srcbuf)[0];
-                        run = ((Uint16 *)srcbuf)[1];
-                        srcbuf += 4;
-                        if (run) {
-                            srcbuf += 4 * run;
-                            ofs += run;
-                        } else if (ofs == 0) {
-                            goto done;
-                        }
-                    } while (ofs < w);
-                } while (--vskip);
-            }
-        }
-    }
+    srcbuf = data->runs + data->lines[srcrect->y].offset;
 
     // if left or right edge clipping needed, call clip blit
     if (srcrect->x || srcrect->w != surf_src->w) {
@@ -847,7 +772,7 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
 done:
     // Unlock the destination if necessary
     if (SDL_MUSTLOCK(surf_dst)) {
-        SDL_UnlockSurface(surf_dst);
+        SDL_UnlockSurfaceRows(surf_dst, dstrect->y, srcrect->h);
     }
     return true;
 }
@@ -856,9 +781,7 @@ done:
  * Auxiliary functions:
  * The encoding functions take 32bpp rgb + a, and
  * return the number of bytes copied to the destination.
- * The decoding functions copy to 32bpp rgb + a, and
- * return the number of bytes copied from the source.
- * These are only used in the encoder and un-RLE code and are therefore not
+ * These are only used in the encoder and are therefore not
  * highly optimised.
  */
 
@@ -878,23 +801,6 @@ static int copy_opaque_16(void *dst, const Uint32 *src, int n,
     return n * 2;
 }
 
-// decode opaque pixels from 16bpp to 32bpp rgb + a
-static int uncopy_opaque_16(Uint32 *dst, const void *src, int n,
-                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
-{
-    int i;
-    const Uint16 *s = (const Uint16 *)src;
-    unsigned alpha = dfmt->Amask ? 255 : 0;
-    for (i = 0; i < n; i++) {
-        unsigned r, g, b;
-        RGB_FROM_PIXEL(*s, sfmt, r, g, b);
-        PIXEL_FROM_RGBA(*dst, dfmt, r, g, b, alpha);
-        s++;
-        dst++;
-    }
-    return n * 2;
-}
-
 // encode 32bpp rgb + a into 32bpp G0RAB format for blitting into 565
 static int copy_transl_565(void *dst, const Uint32 *src, int n,
                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
@@ -931,24 +837,6 @@ static int copy_transl_555(void *dst, const Uint32 *src, int n,
     return n * 4;
 }
 
-// decode translucent pixels from 32bpp GORAB to 32bpp rgb + a
-static int uncopy_transl_16(Uint32 *dst, const void *src, int n,
-                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
-{
-    int i;
-    const Uint32 *s = (const Uint32 *)src;
-    for (i = 0; i < n; i++) {
-        unsigned r, g, b, a;
-        Uint32 pix = *s++;
-        a = (pix & 0x3e0) >> 2;
-        pix = (pix & ~0x3e0) | pix >> 16;
-        RGB_FROM_PIXEL(pix, sfmt, r, g, b);
-        PIXEL_FROM_RGBA(*dst, dfmt, r, g, b, a);
-        dst++;
-    }
-    return n * 4;
-}
-
 // encode 32bpp rgba into 32bpp rgba, keeping alpha (dual purpose)
 static int copy_32(void *dst, const Uint32 *src, int n,
                    const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
@@ -965,119 +853,107 @@ static int copy_32(void *dst, const Uint32 *src, int n,
     return n * 4;
 }
 
-// decode 32bpp rgba into 32bpp rgba, keeping alpha (dual purpose)
-static int uncopy_32(Uint32 *dst, const void *src, int n,
-                     const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
-{
-    int i;
-    const Uint32 *s = (const Uint32 *)src;
-    for (i = 0; i < n; i++) {
-        unsigned r, g, b, a;
-        Uint32 pixel = *s++;
-        RGB_FROM_PIXEL(pixel, sfmt, r, g, b);
-        a = pixel >> 24;
-        PIXEL_FROM_RGBA(*dst, dfmt, r, g, b, a);
-        dst++;
-    }
-    return n * 4;
-}
-
-#define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
-
-#define ISTRANSL(pixel, fmt) \
-    ((unsigned)((((pixel)&fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
+typedef int (*copy_func)(void *, const Uint32 *, int,
+                         const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
 
-// convert surface to be quickly alpha-blittable onto dest, if possible
-static bool RLEAlphaSurface(SDL_Surface *surface)
+// find out whether the destination is one we support for alpha encoding
+static bool RLEAlphaCopyFuncs(const SDL_PixelFormatDetails *df, copy_func *copy_opaque, copy_func *copy_transl)
 {
-    SDL_Surface *dest;
-    const SDL_PixelFormatDetails *df;
-    int maxsize = 0;
-    int max_opaque_run;
-    int max_transl_run = 65535;
-    unsigned masksum;
-    Uint8 *rlebuf, *dst;
-    int (*copy_opaque)(void *, const Uint32 *, int,
-                       const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
-    int (*copy_transl)(void *, const Uint32 *, int,
-                       const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
-
-    dest = surface->map.info.dst_surface;
-    if (!dest) {
-        return false;
-    }
-    df = dest->fmt;
-    if (surface->fmt->bits_per_pixel != 32) {
-        return false; // only 32bpp source supported
-    }
+    unsigned masksum = df->Rmask | df->Gmask | df->Bmask;
 
-    /* find out whether the destination is one we support,
-       and determine the max size of the encoded result */
-    masksum = df->Rmask | df->Gmask | df->Bmask;
     switch (df->bytes_per_pixel) {
     case 2:
         // 16bpp: only support 565 and 555 formats
         switch (masksum) {
         case 0xffff:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                copy_opaque = copy_opaque_16;
-                copy_transl = copy_transl_565;
-            } else {
-                return false;
+                *copy_opaque = copy_opaque_16;
+                *copy_transl = copy_transl_565;
+                return true;
             }
             break;
         case 0x7fff:
             if (df->Gmask == 0x03e0 || df->Rmask == 0x03e0 || df->Bmask == 0x03e0) {
-                copy_opaque = copy_opaque_16;
-                copy_transl = copy_transl_555;
-            } else {
-                return false;
+                *copy_opaque = copy_opaque_16;
+                *copy_transl = copy_transl_555;
+                return true;
             }
             break;
         default:
-            return false;
+            break;
         }
-        max_opaque_run = 255; // runs stored as bytes
-
-        /* worst case is alternating opaque and translucent pixels,
-           with room for alignment padding between lines */
-        maxsize = surface->h * (2 + (4 + 2) * (surface->w + 1)) + 2;
         break;
     case 4:
-        if (masksum != 0x00ffffff) {
-            return false; // requires unused high byte
+        // requires unused high byte
+        if (masksum == 0x00ffffff) {
+            *copy_opaque = copy_32;
+            *copy_transl = copy_32;
+            return true;
         }
-        copy_opaque = copy_32;
-        copy_transl = copy_32;
-        max_opaque_run = 255; // runs stored as short ints
-
-        // worst case is alternating opaque and translucent pixels
-        maxsize = surface->h * 2 * 4 * (surface->w + 1) + 4;
         break;
     default:
-        return false; // anything else unsupported right now
+        break; // anything else unsupported right now
     }
+    return false;
+}
 
-    maxsize += sizeof(SDL_PixelFormat);
-    rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
-        return false;
+// the worst case size of one encoded line
+static size_t RLEMaxLineSize(const SDL_Surface *surface, const SDL_PixelFormatDetails *df, bool alpha)
+{
+    const size_t w = surface->w;
+    const size_t bpp = surface->fmt->bytes_per_pixel;
+
+    if (alpha) {
+        if (df->bytes_per_pixel == 2) {
+            /* worst case is alternating opaque and translucent pixels,
+               with room for alignment padding between lines */
+            return 2 + (4 + 2) * (w + 1);
+        }
+        // worst case is alternating opaque and translucent pixels
+        return 2 * 4 * (w + 1);
+    }
+
+    switch (bpp) {
+    case 1:
+        /* worst case is alternating opaque and transparent pixels,
+           starting with an opaque pixel */
+        return 3 * (w / 2 + 1);
+    case 2:
+    case 3:
+        // worst case is solid runs, at most 255 pixels wide
+        return 2 * (w / 255 + 1) + w * bpp;
+    default:
+        // worst case is solid runs, at most 65535 pixels wide
+        return 4 * (w / 65535 + 1) + w * 4;
     }
-    // save the destination format so we can undo the encoding later
-    *(SDL_PixelFormat *)rlebuf = dest->format;
-    dst = rlebuf + sizeof(SDL_PixelFormat);
-
-    // Do the actual encoding
-    {
-        int x, y;
-        int h = surface->h, w = surface->w;
-        const SDL_PixelFormatDetails *sf = surface->fmt;
-        Uint32 *src = (Uint32 *)surface->pixels;
-        Uint8 *lastline = dst; // end of last non-blank line
-
-        // opaque counts are 8 or 16 bits, depending on target depth
+}
+
+#define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
+
+#define ISTRANSL(pixel, fmt) \
+    ((unsigned)((((pixel)&fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
+
+// encode a line of a surface with per-pixel alpha, returning the end of the encoded line
+static Uint8 *RLEAlphaLine(const SDL_Surface *surface, const SDL_PixelFormatDetails *df,
+                           int y, Uint8 *dst, SDL_RLELine *line)
+{
+    const SDL_PixelFormatDetails *sf = surface->fmt;
+    const Uint32 *src = (const Uint32 *)((const Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+    const int w = surface->w;
+    const int max_opaque_run = 255; // runs stored as bytes or short ints
+    const int max_transl_run = 65535;
+    copy_func copy_opaque = NULL;
+    copy_func copy_transl = NULL;
+    int x, runstart, skipstart;
+    int drawn = 0;
+
+    RLEAlphaCopyFuncs(df, &copy_opaque, &copy_transl);
+
+    line->segments = 0;
+
+    // opaque counts are 8 or 16 bits, depending on target depth
 #define ADD_OPAQUE_COUNTS(n, m)           \
-    if (df->bytes_per_pixel == 4) {         \
+    if (df->bytes_per_pixel == 4) {       \
         ((Uint16 *)dst)[0] = (Uint16)n;   \
         ((Uint16 *)dst)[1] = (Uint16)m;   \
         dst += 4;                         \
@@ -1085,119 +961,87 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
         dst[0] = (Uint8)n;                \
         dst[1] = (Uint8)m;                \
         dst += 2;                         \
-    }
+    }                                     \
+    line->segments++;
 
-        // translucent counts are always 16 bit
+    // translucent counts are always 16 bit
 #define ADD_TRANSL_COUNTS(n, m) \
-    (((Uint16 *)dst)[0] = (Uint16)n, ((Uint16 *)dst)[1] = (Uint16)m, dst += 4)
-
-        for (y = 0; y < h; y++) {
-            int runstart, skipstart;
-            int blankline = 0;
-            // First encode all opaque pixels of a scan line
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
-                runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
-                skip = runstart - skipstart;
-                if (skip == w) {
-                    blankline = 1;
-                }
-                run = x - runstart;
-                while (skip > max_opaque_run) {
-                    ADD_OPAQUE_COUNTS(max_opaque_run, 0);
-                    skip -= max_opaque_run;
-                }
-                len = SDL_min(run, max_opaque_run);
-                ADD_OPAQUE_COUNTS(skip, len);
-                dst += copy_opaque(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = SDL_min(run, max_opaque_run);
-                    ADD_OPAQUE_COUNTS(0, len);
-                    dst += copy_opaque(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-            } while (x < w);
-
-            // Make sure the next output address is 32-bit aligned
-            dst += (uintptr_t)dst & 2;
-
-            // Next, encode all translucent pixels of the same scan line
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf)) {
-                    x++;
-                }
-                runstart = x;
-                while (x < w && ISTRANSL(src[x], sf)) {
-                    x++;
-                }
-                skip = runstart - skipstart;
-                blankline &= (skip == w);
-                run = x - runstart;
-                while (skip > max_transl_run) {
-                    ADD_TRANSL_COUNTS(max_transl_run, 0);
-                    skip -= max_transl_run;
-                }
-                len = SDL_min(run, max_transl_run);
-                ADD_TRANSL_COUNTS(skip, len);
-                dst += copy_transl(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = SDL_min(run, max_transl_run);
-                    ADD_TRANSL_COUNTS(0, len);
-                    dst += copy_transl(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-                if (!blankline) {
-                    lastline = dst;
-                }
-            } while (x < w);
-
-            src += surface->pitch >> 2;
+    (((Uint16 *)dst)[0] = (Uint16)n, ((Uint16 *)dst)[1] = (Uint16)m, dst += 4, line->segments++)
+
+    // First encode all opaque pixels of a scan line
+    x = 0;
+    do {
+        int run, skip, len;
+        skipstart = x;
+        while (x < w && !ISOPAQUE(src[x], sf)) {
+            x++;
         }
-        dst = lastline; // back up past trailing blank lines
-        ADD_OPAQUE_COUNTS(0, 0);
-    }
+        runstart = x;
+        while (x < w && ISOPAQUE(src[x], sf)) {
+            x++;
+        }
+        skip = runstart - skipstart;
+        run = x - runstart;
+        drawn += run;
+        while (skip > max_opaque_run) {
+            ADD_OPAQUE_COUNTS(max_opaque_run, 0);
+            skip -= max_opaque_run;
+        }
+        len = SDL_min(run, max_opaque_run);
+        ADD_OPAQUE_COUNTS(skip, len);
+        dst += copy_opaque(dst, src + runstart, len, sf, df);
+        runstart += len;
+        run -= len;
+        while (run) {
+            len = SDL_min(run, max_opaque_run);
+            ADD_OPAQUE_COUNTS(0, len);
+            dst += copy_opaque(dst, src + runstart, len, sf, df);
+            runstart += len;
+            run -= len;
+        }
+    } while (x < w);
+
+    // Make sure the next output address is 32-bit aligned
+    dst += (uintptr_t)dst & 2;
+
+    // Next, encode all translucent pixels of the same scan line
+    x = 0;
+    do {
+        int run, skip, len;
+        skipstart = x;
+        while (x < w && !ISTRANSL(src[x], sf)) {
+            x++;
+        }
+        runstart = x;
+        while (x < w && ISTRANSL(src[x], sf)) {
+            x++;
+        }
+        skip = runstart - skipstart;
+        run = x - runstart;
+        drawn += run;
+        while (skip > max_transl_run) {
+            ADD_TRANSL_COUNTS(max_transl_run, 0);
+            skip -= max_transl_run;
+        }
+        len = SDL_min(run, max_transl_run);
+        ADD_TRANSL_COUNTS(skip, len);
+        dst += copy_transl(dst, src + runstart, len, sf, df);
+        runstart += len;
+        run -= len;
+        while (run) {
+            len = SDL_min(run, max_transl_run);
+            ADD_TRANSL_COUNTS(0, len);
+            dst += copy_transl(dst, src + runstart, len, sf, df);
+            runstart += len;
+            run -= len;
+        }
+    } while (x < w);
 
 #undef ADD_OPAQUE_COUNTS
 #undef ADD_TRANSL_COUNTS
 
-    // Now that we have it encoded, release the original pixels
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
-    }
-
-    // reallocate the buffer to release unused memory
-    {
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
-        }
-        surface->map.data = p;
-    }
-
-    return true;
+    line->skipped = w - drawn;
+    return dst;
 }
 
 static Uint32 getpix_8(const Uint8 *srcbuf)
@@ -1230,63 +1074,20 @@ static const getpix_func getpixes[4] = {
     getpix_8, getpix_16, getpix_24, getpix_32
 };
 
-static bool RLEColorkeySurface(SDL_Surface *surface)
+// encode a line of a colorkeyed surface, returning the end of the encoded line
+static Uint8 *RLEColorkeyLine(const SDL_Surface *surface, int y, Uint8 *dst, SDL_RLELine *line)
 {
-    SDL_Surface *dest;
-    Uint8 *rlebuf, *dst;
-    int maxn;
-    int y;
-    Uint8 *srcbuf, *lastline;
-    int maxsize = 0;
     const int bpp = surface->fmt->bytes_per_pixel;
-    getpix_func getpix;
-    Uint32 ckey, rgbmask;
-    int w, h;
-
-    dest = surface->map.info.dst_surface;
-    if (!dest) {
-        return false;
-    }
-
-    // calculate the worst case size for the compressed surface
-    switch (bpp) {
-    case 1:
-        /* worst case is alternating opaque and transparent pixels,
-           starting with an opaque pixel */
-        maxsize = surface->h * 3 * (surface->w / 2 + 1) + 2;
-        break;
-    case 2:
-    case 3:
-        // worst case is solid runs, at most 255 pixels wide
-        maxsize = surface->h * (2 * (surface->w / 255 + 1) + surface->w * bpp) + 2;
-        break;
-    case 4:
-        // worst case is solid runs, at most 65535 pixels wide
-        maxsize = surface->h * (4 * (surface->w / 65535 + 1) + surface->w * 4) + 4;
-        break;
-
-    default:
-        return false;
-    }
+    const Uint8 *srcbuf = (const Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+    const int maxn = bpp == 4 ? 65535 : 255;
+    const Uint32 rgbmask = ~surface->fmt->Amask;
+    const Uint32 ckey = surface->map.info.colorkey & rgbmask;
+    const getpix_func getpix = getpixes[bpp - 1];
+    const int w = surface->w;
+    int x = 0;
 
-    maxsize += sizeof(SDL_PixelFormat);
-    rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
-        return false;
-    }
-    // save the destination format so we can undo the encoding later
-    *(SDL_PixelFormat *)rlebuf = dest->format;
-
-    // Set up the conversion
-    srcbuf = (Uint8 *)surface->pixels;
-    maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf + sizeof(SDL_PixelFormat);
-    rgbmask = ~surface->fmt->Amask;
-    ckey = surface->map.info.colorkey & rgbmask;
-    lastline = dst;
-    getpix = getpixes[bpp - 1];
-    w = surface->w;
-    h = surface->h;
+    line->skipped = 0;
+    line->segments = 0;
 
 #define ADD_COUNTS(n, m)                \
     if (bpp == 4) {                     \
@@ -1297,103 +1098,150 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
         dst[0] = (Uint8)n;              \
         dst[1] = (Uint8)m;              \
         dst += 2;                       \
-    }
-
-    for (y = 0; y < h; y++) {
-        int x = 0;
-        int blankline = 0;
-        do {
-            int run, skip;
-            int len;
-            int runstart;
-            int skipstart = x;
-
-            // find run of transparent, then opaque pixels
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
-            }
-            runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
-            }
-            skip = runstart - skipstart;
-            if (skip == w) {
-                blankline = 1;
-            }
-            run = x - runstart;
-
-            // encode segment
-            while (skip > maxn) {
-                ADD_COUNTS(maxn, 0);
-                skip -= maxn;
-            }
+    }                                   \
+    line->segments++;
+
+    do {
+        int run, skip;
+        int len;
+        int runstart;
+        int skipstart = x;
+
+        // find run of transparent, then opaque pixels
+        while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
+            x++;
+        }
+        runstart = x;
+        while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
+            x++;
+        }
+        skip = runstart - skipstart;
+        run = x - runstart;
+        line->skipped += skip;
+
+        // encode segment
+        while (skip > maxn) {
+            ADD_COUNTS(maxn, 0);
+            skip -= maxn;
+        }
+        len = SDL_min(run, maxn);
+        ADD_COUNTS(skip, len);
+        SDL_memcpy(dst, srcbuf + runstart * bpp, (size_t)len * bpp);
+        dst += len * bpp;
+        run -= len;
+        runstart += len;
+        while (run) {
             len = SDL_min(run, maxn);
-            ADD_COUNTS(skip, len);
+            ADD_COUNTS(0, len);
             SDL_memcpy(dst, srcbuf + runstart * bpp, (size_t)len * bpp);
             dst += len * bpp;
-            run -= len;
             runstart += len;
-            while (run) {
-                len = SDL_min(run, maxn);
-                ADD_COUNTS(0, len);
-                SDL_memcpy(dst, srcbuf + runstart * bpp, (size_t)len * bpp);
-                dst += len * bpp;
-                runstart += len;
-                run -= len;
-            }
-            if (!blankline) {
-                lastline = dst;
-            }
-        } while (x < w);
+            run -= len;
+        }
+    } while (x < w);
+
+#undef ADD_COUNTS
+
+    return dst;
+}
+
+/*
+ * Encode the lines from top up to bottom, and splice them into the runs in
+ * place of their previous encoding. Every encoded line is a multiple of the
+ * pixel alignment long, so the lines after them stay aligned when moved.
+ */
+static bool RLEEncodeLines(SDL_Surface *surface, SDL_RLEData *data, int top, int bottom)
+{
+    const SDL_PixelFormatDetails *df = SDL_GetPixelFormatDetails(data->dst_format);
+    SDL_RLELine *lines = data->lines;
+    const size_t head = lines[top].offset;
+    const size_t old_end = lines[bottom].offset;
+    const size_t tail = data->size - old_end;
+    size_t maxsize, new_end;
+    Uint8 *runs, *dst, *p;
+    int y;
 
-        srcbuf += surface->pitch;
+    if (!df) {
+        return false;
     }
-    dst = lastline; // back up bast trailing blank lines
-    ADD_COUNTS(0, 0);
 
-#undef ADD_COUNTS
+    if (!SDL_size_mul_check_overflow((size_t)(bottom - top), RLEMaxLineSize(surface, df, data->alpha), &maxsize) ||
+        !SDL_size_add_check_overflow(maxsize, head + tail, &maxsize)) {
+        return SDL_SetError("RLE encoding would overflow");
+    }
+    runs = (Uint8 *)SDL_malloc(maxsize);
+    if (!runs) {
+        return false;
+    }
+
+    SDL_memcpy(runs, data->runs, head);
+    dst = runs + head;
+    for (y = top; y < bottom; ++y) {
+        SDL_RLELine *line = &lines[y];
 
-    // Now that we have it encoded, release the original pixels
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+        data->skipped -= line->skipped;
+        data->segments -= line->segments;
+        line->offset = (size_t)(dst - runs);
+        if (data->alpha) {
+            dst = RLEAlphaLine(surface, df, y, dst, line);
         } else {
-            SDL_free(surface->pixels);
+            dst = RLEColorkeyLine(surface, y, dst, line);
         }
-        surface->pixels = NULL;
+        data->skipped += line->skipped;
+        data->segments += line->segments;
     }
+    new_end = (size_t)(dst - runs);
+    SDL_memcpy(dst, data->runs + old_end, tail);
+    for (y = bottom; y <= surface->h; ++y) {
+        lines[y].offset = lines[y].offset - old_end + new_end;
+    }
+    data->size = new_end + tail;
 
-    // reallocate the buffer to release unused memory
-    {
-        // If SDL_realloc returns NULL, the original block is left intact
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
-        }
-        surface->map.data = p;
+    SDL_free(data->runs);
+
+    // If SDL_realloc returns NULL, the original block is left intact
+    p = (Uint8 *)SDL_realloc(runs, data->size);
+    if (!p) {
+        p = runs;
     }
+    data->runs = p;
 
     return true;
 }
 
-bool SDL_RLESurface(SDL_Surface *surface)
+static void RLEFreeData(SDL_RLEData *data)
 {
-    int flags;
-
-    // Clear any previous RLE conversion
-    if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        SDL_UnRLESurface(surface, true);
+    if (data) {
+        SDL_free(data->runs);
+        SDL_free(data->lines);
+        SDL_free(data);
     }
+}
+
+// automatic encodings are only kept if they skip a good part of the surface in long runs
+static bool RLEWorthwhile(const SDL_Surface *surface, const SDL_RLEData *data)
+{
+    const Sint64 pixels = (Sint64)surface->w * surface->h;
+
+    return (data->skipped * 4 >= pixels && pixels >= data->segments * 4);
+}
+
+// check whether the surface can be encoded for its blit, and encode it if so
+static SDL_RLEData *RLEEncodeSurface(SDL_Surface *surface)
+{
+    SDL_Surface *dest;
+    SDL_RLEData *data;
+    bool alpha;
+    int flags;
 
     // We don't support RLE encoding of bitmaps
     if (SDL_BITSPERPIXEL(surface->format) < 8) {
-        return false;
+        return NULL;
     }
 
     // Make sure the pixels are available
     if (!surface->pixels) {
-        return false;
+        return NULL;
     }
 
     flags = surface->map.info.flags;
@@ -1403,7 +1251,7 @@ bool SDL_RLESurface(SDL_Surface *surface)
         // ok
     } else {
         // If we don't have colorkey or blending, nothing to do...
-        return false;
+        return NULL;
     }
 
     // Pass on combinations not supported
@@ -1411,165 +1259,162 @@ bool SDL_RLESurface(SDL_Surface *surface)
         ((flags & SDL_COPY_MODULATE_ALPHA) && SDL_ISPIXELFORMAT_ALPHA(surface->format)) ||
         (flags & (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_ADD_PREMULTIPLIED | SDL_COPY_MOD | SDL_COPY_MUL)) ||
         (flags & SDL_COPY_NEAREST)) {
-        return false;
+        return NULL;
     }
 
-    // Encode and set up the blit
-    if (!SDL_ISPIXELFORMAT_ALPHA(surface->format) || !(flags & SDL_COPY_BLEND)) {
-        if (!surface->map.identity) {
-            return false;
+    dest = surface->map.info.dst_surface;
+    if (!dest) {
+        return NULL;
+    }
+
+    // Make sure we can encode for this combination
+    alpha = (SDL_ISPIXELFORMAT_ALPHA(surface->format) && (flags & SDL_COPY_BLEND));
+    if (alpha) {
+        copy_func copy_opaque, copy_transl;
+
+        if (surface->fmt->bits_per_pixel != 32) {
+            return NULL; // only 32bpp source supported
         }
-        if (!RLEColorkeySurface(surface)) {
-            return false;
+        if (!RLEAlphaCopyFuncs(dest->fmt, &copy_opaque, &copy_transl)) {
+            return NULL;
         }
-        surface->map.blit = SDL_RLEBlit;
-        surface->map.info.flags |= SDL_COPY_RLE_COLORKEY;
     } else {
-        if (!RLEAlphaSurface(surface)) {
-            return false;
+        if (!surface->map.identity) {
+            return NULL;
+        }
+        if (surface->fmt->bytes_per_pixel > 4) {
+            return NULL;
         }
+    }
+
+    // Start with an empty sequence and encode all the lines into it
+    data = (SDL_RLEData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return NULL;
+    }
+    data->dst_format = dest->format;
+    data->alpha = alpha;
+    data->size = 4;
+    data->runs = (Uint8 *)SDL_calloc(1, data->size);
+    data->lines = (SDL_RLELine *)SDL_calloc((size_t)surface->h + 1, sizeof(*data->lines));
+    data->dirty_top = surface->h;
+    data->dirty_bottom = 0;
+    if (!data->runs || !data->lines || !RLEEncodeLines(surface, data, 0, surface->h)) {
+        RLEFreeData(data);
+        return NULL;
+    }
+    return data;
+}
+
+static void RLESetupBlit(SDL_Surface *surface, SDL_RLEData *data)
+{
+    surface->map.data = data;
+    if (data->alpha) {
         surface->map.blit = SDL_RLEAlphaBlit;
         surface->map.info.flags |= SDL_COPY_RLE_ALPHAKEY;
+    } else {
+        surface->map.blit = SDL_RLEBlit;
+        surface->map.info.flags |= SDL_COPY_RLE_COLORKEY;
     }
 
     // The surface is now accelerated
     surface->internal_flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
+    SDL_UpdateSurfaceLockFlag(surface);
+}
+
+bool SDL_RLESurface(SDL_Surface *surface)
+{
+    SDL_RLEData *data;
 
+    // Clear any previous RLE conversion
+    if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        SDL_UnRLESurface(surface);
+    }
+
+    data = RLEEncodeSurface(surface);
+    if (!data) {
+        return false;
+    }
+    RLESetupBlit(surface, data);
     return true;
 }
 
-/*
- * Un-RLE a surface with pixel alpha
- * This may not give back exactly the image before RLE-encoding; all
- * completely transparent pixels will be lost, and color and alpha depth
- * may have been reduced (when encoding for 16bpp targets).
- */
-static bool UnRLEAlpha(SDL_Surface *surface)
+bool SDL_AutoRLESurface(SDL_Surface *surface)
 {
-    Uint8 *srcbuf;
-    Uint32 *dst;
-    const SDL_PixelFormatDetails *sf = surface->fmt;
-    const SDL_PixelFormatDetails *df = SDL_GetPixelFormatDetails(*(SDL_PixelFormat *)surface->map.data);
-    int (*uncopy_opaque)(Uint32 *, const void *, int,
-                         const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
-    int (*uncopy_transl)(Uint32 *, const void *, int,
-                         const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
-    int w = surface->w;
-    int bpp = df->bytes_per_pixel;
-    size_t size;
+    SDL_RLEData *data;
 
-    if (bpp == 2) {
-        uncopy_opaque = uncopy_opaque_16;
-        uncopy_transl = uncopy_transl_16;
-    } else {
-        uncopy_opaque = uncopy_transl = uncopy_32;
+    // The application may write to its own pixels at any time
+    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
+        return false;
     }
 
-    if (!SDL_size_mul_check_overflow(surface->h, surface->pitch, &size)) {
-        return false;
+    if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        SDL_UnRLESurface(surface);
     }
 
-    surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-    if (!surface->pixels) {
+    data = RLEEncodeSurface(surface);
+    if (!data) {
         return false;
     }
-    surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
-    // fill background with transparent pixels
-    SDL_memset(surface->pixels, 0, (size_t)surface->h * surface->pitch);
-
-    dst = (Uint32 *)surface->pixels;
-    srcbuf = (Uint8 *)surface->map.data + sizeof(SDL_PixelFormat);
-    for (;;) {
-        // copy opaque pixels
-        int ofs = 0;
-        do {
-            unsigned run;
-            if (bpp == 2) {
-                ofs += srcbuf[0];
-                run = srcbuf[1];
-                srcbuf += 2;
-            } else {
-                ofs += ((Uint16 *)srcbuf)[0];
-                run = ((Uint16 *)srcbuf)[1];
-                srcbuf += 4;
-            }
-            if (run) {
-                srcbuf += uncopy_opaque(dst + ofs, srcbuf, run, df, sf);
-                ofs += run;
-            } else if (!ofs) {
-                goto end_function;
-            }
-        } while (ofs < w);
+    if (!RLEWorthwhile(surface, data)) {
+        RLEFreeData(data);
+        surface->internal_flags |= SDL_INTERNAL_SURFACE_AUTO_RLE_REJECTED;
+        return false;
+    }
+    data->automatic = true;
+    RLESetupBlit(surface, data);
+    return true;
+}
 
-        // skip padding if needed
-        if (bpp == 2) {
-            srcbuf += (uintptr_t)srcbuf & 2;
-        }
+void SDL_UpdateRLESurface(SDL_Surface *surface, int y, int h)
+{
+    SDL_RLEData *data = (SDL_RLEData *)surface->map.data;
+    int top = SDL_max(y, 0);
+    int bottom = SDL_min(y + h, surface->h);
 
-        // copy translucent pixels
-        ofs = 0;
-        do {
-            unsigned run;
-            ofs += ((Uint16 *)srcbuf)[0];
-            run = ((Uint16 *)srcbuf)[1];
-            srcbuf += 4;
-            if (run) {
-                srcbuf += uncopy_transl(dst + ofs, srcbuf, run, df, sf);
-                ofs += run;
-            }
-        } while (ofs < w);
-        dst += surface->pitch >> 2;
+    if (top < bottom) {
+        data->dirty_top = SDL_min(data->dirty_top, top);
+        data->dirty_bottom = SDL_max(data->dirty_bottom, bottom);
     }
 
-end_function:
-    return true;
+    // Wait for the last lock to be released
+    if (surface->locked || data->dirty_top >= data->dirty_bottom) {
+        return;
+    }
+
+    top = data->dirty_top;
+    bottom = data->dirty_bottom;
+    data->dirty_top = surface->h;
+    data->dirty_bottom = 0;
+
+    if (!surface->map.info.dst_fmt) {
+        // The map was invalidated, the next blit will encode the whole surface again
+        SDL_UnRLESurface(surface);
+        return;
+    }
+
+    if (!RLEEncodeLines(surface, data, top, bottom)) {
+        SDL_UnRLESurface(surface);
+        SDL_InvalidateMap(&surface->map);
+    } else if (data->automatic && !RLEWorthwhile(surface, data)) {
+        SDL_UnRLESurface(surface);
+        SDL_InvalidateMap(&surface->map);
+        surface->internal_flags |= SDL_INTERNAL_SURFACE_AUTO_RLE_REJECTED;
+    }
 }
 
-void SDL_UnRLESurface(SDL_Surface *surface, bool recode)
+void SDL_UnRLESurface(SDL_Surface *surface)
 {
     if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
         surface->internal_flags &= ~SDL_INTERNAL_SURFACE_RLEACCEL;
 
-        if (recode && !(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-            if (surface->map.info.flags & SDL_COPY_RLE_COLORKEY) {
-                SDL_Rect full;
-                size_t size;
-
-                // re-create the original surface
-                if (!SDL_size_mul_check_overflow(surface->h, surface->pitch, &size)) {
-                    // Memory corruption?
-                    surface->internal_flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
-                    return;
-                }
-                surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-                if (!surface->pixels) {
-                    // Oh crap...
-                    surface->internal_flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
-                    return;
-                }
-                surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
-
-                // fill it with the background color
-                SDL_FillSurfaceRect(surface, NULL, surface->map.info.colorkey);
-
-                // now render the encoded surface
-                full.x = full.y = 0;
-                full.w = surface->w;
-                full.h = surface->h;
-                SDL_RLEBlit(surface, &full, surface, &full);
-            } else {
-                if (!UnRLEAlpha(surface)) {
-                    // Oh crap...
-                    surface->internal_flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
-                    return;
-                }
-            }
-        }
         surface->map.info.flags &=
             ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
 
-        SDL_free(surface->map.data);
+        RLEFreeData((SDL_RLEData *)surface->map.data);
         surface->map.data = NULL;
+
+        SDL_UpdateSurfaceLockFlag(surface);
     }
 }
 
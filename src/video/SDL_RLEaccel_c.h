@@ -27,6 +27,8 @@
 // Useful functions and variables from SDL_RLEaccel.c
 
 extern bool SDL_RLESurface(SDL_Surface *surface);
-extern void SDL_UnRLESurface(SDL_Surface *surface, bool recode);
+extern bool SDL_AutoRLESurface(SDL_Surface *surface);
+extern void SDL_UpdateRLESurface(SDL_Surface *surface, int y, int h);
+extern void SDL_UnRLESurface(SDL_Surface *surface);
 
 #endif // SDL_RLEaccel_c_h_
@@ -24,9 +24,30 @@
 #include "SDL_surface_c.h"
 #include "SDL_blit_auto.h"
 #include "SDL_blit_copy.h"
+#include "SDL_blit_pipeline.h"
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_surface_threads.h"
+
+typedef struct
+{
+    const SDL_BlitInfo *info;
+    SDL_BlitFunc blit;
+} SoftBlitRows;
+
+static bool SDL_SoftBlitRows(void *userdata, int y, int h)
+{
+    const SoftBlitRows *rows = (const SoftBlitRows *)userdata;
+    SDL_BlitInfo info = *rows->info;
+
+    info.src += y * info.src_pitch;
+    info.src_h = h;
+    info.dst += y * info.dst_pitch;
+    info.dst_h = h;
+    rows->blit(&info);
+    return true;
+}
 
 // The general purpose software blit routine
 static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
@@ -61,9 +82,10 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     // Set up source and destination buffer pointers, and BLIT!
     if (okay) {
         SDL_BlitFunc RunBlit;
-        SDL_BlitInfo *info = &src->map.info;
+        SDL_BlitInfo blit_info = src->map.info;
+        SDL_BlitInfo *info = &blit_info;
 
-        // Set up the blit information
+        // Set up the blit information on a copy, so the same surface can be blitted to different places at once
         info->src = (Uint8 *)src->pixels +
                     (Uint16)srcrect->y * src->pitch +
                     (Uint16)srcrect->x * info->src_fmt->bytes_per_pixel;
@@ -83,15 +105,30 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         RunBlit = (SDL_BlitFunc)src->map.data;
 
         // Run the actual software blit
-        RunBlit(info);
+        if (info->src_w == info->dst_w && info->src_h == info->dst_h &&
+            !info->palette_map && src != dst &&
+            (Sint64)info->dst_w * info->dst_h >= SDL_SURFACE_THREADS_MIN_PIXELS) {
+            // Unscaled rows are independent, so they can be split across threads
+            SoftBlitRows rows;
+            rows.info = info;
+            rows.blit = RunBlit;
+            if (RunBlit == SDL_Blit_Slow_Float) {
+                // Don't race to create the properties that the float blitter looks at
+                SDL_GetSurfaceProperties(src);
+                SDL_GetSurfaceProperties(dst);
+            }
+            SDL_RunSurfaceRows(info->dst_w, info->dst_h, 1, SDL_SoftBlitRows, &rows);
+        } else {
+            RunBlit(info);
+        }
     }
 
     // We need to unlock the surfaces if they're locked
     if (dst_locked) {
-        SDL_UnlockSurface(dst);
+        SDL_UnlockSurfaceRows(dst, dstrect->y, dstrect->h);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceRows(src, 0, 0);
     }
     // Blit is done!
     return okay;
@@ -175,6 +212,18 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
 }
 #endif // SDL_HAVE_BLIT_AUTO
 
+// The cached stage pipeline for this combination, or the per-pixel fallback if it can't be set up
+static SDL_BlitFunc SDL_ChooseGenericBlit(SDL_BlitMap *map)
+{
+#ifndef TEST_SLOW_BLIT
+    if (SDL_GetHintBoolean(SDL_HINT_SURFACE_BLIT_PIPELINE, true) &&
+        SDL_SetupBlitPipeline(&map->info)) {
+        return SDL_Blit_Pipeline;
+    }
+#endif
+    return SDL_Blit_Slow;
+}
+
 // Figure out which of many blit routines to set up on a surface
 bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 {
@@ -191,8 +240,8 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 
 #ifdef SDL_HAVE_RLE
     // Clean everything out to start
-    if (surface->flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        SDL_UnRLESurface(surface, true);
+    if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        SDL_UnRLESurface(surface);
     }
 #endif
 
@@ -210,6 +259,11 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         if (SDL_RLESurface(surface)) {
             return true;
         }
+    } else if (!(surface->internal_flags & (SDL_INTERNAL_SURFACE_NO_AUTO_RLE | SDL_INTERNAL_SURFACE_AUTO_RLE_REJECTED)) &&
+               SDL_GetHintBoolean(SDL_HINT_SURFACE_AUTO_RLE, false)) {
+        if (SDL_AutoRLESurface(surface)) {
+            return true;
+        }
     }
 #endif
 
@@ -226,7 +280,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
             blit = SDL_BlitCopy;
         } else if (SDL_ISPIXELFORMAT_10BIT(surface->format) ||
                    SDL_ISPIXELFORMAT_10BIT(dst->format)) {
-            blit = SDL_Blit_Slow;
+            blit = SDL_ChooseGenericBlit(map);
         }
 #ifdef SDL_HAVE_BLIT_0
         else if (SDL_BITSPERPIXEL(surface->format) < 8 &&
@@ -275,7 +329,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
             (!SDL_ISPIXELFORMAT_INDEXED(dst_format) ||
              (dst_format == SDL_PIXELFORMAT_INDEX8 && dst->palette)) &&
             !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-            blit = SDL_Blit_Slow;
+            blit = SDL_ChooseGenericBlit(map);
         }
     }
     map->data = (void *)blit;
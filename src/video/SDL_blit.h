@@ -71,6 +71,7 @@ typedef struct
     const SDL_Palette *dst_pal;
     Uint8 *table;
     SDL_HashTable *palette_map;
+    const struct SDL_BlitPipeline *pipeline;
     int flags;
     Uint32 colorkey;
     Uint8 r, g, b, a;
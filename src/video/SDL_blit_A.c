@@ -24,6 +24,7 @@
 
 #include "SDL_pixels_c.h"
 #include "SDL_surface_c.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 // Functions to perform alpha blended blitting
 
@@ -178,8 +179,9 @@ static void SDL_TARGETING("sse2") Blit888to888SurfaceAlphaSSE2(SDL_BlitInfo *inf
     Uint8 *dst = info->dst;
     int dstskip = info->dst_skip;
     Uint8 alpha = info->a;
+    const Uint32 dstAmask = ~(info->dst_fmt->Rmask | info->dst_fmt->Gmask | info->dst_fmt->Bmask);
 
-    const __m128i alpha_fill_mask = _mm_set1_epi32((int)0xff000000);
+    const __m128i alpha_fill_mask = _mm_set1_epi32((int)dstAmask);
     const __m128i srcA = _mm_set1_epi16(alpha);
 
     while (height--) {
@@ -229,7 +231,84 @@ static void SDL_TARGETING("sse2") Blit888to888SurfaceAlphaSSE2(SDL_BlitInfo *inf
 
             FACTOR_BLEND_8888(src32, dst32, alpha);
 
-            *dst = dst32 | 0xff000000;
+            *(Uint32 *)dst = dst32 | dstAmask;
+
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static void SDL_TARGETING("avx2") Blit888to888SurfaceAlphaAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 alpha = info->a;
+    const Uint32 dstAmask = ~(info->dst_fmt->Rmask | info->dst_fmt->Gmask | info->dst_fmt->Bmask);
+
+    const __m256i alpha_fill_mask = _mm256_set1_epi32((int)dstAmask);
+    const __m256i srcA = _mm256_set1_epi16(alpha);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src pixels
+            __m256i src256 = _mm256_loadu_si256((__m256i *)src);
+
+            // Load 8 dst pixels
+            __m256i dst256 = _mm256_loadu_si256((__m256i *)dst);
+
+            __m256i src_lo = _mm256_unpacklo_epi8(src256, _mm256_setzero_si256());
+            __m256i src_hi = _mm256_unpackhi_epi8(src256, _mm256_setzero_si256());
+
+            __m256i dst_lo = _mm256_unpacklo_epi8(dst256, _mm256_setzero_si256());
+            __m256i dst_hi = _mm256_unpackhi_epi8(dst256, _mm256_setzero_si256());
+
+            // dst = ((src - dst) * srcA) + ((dst << 8) - dst)
+            dst_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(src_lo, dst_lo), srcA),
+                                      _mm256_sub_epi16(_mm256_slli_epi16(dst_lo, 8), dst_lo));
+            dst_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(src_hi, dst_hi), srcA),
+                                      _mm256_sub_epi16(_mm256_slli_epi16(dst_hi, 8), dst_hi));
+
+            // dst += 0x1U (use 0x80 to round instead of floor)
+            dst_lo = _mm256_add_epi16(dst_lo, _mm256_set1_epi16(1));
+            dst_hi = _mm256_add_epi16(dst_hi, _mm256_set1_epi16(1));
+
+            // dst = (dst + (dst >> 8)) >> 8
+            dst_lo = _mm256_srli_epi16(_mm256_add_epi16(dst_lo, _mm256_srli_epi16(dst_lo, 8)), 8);
+            dst_hi = _mm256_srli_epi16(_mm256_add_epi16(dst_hi, _mm256_srli_epi16(dst_hi, 8)), 8);
+
+            // The unpacks and the pack both work within 128-bit lanes, so the pixels stay in order
+            dst256 = _mm256_packus_epi16(dst_lo, dst_hi);
+
+            // Set the alpha channels of dst to 255
+            dst256 = _mm256_or_si256(dst256, alpha_fill_mask);
+
+            _mm256_storeu_si256((__m256i *)dst, dst256);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+
+            FACTOR_BLEND_8888(src32, dst32, alpha);
+
+            *(Uint32 *)dst = dst32 | dstAmask;
 
             src += 4;
             dst += 4;
@@ -1202,6 +1281,250 @@ static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaSwizzleAVX2(SDL_BlitIn
 
 #endif
 
+#ifdef SDL_AVX512F_INTRINSICS
+
+static void SDL_TARGETING("avx512f,avx512bw") Blit8888to8888PixelAlphaSwizzleAVX512BW(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    bool fill_alpha = !dstfmt->Amask;
+    Uint32 dstAmask, dstAshift;
+
+    SDL_Get8888AlphaMaskAndShift(dstfmt, &dstAmask, &dstAshift);
+
+    // The byte offsets for the start of each pixel, the shuffles work within 128-bit lanes
+    const __m512i mask_offsets = _mm512_broadcast_i32x4(_mm_set_epi8(
+        12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0));
+
+    const __m512i convert_mask = _mm512_add_epi32(
+        _mm512_set1_epi32(
+            ((srcfmt->Rshift >> 3) << dstfmt->Rshift) |
+            ((srcfmt->Gshift >> 3) << dstfmt->Gshift) |
+            ((srcfmt->Bshift >> 3) << dstfmt->Bshift)),
+        mask_offsets);
+
+    const __m512i alpha_splat_mask = _mm512_add_epi8(_mm512_set1_epi8(srcfmt->Ashift >> 3), mask_offsets);
+    const __m512i alpha_fill_mask = _mm512_set1_epi32((int)dstAmask);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 16 <= width; i += 16) {
+            // Load 16 src pixels
+            __m512i src512 = _mm512_loadu_si512((__m512i *)src);
+
+            // Load 16 dst pixels
+            __m512i dst512 = _mm512_loadu_si512((__m512i *)dst);
+
+            // Extract the alpha from each pixel and splat it into all the channels
+            __m512i srcA = _mm512_shuffle_epi8(src512, alpha_splat_mask);
+
+            // Convert to dst format
+            src512 = _mm512_shuffle_epi8(src512, convert_mask);
+
+            // Set the alpha channels of src to 255
+            src512 = _mm512_or_si512(src512, alpha_fill_mask);
+
+            // Duplicate each 8-bit alpha value into both bytes of 16-bit lanes
+            __m512i alpha_lo = _mm512_unpacklo_epi8(srcA, srcA);
+            __m512i alpha_hi = _mm512_unpackhi_epi8(srcA, srcA);
+
+            // Calculate 255-srcA in every second 8-bit lane (255-srcA = srcA^0xff)
+            alpha_lo = _mm512_xor_si512(alpha_lo, _mm512_set1_epi16((short)0xff00));
+            alpha_hi = _mm512_xor_si512(alpha_hi, _mm512_set1_epi16((short)0xff00));
+
+            // maddubs expects second argument to be signed, so subtract 128
+            src512 = _mm512_sub_epi8(src512, _mm512_set1_epi8((char)128));
+            dst512 = _mm512_sub_epi8(dst512, _mm512_set1_epi8((char)128));
+
+            // dst = srcA*(src-128) + (255-srcA)*(dst-128) = srcA*src + (255-srcA)*dst - 128*255
+            __m512i dst_lo = _mm512_maddubs_epi16(alpha_lo, _mm512_unpacklo_epi8(src512, dst512));
+            __m512i dst_hi = _mm512_maddubs_epi16(alpha_hi, _mm512_unpackhi_epi8(src512, dst512));
+
+            // dst += 0x1U (use 0x80 to round instead of floor) + 128*255 (to fix maddubs result)
+            dst_lo = _mm512_add_epi16(dst_lo, _mm512_set1_epi16(1 + 128 * 255));
+            dst_hi = _mm512_add_epi16(dst_hi, _mm512_set1_epi16(1 + 128 * 255));
+
+            // dst = (dst + (dst >> 8)) >> 8 = (dst * 257) >> 16
+            dst_lo = _mm512_mulhi_epu16(dst_lo, _mm512_set1_epi16(257));
+            dst_hi = _mm512_mulhi_epu16(dst_hi, _mm512_set1_epi16(257));
+
+            // Blend the pixels together and save the result
+            dst512 = _mm512_packus_epi16(dst_lo, dst_hi);
+            if (fill_alpha) {
+                dst512 = _mm512_or_si512(dst512, alpha_fill_mask);
+            }
+            _mm512_storeu_si512((__m512i *)dst, dst512);
+
+            src += 64;
+            dst += 64;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            ALPHA_BLEND_SWIZZLE_8888(src32, dst32, srcfmt, dstfmt);
+            if (fill_alpha) {
+                dst32 |= dstAmask;
+            }
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+
+// (a * b) / 255 in each 16-bit lane, rounded the same way as MULT_DIV_255()
+static SDL_INLINE __m256i SDL_TARGETING("avx2") MULT_DIV_255_AVX2(__m256i a, __m256i b)
+{
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1));
+    x = _mm256_add_epi16(x, _mm256_srli_epi16(x, 8));
+    return _mm256_srli_epi16(x, 8);
+}
+
+/* 32-bit RGBA->RGB(A) blending with pixel alpha and color and/or alpha modulation.
+   This matches the results of the generic blitters in SDL_blit_auto.c exactly,
+   which fill the unused byte of the destination with 0 instead of 255. */
+static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaModulateAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    const Uint32 modulateR = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const Uint32 modulateG = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const Uint32 modulateB = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const Uint32 modulateA = (info->flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    Uint32 dstAmask, dstAshift, keep_mask;
+
+    SDL_Get8888AlphaMaskAndShift(dstfmt, &dstAmask, &dstAshift);
+    keep_mask = dstfmt->Amask ? 0xFFFFFFFF : ~dstAmask;
+
+    // The byte offsets for the start of each pixel
+    const __m256i mask_offsets = _mm256_set_epi8(
+        28, 28, 28, 28, 24, 24, 24, 24, 20, 20, 20, 20, 16, 16, 16, 16, 12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0);
+
+    // Convert to dst format, with the src alpha in the dst alpha channel
+    const __m256i convert_mask = _mm256_add_epi32(
+        _mm256_set1_epi32(
+            ((srcfmt->Rshift >> 3) << dstfmt->Rshift) |
+            ((srcfmt->Gshift >> 3) << dstfmt->Gshift) |
+            ((srcfmt->Bshift >> 3) << dstfmt->Bshift) |
+            ((srcfmt->Ashift >> 3) << dstAshift)),
+        mask_offsets);
+
+    // The modulation of each channel, widened to 16 bits like the pixels will be
+    const __m256i modulate = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)(
+        (modulateR << dstfmt->Rshift) |
+        (modulateG << dstfmt->Gshift) |
+        (modulateB << dstfmt->Bshift) |
+        (modulateA << dstAshift))), _mm256_setzero_si256());
+
+    // After widening, each pixel takes 8 bytes and the alpha is the 16-bit value at alpha_index
+    const char alpha_index = (char)(dstAshift >> 2);
+    const __m256i alpha_splat_mask = _mm256_setr_epi8(
+        alpha_index, alpha_index + 1, alpha_index, alpha_index + 1, alpha_index, alpha_index + 1, alpha_index, alpha_index + 1,
+        alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9,
+        alpha_index, alpha_index + 1, alpha_index, alpha_index + 1, alpha_index, alpha_index + 1, alpha_index, alpha_index + 1,
+        alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9, alpha_index + 8, alpha_index + 9);
+    const __m256i alpha_channel = _mm256_set1_epi64x((Sint64)0xFF << (dstAshift * 2));
+    const __m256i keep = _mm256_set1_epi32((int)keep_mask);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src pixels, in the dst format
+            __m256i src256 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)src), convert_mask);
+
+            // Load 8 dst pixels
+            __m256i dst256 = _mm256_loadu_si256((__m256i *)dst);
+
+            __m256i src_lo = _mm256_unpacklo_epi8(src256, _mm256_setzero_si256());
+            __m256i src_hi = _mm256_unpackhi_epi8(src256, _mm256_setzero_si256());
+            __m256i dst_lo = _mm256_unpacklo_epi8(dst256, _mm256_setzero_si256());
+            __m256i dst_hi = _mm256_unpackhi_epi8(dst256, _mm256_setzero_si256());
+
+            // src = src * modulate
+            src_lo = MULT_DIV_255_AVX2(src_lo, modulate);
+            src_hi = MULT_DIV_255_AVX2(src_hi, modulate);
+
+            // Splat the modulated alpha into all the channels
+            __m256i alpha_lo = _mm256_shuffle_epi8(src_lo, alpha_splat_mask);
+            __m256i alpha_hi = _mm256_shuffle_epi8(src_hi, alpha_splat_mask);
+
+            // src = src * srcA, leaving the alpha channel alone
+            src_lo = MULT_DIV_255_AVX2(src_lo, _mm256_or_si256(alpha_lo, alpha_channel));
+            src_hi = MULT_DIV_255_AVX2(src_hi, _mm256_or_si256(alpha_hi, alpha_channel));
+
+            // dst = src + dst * (255 - srcA)
+            dst_lo = _mm256_add_epi16(src_lo, MULT_DIV_255_AVX2(dst_lo, _mm256_xor_si256(alpha_lo, _mm256_set1_epi16(0xff))));
+            dst_hi = _mm256_add_epi16(src_hi, MULT_DIV_255_AVX2(dst_hi, _mm256_xor_si256(alpha_hi, _mm256_set1_epi16(0xff))));
+
+            dst256 = _mm256_and_si256(_mm256_packus_epi16(dst_lo, dst_hi), keep);
+            _mm256_storeu_si256((__m256i *)dst, dst256);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 src32 = *(Uint32 *)src;
+            Uint32 dst32 = *(Uint32 *)dst;
+            Uint32 srcR = (src32 >> srcfmt->Rshift) & 0xFF;
+            Uint32 srcG = (src32 >> srcfmt->Gshift) & 0xFF;
+            Uint32 srcB = (src32 >> srcfmt->Bshift) & 0xFF;
+            Uint32 srcA = (src32 >> srcfmt->Ashift) & 0xFF;
+            Uint32 dstR = (dst32 >> dstfmt->Rshift) & 0xFF;
+            Uint32 dstG = (dst32 >> dstfmt->Gshift) & 0xFF;
+            Uint32 dstB = (dst32 >> dstfmt->Bshift) & 0xFF;
+            Uint32 dstA = (dst32 >> dstAshift) & 0xFF;
+
+            MULT_DIV_255(srcR, modulateR, srcR);
+            MULT_DIV_255(srcG, modulateG, srcG);
+            MULT_DIV_255(srcB, modulateB, srcB);
+            MULT_DIV_255(srcA, modulateA, srcA);
+            MULT_DIV_255(srcR, srcA, srcR);
+            MULT_DIV_255(srcG, srcA, srcG);
+            MULT_DIV_255(srcB, srcA, srcB);
+            MULT_DIV_255((255 - srcA), dstR, dstR);
+            MULT_DIV_255((255 - srcA), dstG, dstG);
+            MULT_DIV_255((255 - srcA), dstB, dstB);
+            MULT_DIV_255((255 - srcA), dstA, dstA);
+
+            dst32 = ((dstR + srcR) << dstfmt->Rshift) |
+                    ((dstG + srcG) << dstfmt->Gshift) |
+                    ((dstB + srcB) << dstfmt->Bshift) |
+                    ((dstA + srcA) << dstAshift);
+            *(Uint32 *)dst = dst32 & keep_mask;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
 #if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
 
 static void Blit8888to8888PixelAlphaSwizzleNEON(SDL_BlitInfo *info)
@@ -1392,6 +1715,11 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
         case 4:
             if (SDL_PIXELLAYOUT(sf->format) == SDL_PACKEDLAYOUT_8888 && sf->Amask &&
                 SDL_PIXELLAYOUT(df->format) == SDL_PACKEDLAYOUT_8888) {
+#ifdef SDL_AVX512F_INTRINSICS
+                if (SDL_HasAVX512BW()) {
+                    return Blit8888to8888PixelAlphaSwizzleAVX512BW;
+                }
+#endif
 #ifdef SDL_AVX2_INTRINSICS
                 if (SDL_HasAVX2()) {
                     return Blit8888to8888PixelAlphaSwizzleAVX2;
@@ -1461,6 +1789,11 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 
             case 4:
                 if (sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask && sf->bytes_per_pixel == 4) {
+#ifdef SDL_AVX2_INTRINSICS
+                    if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasAVX2()) {
+                        return Blit888to888SurfaceAlphaAVX2;
+                    }
+#endif
 #ifdef SDL_SSE2_INTRINSICS
                     if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasSSE2()) {
                         return Blit888to888SurfaceAlphaSSE2;
@@ -1477,6 +1810,19 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                 return BlitNtoNSurfaceAlpha;
             }
         }
+        SDL_FALLTHROUGH;
+
+    case SDL_COPY_MODULATE_COLOR | SDL_COPY_BLEND:
+    case SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+        // Per-pixel alpha blits with modulation, the rest are left to the generic blitters
+#ifdef SDL_AVX2_INTRINSICS
+        if (sf->Amask && SDL_PIXELLAYOUT(sf->format) == SDL_PACKEDLAYOUT_8888 &&
+            (df->format == SDL_PIXELFORMAT_XRGB8888 || df->format == SDL_PIXELFORMAT_ARGB8888 ||
+             df->format == SDL_PIXELFORMAT_XBGR8888 || df->format == SDL_PIXELFORMAT_ABGR8888) &&
+            SDL_HasAVX2()) {
+            return Blit8888to8888PixelAlphaModulateAVX2;
+        }
+#endif
         break;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
@@ -0,0 +1,742 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_c.h"
+#include "SDL_blit_pipeline.h"
+#include "SDL_pixels_c.h"
+
+/* This gives the same results as SDL_Blit_Slow(), but each stage runs over a
+ * chunk of pixels at a time, so there is no per-pixel dispatch on the formats
+ * and flags, and the simple loops can be vectorized by the compiler.
+ */
+
+#define PIPELINE_CHUNK 256
+
+typedef struct
+{
+    Uint32 r[PIPELINE_CHUNK];
+    Uint32 g[PIPELINE_CHUNK];
+    Uint32 b[PIPELINE_CHUNK];
+    Uint32 a[PIPELINE_CHUNK];
+} PipelineColors;
+
+typedef struct
+{
+    SDL_HashTable *palette_map;
+    const SDL_Palette *pal;
+    Uint32 last_pixel;
+    Uint8 last_index;
+} PipelineStoreState;
+
+// Reads pixels xs[0..n) of a row, and the raw pixel values for colorkey checks
+typedef void (*PipelineLoadFunc)(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors);
+
+// Modulates or blends the source colors, the result is left in src
+typedef void (*PipelineOpFunc)(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n);
+
+// Writes n pixels to a row, skipping the ones marked in skip, if there is one
+typedef void (*PipelineStoreFunc)(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n);
+
+#define PIPELINE_MAX_OPS 4
+
+typedef struct
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    int flags;
+} PipelineKey;
+
+// Held by the cache and by every blit map using it, so maps can outlive SDL_QuitBlitPipelines()
+typedef struct SDL_BlitPipeline
+{
+    SDL_AtomicInt refcount;
+    PipelineKey key;
+    PipelineLoadFunc load_src;
+    PipelineLoadFunc load_dst;
+    PipelineOpFunc ops[PIPELINE_MAX_OPS];
+    int num_ops;
+    PipelineStoreFunc store;
+} SDL_BlitPipeline;
+
+static SDL_InitState SDL_blit_pipelines_init;
+static SDL_HashTable *SDL_blit_pipelines;
+
+// Pixel loaders
+
+static void LoadIndex8(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 pixel = row[xs[i]];
+        const SDL_Color *color = &pal->colors[pixel];
+        pixels[i] = pixel;
+        colors->r[i] = color->r;
+        colors->g[i] = color->g;
+        colors->b[i] = color->b;
+        colors->a[i] = color->a;
+    }
+}
+
+#define DEFINE_LOAD_RGB(name, bpp)                                                                                                                       \
+    static void name(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors) \
+    {                                                                                                                                                    \
+        int i;                                                                                                                                           \
+        for (i = 0; i < n; ++i) {                                                                                                                        \
+            Uint8 *src = row + xs[i] * bpp;                                                                                                              \
+            Uint32 pixel, r, g, b;                                                                                                                       \
+            DISEMBLE_RGB(src, bpp, fmt, pixel, r, g, b);                                                                                                 \
+            if (bpp == 3) {                                                                                                                              \
+                pixel = (r << fmt->Rshift) | (g << fmt->Gshift) | (b << fmt->Bshift);                                                                    \
+            }                                                                                                                                            \
+            pixels[i] = pixel;                                                                                                                           \
+            colors->r[i] = r;                                                                                                                            \
+            colors->g[i] = g;                                                                                                                            \
+            colors->b[i] = b;                                                                                                                            \
+            colors->a[i] = 0xFF;                                                                                                                         \
+        }                                                                                                                                                \
+    }
+
+#define DEFINE_LOAD_RGBA(name, bpp)                                                                                                                      \
+    static void name(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors) \
+    {                                                                                                                                                    \
+        int i;                                                                                                                                           \
+        for (i = 0; i < n; ++i) {                                                                                                                        \
+            Uint8 *src = row + xs[i] * bpp;                                                                                                              \
+            Uint32 pixel, r, g, b, a;                                                                                                                    \
+            DISEMBLE_RGBA(src, bpp, fmt, pixel, r, g, b, a);                                                                                             \
+            if (bpp == 3) {                                                                                                                              \
+                pixel = (r << fmt->Rshift) | (g << fmt->Gshift) | (b << fmt->Bshift);                                                                    \
+            }                                                                                                                                            \
+            pixels[i] = pixel;                                                                                                                           \
+            colors->r[i] = r;                                                                                                                            \
+            colors->g[i] = g;                                                                                                                            \
+            colors->b[i] = b;                                                                                                                            \
+            colors->a[i] = a;                                                                                                                            \
+        }                                                                                                                                                \
+    }
+
+DEFINE_LOAD_RGB(LoadRGB1, 1)
+DEFINE_LOAD_RGB(LoadRGB2, 2)
+DEFINE_LOAD_RGB(LoadRGB3, 3)
+DEFINE_LOAD_RGB(LoadRGB4, 4)
+DEFINE_LOAD_RGBA(LoadRGBA1, 1)
+DEFINE_LOAD_RGBA(LoadRGBA2, 2)
+DEFINE_LOAD_RGBA(LoadRGBA4, 4)
+
+// 8 bits per channel, no expansion needed
+static void LoadRGB8888(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors)
+{
+    const Uint32 *src = (const Uint32 *)row;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 pixel = src[xs[i]];
+        pixels[i] = pixel;
+        colors->r[i] = (pixel >> fmt->Rshift) & 0xFF;
+        colors->g[i] = (pixel >> fmt->Gshift) & 0xFF;
+        colors->b[i] = (pixel >> fmt->Bshift) & 0xFF;
+        colors->a[i] = 0xFF;
+    }
+}
+
+static void LoadRGBA8888(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors)
+{
+    const Uint32 *src = (const Uint32 *)row;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 pixel = src[xs[i]];
+        pixels[i] = pixel;
+        colors->r[i] = (pixel >> fmt->Rshift) & 0xFF;
+        colors->g[i] = (pixel >> fmt->Gshift) & 0xFF;
+        colors->b[i] = (pixel >> fmt->Bshift) & 0xFF;
+        colors->a[i] = (pixel >> fmt->Ashift) & 0xFF;
+    }
+}
+
+#define DEFINE_LOAD_10BIT(name, CONVERT, opaque)                                                                                                         \
+    static void name(const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, Uint8 *row, const int *xs, int n, Uint32 *pixels, PipelineColors *colors) \
+    {                                                                                                                                                    \
+        const Uint32 *src = (const Uint32 *)row;                                                                                                         \
+        int i;                                                                                                                                           \
+        for (i = 0; i < n; ++i) {                                                                                                                        \
+            const Uint32 pixel = src[xs[i]];                                                                                                             \
+            Uint32 r, g, b, a;                                                                                                                           \
+            CONVERT(pixel, r, g, b, a);                                                                                                                  \
+            pixels[i] = pixel;                                                                                                                           \
+            colors->r[i] = r;                                                                                                                            \
+            colors->g[i] = g;                                                                                                                            \
+            colors->b[i] = b;                                                                                                                            \
+            colors->a[i] = opaque ? 0xFF : a;                                                                                                            \
+        }                                                                                                                                                \
+    }
+
+DEFINE_LOAD_10BIT(LoadXRGB2101010, RGBA_FROM_ARGB2101010, true)
+DEFINE_LOAD_10BIT(LoadXBGR2101010, RGBA_FROM_ABGR2101010, true)
+DEFINE_LOAD_10BIT(LoadARGB2101010, RGBA_FROM_ARGB2101010, false)
+DEFINE_LOAD_10BIT(LoadABGR2101010, RGBA_FROM_ABGR2101010, false)
+
+// Modulation and blending, matching the arithmetic in SDL_Blit_Slow()
+
+static void OpModulateColor(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    const Uint32 modulateR = info->r;
+    const Uint32 modulateG = info->g;
+    const Uint32 modulateB = info->b;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        src->r[i] = (src->r[i] * modulateR) / 255;
+        src->g[i] = (src->g[i] * modulateG) / 255;
+        src->b[i] = (src->b[i] * modulateB) / 255;
+    }
+}
+
+static void OpModulateAlpha(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    const Uint32 modulateA = info->a;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        src->a[i] = (src->a[i] * modulateA) / 255;
+    }
+}
+
+// Multiplying by an alpha of 255 is exact, so this doesn't need to check for it
+static void OpPremultiply(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 srcA = src->a[i];
+        src->r[i] = (src->r[i] * srcA) / 255;
+        src->g[i] = (src->g[i] * srcA) / 255;
+        src->b[i] = (src->b[i] * srcA) / 255;
+    }
+}
+
+static void OpBlend(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 inv_srcA = 255 - src->a[i];
+        src->r[i] = src->r[i] + (inv_srcA * dst->r[i]) / 255;
+        src->g[i] = src->g[i] + (inv_srcA * dst->g[i]) / 255;
+        src->b[i] = src->b[i] + (inv_srcA * dst->b[i]) / 255;
+        src->a[i] = src->a[i] + (inv_srcA * dst->a[i]) / 255;
+    }
+}
+
+static void OpBlendPremultiplied(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 inv_srcA = 255 - src->a[i];
+        src->r[i] = SDL_min(src->r[i] + (inv_srcA * dst->r[i]) / 255, 255);
+        src->g[i] = SDL_min(src->g[i] + (inv_srcA * dst->g[i]) / 255, 255);
+        src->b[i] = SDL_min(src->b[i] + (inv_srcA * dst->b[i]) / 255, 255);
+        src->a[i] = SDL_min(src->a[i] + (inv_srcA * dst->a[i]) / 255, 255);
+    }
+}
+
+// The remaining modes leave the destination alpha alone
+static void OpAdd(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        src->r[i] = SDL_min(src->r[i] + dst->r[i], 255);
+        src->g[i] = SDL_min(src->g[i] + dst->g[i], 255);
+        src->b[i] = SDL_min(src->b[i] + dst->b[i], 255);
+        src->a[i] = dst->a[i];
+    }
+}
+
+static void OpMod(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        src->r[i] = (src->r[i] * dst->r[i]) / 255;
+        src->g[i] = (src->g[i] * dst->g[i]) / 255;
+        src->b[i] = (src->b[i] * dst->b[i]) / 255;
+        src->a[i] = dst->a[i];
+    }
+}
+
+static void OpMul(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 inv_srcA = 255 - src->a[i];
+        src->r[i] = SDL_min(((src->r[i] * dst->r[i]) + (dst->r[i] * inv_srcA)) / 255, 255);
+        src->g[i] = SDL_min(((src->g[i] * dst->g[i]) + (dst->g[i] * inv_srcA)) / 255, 255);
+        src->b[i] = SDL_min(((src->b[i] * dst->b[i]) + (dst->b[i] * inv_srcA)) / 255, 255);
+        src->a[i] = dst->a[i];
+    }
+}
+
+// More than one blend flag matches no blend mode, and the destination is written back unchanged
+static void OpKeepDestination(const SDL_BlitInfo *info, PipelineColors *src, const PipelineColors *dst, int n)
+{
+    SDL_memcpy(src->r, dst->r, n * sizeof(Uint32));
+    SDL_memcpy(src->g, dst->g, n * sizeof(Uint32));
+    SDL_memcpy(src->b, dst->b, n * sizeof(Uint32));
+    SDL_memcpy(src->a, dst->a, n * sizeof(Uint32));
+}
+
+// Pixel writers
+
+static void StoreIndex8(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        Uint32 pixel;
+        if (skip && skip[i]) {
+            continue;
+        }
+        pixel = (colors->r[i] << 24) | (colors->g[i] << 16) | (colors->b[i] << 8) | colors->a[i];
+        if (pixel != state->last_pixel) {
+            state->last_pixel = pixel;
+            state->last_index = SDL_LookupRGBAColor(state->palette_map, pixel, state->pal);
+        }
+        row[i] = state->last_index;
+    }
+}
+
+#define DEFINE_STORE_RGB(name, bpp)                                                                                                          \
+    static void name(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n) \
+    {                                                                                                                                        \
+        int i;                                                                                                                               \
+        for (i = 0; i < n; ++i) {                                                                                                            \
+            Uint8 *dst = row + i * bpp;                                                                                                      \
+            if (skip && skip[i]) {                                                                                                           \
+                continue;                                                                                                                    \
+            }                                                                                                                                \
+            ASSEMBLE_RGB(dst, bpp, fmt, colors->r[i], colors->g[i], colors->b[i]);                                                           \
+        }                                                                                                                                    \
+    }
+
+#define DEFINE_STORE_RGBA(name, bpp)                                                                                                         \
+    static void name(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n) \
+    {                                                                                                                                        \
+        int i;                                                                                                                               \
+        for (i = 0; i < n; ++i) {                                                                                                            \
+            Uint8 *dst = row + i * bpp;                                                                                                      \
+            if (skip && skip[i]) {                                                                                                           \
+                continue;                                                                                                                    \
+            }                                                                                                                                \
+            ASSEMBLE_RGBA(dst, bpp, fmt, colors->r[i], colors->g[i], colors->b[i], colors->a[i]);                                            \
+        }                                                                                                                                    \
+    }
+
+DEFINE_STORE_RGB(StoreRGB1, 1)
+DEFINE_STORE_RGB(StoreRGB2, 2)
+DEFINE_STORE_RGB(StoreRGB3, 3)
+DEFINE_STORE_RGB(StoreRGB4, 4)
+DEFINE_STORE_RGBA(StoreRGBA1, 1)
+DEFINE_STORE_RGBA(StoreRGBA2, 2)
+DEFINE_STORE_RGBA(StoreRGBA4, 4)
+
+static void StoreRGB8888(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n)
+{
+    Uint32 *dst = (Uint32 *)row;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        if (skip && skip[i]) {
+            continue;
+        }
+        dst[i] = (colors->r[i] << fmt->Rshift) | (colors->g[i] << fmt->Gshift) | (colors->b[i] << fmt->Bshift) | fmt->Amask;
+    }
+}
+
+static void StoreRGBA8888(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n)
+{
+    Uint32 *dst = (Uint32 *)row;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        if (skip && skip[i]) {
+            continue;
+        }
+        dst[i] = (colors->r[i] << fmt->Rshift) | (colors->g[i] << fmt->Gshift) | (colors->b[i] << fmt->Bshift) | (colors->a[i] << fmt->Ashift);
+    }
+}
+
+#define DEFINE_STORE_10BIT(name, CONVERT, opaque)                                                                                            \
+    static void name(const SDL_PixelFormatDetails *fmt, PipelineStoreState *state, Uint8 *row, PipelineColors *colors, const Uint8 *skip, int n) \
+    {                                                                                                                                        \
+        Uint32 *dst = (Uint32 *)row;                                                                                                         \
+        int i;                                                                                                                               \
+        for (i = 0; i < n; ++i) {                                                                                                            \
+            Uint32 pixel, r, g, b, a;                                                                                                        \
+            if (skip && skip[i]) {                                                                                                           \
+                continue;                                                                                                                    \
+            }                                                                                                                                \
+            r = colors->r[i];                                                                                                                \
+            g = colors->g[i];                                                                                                                \
+            b = colors->b[i];                                                                                                                \
+            a = opaque ? 0xFF : colors->a[i];                                                                                                \
+            CONVERT(pixel, r, g, b, a);                                                                                                      \
+            dst[i] = pixel;                                                                                                                  \
+        }                                                                                                                                    \
+    }
+
+DEFINE_STORE_10BIT(StoreXRGB2101010, ARGB2101010_FROM_RGBA, true)
+DEFINE_STORE_10BIT(StoreXBGR2101010, ABGR2101010_FROM_RGBA, true)
+DEFINE_STORE_10BIT(StoreARGB2101010, ARGB2101010_FROM_RGBA, false)
+DEFINE_STORE_10BIT(StoreABGR2101010, ABGR2101010_FROM_RGBA, false)
+
+// Building the stage chain
+
+static bool Is8888(const SDL_PixelFormatDetails *fmt)
+{
+    return fmt->bytes_per_pixel == 4 && fmt->Rbits == 8 && fmt->Gbits == 8 && fmt->Bbits == 8 &&
+           (fmt->Abits == 8 || fmt->Abits == 0);
+}
+
+static PipelineLoadFunc ChooseLoadFunc(const SDL_PixelFormatDetails *fmt)
+{
+    if (fmt->bytes_per_pixel > 4) {
+        return NULL;
+    } else if (SDL_ISPIXELFORMAT_10BIT(fmt->format)) {
+        switch (fmt->format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+            return LoadXRGB2101010;
+        case SDL_PIXELFORMAT_XBGR2101010:
+            return LoadXBGR2101010;
+        case SDL_PIXELFORMAT_ARGB2101010:
+            return LoadARGB2101010;
+        case SDL_PIXELFORMAT_ABGR2101010:
+            return LoadABGR2101010;
+        default:
+            return NULL;
+        }
+    } else if (fmt->format == SDL_PIXELFORMAT_INDEX8) {
+        return LoadIndex8;
+    } else if (SDL_ISPIXELFORMAT_INDEXED(fmt->format) || SDL_ISPIXELFORMAT_FOURCC(fmt->format)) {
+        return NULL;
+    } else if (SDL_ISPIXELFORMAT_ALPHA(fmt->format)) {
+        if (Is8888(fmt)) {
+            return LoadRGBA8888;
+        }
+        switch (fmt->bytes_per_pixel) {
+        case 1:
+            return LoadRGBA1;
+        case 2:
+            return LoadRGBA2;
+        case 4:
+            return LoadRGBA4;
+        default:
+            return NULL;
+        }
+    } else {
+        if (Is8888(fmt)) {
+            return LoadRGB8888;
+        }
+        switch (fmt->bytes_per_pixel) {
+        case 1:
+            return LoadRGB1;
+        case 2:
+            return LoadRGB2;
+        case 3:
+            return LoadRGB3;
+        case 4:
+            return LoadRGB4;
+        default:
+            return NULL;
+        }
+    }
+}
+
+static PipelineStoreFunc ChooseStoreFunc(const SDL_PixelFormatDetails *fmt)
+{
+    if (fmt->bytes_per_pixel > 4) {
+        return NULL;
+    } else if (SDL_ISPIXELFORMAT_10BIT(fmt->format)) {
+        switch (fmt->format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+            return StoreXRGB2101010;
+        case SDL_PIXELFORMAT_XBGR2101010:
+            return StoreXBGR2101010;
+        case SDL_PIXELFORMAT_ARGB2101010:
+            return StoreARGB2101010;
+        case SDL_PIXELFORMAT_ABGR2101010:
+            return StoreABGR2101010;
+        default:
+            return NULL;
+        }
+    } else if (fmt->format == SDL_PIXELFORMAT_INDEX8) {
+        return StoreIndex8;
+    } else if (SDL_ISPIXELFORMAT_INDEXED(fmt->format) || SDL_ISPIXELFORMAT_FOURCC(fmt->format)) {
+        return NULL;
+    } else if (SDL_ISPIXELFORMAT_ALPHA(fmt->format)) {
+        if (Is8888(fmt)) {
+            return StoreRGBA8888;
+        }
+        switch (fmt->bytes_per_pixel) {
+        case 1:
+            return StoreRGBA1;
+        case 2:
+            return StoreRGBA2;
+        case 4:
+            return StoreRGBA4;
+        default:
+            return NULL;
+        }
+    } else {
+        if (Is8888(fmt)) {
+            return StoreRGB8888;
+        }
+        switch (fmt->bytes_per_pixel) {
+        case 1:
+            return StoreRGB1;
+        case 2:
+            return StoreRGB2;
+        case 3:
+            return StoreRGB3;
+        case 4:
+            return StoreRGB4;
+        default:
+            return NULL;
+        }
+    }
+}
+
+static SDL_BlitPipeline *CreateBlitPipeline(const PipelineKey *key)
+{
+    const SDL_PixelFormatDetails *src_fmt = SDL_GetPixelFormatDetails(key->src_format);
+    const SDL_PixelFormatDetails *dst_fmt = SDL_GetPixelFormatDetails(key->dst_format);
+    SDL_BlitPipeline *pipeline;
+    const int flags = key->flags;
+
+    if (!src_fmt || !dst_fmt) {
+        return NULL;
+    }
+
+    pipeline = (SDL_BlitPipeline *)SDL_calloc(1, sizeof(*pipeline));
+    if (!pipeline) {
+        return NULL;
+    }
+    SDL_SetAtomicInt(&pipeline->refcount, 1);
+    pipeline->key = *key;
+    pipeline->load_src = ChooseLoadFunc(src_fmt);
+    pipeline->store = ChooseStoreFunc(dst_fmt);
+    if (!pipeline->load_src || !pipeline->store) {
+        SDL_free(pipeline);
+        SDL_Unsupported();
+        return NULL;
+    }
+    if (flags & SDL_COPY_BLEND_MASK) {
+        pipeline->load_dst = ChooseLoadFunc(dst_fmt);
+        if (!pipeline->load_dst) {
+            SDL_free(pipeline);
+            SDL_Unsupported();
+            return NULL;
+        }
+    }
+
+    if (flags & SDL_COPY_MODULATE_COLOR) {
+        pipeline->ops[pipeline->num_ops++] = OpModulateColor;
+    }
+    if (flags & SDL_COPY_MODULATE_ALPHA) {
+        pipeline->ops[pipeline->num_ops++] = OpModulateAlpha;
+    }
+    if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+        pipeline->ops[pipeline->num_ops++] = OpPremultiply;
+    }
+    switch (flags & SDL_COPY_BLEND_MASK) {
+    case 0:
+        break;
+    case SDL_COPY_BLEND:
+        pipeline->ops[pipeline->num_ops++] = OpBlend;
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        pipeline->ops[pipeline->num_ops++] = OpBlendPremultiplied;
+        break;
+    case SDL_COPY_ADD:
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        pipeline->ops[pipeline->num_ops++] = OpAdd;
+        break;
+    case SDL_COPY_MOD:
+        pipeline->ops[pipeline->num_ops++] = OpMod;
+        break;
+    case SDL_COPY_MUL:
+        pipeline->ops[pipeline->num_ops++] = OpMul;
+        break;
+    default:
+        pipeline->ops[pipeline->num_ops++] = OpKeepDestination;
+        break;
+    }
+    return pipeline;
+}
+
+static void ReleaseBlitPipeline(SDL_BlitPipeline *pipeline)
+{
+    if (SDL_AtomicDecRef(&pipeline->refcount)) {
+        SDL_free(pipeline);
+    }
+}
+
+static void SDLCALL DestroyPipelineValue(void *unused, const void *key, const void *value)
+{
+    ReleaseBlitPipeline((SDL_BlitPipeline *)value);
+}
+
+static Uint32 SDLCALL HashPipelineKey(void *unused, const void *key)
+{
+    return SDL_murmur3_32(key, sizeof(PipelineKey), 0);
+}
+
+static bool SDLCALL MatchPipelineKey(void *unused, const void *a, const void *b)
+{
+    return SDL_memcmp(a, b, sizeof(PipelineKey)) == 0;
+}
+
+bool SDL_SetupBlitPipeline(SDL_BlitInfo *info)
+{
+    PipelineKey key;
+    SDL_BlitPipeline *pipeline;
+
+    SDL_ReleaseBlitPipeline(info);
+
+    if (SDL_ShouldInit(&SDL_blit_pipelines_init)) {
+        SDL_blit_pipelines = SDL_CreateHashTable(0, true, HashPipelineKey, MatchPipelineKey, DestroyPipelineValue, NULL);
+        if (!SDL_blit_pipelines) {
+            SDL_SetInitialized(&SDL_blit_pipelines_init, false);
+            return false;
+        }
+        SDL_SetInitialized(&SDL_blit_pipelines_init, true);
+    }
+
+    SDL_zero(key);
+    key.src_format = info->src_fmt->format;
+    key.dst_format = info->dst_fmt->format;
+    key.flags = info->flags & (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY);
+
+    if (!SDL_FindInHashTable(SDL_blit_pipelines, &key, (const void **)&pipeline)) {
+        pipeline = CreateBlitPipeline(&key);
+        if (!pipeline) {
+            return false;
+        }
+        if (!SDL_InsertIntoHashTable(SDL_blit_pipelines, &pipeline->key, pipeline, false)) {
+            SDL_free(pipeline);
+            // Another thread may have added the same one first
+            if (!SDL_FindInHashTable(SDL_blit_pipelines, &key, (const void **)&pipeline)) {
+                return false;
+            }
+        }
+    }
+    SDL_AtomicIncRef(&pipeline->refcount);
+    info->pipeline = pipeline;
+    return true;
+}
+
+void SDL_ReleaseBlitPipeline(SDL_BlitInfo *info)
+{
+    if (info->pipeline) {
+        ReleaseBlitPipeline((SDL_BlitPipeline *)info->pipeline);
+        info->pipeline = NULL;
+    }
+}
+
+void SDL_Blit_Pipeline(SDL_BlitInfo *info)
+{
+    const SDL_BlitPipeline *pipeline = info->pipeline;
+    const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
+    const int dstbpp = dst_fmt->bytes_per_pixel;
+    const bool colorkey = (info->flags & SDL_COPY_COLORKEY) != 0;
+    const Uint32 rgbmask = ~src_fmt->Amask;
+    const Uint32 ckey = info->colorkey & rgbmask;
+    PipelineColors src_colors, dst_colors;
+    PipelineStoreState state;
+    Uint32 pixels[PIPELINE_CHUNK];
+    int xs[PIPELINE_CHUNK], dst_xs[PIPELINE_CHUNK];
+    Uint8 skip[PIPELINE_CHUNK];
+    Uint64 posy, posx;
+    Uint64 incy, incx;
+    int i;
+
+    state.palette_map = info->palette_map;
+    state.pal = info->dst_pal;
+    state.last_pixel = 0;
+    state.last_index = 0;
+    if (dst_fmt->format == SDL_PIXELFORMAT_INDEX8) {
+        state.last_index = SDL_LookupRGBAColor(state.palette_map, state.last_pixel, state.pal);
+    }
+
+    for (i = 0; i < PIPELINE_CHUNK; ++i) {
+        dst_xs[i] = i;
+    }
+
+    incy = ((Uint64)info->src_h << 16) / info->dst_h;
+    incx = ((Uint64)info->src_w << 16) / info->dst_w;
+    posy = incy / 2; // start at the middle of pixel
+
+    while (info->dst_h--) {
+        Uint8 *src = info->src + (posy >> 16) * info->src_pitch;
+        Uint8 *dst = info->dst;
+        int x, n;
+
+        posx = incx / 2; // start at the middle of pixel
+        for (x = 0; x < info->dst_w; x += n, dst += n * dstbpp) {
+            n = SDL_min(info->dst_w - x, PIPELINE_CHUNK);
+
+            for (i = 0; i < n; ++i) {
+                xs[i] = (int)(posx >> 16);
+                posx += incx;
+            }
+            pipeline->load_src(src_fmt, info->src_pal, src, xs, n, pixels, &src_colors);
+
+            if (colorkey) {
+                for (i = 0; i < n; ++i) {
+                    skip[i] = ((pixels[i] & rgbmask) == ckey);
+                }
+            }
+            if (pipeline->load_dst) {
+                pipeline->load_dst(dst_fmt, info->dst_pal, dst, dst_xs, n, pixels, &dst_colors);
+            }
+            for (i = 0; i < pipeline->num_ops; ++i) {
+                pipeline->ops[i](info, &src_colors, &dst_colors, n);
+            }
+            pipeline->store(dst_fmt, &state, dst, &src_colors, colorkey ? skip : NULL, n);
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+void SDL_QuitBlitPipelines(void)
+{
+    if (SDL_ShouldQuit(&SDL_blit_pipelines_init)) {
+        SDL_DestroyHashTable(SDL_blit_pipelines);
+        SDL_blit_pipelines = NULL;
+        SDL_SetInitialized(&SDL_blit_pipelines_init, false);
+    }
+}
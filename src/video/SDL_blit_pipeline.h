@@ -0,0 +1,36 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_blit_pipeline_h_
+#define SDL_blit_pipeline_h_
+
+#include "SDL_internal.h"
+
+/* Blits that have no dedicated function are run as a chain of stages:
+ * load and convert the source, modulate, blend with the destination, and store.
+ * The chain for each combination of formats and flags is built once and cached.
+ */
+extern bool SDL_SetupBlitPipeline(SDL_BlitInfo *info);
+extern void SDL_Blit_Pipeline(SDL_BlitInfo *info);
+extern void SDL_ReleaseBlitPipeline(SDL_BlitInfo *info);
+extern void SDL_QuitBlitPipelines(void);
+
+#endif // SDL_blit_pipeline_h_
@@ -25,6 +25,7 @@
 #include "SDL_sysvideo.h"
 #include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
+#include "SDL_blit_pipeline.h"
 
 // Lookup tables to expand partial bytes to the full 0..255 range
 
@@ -1478,6 +1479,7 @@ void SDL_InvalidateMap(SDL_BlitMap *map)
         SDL_DestroyHashTable(map->info.palette_map);
         map->info.palette_map = NULL;
     }
+    SDL_ReleaseBlitPipeline(&map->info);
 }
 
 bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
@@ -1492,7 +1494,7 @@ bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
     map = &src->map;
 #ifdef SDL_HAVE_RLE
     if (src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        SDL_UnRLESurface(src, true);
+        SDL_UnRLESurface(src);
     }
 #endif
     SDL_InvalidateMap(map);
@@ -21,9 +21,11 @@
 #include "SDL_internal.h"
 
 #include "SDL_surface_c.h"
+#include "SDL_surface_threads.h"
 
 static bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static bool SDL_StretchSurfaceUncheckedFiltered(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
 bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -82,8 +84,10 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
 
     switch (scaleMode) {
     case SDL_SCALEMODE_NEAREST:
-        break;
     case SDL_SCALEMODE_LINEAR:
+    case SDL_SCALEMODE_BICUBIC:
+    case SDL_SCALEMODE_LANCZOS:
+    case SDL_SCALEMODE_AREA:
         break;
     case SDL_SCALEMODE_PIXELART:
         scaleMode = SDL_SCALEMODE_NEAREST;
@@ -92,7 +96,7 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         return SDL_InvalidParamError("scaleMode");
     }
 
-    if (scaleMode == SDL_SCALEMODE_LINEAR) {
+    if (scaleMode != SDL_SCALEMODE_NEAREST) {
         if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
             return SDL_SetError("Wrong format");
         }
@@ -157,16 +161,18 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
         result = SDL_StretchSurfaceUncheckedNearest(src, srcrect, dst, dstrect);
-    } else {
+    } else if (scaleMode == SDL_SCALEMODE_LINEAR) {
         result = SDL_StretchSurfaceUncheckedLinear(src, srcrect, dst, dstrect);
+    } else {
+        result = SDL_StretchSurfaceUncheckedFiltered(src, srcrect, dst, dstrect, scaleMode);
     }
 
     // We need to unlock the surfaces if they're locked
     if (dst_locked) {
-        SDL_UnlockSurface(dst);
+        SDL_UnlockSurfaceRows(dst, dstrect->y, dstrect->h);
     }
     if (src_locked) {
-        SDL_UnlockSurface(src);
+        SDL_UnlockSurfaceRows(src, 0, 0);
     }
 
     return result;
@@ -196,11 +202,13 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
     int left_pad_w_init, right_pad_w_init, dst_gap, middle_init;                      \
     get_scaler_datas(src_h, dst_h, &fp_sum_h, &fp_step_h, &left_pad_h, &right_pad_h); \
     get_scaler_datas(src_w, dst_w, &fp_sum_w, &fp_step_w, &left_pad_w, &right_pad_w); \
+    fp_sum_h += (Sint64)first_row * fp_step_h;                                        \
     fp_sum_w_init = fp_sum_w + left_pad_w * fp_step_w;                                \
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
     dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    middle_init = dst_w - left_pad_w - right_pad_w;                                   \
+    dst = (Uint32 *)((Uint8 *)dst + (Sint64)first_row * dst_pitch);
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -228,6 +236,33 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
     left_pad_w = left_pad_w_init;                                      \
     middle = middle_init;
 
+// The destination rows are independent, so they can be split across threads
+typedef struct
+{
+    const Uint32 *src;
+    int src_w;
+    int src_h;
+    int src_pitch;
+    Uint32 *dst;
+    int dst_w;
+    int dst_h;
+    int dst_pitch;
+    int bpp;
+} StretchRows;
+
+static void SetupStretchRows(StretchRows *rows, SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
+{
+    rows->bpp = SDL_BYTESPERPIXEL(d->format);
+    rows->src_w = srcrect->w;
+    rows->src_h = srcrect->h;
+    rows->src_pitch = s->pitch;
+    rows->src = (const Uint32 *)((const Uint8 *)s->pixels + srcrect->x * rows->bpp + srcrect->y * rows->src_pitch);
+    rows->dst_w = dstrect->w;
+    rows->dst_h = dstrect->h;
+    rows->dst_pitch = d->pitch;
+    rows->dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * rows->bpp + dstrect->y * rows->dst_pitch);
+}
+
 #ifdef __clang__
 // Remove inlining of this function
 // Compiler crash with clang 9.0.8 / android-ndk-r21d
@@ -327,11 +362,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
     INTERPOL(tmp, tmp + 1, frac_w0, frac_w1, dst);
 }
 
-static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = first_row; i < first_row + num_rows; i++) {
 
         BILINEAR___HEIGHT
 
@@ -447,11 +482,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = first_row; i < first_row + num_rows; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -611,11 +646,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = first_row; i < first_row + num_rows; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -829,37 +864,38 @@ static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitc
 }
 #endif
 
-bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
+static bool SDL_StretchRowsLinear(void *userdata, int first_row, int num_rows)
 {
+    const StretchRows *rows = (const StretchRows *)userdata;
     bool result = false;
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
 
 #ifdef SDL_NEON_INTRINSICS
     if (!result && hasNEON()) {
-        result = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat_NEON(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
     if (!result && hasSSE2()) {
-        result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat_SSE(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
     }
 #endif
 
     if (!result) {
-        result = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
     }
 
     return result;
 }
 
+bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
+{
+    StretchRows rows;
+
+    SetupStretchRows(&rows, s, srcrect, d, dstrect);
+    return SDL_RunSurfaceRows(rows.dst_w, rows.dst_h, 1, SDL_StretchRowsLinear, &rows);
+}
+
 #define SDL_SCALE_NEAREST__START          \
     int i;                                \
     Uint64 posy, incy;                    \
@@ -870,7 +906,8 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     incy = ((Uint64)src_h << 16) / dst_h; \
     incx = ((Uint64)src_w << 16) / dst_w; \
     dst_gap = dst_pitch - bpp * dst_w;    \
-    posy = incy / 2;
+    posy = incy / 2 + first_row * incy;   \
+    dst = (Uint32 *)((Uint8 *)dst + (Sint64)first_row * dst_pitch);
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
@@ -879,11 +916,11 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     posx = incx / 2;                                                      \
     n = dst_w;
 
-static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < num_rows; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -898,11 +935,11 @@ static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < num_rows; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -917,11 +954,11 @@ static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < num_rows; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -938,11 +975,11 @@ static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int first_row, int num_rows)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < num_rows; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -957,26 +994,498 @@ static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
+static bool SDL_StretchRowsNearest(void *userdata, int first_row, int num_rows)
+{
+    const StretchRows *rows = (const StretchRows *)userdata;
+
+    if (rows->bpp == 4) {
+        return scale_mat_nearest_4(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
+    } else if (rows->bpp == 3) {
+        return scale_mat_nearest_3(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
+    } else if (rows->bpp == 2) {
+        return scale_mat_nearest_2(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
+    } else {
+        return scale_mat_nearest_1(rows->src, rows->src_w, rows->src_h, rows->src_pitch, rows->dst, rows->dst_w, rows->dst_h, rows->dst_pitch, first_row, num_rows);
+    }
+}
+
 bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
-    int bpp = SDL_BYTESPERPIXEL(d->format);
-
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
-
-    if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
-    } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
-    } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    StretchRows rows;
+
+    SetupStretchRows(&rows, s, srcrect, d, dstrect);
+    return SDL_RunSurfaceRows(rows.dst_w, rows.dst_h, 1, SDL_StretchRowsNearest, &rows);
+}
+
+/* Bicubic, Lanczos and area scaling are done as two separable passes:
+   every source row is filtered horizontally into a temporary image,
+   which is then filtered vertically into the destination.
+
+   Each destination pixel on an axis is a weighted sum of the same number of
+   consecutive source pixels, so the weights are computed once per axis up
+   front, in fixed point so the SIMD and C versions give identical results. */
+#define FILTER_BITS  14
+#define FILTER_ONE   (1 << FILTER_BITS)
+#define FILTER_ROUND (1 << (FILTER_BITS - 1))
+
+typedef struct
+{
+    int taps;        // number of source pixels per destination pixel
+    int stride;      // taps rounded up to an even number, the extra weight is 0
+    int *start;      // first source pixel for each destination pixel
+    Sint16 *weights; // stride weights for each destination pixel, summing to FILTER_ONE
+} StretchFilterAxis;
+
+typedef struct
+{
+    StretchFilterAxis x;
+    StretchFilterAxis y;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *tmp;
+    int tmp_pitch;
+    int tmp_first_row; // the source row in the first row of tmp
+    Uint8 *dst;
+    int dst_pitch;
+    int dst_w;
+} StretchFilter;
+
+static double FilterBicubic(double x)
+{
+    // Keys cubic convolution with a = -0.5
+    const double a = -0.5;
+
+    x = SDL_fabs(x);
+    if (x < 1.0) {
+        return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+    } else if (x < 2.0) {
+        return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+    }
+    return 0.0;
+}
+
+static double FilterLanczos3(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    } else if (x > -3.0 && x < 3.0) {
+        const double pix = SDL_PI_D * x;
+        return 3.0 * SDL_sin(pix) * SDL_sin(pix / 3.0) / (pix * pix);
+    }
+    return 0.0;
+}
+
+static void FreeFilterAxis(StretchFilterAxis *axis)
+{
+    SDL_free(axis->start);
+    SDL_free(axis->weights);
+    axis->start = NULL;
+    axis->weights = NULL;
+}
+
+static bool BuildFilterAxis(StretchFilterAxis *axis, int src_n, int dst_n, SDL_ScaleMode scaleMode)
+{
+    const double scale = (double)src_n / dst_n;
+    const double filter_scale = SDL_max(scale, 1.0);
+    double support;
+    double *values;
+    int i, k;
+
+    // When shrinking, the filter is stretched to cover all the source pixels
+    if (scaleMode == SDL_SCALEMODE_AREA) {
+        support = scale / 2.0;
+        axis->taps = (int)SDL_ceil(scale) + 1;
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        support = ((scaleMode == SDL_SCALEMODE_LANCZOS) ? 3.0 : 2.0) * filter_scale;
+        axis->taps = (int)SDL_ceil(support) * 2 + 1;
+    }
+    axis->taps = SDL_min(axis->taps, src_n);
+    axis->stride = (axis->taps + 1) & ~1;
+
+    axis->start = (int *)SDL_malloc(dst_n * sizeof(*axis->start));
+    axis->weights = (Sint16 *)SDL_calloc((size_t)dst_n * axis->stride, sizeof(*axis->weights));
+    values = (double *)SDL_malloc((axis->taps + 1) * sizeof(*values));
+    if (!axis->start || !axis->weights || !values) {
+        FreeFilterAxis(axis);
+        SDL_free(values);
+        return false;
+    }
+
+    for (i = 0; i < dst_n; ++i) {
+        const double center = (i + 0.5) * scale;
+        Sint16 *weights = axis->weights + i * axis->stride;
+        double total = 0.0;
+        int first, count, offset, sum, largest;
+
+        if (scaleMode == SDL_SCALEMODE_AREA) {
+            first = (int)SDL_floor(center - support);
+            count = (int)SDL_ceil(center + support) - first;
+        } else {
+            first = (int)SDL_floor(center - support + 0.5);
+            count = (int)SDL_floor(center + support + 0.5) - first;
+        }
+        if (first < 0) {
+            count += first;
+            first = 0;
+        }
+        count = SDL_min(count, src_n - first);
+        count = SDL_clamp(count, 1, axis->taps + 1);
+
+        for (k = 0; k < count; ++k) {
+            const double x = first + k;
+            double value;
+            if (scaleMode == SDL_SCALEMODE_AREA) {
+                // How much of the source pixel is covered by the destination pixel
+                value = SDL_min(x + 1.0, center + support) - SDL_max(x, center - support);
+                value = SDL_max(value, 0.0);
+            } else if (scaleMode == SDL_SCALEMODE_LANCZOS) {
+                value = FilterLanczos3((x + 0.5 - center) / filter_scale);
+            } else {
+                value = FilterBicubic((x + 0.5 - center) / filter_scale);
+            }
+            values[k] = value;
+            total += value;
+        }
+        if (total == 0.0) {
+            values[0] = total = 1.0;
+        }
+
+        // Rounding can add an uncovered pixel at either end of the area
+        while (count > 1 && values[count - 1] == 0.0) {
+            --count;
+        }
+        while (count > 1 && values[0] == 0.0) {
+            SDL_memmove(values, values + 1, (count - 1) * sizeof(*values));
+            ++first;
+            --count;
+        }
+        count = SDL_min(count, axis->taps);
+
+        // Keep all the taps inside the source, padding with zero weights at the edges
+        axis->start[i] = SDL_min(first, src_n - axis->taps);
+        offset = first - axis->start[i];
+
+        sum = 0;
+        largest = 0;
+        for (k = 0; k < count; ++k) {
+            weights[offset + k] = (Sint16)SDL_floor(values[k] / total * FILTER_ONE + 0.5);
+            sum += weights[offset + k];
+            if (weights[offset + k] > weights[offset + largest]) {
+                largest = k;
+            }
+        }
+        // Flat areas have to stay flat, so put any rounding error in the largest weight
+        weights[offset + largest] += (Sint16)(FILTER_ONE - sum);
     }
+    SDL_free(values);
+    return true;
+}
+
+static SDL_INLINE Uint8 FILTER_CLAMP(int value)
+{
+    if (value < 0) {
+        return 0;
+    }
+    value >>= FILTER_BITS;
+    return (Uint8)SDL_min(value, 255);
+}
+
+// The two weights at w as a pair of 16-bit values, for _mm_madd_epi16()
+static SDL_INLINE int FILTER_PAIR(const Sint16 *w)
+{
+    return (int)((Uint16)w[0] | ((Uint32)(Uint16)w[1] << 16));
+}
+
+static void filter_row_horizontal(const Uint32 *src, Uint32 *dst, int x, int dst_w, const StretchFilterAxis *axis)
+{
+    for (; x < dst_w; ++x) {
+        const Uint8 *p = (const Uint8 *)(src + axis->start[x]);
+        const Sint16 *w = axis->weights + x * axis->stride;
+        int c0 = FILTER_ROUND, c1 = FILTER_ROUND, c2 = FILTER_ROUND, c3 = FILTER_ROUND;
+        Uint8 *d = (Uint8 *)(dst + x);
+        int k;
+
+        for (k = 0; k < axis->taps; ++k, p += 4) {
+            c0 += w[k] * p[0];
+            c1 += w[k] * p[1];
+            c2 += w[k] * p[2];
+            c3 += w[k] * p[3];
+        }
+        d[0] = FILTER_CLAMP(c0);
+        d[1] = FILTER_CLAMP(c1);
+        d[2] = FILTER_CLAMP(c2);
+        d[3] = FILTER_CLAMP(c3);
+    }
+}
+
+static void filter_row_vertical(const Uint8 *src, int src_pitch, Uint8 *dst, int b, int row_bytes, const Sint16 *w, int taps)
+{
+    for (; b < row_bytes; ++b) {
+        const Uint8 *p = src + b;
+        int c = FILTER_ROUND;
+        int k;
+
+        for (k = 0; k < taps; ++k, p += src_pitch) {
+            c += w[k] * *p;
+        }
+        dst[b] = FILTER_CLAMP(c);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Taps are paired up so _mm_madd_epi16() can do two multiplies and an add
+   at once: the bytes of two pixels are interleaved and widened to 16 bits
+   and multiplied with the two weights repeated over the register. */
+static void SDL_TARGETING("sse2") filter_row_horizontal_SSE(const Uint32 *src, Uint32 *dst, int dst_w, const StretchFilterAxis *axis)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const int taps = axis->taps;
+    int x;
+
+    for (x = 0; x < dst_w; ++x) {
+        const Uint32 *p = src + axis->start[x];
+        const Sint16 *w = axis->weights + x * axis->stride;
+        __m128i acc = _mm_set1_epi32(FILTER_ROUND);
+        __m128i pix;
+        int k = 0;
+
+        for (; k + 4 <= taps; k += 4) {
+            // [p0 p1 p2 p3] -> [p0 p2 p1 p3] -> bytes of p0 and p1 interleaved, then p2 and p3
+            pix = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(p + k)), _MM_SHUFFLE(3, 1, 2, 0));
+            pix = _mm_unpacklo_epi8(pix, _mm_srli_si128(pix, 8));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(pix, zero), _mm_set1_epi32(FILTER_PAIR(w + k))));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(pix, zero), _mm_set1_epi32(FILTER_PAIR(w + k + 2))));
+        }
+        if (k + 2 <= taps) {
+            pix = _mm_loadl_epi64((const __m128i *)(p + k));
+            pix = _mm_unpacklo_epi8(pix, _mm_srli_si128(pix, 4));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(pix, zero), _mm_set1_epi32(FILTER_PAIR(w + k))));
+            k += 2;
+        }
+        if (k < taps) {
+            // The other weight of the pair is the zero padding
+            pix = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)p[k]), zero), zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(pix, _mm_set1_epi32(FILTER_PAIR(w + k))));
+        }
+
+        acc = _mm_srai_epi32(acc, FILTER_BITS);
+        acc = _mm_packs_epi32(acc, acc);
+        acc = _mm_packus_epi16(acc, acc);
+        dst[x] = (Uint32)_mm_cvtsi128_si32(acc);
+    }
+}
+
+static int SDL_TARGETING("sse2") filter_row_vertical_SSE(const Uint8 *src, int src_pitch, Uint8 *dst, int row_bytes, const Sint16 *w, int taps)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int b;
+
+    for (b = 0; b + 16 <= row_bytes; b += 16) {
+        const Uint8 *p = src + b;
+        __m128i acc0 = _mm_set1_epi32(FILTER_ROUND);
+        __m128i acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        int k;
+
+        for (k = 0; k < taps; k += 2, p += 2 * src_pitch) {
+            const __m128i weights = _mm_set1_epi32(FILTER_PAIR(w + k));
+            const __m128i row0 = _mm_loadu_si128((const __m128i *)p);
+            const __m128i row1 = (k + 1 < taps) ? _mm_loadu_si128((const __m128i *)(p + src_pitch)) : zero;
+            const __m128i lo = _mm_unpacklo_epi8(row0, row1);
+            const __m128i hi = _mm_unpackhi_epi8(row0, row1);
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), weights));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), weights));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), weights));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), weights));
+        }
+
+        acc0 = _mm_packs_epi32(_mm_srai_epi32(acc0, FILTER_BITS), _mm_srai_epi32(acc1, FILTER_BITS));
+        acc2 = _mm_packs_epi32(_mm_srai_epi32(acc2, FILTER_BITS), _mm_srai_epi32(acc3, FILTER_BITS));
+        _mm_storeu_si128((__m128i *)(dst + b), _mm_packus_epi16(acc0, acc2));
+    }
+    return b;
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+// The same as the SSE2 versions, with a second pixel or 16 more bytes in the upper lane
+static int SDL_TARGETING("avx2") filter_row_horizontal_AVX2(const Uint32 *src, Uint32 *dst, int dst_w, const StretchFilterAxis *axis)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const int taps = axis->taps;
+    int x;
+
+    for (x = 0; x + 2 <= dst_w; x += 2) {
+        const Uint32 *p0 = src + axis->start[x];
+        const Uint32 *p1 = src + axis->start[x + 1];
+        const Sint16 *w0 = axis->weights + x * axis->stride;
+        const Sint16 *w1 = w0 + axis->stride;
+        __m256i acc = _mm256_set1_epi32(FILTER_ROUND);
+        __m256i pix;
+        __m128i result;
+        int k = 0;
+
+        for (; k + 4 <= taps; k += 4) {
+            pix = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p0 + k))), _mm_loadu_si128((const __m128i *)(p1 + k)), 1);
+            pix = _mm256_shuffle_epi32(pix, _MM_SHUFFLE(3, 1, 2, 0));
+            pix = _mm256_unpacklo_epi8(pix, _mm256_srli_si256(pix, 8));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_unpacklo_epi8(pix, zero), _mm256_setr_epi32(FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k))));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_unpackhi_epi8(pix, zero), _mm256_setr_epi32(FILTER_PAIR(w0 + k + 2), FILTER_PAIR(w0 + k + 2), FILTER_PAIR(w0 + k + 2), FILTER_PAIR(w0 + k + 2), FILTER_PAIR(w1 + k + 2), FILTER_PAIR(w1 + k + 2), FILTER_PAIR(w1 + k + 2), FILTER_PAIR(w1 + k + 2))));
+        }
+        if (k + 2 <= taps) {
+            pix = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)(p0 + k))), _mm_loadl_epi64((const __m128i *)(p1 + k)), 1);
+            pix = _mm256_unpacklo_epi8(pix, _mm256_srli_si256(pix, 4));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_unpacklo_epi8(pix, zero), _mm256_setr_epi32(FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k))));
+            k += 2;
+        }
+        if (k < taps) {
+            pix = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_cvtsi32_si128((int)p0[k])), _mm_cvtsi32_si128((int)p1[k]), 1);
+            pix = _mm256_unpacklo_epi16(_mm256_unpacklo_epi8(pix, zero), zero);
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(pix, _mm256_setr_epi32(FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w0 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k), FILTER_PAIR(w1 + k))));
+        }
+
+        acc = _mm256_srai_epi32(acc, FILTER_BITS);
+        acc = _mm256_packs_epi32(acc, acc);
+        acc = _mm256_packus_epi16(acc, acc);
+        result = _mm256_castsi256_si128(acc);
+        dst[x] = (Uint32)_mm_cvtsi128_si32(result);
+        result = _mm256_extracti128_si256(acc, 1);
+        dst[x + 1] = (Uint32)_mm_cvtsi128_si32(result);
+    }
+    return x;
+}
+
+static int SDL_TARGETING("avx2") filter_row_vertical_AVX2(const Uint8 *src, int src_pitch, Uint8 *dst, int row_bytes, const Sint16 *w, int taps)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int b;
+
+    for (b = 0; b + 32 <= row_bytes; b += 32) {
+        const Uint8 *p = src + b;
+        __m256i acc0 = _mm256_set1_epi32(FILTER_ROUND);
+        __m256i acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        int k;
+
+        for (k = 0; k < taps; k += 2, p += 2 * src_pitch) {
+            const __m256i weights = _mm256_set1_epi32(FILTER_PAIR(w + k));
+            const __m256i row0 = _mm256_loadu_si256((const __m256i *)p);
+            const __m256i row1 = (k + 1 < taps) ? _mm256_loadu_si256((const __m256i *)(p + src_pitch)) : zero;
+            const __m256i lo = _mm256_unpacklo_epi8(row0, row1);
+            const __m256i hi = _mm256_unpackhi_epi8(row0, row1);
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), weights));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), weights));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), weights));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), weights));
+        }
+
+        // The unpacks and packs all work within each lane, so the bytes come out in order
+        acc0 = _mm256_packs_epi32(_mm256_srai_epi32(acc0, FILTER_BITS), _mm256_srai_epi32(acc1, FILTER_BITS));
+        acc2 = _mm256_packs_epi32(_mm256_srai_epi32(acc2, FILTER_BITS), _mm256_srai_epi32(acc3, FILTER_BITS));
+        _mm256_storeu_si256((__m256i *)(dst + b), _mm256_packus_epi16(acc0, acc2));
+    }
+    return b;
+}
+#endif
+
+static bool SDL_StretchRowsFilteredH(void *userdata, int first_row, int num_rows)
+{
+    const StretchFilter *filter = (const StretchFilter *)userdata;
+    int i;
+
+    for (i = first_row; i < first_row + num_rows; ++i) {
+        const Uint32 *src = (const Uint32 *)(filter->src + (Sint64)(filter->tmp_first_row + i) * filter->src_pitch);
+        Uint32 *dst = (Uint32 *)(filter->tmp + (Sint64)i * filter->tmp_pitch);
+        int x = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            x = filter_row_horizontal_AVX2(src, dst, filter->dst_w, &filter->x);
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (x == 0 && hasSSE2()) {
+            filter_row_horizontal_SSE(src, dst, filter->dst_w, &filter->x);
+            continue;
+        }
+#endif
+        filter_row_horizontal(src, dst, x, filter->dst_w, &filter->x);
+    }
+    return true;
+}
+
+static bool SDL_StretchRowsFilteredV(void *userdata, int first_row, int num_rows)
+{
+    const StretchFilter *filter = (const StretchFilter *)userdata;
+    const int row_bytes = filter->dst_w * 4;
+    int i;
+
+    for (i = first_row; i < first_row + num_rows; ++i) {
+        const Uint8 *src = filter->tmp + (Sint64)(filter->y.start[i] - filter->tmp_first_row) * filter->tmp_pitch;
+        const Sint16 *w = filter->y.weights + i * filter->y.stride;
+        Uint8 *dst = filter->dst + (Sint64)i * filter->dst_pitch;
+        int b = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            b = filter_row_vertical_AVX2(src, filter->tmp_pitch, dst, row_bytes, w, filter->y.taps);
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (hasSSE2()) {
+            b += filter_row_vertical_SSE(src + b, filter->tmp_pitch, dst + b, row_bytes - b, w, filter->y.taps);
+        }
+#endif
+        filter_row_vertical(src, filter->tmp_pitch, dst, b, row_bytes, w, filter->y.taps);
+    }
+    return true;
+}
+
+bool SDL_StretchSurfaceUncheckedFiltered(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    StretchFilter filter;
+    const bool scale_x = (srcrect->w != dstrect->w);
+    const bool scale_y = (srcrect->h != dstrect->h) || !scale_x;
+    int tmp_rows;
+    bool result = true;
+
+    SDL_zero(filter);
+    filter.src = (const Uint8 *)s->pixels + srcrect->x * 4 + (Sint64)srcrect->y * s->pitch;
+    filter.src_pitch = s->pitch;
+    filter.dst = (Uint8 *)d->pixels + dstrect->x * 4 + (Sint64)dstrect->y * d->pitch;
+    filter.dst_pitch = d->pitch;
+    filter.dst_w = dstrect->w;
+
+    if ((scale_x && !BuildFilterAxis(&filter.x, srcrect->w, dstrect->w, scaleMode)) ||
+        (scale_y && !BuildFilterAxis(&filter.y, srcrect->h, dstrect->h, scaleMode))) {
+        FreeFilterAxis(&filter.x);
+        return false;
+    }
+
+    if (!scale_y) {
+        // Only the width changes, so filter straight into the destination
+        filter.tmp = filter.dst;
+        filter.tmp_pitch = filter.dst_pitch;
+        result = SDL_RunSurfaceRows(dstrect->w, dstrect->h, 1, SDL_StretchRowsFilteredH, &filter);
+    } else if (!scale_x) {
+        // Only the height changes, so filter straight from the source
+        filter.tmp = (Uint8 *)filter.src;
+        filter.tmp_pitch = filter.src_pitch;
+        result = SDL_RunSurfaceRows(dstrect->w, dstrect->h, 1, SDL_StretchRowsFilteredV, &filter);
+    } else {
+        // Only the source rows that the vertical pass reads need filtering
+        filter.tmp_first_row = filter.y.start[0];
+        tmp_rows = filter.y.start[dstrect->h - 1] + filter.y.taps - filter.tmp_first_row;
+        filter.tmp_pitch = dstrect->w * 4;
+        filter.tmp = (Uint8 *)SDL_malloc((size_t)tmp_rows * filter.tmp_pitch);
+        if (!filter.tmp) {
+            result = false;
+        } else {
+            result = SDL_RunSurfaceRows(dstrect->w, tmp_rows, 1, SDL_StretchRowsFilteredH, &filter) &&
+                     SDL_RunSurfaceRows(dstrect->w, dstrect->h, 1, SDL_StretchRowsFilteredV, &filter);
+            SDL_free(filter.tmp);
+        }
+    }
+
+    FreeFilterAxis(&filter.x);
+    FreeFilterAxis(&filter.y);
+    return result;
 }
@@ -25,6 +25,7 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_stb_c.h"
+#include "SDL_surface_threads.h"
 #include "SDL_yuv_c.h"
 #include "../render/SDL_sysrender.h"
 
@@ -605,8 +606,10 @@ bool SDL_SetSurfaceRLE(SDL_Surface *surface, bool enabled)
     flags = surface->map.info.flags;
     if (enabled) {
         surface->map.info.flags |= SDL_COPY_RLE_DESIRED;
+        surface->internal_flags &= ~SDL_INTERNAL_SURFACE_NO_AUTO_RLE;
     } else {
         surface->map.info.flags &= ~SDL_COPY_RLE_DESIRED;
+        surface->internal_flags |= SDL_INTERNAL_SURFACE_NO_AUTO_RLE;
     }
     if (surface->map.info.flags != flags) {
         SDL_InvalidateMap(&surface->map);
@@ -621,7 +624,8 @@ bool SDL_SurfaceHasRLE(SDL_Surface *surface)
         return false;
     }
 
-    if (!(surface->map.info.flags & SDL_COPY_RLE_DESIRED)) {
+    if (!(surface->map.info.flags & SDL_COPY_RLE_DESIRED) &&
+        !(surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
         return false;
     }
 
@@ -1111,8 +1115,10 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
 
     switch (scaleMode) {
     case SDL_SCALEMODE_NEAREST:
-        break;
     case SDL_SCALEMODE_LINEAR:
+    case SDL_SCALEMODE_BICUBIC:
+    case SDL_SCALEMODE_LANCZOS:
+    case SDL_SCALEMODE_AREA:
         break;
     case SDL_SCALEMODE_PIXELART:
         scaleMode = SDL_SCALEMODE_NEAREST;
@@ -1307,8 +1313,8 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
             SDL_BYTESPERPIXEL(src->format) == 4 &&
             src->format != SDL_PIXELFORMAT_ARGB2101010) {
-            // fast path
-            return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            // fast path, the filters all work on 4 byte pixels
+            return SDL_StretchSurface(src, srcrect, dst, dstrect, scaleMode);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
@@ -1367,7 +1373,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
                 SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_StretchSurface(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_StretchSurface(src, &srcrect2, tmp2, NULL, scaleMode);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1380,7 +1386,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
                 result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
-                result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1754,15 +1760,7 @@ bool SDL_LockSurface(SDL_Surface *surface)
         return SDL_InvalidParamError("surface");
     }
 
-    if (!surface->locked) {
-#ifdef SDL_HAVE_RLE
-        // Perform the lock
-        if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-            SDL_UnRLESurface(surface, true);
-            surface->internal_flags |= SDL_INTERNAL_SURFACE_RLEACCEL; // save accel'd state
-        }
-#endif
-    }
+    // RLE encoded surfaces keep their pixels, so there's nothing to decode here
 
     // Increment the surface lock count, for recursive locks
     ++surface->locked;
@@ -1781,19 +1779,35 @@ void SDL_UnlockSurface(SDL_Surface *surface)
         return;
     }
 
+    SDL_UnlockSurfaceRows(surface, 0, surface->h);
+}
+
+/*
+ * Unlock a surface, where only rows y up to y + h may have been changed
+ */
+void SDL_UnlockSurfaceRows(SDL_Surface *surface, int y, int h)
+{
     // Only perform an unlock if we are locked
-    if (!surface->locked || (--surface->locked > 0)) {
+    if (!surface->locked) {
         return;
     }
+    --surface->locked;
 
 #ifdef SDL_HAVE_RLE
-    // Update RLE encoded surface with new data
+    if (h > 0) {
+        surface->internal_flags &= ~SDL_INTERNAL_SURFACE_AUTO_RLE_REJECTED;
+    }
+
+    // Update RLE encoded surface with new data, once the last lock is released
     if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        surface->internal_flags &= ~SDL_INTERNAL_SURFACE_RLEACCEL; // stop lying
-        SDL_RLESurface(surface);
+        SDL_UpdateRLESurface(surface, y, h);
     }
 #endif
 
+    if (surface->locked > 0) {
+        return;
+    }
+
     surface->flags &= ~SDL_SURFACE_LOCKED;
 }
 
@@ -2483,6 +2497,41 @@ static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src,
     }
 }
 
+typedef struct
+{
+    SDL_PixelFormat format;
+    int width;
+    const void *src;
+    int src_pitch;
+    void *dst;
+    int dst_pitch;
+} PremultiplyAlphaRows;
+
+static bool SDL_PremultiplyAlphaRows(void *userdata, int y, int h)
+{
+    const PremultiplyAlphaRows *rows = (const PremultiplyAlphaRows *)userdata;
+    const void *src = (const Uint8 *)rows->src + y * rows->src_pitch;
+    void *dst = (Uint8 *)rows->dst + y * rows->dst_pitch;
+
+    switch (rows->format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        SDL_PremultiplyAlpha_AXYZ8888(rows->width, h, src, rows->src_pitch, dst, rows->dst_pitch);
+        break;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        SDL_PremultiplyAlpha_XYZA8888(rows->width, h, src, rows->src_pitch, dst, rows->dst_pitch);
+        break;
+    case SDL_PIXELFORMAT_ARGB128_FLOAT:
+    case SDL_PIXELFORMAT_ABGR128_FLOAT:
+        SDL_PremultiplyAlpha_AXYZ128(rows->width, h, src, rows->src_pitch, dst, rows->dst_pitch);
+        break;
+    default:
+        return SDL_SetError("Unexpected internal pixel format");
+    }
+    return true;
+}
+
 static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear)
 {
     SDL_Surface *convert = NULL;
@@ -2490,6 +2539,7 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
     int final_dst_pitch = dst_pitch;
     SDL_PixelFormat format;
     SDL_Colorspace colorspace;
+    PremultiplyAlphaRows rows;
     bool result = false;
 
     if (!src) {
@@ -2554,21 +2604,13 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         dst_pitch = convert->pitch;
     }
 
-    switch (format) {
-    case SDL_PIXELFORMAT_ARGB8888:
-    case SDL_PIXELFORMAT_ABGR8888:
-        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_RGBA8888:
-    case SDL_PIXELFORMAT_BGRA8888:
-        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_ARGB128_FLOAT:
-    case SDL_PIXELFORMAT_ABGR128_FLOAT:
-        SDL_PremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    default:
-        SDL_SetError("Unexpected internal pixel format");
+    rows.format = format;
+    rows.width = width;
+    rows.src = src;
+    rows.src_pitch = src_pitch;
+    rows.dst = dst;
+    rows.dst_pitch = dst_pitch;
+    if (!SDL_RunSurfaceRows(width, height, 1, SDL_PremultiplyAlphaRows, &rows)) {
         goto done;
     }
 
@@ -3009,14 +3051,14 @@ void SDL_DestroySurface(SDL_Surface *surface)
 
     SDL_InvalidateMap(&surface->map);
 
-    while (surface->locked > 0) {
-        SDL_UnlockSurface(surface);
-    }
 #ifdef SDL_HAVE_RLE
     if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        SDL_UnRLESurface(surface, false);
+        SDL_UnRLESurface(surface);
     }
 #endif
+    while (surface->locked > 0) {
+        SDL_UnlockSurface(surface);
+    }
     SDL_SetSurfacePalette(surface, NULL);
 
     if (surface->flags & SDL_SURFACE_PREALLOCATED) {
@@ -33,6 +33,8 @@ typedef Uint32 SDL_SurfaceDataFlags;
 #define SDL_INTERNAL_SURFACE_DONTFREE   0x00000001u /**< Surface is referenced internally */
 #define SDL_INTERNAL_SURFACE_STACK      0x00000002u /**< Surface is allocated on the stack */
 #define SDL_INTERNAL_SURFACE_RLEACCEL   0x00000004u /**< Surface is RLE encoded */
+#define SDL_INTERNAL_SURFACE_NO_AUTO_RLE 0x00000008u /**< Surface is never RLE encoded automatically */
+#define SDL_INTERNAL_SURFACE_AUTO_RLE_REJECTED 0x00000010u /**< Surface wasn't worth RLE encoding automatically */
 
 // Surface internal data definition
 struct SDL_Surface
@@ -83,6 +85,7 @@ struct SDL_Surface
 // Surface functions
 extern bool SDL_SurfaceValid(SDL_Surface *surface);
 extern void SDL_UpdateSurfaceLockFlag(SDL_Surface *surface);
+extern void SDL_UnlockSurfaceRows(SDL_Surface *surface, int y, int h);
 extern bool SDL_CalculateSurfaceSize(SDL_PixelFormat format, int width, int height, size_t *size, size_t *pitch, bool minimalPitch);
 extern float SDL_GetDefaultSDRWhitePoint(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspace);
@@ -0,0 +1,225 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_threads.h"
+
+/* Large conversions, blits, alpha premultiplication and stretches are split
+ * into bands of rows. Each band is processed by exactly the same code that
+ * would process it on a single thread, so the output doesn't depend on the
+ * number of threads or on which thread got which band.
+ */
+
+#define SURFACE_MAX_THREADS      64
+#define SURFACE_BANDS_PER_THREAD 4
+
+typedef struct
+{
+    SDL_SurfaceRowsFunc func;
+    void *userdata;
+    int height;
+    int band_height;
+    int num_bands;
+    SDL_AtomicInt next_band;
+    SDL_AtomicInt failed;
+} SurfaceRowsJob;
+
+typedef struct
+{
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_Condition *done_cond;
+    SDL_Thread **threads;
+    int num_threads;
+    int requested_threads;
+    Uint32 generation;
+    int active_workers;
+    bool shutdown;
+    SurfaceRowsJob *job;
+} SurfaceThreadPool;
+
+static SurfaceThreadPool SDL_surface_threads;
+
+// Set while a thread has the pool, anyone else processes their rows on their own
+static SDL_AtomicInt SDL_surface_threads_busy;
+
+static void RunSurfaceBands(SurfaceRowsJob *job)
+{
+    for (;;) {
+        const int band = SDL_AddAtomicInt(&job->next_band, 1);
+        int y, h;
+
+        if (band >= job->num_bands) {
+            break;
+        }
+
+        y = band * job->band_height;
+        h = SDL_min(job->band_height, job->height - y);
+        if (!job->func(job->userdata, y, h)) {
+            SDL_SetAtomicInt(&job->failed, 1);
+        }
+    }
+}
+
+static int SDLCALL SDL_SurfaceThread(void *ptr)
+{
+    SurfaceThreadPool *pool = (SurfaceThreadPool *)ptr;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(pool->lock);
+    while (!pool->shutdown) {
+        SurfaceRowsJob *job;
+
+        if (pool->generation == generation) {
+            SDL_WaitCondition(pool->cond, pool->lock);
+            continue;
+        }
+        generation = pool->generation;
+
+        // If we woke up late, the other threads may have finished the job already
+        job = pool->job;
+        if (!job) {
+            continue;
+        }
+
+        pool->active_workers++;
+        SDL_UnlockMutex(pool->lock);
+
+        RunSurfaceBands(job);
+
+        SDL_LockMutex(pool->lock);
+        if (--pool->active_workers == 0) {
+            SDL_BroadcastCondition(pool->done_cond);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+static void StopSurfaceThreads(SurfaceThreadPool *pool)
+{
+    int i;
+
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->shutdown = true;
+        SDL_BroadcastCondition(pool->cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    for (i = 0; i < pool->num_threads; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    SDL_free(pool->threads);
+    SDL_DestroyCondition(pool->done_cond);
+    SDL_DestroyCondition(pool->cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_zerop(pool);
+}
+
+static void StartSurfaceThreads(SurfaceThreadPool *pool, int num_threads)
+{
+    pool->requested_threads = num_threads;
+    pool->lock = SDL_CreateMutex();
+    pool->cond = SDL_CreateCondition();
+    pool->done_cond = SDL_CreateCondition();
+    pool->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(SDL_Thread *));
+    if (!pool->lock || !pool->cond || !pool->done_cond || !pool->threads) {
+        return;  // Not fatal, with no threads everything runs on the calling thread.
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        char name[64];
+        SDL_snprintf(name, sizeof(name), "SDLSurface%d", i);
+        pool->threads[i] = SDL_CreateThread(SDL_SurfaceThread, name, pool);
+        if (!pool->threads[i]) {
+            break;
+        }
+        pool->num_threads++;
+    }
+}
+
+bool SDL_RunSurfaceRows(int width, int height, int align, SDL_SurfaceRowsFunc func, void *userdata)
+{
+    SurfaceThreadPool *pool = &SDL_surface_threads;
+    SurfaceRowsJob job;
+    const char *hint;
+    int num_threads;
+    int num_bands;
+
+    if ((Sint64)width * height < SDL_SURFACE_THREADS_MIN_PIXELS || height < 2 * align) {
+        return func(userdata, 0, height);
+    }
+
+    hint = SDL_GetHint(SDL_HINT_SURFACE_THREADS);
+    num_threads = hint ? SDL_clamp(SDL_atoi(hint), 0, SURFACE_MAX_THREADS) : 0;
+    if (num_threads == 0 || !SDL_CompareAndSwapAtomicInt(&SDL_surface_threads_busy, 0, 1)) {
+        return func(userdata, 0, height);
+    }
+
+    if (pool->requested_threads != num_threads) {
+        StopSurfaceThreads(pool);
+        StartSurfaceThreads(pool, num_threads);
+    }
+    if (pool->num_threads == 0) {
+        SDL_SetAtomicInt(&SDL_surface_threads_busy, 0);
+        return func(userdata, 0, height);
+    }
+
+    SDL_zero(job);
+    job.func = func;
+    job.userdata = userdata;
+    job.height = height;
+    num_bands = (pool->num_threads + 1) * SURFACE_BANDS_PER_THREAD;
+    job.band_height = (height + num_bands - 1) / num_bands;
+    job.band_height = ((job.band_height + align - 1) / align) * align;
+    job.num_bands = (height + job.band_height - 1) / job.band_height;
+
+    SDL_LockMutex(pool->lock);
+    pool->job = &job;
+    pool->generation++;
+    SDL_BroadcastCondition(pool->cond);
+    SDL_UnlockMutex(pool->lock);
+
+    RunSurfaceBands(&job);
+
+    SDL_LockMutex(pool->lock);
+    while (pool->active_workers > 0) {
+        SDL_WaitCondition(pool->done_cond, pool->lock);
+    }
+    pool->job = NULL;
+    SDL_UnlockMutex(pool->lock);
+
+    SDL_SetAtomicInt(&SDL_surface_threads_busy, 0);
+
+    return !SDL_GetAtomicInt(&job.failed);
+}
+
+void SDL_QuitSurfaceThreads(void)
+{
+    // Take the pool like SDL_RunSurfaceRows() does, so a job that another thread is running finishes first
+    while (!SDL_CompareAndSwapAtomicInt(&SDL_surface_threads_busy, 0, 1)) {
+        SDL_Delay(1);
+    }
+    StopSurfaceThreads(&SDL_surface_threads);
+    SDL_SetAtomicInt(&SDL_surface_threads_busy, 0);
+}
@@ -0,0 +1,47 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_surface_threads_h_
+#define SDL_surface_threads_h_
+
+#include "SDL_internal.h"
+
+// Surfaces with at least this many pixels are split across threads, see SDL_HINT_SURFACE_THREADS
+#define SDL_SURFACE_THREADS_MIN_PIXELS (256 * 256)
+
+// Processes rows [y, y + h) of the image, returning false if something went wrong
+typedef bool (*SDL_SurfaceRowsFunc)(void *userdata, int y, int h);
+
+/* Runs func over all the rows of a width x height image.
+ *
+ * If SDL_HINT_SURFACE_THREADS is set and the image is large enough, the rows
+ * are split into bands that are a multiple of align rows high (except for the
+ * last one), and the surface worker threads and the calling thread process
+ * different bands at the same time. Otherwise, or if the workers are already
+ * busy with another image, func is called once with all the rows.
+ *
+ * Errors set on a worker thread are lost, so anything that can fail with a
+ * message should be checked before calling this.
+ */
+extern bool SDL_RunSurfaceRows(int width, int height, int align, SDL_SurfaceRowsFunc func, void *userdata);
+extern void SDL_QuitSurfaceThreads(void);
+
+#endif // SDL_surface_threads_h_
@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_pixels_c.h"
+#include "SDL_surface_threads.h"
 #include "SDL_yuv_c.h"
 
 #include "yuv2rgb/yuv_rgb.h"
@@ -586,6 +587,44 @@ static bool yuv_rgb_std(
     return false;
 }
 
+typedef struct
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    Uint32 width;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    Uint8 *rgb;
+    Uint32 rgb_stride;
+    YCbCrType yuv_type;
+} YUVToRGBRows;
+
+static bool yuv_rgb_rows(void *userdata, int row, int num_rows)
+{
+    const YUVToRGBRows *rows = (const YUVToRGBRows *)userdata;
+    const int uv_row = IsPlanar2x2Format(rows->src_format) ? (row / 2) : row;
+    const Uint8 *y = rows->y + (size_t)row * rows->y_stride;
+    const Uint8 *u = rows->u + (size_t)uv_row * rows->uv_stride;
+    const Uint8 *v = rows->v + (size_t)uv_row * rows->uv_stride;
+    Uint8 *rgb = rows->rgb + (size_t)row * rows->rgb_stride;
+
+    if (yuv_rgb_sse(rows->src_format, rows->dst_format, rows->width, num_rows, y, u, v, rows->y_stride, rows->uv_stride, rgb, rows->rgb_stride, rows->yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_lsx(rows->src_format, rows->dst_format, rows->width, num_rows, y, u, v, rows->y_stride, rows->uv_stride, rgb, rows->rgb_stride, rows->yuv_type)) {
+        return true;
+    }
+
+    if (yuv_rgb_std(rows->src_format, rows->dst_format, rows->width, num_rows, y, u, v, rows->y_stride, rows->uv_stride, rgb, rows->rgb_stride, rows->yuv_type)) {
+        return true;
+    }
+    return false;
+}
+
 bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
                                   SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
                                   SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
@@ -601,21 +640,26 @@ bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     }
 
     if (SDL_COLORSPACEPRIMARIES(src_colorspace) == SDL_COLORSPACEPRIMARIES(dst_colorspace)) {
-        YCbCrType yuv_type = YCBCR_601_LIMITED;
+        YUVToRGBRows rows;
 
-        if (!GetYUVConversionType(src_colorspace, &yuv_type)) {
+        rows.yuv_type = YCBCR_601_LIMITED;
+        if (!GetYUVConversionType(src_colorspace, &rows.yuv_type)) {
             return false;
         }
 
-        if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-            return true;
-        }
-
-        if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-            return true;
-        }
+        rows.src_format = src_format;
+        rows.dst_format = dst_format;
+        rows.width = width;
+        rows.y = y;
+        rows.u = u;
+        rows.v = v;
+        rows.y_stride = y_stride;
+        rows.uv_stride = uv_stride;
+        rows.rgb = (Uint8 *)dst;
+        rows.rgb_stride = dst_pitch;
 
-        if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        // Each pair of rows shares a row of chroma, so the bands have to start on even rows
+        if (SDL_RunSurfaceRows(width, height, 2, yuv_rgb_rows, &rows)) {
             return true;
         }
     }
@@ -716,11 +760,12 @@ static struct RGB2YUVFactors RGB2YUVFactorTables[] = {
     },
 };
 
-static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+// Converts rows [row, row + num_rows) of the image, row has to be even
+static bool SDL_ConvertPixels_XRGB8888_to_YUV_Rows(int width, int height, int row, int num_rows, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
 {
     const int src_pitch_x_2 = src_pitch * 2;
-    const int height_half = height / 2;
-    const int height_remainder = (height & 0x1);
+    const int height_half = num_rows / 2;
+    const int height_remainder = (num_rows & 0x1);
     const int width_half = width / 2;
     const int width_remainder = (width & 0x1);
     int i, j;
@@ -795,13 +840,16 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
             return false;
         }
 
-        plane_interleaved_uv = (plane_y + height * y_stride);
+        plane_interleaved_uv = (plane_y + height * y_stride) + (row / 2) * uv_stride;
+        plane_y += row * y_stride;
+        plane_u += (row / 2) * uv_stride;
+        plane_v += (row / 2) * uv_stride;
         y_skip = (y_stride - width);
 
-        curr_row = (const Uint8 *)src;
+        curr_row = (const Uint8 *)src + row * src_pitch;
 
         // Write Y plane
-        for (j = 0; j < height; j++) {
+        for (j = 0; j < num_rows; j++) {
             for (i = 0; i < width; i++) {
                 const Uint32 p1 = ((const Uint32 *)curr_row)[i];
                 const Uint32 r = (p1 & 0x00ff0000) >> 16;
@@ -813,9 +861,8 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
             curr_row += src_pitch;
         }
 
-        curr_row = (const Uint8 *)src;
-        next_row = (const Uint8 *)src;
-        next_row += src_pitch;
+        curr_row = (const Uint8 *)src + row * src_pitch;
+        next_row = curr_row + src_pitch;
 
         if (dst_format == SDL_PIXELFORMAT_YV12 || dst_format == SDL_PIXELFORMAT_IYUV) {
             // Write UV planes, not interleaved
@@ -915,19 +962,14 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
     {
-        const Uint8 *curr_row = (const Uint8 *)src;
-        Uint8 *plane = (Uint8 *)dst;
+        const Uint8 *curr_row = (const Uint8 *)src + row * src_pitch;
+        Uint8 *plane = (Uint8 *)dst + row * dst_pitch;
         const int row_size = (4 * ((width + 1) / 2));
-        int plane_skip;
-
-        if (dst_pitch < row_size) {
-            return SDL_SetError("Destination pitch is too small, expected at least %d", row_size);
-        }
-        plane_skip = (dst_pitch - row_size);
+        const int plane_skip = (dst_pitch - row_size);
 
         // Write YUV plane, packed
         if (dst_format == SDL_PIXELFORMAT_YUY2) {
-            for (j = 0; j < height; j++) {
+            for (j = 0; j < num_rows; j++) {
                 for (i = 0; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // Y U Y1 V
@@ -948,7 +990,7 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
                 curr_row += src_pitch;
             }
         } else if (dst_format == SDL_PIXELFORMAT_UYVY) {
-            for (j = 0; j < height; j++) {
+            for (j = 0; j < num_rows; j++) {
                 for (i = 0; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // U Y V Y1
@@ -969,7 +1011,7 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
                 curr_row += src_pitch;
             }
         } else if (dst_format == SDL_PIXELFORMAT_YVYU) {
-            for (j = 0; j < height; j++) {
+            for (j = 0; j < num_rows; j++) {
                 for (i = 0; i < width_half; i++) {
                     READ_TWO_RGB_PIXELS;
                     // Y V Y1 U
@@ -1007,6 +1049,50 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     return true;
 }
 
+typedef struct
+{
+    int width;
+    int height;
+    const void *src;
+    int src_pitch;
+    SDL_PixelFormat dst_format;
+    void *dst;
+    int dst_pitch;
+    YCbCrType yuv_type;
+} XRGB8888ToYUVRows;
+
+static bool SDL_ConvertPixels_XRGB8888_to_YUV_Band(void *userdata, int row, int num_rows)
+{
+    const XRGB8888ToYUVRows *rows = (const XRGB8888ToYUVRows *)userdata;
+
+    return SDL_ConvertPixels_XRGB8888_to_YUV_Rows(rows->width, rows->height, row, num_rows, rows->src, rows->src_pitch, rows->dst_format, rows->dst, rows->dst_pitch, rows->yuv_type);
+}
+
+static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+{
+    XRGB8888ToYUVRows rows;
+
+    // Check everything that can fail up front, the rows may be converted on other threads
+    if (IsPacked4Format(dst_format)) {
+        const int row_size = (4 * ((width + 1) / 2));
+        if (dst_pitch < row_size) {
+            return SDL_SetError("Destination pitch is too small, expected at least %d", row_size);
+        }
+    } else if (!IsPlanar2x2Format(dst_format) || dst_format == SDL_PIXELFORMAT_P010) {
+        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+    }
+
+    rows.width = width;
+    rows.height = height;
+    rows.src = src;
+    rows.src_pitch = src_pitch;
+    rows.dst_format = dst_format;
+    rows.dst = dst;
+    rows.dst_pitch = dst_pitch;
+    rows.yuv_type = yuv_type;
+    return SDL_RunSurfaceRows(width, height, 2, SDL_ConvertPixels_XRGB8888_to_YUV_Band, &rows);
+}
+
 static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
 {
     const int src_pitch_x_2 = src_pitch * 2;
@@ -0,0 +1,284 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for many small async I/O requests
+
+   A file is read in small blocks at random offsets through an
+   SDL_AsyncIOQueue, keeping a fixed number of requests in flight. This is
+   done with one submission per request, with SDL_BeginAsyncIOBatch() and
+   SDL_EndAsyncIOBatch() around each group of requests, and with batching
+   plus registered files and buffers or a kernel polling thread where the
+   backend supports them. A final pass reads the file front to back, which
+   lets the threadpool backend merge adjacent reads. Operations per second
+   and the CPU time used by the process are reported for each, and the exit
+   code is nonzero if any read fails.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#if defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)
+#include <sys/resource.h>
+#define HAVE_GETRUSAGE 1
+#endif
+
+#define TEST_FILE "testasyncioperf.dat"
+
+typedef struct
+{
+    const char *name;
+    bool batch;
+    bool registered;
+    bool sqpoll;
+    bool sequential;
+} Mode;
+
+static int block_size = 4096;
+static int depth = 64;
+static int num_ops = 200000;
+static Sint64 file_size = 64 * 1024 * 1024;
+
+static bool create_file(const char *file, Sint64 size)
+{
+    SDL_IOStream *io;
+    Uint8 *chunk;
+    const size_t chunk_size = 1024 * 1024;
+    Sint64 written = 0;
+    size_t i;
+    bool result = true;
+
+    chunk = (Uint8 *)SDL_malloc(chunk_size);
+    if (!chunk) {
+        return false;
+    }
+    for (i = 0; i < chunk_size; ++i) {
+        chunk[i] = (Uint8)(i * 31);
+    }
+
+    io = SDL_IOFromFile(file, "wb");
+    if (!io) {
+        SDL_free(chunk);
+        return false;
+    }
+    while (written < size && result) {
+        const size_t amount = (size_t)SDL_min((Sint64)chunk_size, size - written);
+        result = (SDL_WriteIO(io, chunk, amount) == amount);
+        written += amount;
+    }
+    if (!SDL_CloseIO(io)) {
+        result = false;
+    }
+    SDL_free(chunk);
+    return result;
+}
+
+static double get_cpu_seconds(void)
+{
+#ifdef HAVE_GETRUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return (double)usage.ru_utime.tv_sec + (double)usage.ru_utime.tv_usec / 1000000.0 +
+               (double)usage.ru_stime.tv_sec + (double)usage.ru_stime.tv_usec / 1000000.0;
+    }
+#endif
+    return -1.0;
+}
+
+static bool start_read(SDL_AsyncIO *asyncio, Uint8 *buffers, int slot, int index, bool sequential, SDL_AsyncIOQueue *queue)
+{
+    const Uint64 num_blocks = (Uint64)(file_size / block_size);
+    const Uint64 block = sequential ? ((Uint64)index % num_blocks) : ((Uint64)SDL_rand_bits() % num_blocks);
+    const Uint64 offset = block * (Uint64)block_size;
+    Uint8 *ptr = buffers + (size_t)slot * block_size;
+    return SDL_ReadAsyncIO(asyncio, ptr, offset, (Uint64)block_size, queue, (void *)(intptr_t)slot);
+}
+
+static bool run_mode(const Mode *mode)
+{
+    SDL_PropertiesID props;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOOutcome outcome;
+    Uint8 *buffers;
+    Uint64 start, elapsed;
+    double cpu_start, cpu;
+    int started = 0, finished = 0, in_flight = 0;
+    bool result = false;
+    int i;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER, depth * 2);
+    SDL_SetBooleanProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_SQPOLL_BOOLEAN, mode->sqpoll);
+    if (mode->registered) {
+        SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_FILES_NUMBER, 1);
+        SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER, 1);
+    }
+    queue = SDL_CreateAsyncIOQueueWithProperties(props);
+    SDL_DestroyProperties(props);
+    if (!queue) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: couldn't create queue: %s", mode->name, SDL_GetError());
+        return false;
+    }
+
+    buffers = (Uint8 *)SDL_aligned_alloc(4096, (size_t)depth * block_size);
+    asyncio = SDL_AsyncIOFromFile(TEST_FILE, "r");
+    if (!buffers || !asyncio) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: setup failed: %s", mode->name, SDL_GetError());
+        goto done;
+    }
+    if (mode->registered && !SDL_RegisterAsyncIOBuffer(queue, buffers, (size_t)depth * block_size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: couldn't register buffer: %s", mode->name, SDL_GetError());
+        goto done;
+    }
+
+    SDL_srand(0);
+    result = true;
+    cpu_start = get_cpu_seconds();
+    start = SDL_GetTicksNS();
+
+    /* Fill the pipeline, then refill each slot as its read completes. */
+    while (finished < num_ops) {
+        const int wanted = SDL_min(depth - in_flight, num_ops - started);
+        if (wanted > 0) {
+            if (mode->batch) {
+                SDL_BeginAsyncIOBatch(queue);
+            }
+            for (i = 0; i < wanted; ++i) {
+                /* any free slot will do, the data is thrown away. */
+                if (!start_read(asyncio, buffers, (started + i) % depth, started + i, mode->sequential, queue)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: read failed: %s", mode->name, SDL_GetError());
+                    result = false;
+                    num_ops = started + i;
+                    break;
+                }
+            }
+            started += i;
+            in_flight += i;
+            if (mode->batch) {
+                SDL_EndAsyncIOBatch(queue);
+            }
+        }
+
+        if (in_flight == 0) {
+            break;
+        }
+
+        /* collect everything that has landed, blocking for at least one. */
+        if (SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+            do {
+                if (outcome.result != SDL_ASYNCIO_COMPLETE || outcome.bytes_transferred != (Uint64)block_size) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: a read didn't complete", mode->name);
+                    result = false;
+                }
+                --in_flight;
+                ++finished;
+            } while (SDL_GetAsyncIOResult(queue, &outcome));
+        }
+    }
+
+    elapsed = SDL_GetTicksNS() - start;
+    cpu = get_cpu_seconds() - cpu_start;
+
+    if (cpu_start >= 0.0) {
+        SDL_Log("%-24s %10.0f ops/s, %8.2f ms, CPU %8.2f ms", mode->name,
+                (double)finished / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND),
+                (double)elapsed / SDL_NS_PER_MS, cpu * 1000.0);
+    } else {
+        SDL_Log("%-24s %10.0f ops/s, %8.2f ms, CPU n/a", mode->name,
+                (double)finished / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND),
+                (double)elapsed / SDL_NS_PER_MS);
+    }
+
+done:
+    if (asyncio) {
+        SDL_CloseAsyncIO(asyncio, false, queue, NULL);
+    }
+    SDL_DestroyAsyncIOQueue(queue); /* waits for the close to finish. */
+    SDL_aligned_free(buffers);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    static const Mode modes[] = {
+        { "unbatched", false, false, false, false },
+        { "batched", true, false, false, false },
+        { "batched+registered", true, true, false, false },
+        { "batched+sqpoll", true, false, true, false },
+        { "batched+sequential", true, false, false, true },
+    };
+    SDLTest_CommonState *state;
+    int iterations = 3;
+    int result = 0;
+    int i, j;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--ops") == 0 && argv[i + 1]) {
+                num_ops = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--depth") == 0 && argv[i + 1]) {
+                depth = SDL_clamp(SDL_atoi(argv[i + 1]), 1, 4096);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--block-size") == 0 && argv[i + 1]) {
+                block_size = SDL_clamp(SDL_atoi(argv[i + 1]), 512, 1024 * 1024) & ~511;
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--ops N]", "[--depth N]", "[--block-size BYTES]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Creating a %d MB test file", (int)(file_size / (1024 * 1024)));
+    if (!create_file(TEST_FILE, file_size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create %s: %s", TEST_FILE, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%d reads of %d bytes, %d in flight", num_ops, block_size, depth);
+    for (i = 0; i < iterations; ++i) {
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            if (!run_mode(&modes[j])) {
+                result = 1;
+            }
+        }
+    }
+
+    SDL_RemovePath(TEST_FILE);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
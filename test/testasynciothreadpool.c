@@ -0,0 +1,382 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Test of the task lists in SDL's generic async I/O threadpool
+
+   The generic backend's source is built into this program directly, so the
+   tests can queue tasks while the threadpool is asleep and then take and run
+   them on this thread in a known order. That covers merging adjacent reads,
+   including reads that run past the end of the file, canceling tasks that
+   haven't started, and starting higher priority work first.
+*/
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include "../src/io/generic/SDL_asyncio_generic.c"
+
+#define TEST_FILE   "testasynciothreadpool.dat"
+#define FILE_SIZE   1000
+#define BUFFER_SIZE 64
+#define UNTOUCHED   0xEE
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                              \
+    do {                                              \
+        if (!(cond)) {                                \
+            SDL_Log("FAILED: " __VA_ARGS__);          \
+            failures++;                               \
+        }                                             \
+    } while (0)
+
+#if SDL_ASYNCIO_USE_THREADPOOL
+
+static SDL_AsyncIOQueue queues[NUM_ASYNCIO_PRIORITIES];
+static SDL_AsyncIO files[2];
+static AsyncIOWorker main_worker;  /* gives this thread its own buffer for merged reads */
+
+static Uint8 file_byte(Uint64 offset)
+{
+    return (Uint8)(offset * 7 + 3);
+}
+
+static bool create_file(void)
+{
+    Uint8 data[FILE_SIZE];
+    int i;
+
+    for (i = 0; i < FILE_SIZE; ++i) {
+        data[i] = file_byte(i);
+    }
+    return SDL_SaveFile(TEST_FILE, data, sizeof(data));
+}
+
+/* Wait until every threadpool thread is asleep, so tasks queued during a batch stay queued. */
+static bool wait_for_idle_threadpool(void)
+{
+    const Uint64 timeout = SDL_GetTicks() + 5000;
+
+    while (SDL_GetAtomicInt(&idle_threadpool_threads) != SDL_GetAtomicInt(&running_threadpool_threads)) {
+        if (SDL_GetTicks() >= timeout) {
+            return false;
+        }
+        SDL_Delay(1);
+    }
+    return true;
+}
+
+static void queue_read(SDL_AsyncIOTask *task, int file, int priority, Uint8 *buffer, Uint64 offset, Uint64 size)
+{
+    SDL_zerop(task);
+    SDL_memset(buffer, UNTOUCHED, BUFFER_SIZE);
+    task->asyncio = &files[file];
+    task->queue = &queues[priority];
+    task->type = SDL_ASYNCIO_TASK_READ;
+    task->offset = offset;
+    task->buffer = buffer;
+    task->requested_size = size;
+    generic_asyncioqueue_queue_task(task->queue->userdata, task);
+}
+
+/* Take the next piece of work the way a threadpool thread would, and run it on this thread. */
+static int run_next(SDL_AsyncIOTask **tasks)
+{
+    const int count = GetNextTasks(&threadpool_workers[0], tasks);
+
+    if (count == 1) {
+        SynchronousIO(tasks[0]);
+    } else if (count > 1) {
+        CoalescedRead(&main_worker, tasks, count);
+    }
+    return count;
+}
+
+/* Pick up every result delivered to the queues, returns how many there were. */
+static int drain_results(void)
+{
+    int count = 0;
+    int i;
+
+    for (i = 0; i < NUM_ASYNCIO_PRIORITIES; ++i) {
+        while (generic_asyncioqueue_get_results(queues[i].userdata)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static bool check_read(const SDL_AsyncIOTask *task, const Uint8 *buffer, Uint64 expected_size)
+{
+    Uint64 i;
+
+    if (task->result != SDL_ASYNCIO_COMPLETE || task->result_size != expected_size) {
+        return false;
+    }
+    for (i = 0; i < BUFFER_SIZE; ++i) {
+        const Uint8 expected = (i < expected_size) ? file_byte(task->offset + i) : UNTOUCHED;
+        if (buffer[i] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool untouched(const Uint8 *buffer)
+{
+    int i;
+
+    for (i = 0; i < BUFFER_SIZE; ++i) {
+        if (buffer[i] != UNTOUCHED) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_coalesce(void)
+{
+    static const Uint64 offsets[] = { 880, 928, 976, 1024 };
+    static const Uint64 sizes[] = { 48, 48, 24, 0 };
+    SDL_AsyncIOTask reads[4], other;
+    SDL_AsyncIOTask *tasks[MAX_COALESCED_TASKS];
+    Uint8 buffers[4][BUFFER_SIZE], other_buffer[BUFFER_SIZE];
+    int count, i;
+
+    /* Four reads that continue each other past the end of the file, with an unrelated read in the middle of them. */
+    queue_read(&reads[0], 0, SDL_ASYNCIO_PRIORITY_NORMAL, buffers[0], offsets[0], 48);
+    queue_read(&other, 0, SDL_ASYNCIO_PRIORITY_NORMAL, other_buffer, 0, 16);
+    for (i = 1; i < SDL_arraysize(reads); ++i) {
+        queue_read(&reads[i], 0, SDL_ASYNCIO_PRIORITY_NORMAL, buffers[i], offsets[i], 48);
+    }
+
+    count = run_next(tasks);
+    CHECK(count == SDL_arraysize(reads), "adjacent reads were taken as %d tasks, expected %d", count, (int)SDL_arraysize(reads));
+    for (i = 0; i < count && i < SDL_arraysize(reads); ++i) {
+        CHECK(tasks[i] == &reads[i], "merged read %d is out of order", i);
+    }
+    count = run_next(tasks);
+    CHECK(count == 1 && tasks[0] == &other, "the unrelated read wasn't taken by itself");
+    CHECK(run_next(tasks) == 0, "tasks left over after merging reads");
+
+    for (i = 0; i < SDL_arraysize(reads); ++i) {
+        CHECK(check_read(&reads[i], buffers[i], sizes[i]), "merged read at %d: result %d, %d bytes, expected %d bytes",
+              (int)offsets[i], (int)reads[i].result, (int)reads[i].result_size, (int)sizes[i]);
+    }
+    CHECK(check_read(&other, other_buffer, 16), "unrelated read: result %d, %d bytes", (int)other.result, (int)other.result_size);
+    CHECK(drain_results() == SDL_arraysize(reads) + 1, "wrong number of results delivered for merged reads");
+}
+
+static void test_cancel(void)
+{
+    SDL_AsyncIOTask reads[3];
+    SDL_AsyncIOTask *tasks[MAX_COALESCED_TASKS];
+    Uint8 buffers[3][BUFFER_SIZE];
+    int count, i;
+
+    for (i = 0; i < SDL_arraysize(reads); ++i) {
+        queue_read(&reads[i], 0, SDL_ASYNCIO_PRIORITY_NORMAL, buffers[i], i * 32, 32);
+    }
+
+    /* Canceling the middle read delivers it right away and leaves a gap the others can't be merged across. */
+    generic_asyncioqueue_cancel_task(reads[1].queue->userdata, &reads[1]);
+    CHECK(reads[1].result == SDL_ASYNCIO_CANCELED, "queued read wasn't canceled");
+    CHECK(drain_results() == 1, "canceled read wasn't delivered");
+    CHECK(SDL_GetAtomicInt(&pending_threadpool_tasks) == 2, "%d tasks pending after a cancel, expected 2", SDL_GetAtomicInt(&pending_threadpool_tasks));
+
+    count = run_next(tasks);
+    CHECK(count == 1 && tasks[0] == &reads[0], "first read was merged across a canceled read");
+    count = run_next(tasks);
+    CHECK(count == 1 && tasks[0] == &reads[2], "last read wasn't run after a canceled read");
+    CHECK(run_next(tasks) == 0, "canceled read was run");
+
+    CHECK(check_read(&reads[0], buffers[0], 32), "read before the canceled one: result %d, %d bytes", (int)reads[0].result, (int)reads[0].result_size);
+    CHECK(check_read(&reads[2], buffers[2], 32), "read after the canceled one: result %d, %d bytes", (int)reads[2].result, (int)reads[2].result_size);
+    CHECK(untouched(buffers[1]), "canceled read wrote to its buffer");
+
+    /* Canceling a read that already ran changes nothing. */
+    generic_asyncioqueue_cancel_task(reads[0].queue->userdata, &reads[0]);
+    CHECK(reads[0].result == SDL_ASYNCIO_COMPLETE, "finished read was canceled");
+    CHECK(drain_results() == 2, "wrong number of results delivered around a cancel");
+}
+
+static void test_priority(void)
+{
+    SDL_AsyncIOTask low[2], normal, high[2];
+    SDL_AsyncIOTask *expected[5];
+    SDL_AsyncIOTask *tasks[MAX_COALESCED_TASKS];
+    Uint8 buffers[5][BUFFER_SIZE];
+    int count, i;
+
+    /* Queued from lowest to highest priority, on two files so the work is spread over workers. None of it is adjacent. */
+    queue_read(&low[0], 0, SDL_ASYNCIO_PRIORITY_LOW, buffers[0], 0, 16);
+    queue_read(&low[1], 1, SDL_ASYNCIO_PRIORITY_LOW, buffers[1], 100, 16);
+    queue_read(&normal, 0, SDL_ASYNCIO_PRIORITY_NORMAL, buffers[2], 200, 16);
+    queue_read(&high[0], 1, SDL_ASYNCIO_PRIORITY_HIGH, buffers[3], 300, 16);
+    queue_read(&high[1], 0, SDL_ASYNCIO_PRIORITY_HIGH, buffers[4], 400, 16);
+
+    expected[0] = &high[0];
+    expected[1] = &high[1];
+    expected[2] = &normal;
+    expected[3] = &low[0];
+    expected[4] = &low[1];
+    for (i = 0; i < SDL_arraysize(expected); ++i) {
+        count = run_next(tasks);
+        CHECK(count == 1 && tasks[0] == expected[i], "task %d ran out of priority order", i);
+    }
+    CHECK(run_next(tasks) == 0, "tasks left over after running by priority");
+
+    for (i = 0; i < SDL_arraysize(expected); ++i) {
+        CHECK(check_read(expected[i], (const Uint8 *)expected[i]->buffer, 16),
+              "prioritized read %d: result %d, %d bytes", i, (int)expected[i]->result, (int)expected[i]->result_size);
+    }
+    CHECK(drain_results() == SDL_arraysize(expected), "wrong number of results delivered for prioritized reads");
+}
+
+static void test_threadpool(void)
+{
+    SDL_AsyncIOTask read, parked;
+    SDL_AsyncIOTask *task;
+    Uint8 buffer[BUFFER_SIZE], parked_buffer[BUFFER_SIZE];
+
+    /* Outside of a batch, a sleeping thread is woken up to do the work. */
+    SDL_SetAtomicInt(&queues[SDL_ASYNCIO_PRIORITY_NORMAL].batch_depth, 0);
+    queue_read(&read, 1, SDL_ASYNCIO_PRIORITY_NORMAL, buffer, 500, 40);
+    task = generic_asyncioqueue_wait_results(queues[SDL_ASYNCIO_PRIORITY_NORMAL].userdata, 5000);
+    CHECK(task == &read, "threadpool didn't deliver the read");
+    CHECK(check_read(&read, buffer, 40), "threadpool read: result %d, %d bytes", (int)read.result, (int)read.result_size);
+    SDL_SetAtomicInt(&queues[SDL_ASYNCIO_PRIORITY_NORMAL].batch_depth, 1);
+
+    /* Shutting down cancels work that never started. */
+    CHECK(wait_for_idle_threadpool(), "threadpool didn't go idle");
+    queue_read(&parked, 1, SDL_ASYNCIO_PRIORITY_NORMAL, parked_buffer, 0, 16);
+    ShutdownThreadpool();
+    CHECK(parked.result == SDL_ASYNCIO_CANCELED, "queued read wasn't canceled by shutdown");
+    CHECK(untouched(parked_buffer), "read canceled by shutdown wrote to its buffer");
+    CHECK(drain_results() == 1, "read canceled by shutdown wasn't delivered");
+}
+
+static bool run_test(void)
+{
+    int num_queues = 0, num_files = 0;
+    int i;
+
+    if (!create_file()) {
+        SDL_Log("Couldn't create %s: %s", TEST_FILE, SDL_GetError());
+        return false;
+    }
+
+    for (i = 0; i < NUM_ASYNCIO_PRIORITIES; ++i) {
+        const SDL_PropertiesID props = SDL_CreateProperties();
+        bool created;
+
+        SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_PRIORITY_NUMBER, i);
+        created = SDL_SYS_CreateAsyncIOQueue_Generic(&queues[i], props);
+        SDL_DestroyProperties(props);
+        CHECK(created, "couldn't create queue with priority %d: %s", i, SDL_GetError());
+        if (!created) {
+            goto done;
+        }
+        /* Keep the threadpool from being woken up for new tasks, so this thread can take them. */
+        SDL_SetAtomicInt(&queues[i].batch_depth, 1);
+        num_queues++;
+    }
+    for (i = 0; i < SDL_arraysize(files); ++i) {
+        const bool opened = SDL_SYS_AsyncIOFromFile_Generic(TEST_FILE, "rb", &files[i]);
+        CHECK(opened, "couldn't open %s: %s", TEST_FILE, SDL_GetError());
+        if (!opened) {
+            goto done;
+        }
+        num_files++;
+    }
+
+    CHECK(wait_for_idle_threadpool(), "threadpool didn't go idle");
+
+    test_coalesce();
+    test_cancel();
+    test_priority();
+    test_threadpool();
+
+done:
+    ShutdownThreadpool();
+    for (i = 0; i < num_files; ++i) {
+        GenericAsyncIOData *data = (GenericAsyncIOData *)files[i].userdata;
+        SDL_CloseIO(data->io);
+        generic_asyncio_destroy(data);
+    }
+    for (i = 0; i < num_queues; ++i) {
+        generic_asyncioqueue_destroy(queues[i].userdata);
+    }
+    SDL_free(main_worker.coalesce_buffer);
+    SDL_RemovePath(TEST_FILE);
+
+    if (failures) {
+        SDL_Log("%d checks failed", failures);
+        return false;
+    }
+    SDL_Log("All tests passed");
+    return true;
+}
+
+#else
+
+static bool run_test(void)
+{
+    SDL_Log("No async I/O threadpool on this platform, skipping");
+    return true;
+}
+
+#endif /* SDL_ASYNCIO_USE_THREADPOOL */
+
+int main(int argc, char *argv[])
+{
+    int result;
+    SDLTest_CommonState *state;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    result = run_test() ? 0 : 1;
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
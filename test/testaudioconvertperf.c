@@ -0,0 +1,200 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for audio sample format, channel and sample rate conversion
+
+   Run this with --simd -all to measure the scalar converters, or with a
+   mask like --simd -avx512f to measure a specific set of SIMD converters.
+   The checksums printed for each conversion should match between runs.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    SDL_AudioFormat src_format;
+    int src_channels;
+    int src_freq;
+    SDL_AudioFormat dst_format;
+    int dst_channels;
+    int dst_freq;
+} Conversion;
+
+static const Conversion conversions[] = {
+    { SDL_AUDIO_S8, 2, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_U8, 2, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_S16, 2, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_S32, 2, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_S8, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_U8, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_S16, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_S32, 2, 48000 },
+    { SDL_AUDIO_S16BE, 2, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_S32BE, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_F32, 1, 48000 },
+    { SDL_AUDIO_F32, 1, 48000, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_S16, 2, 48000, SDL_AUDIO_S16, 1, 48000 },
+    { SDL_AUDIO_F32, 1, 44100, SDL_AUDIO_F32, 1, 48000 },
+    { SDL_AUDIO_F32, 2, 44100, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_F32, 6, 44100, SDL_AUDIO_F32, 6, 48000 },
+    { SDL_AUDIO_F32, 8, 44100, SDL_AUDIO_F32, 8, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_F32, 2, 44100 },
+    { SDL_AUDIO_F32, 2, 22050, SDL_AUDIO_F32, 2, 48000 },
+};
+
+static Uint32 checksum(const Uint8 *data, int len)
+{
+    Uint32 hash = 2166136261u;
+    int i;
+
+    for (i = 0; i < len; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void fill_samples(Uint8 *data, int num_samples, SDL_AudioFormat format)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        /* A full scale sine wave, with some samples slightly out of range */
+        const float value = SDL_sinf((float)i * 0.01f) * 1.05f;
+
+        switch (format) {
+        case SDL_AUDIO_S8:
+            ((Sint8 *)data)[i] = (Sint8)SDL_clamp(value * 128.0f, -128.0f, 127.0f);
+            break;
+        case SDL_AUDIO_U8:
+            ((Uint8 *)data)[i] = (Uint8)(SDL_clamp(value * 128.0f, -128.0f, 127.0f) + 128.0f);
+            break;
+        case SDL_AUDIO_S16LE:
+        case SDL_AUDIO_S16BE:
+            ((Sint16 *)data)[i] = (Sint16)SDL_clamp(value * 32768.0f, -32768.0f, 32767.0f);
+            break;
+        case SDL_AUDIO_S32LE:
+        case SDL_AUDIO_S32BE:
+            ((Sint32 *)data)[i] = (Sint32)SDL_clamp(value * 2147483648.0f, -2147483648.0f, 2147483520.0f);
+            break;
+        default:
+            ((float *)data)[i] = value;
+            break;
+        }
+    }
+}
+
+static bool run_benchmark(const Conversion *conversion, int num_frames, int iterations)
+{
+    SDL_AudioSpec src_spec, dst_spec;
+    const int num_samples = num_frames * conversion->src_channels;
+    const int src_len = num_samples * SDL_AUDIO_BYTESIZE(conversion->src_format);
+    Uint8 *src_data;
+    Uint8 *dst_data = NULL;
+    int dst_len = 0;
+    Uint64 start, elapsed = 0;
+    Uint32 sum = 0;
+    int i;
+
+    src_data = (Uint8 *)SDL_malloc(src_len);
+    if (!src_data) {
+        return false;
+    }
+    fill_samples(src_data, num_samples, conversion->src_format);
+
+    src_spec.format = conversion->src_format;
+    src_spec.channels = conversion->src_channels;
+    src_spec.freq = conversion->src_freq;
+    dst_spec.format = conversion->dst_format;
+    dst_spec.channels = conversion->dst_channels;
+    dst_spec.freq = conversion->dst_freq;
+
+    for (i = 0; i < iterations; ++i) {
+        start = SDL_GetTicksNS();
+        if (!SDL_ConvertAudioSamples(&src_spec, src_data, src_len, &dst_spec, &dst_data, &dst_len)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert audio: %s", SDL_GetError());
+            SDL_free(src_data);
+            return false;
+        }
+        elapsed += SDL_GetTicksNS() - start;
+        if (i == 0) {
+            sum = checksum(dst_data, dst_len);
+        }
+        SDL_free(dst_data);
+    }
+
+    SDL_Log("%-6s %dch %5dHz -> %-6s %dch %5dHz: %7.3f ns/frame (checksum %08" SDL_PRIx32 ")",
+            SDL_GetAudioFormatName(conversion->src_format), conversion->src_channels, conversion->src_freq,
+            SDL_GetAudioFormatName(conversion->dst_format), conversion->dst_channels, conversion->dst_freq,
+            (double)elapsed / iterations / num_frames, sum);
+
+    SDL_free(src_data);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int num_frames = 4096;
+    int iterations = 2000;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                num_frames = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--simd") == 0 && argv[i + 1]) {
+                SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--frames N]", "[--iterations N]", "[--simd MASK]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("SSE2: %d, AVX2: %d, AVX-512F: %d, NEON: %d",
+            SDL_HasSSE2(), SDL_HasAVX2(), SDL_HasAVX512F(), SDL_HasNEON());
+
+    for (i = 0; i < (int)SDL_arraysize(conversions); ++i) {
+        if (!run_benchmark(&conversions[i], num_frames, iterations)) {
+            break;
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
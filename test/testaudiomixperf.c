@@ -0,0 +1,237 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for mixing many audio streams bound to one playback device
+
+   Every stream is resampled from 44100Hz to the device's 48000Hz. Run this
+   with --workers N to pull the streams on N mixer threads. The checksums of
+   the mixed output should match no matter how many workers are used.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SOURCE_FREQ     44100
+#define SOURCE_CHANNELS 2
+#define CHECKSUM_ITERATIONS 8
+
+static Sint16 *source_data;
+static int source_frames;
+
+/* These are only touched on the device thread while it's unpaused */
+static Uint64 iteration_start_ns;
+static Uint64 total_mix_ns;
+static Uint64 max_mix_ns;
+static Uint32 output_checksum;
+static int num_iterations;
+
+static void SDLCALL feed_stream(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    /* Each stream loops through the shared source buffer, starting at a different spot */
+    int *position = (int *)userdata;
+    const int framesize = SOURCE_CHANNELS * (int)sizeof(Sint16);
+    int frames = additional_amount / framesize + 1;
+
+    while (frames > 0) {
+        const int chunk = SDL_min(frames, source_frames - *position);
+        SDL_PutAudioStreamData(stream, source_data + (*position * SOURCE_CHANNELS), chunk * framesize);
+        *position = (*position + chunk) % source_frames;
+        frames -= chunk;
+    }
+}
+
+static void SDLCALL iteration_start(void *userdata, SDL_AudioDeviceID devid, bool start)
+{
+    iteration_start_ns = SDL_GetTicksNS();
+}
+
+static void SDLCALL iteration_end(void *userdata, SDL_AudioDeviceID devid, bool start)
+{
+    const Uint64 elapsed = SDL_GetTicksNS() - iteration_start_ns;
+
+    total_mix_ns += elapsed;
+    max_mix_ns = SDL_max(max_mix_ns, elapsed);
+    num_iterations++;
+}
+
+static void SDLCALL postmix(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    /* Only checksum the first few iterations, so they cover the same input in every run */
+    if (num_iterations < CHECKSUM_ITERATIONS) {
+        const Uint8 *data = (const Uint8 *)buffer;
+        int i;
+
+        for (i = 0; i < buflen; ++i) {
+            output_checksum = (output_checksum ^ data[i]) * 16777619u;
+        }
+    }
+}
+
+static bool run_benchmark(SDL_AudioDeviceID devid, SDL_AudioStream **streams, int *positions, int num_streams, int iterations, double buffer_us)
+{
+    int i;
+
+    SDL_PauseAudioDevice(devid);
+
+    for (i = 0; i < num_streams; ++i) {
+        SDL_ClearAudioStream(streams[i]);
+        positions[i] = (i * 997) % source_frames;
+    }
+    if (!SDL_BindAudioStreams(devid, streams, num_streams)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't bind audio streams: %s", SDL_GetError());
+        return false;
+    }
+
+    total_mix_ns = 0;
+    max_mix_ns = 0;
+    output_checksum = 2166136261u;
+    num_iterations = 0;
+
+    for (;;) {
+        SDL_ResumeAudioDevice(devid);
+        SDL_Delay(10);
+
+        /* Pausing waits for the device thread to finish the current iteration */
+        SDL_PauseAudioDevice(devid);
+        if (num_iterations >= iterations) {
+            break;
+        }
+    }
+
+    SDL_UnbindAudioStreams(streams, num_streams);
+
+    SDL_Log("%4d streams: %8.1f us/iteration average, %8.1f us max (%5.1f%% of the buffer), checksum %08" SDL_PRIx32,
+            num_streams, (double)total_mix_ns / SDL_NS_PER_US / num_iterations, (double)max_mix_ns / SDL_NS_PER_US,
+            100.0 * ((double)total_mix_ns / SDL_NS_PER_US / num_iterations) / buffer_us, output_checksum);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int counts[] = { 1, 4, 16, 64, 256, 1024 };
+    SDLTest_CommonState *state;
+    SDL_AudioSpec spec, src_spec;
+    SDL_AudioDeviceID devid;
+    SDL_AudioStream **streams = NULL;
+    int *positions = NULL;
+    int max_streams = 256;
+    int iterations = 100;
+    int sample_frames = 1024;
+    char sample_frames_hint[16];
+    int result = 1;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-streams") == 0 && argv[i + 1]) {
+                max_streams = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                sample_frames = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--workers") == 0 && argv[i + 1]) {
+                SDL_SetHint(SDL_HINT_AUDIO_MIXER_THREADS, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-streams N]", "[--iterations N]", "[--frames N]", "[--workers N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    /* Don't wait on real hardware, we want to measure the mixing */
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIO_DUMMY_TIMESCALE, "0.1");
+    SDL_snprintf(sample_frames_hint, sizeof(sample_frames_hint), "%d", sample_frames);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, sample_frames_hint);
+
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        goto quit;
+    }
+
+    /* A second of a quiet sine wave, so hundreds of streams mixed together don't clip */
+    source_frames = SOURCE_FREQ;
+    source_data = (Sint16 *)SDL_malloc(source_frames * SOURCE_CHANNELS * sizeof(Sint16));
+    streams = (SDL_AudioStream **)SDL_calloc(max_streams, sizeof(*streams));
+    positions = (int *)SDL_calloc(max_streams, sizeof(*positions));
+    if (!source_data || !streams || !positions) {
+        goto quit;
+    }
+    for (i = 0; i < source_frames * SOURCE_CHANNELS; ++i) {
+        source_data[i] = (Sint16)(SDL_sinf((float)(i / SOURCE_CHANNELS) * 0.0627f) * 30.0f);
+    }
+
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = SOURCE_CHANNELS;
+    spec.freq = 48000;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    if (!devid) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open audio device: %s", SDL_GetError());
+        goto quit;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec, &sample_frames);
+    SDL_SetAudioIterationCallbacks(devid, iteration_start, iteration_end, NULL);
+    SDL_SetAudioPostmixCallback(devid, postmix, NULL);
+
+    src_spec.format = SDL_AUDIO_S16;
+    src_spec.channels = SOURCE_CHANNELS;
+    src_spec.freq = SOURCE_FREQ;
+    for (i = 0; i < max_streams; ++i) {
+        streams[i] = SDL_CreateAudioStream(&src_spec, NULL);
+        if (!streams[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create audio stream: %s", SDL_GetError());
+            goto quit;
+        }
+        SDL_SetAudioStreamGetCallback(streams[i], feed_stream, &positions[i]);
+    }
+
+    SDL_Log("%d sample frames per iteration, %s mixer threads",
+            sample_frames, SDL_GetHint(SDL_HINT_AUDIO_MIXER_THREADS) ? SDL_GetHint(SDL_HINT_AUDIO_MIXER_THREADS) : "0");
+
+    for (i = 0; i < (int)SDL_arraysize(counts) && counts[i] <= max_streams; ++i) {
+        if (!run_benchmark(devid, streams, positions, counts[i], iterations, (double)sample_frames * SDL_US_PER_SECOND / spec.freq)) {
+            goto quit;
+        }
+    }
+    result = 0;
+
+quit:
+    if (streams) {
+        for (i = 0; i < max_streams; ++i) {
+            SDL_DestroyAudioStream(streams[i]);
+        }
+    }
+    SDL_free(streams);
+    SDL_free(positions);
+    SDL_free(source_data);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
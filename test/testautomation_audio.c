@@ -1047,6 +1047,7 @@ static int SDLCALL audio_resampleLoss(void *arg)
     { 50, 5000, SDL_PI_D / 2, 20000, 10000, 999, 0.0001 },
     { 50, 440, 0, 22050, 96000, 79, 0.0120 },
     { 50, 440, 0, 96000, 22050, 80, 0.0002 },
+    { 50, 440, 0, 48000, 44100, 80, 0.0010 },
     { 0 }
   };
 
@@ -1460,6 +1461,125 @@ cleanup:
 
     return status;
 }
+/**
+ * Changes the device format while several streams are pulled on mixer threads.
+ *
+ * \sa SDL_HINT_AUDIO_MIXER_THREADS
+ * \sa SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES
+ */
+static int SDLCALL audio_mixerThreadsFormatChange(void *arg)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    const int num_frames = spec.freq * 2;
+    SDL_AudioStream *streams[4];
+    int queued[SDL_arraysize(streams)];
+    SDL_AudioDeviceID devid = 0;
+    SDL_AudioSpec devspec;
+    float *data = NULL;
+    int sample_frames = 0;
+    int audio_refs = 0;
+    int status = TEST_ABORTED;
+    bool result;
+    int i, j;
+
+    SDL_zeroa(streams);
+
+    /* The mixer threads start with the audio subsystem, so really shut it down first */
+    while (SDL_WasInit(SDL_INIT_AUDIO)) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        ++audio_refs;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIO_MIXER_THREADS, "2");
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, "256");
+    result = SDL_InitSubSystem(SDL_INIT_AUDIO);
+    SDLTest_AssertCheck(result == true, "Call to SDL_InitSubSystem(SDL_INIT_AUDIO) with the dummy driver and mixer threads");
+    if (!result) {
+        goto cleanup;
+    }
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    SDLTest_AssertCheck(devid != 0, "Validate device ID; expected: !=0, got: %" SDL_PRIu32, devid);
+    if (!devid) {
+        goto cleanup;
+    }
+
+    /* Two seconds of a quiet sine wave for every stream */
+    data = (float *)SDL_malloc(num_frames * spec.channels * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Check audio data allocation");
+    if (!data) {
+        goto cleanup;
+    }
+    for (i = 0; i < num_frames; ++i) {
+        data[i * 2] = data[i * 2 + 1] = 0.1f * (float)sine_wave_sample(i, spec.freq, 440, 0.0f);
+    }
+    for (i = 0; i < (int)SDL_arraysize(streams); ++i) {
+        streams[i] = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Check SDL_CreateAudioStream() #%d", i);
+        if (!streams[i] || !SDL_PutAudioStreamData(streams[i], data, num_frames * spec.channels * (int)sizeof(float))) {
+            goto cleanup;
+        }
+    }
+    result = SDL_BindAudioStreams(devid, streams, (int)SDL_arraysize(streams));
+    SDLTest_AssertCheck(result == true, "Check SDL_BindAudioStreams() of %d streams", (int)SDL_arraysize(streams));
+    if (!result) {
+        goto cleanup;
+    }
+    SDL_Delay(50);
+
+    /* A much bigger buffer grows the device's work buffer while the streams stay bound */
+    SDL_SetHint(SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES, "4096");
+    for (i = 0; i < 200; ++i) {
+        if (SDL_GetAudioDeviceFormat(devid, &devspec, &sample_frames) && sample_frames == 4096) {
+            break;
+        }
+        SDL_Delay(10);
+    }
+    SDLTest_AssertCheck(sample_frames == 4096, "Check the device changed its buffer size; expected: 4096, got: %d", sample_frames);
+
+    /* Every stream keeps being pulled after the change */
+    for (i = 0; i < (int)SDL_arraysize(streams); ++i) {
+        queued[i] = SDL_GetAudioStreamQueued(streams[i]);
+    }
+    SDL_Delay(300);
+    for (i = 0; i < (int)SDL_arraysize(streams); ++i) {
+        j = SDL_GetAudioStreamQueued(streams[i]);
+        SDLTest_AssertCheck(j < queued[i], "Check stream #%d is still being played; queued before: %d, after: %d", i, queued[i], j);
+    }
+
+    /* And back down again */
+    SDL_SetHint(SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES, "128");
+    for (i = 0; i < 200; ++i) {
+        if (SDL_GetAudioDeviceFormat(devid, &devspec, &sample_frames) && sample_frames == 128) {
+            break;
+        }
+        SDL_Delay(10);
+    }
+    SDLTest_AssertCheck(sample_frames == 128, "Check the device changed its buffer size; expected: 128, got: %d", sample_frames);
+    SDL_Delay(50);
+
+    status = TEST_COMPLETED;
+
+cleanup:
+    for (i = 0; i < (int)SDL_arraysize(streams); ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    SDL_free(data);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_ResetHint(SDL_HINT_AUDIO_DUMMY_SAMPLE_FRAMES);
+    SDL_ResetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES);
+    SDL_ResetHint(SDL_HINT_AUDIO_MIXER_THREADS);
+    SDL_ResetHint(SDL_HINT_AUDIO_DRIVER);
+    while (audio_refs-- > 0) {
+        SDL_InitSubSystem(SDL_INIT_AUDIO);
+    }
+
+    return status;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1541,13 +1661,17 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_mixerThreadsFormatChange, "audio_mixerThreadsFormatChange", "Change the device format while streams are pulled on mixer threads.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTestGetAudioFormatName,
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, NULL
 };
 
 /* Audio test suite (global) */
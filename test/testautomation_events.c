@@ -304,6 +304,241 @@ static int SDLCALL events_mainThreadCallbacks(void *arg)
     return TEST_COMPLETED;
 }
 
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+#define LOCKFREE_PRODUCERS 4
+#define LOCKFREE_EVENTS_PER_PRODUCER 2000
+
+static int SDLCALL PushUserEventsThread(void *userdata)
+{
+    Sint32 producer = (Sint32)(intptr_t)userdata;
+    SDL_Event events[4];
+    int i, j;
+
+    /* Push single events and small batches so both paths through SDL_PeepEvents() are used */
+    for (i = 0; i < LOCKFREE_EVENTS_PER_PRODUCER;) {
+        const int count = (i % 3) ? 1 : SDL_min((int)SDL_arraysize(events), LOCKFREE_EVENTS_PER_PRODUCER - i);
+        for (j = 0; j < count; ++j) {
+            SDL_zero(events[j]);
+            events[j].type = SDL_EVENT_USER;
+            events[j].user.code = producer;
+            events[j].user.data1 = (void *)(intptr_t)(i + j);
+        }
+        if (count == 1) {
+            if (!SDL_PushEvent(&events[0])) {
+                return -1;
+            }
+        } else if (SDL_PeepEvents(events, count, SDL_ADDEVENT, 0, 0) != count) {
+            return -1;
+        }
+        i += count;
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+/**
+ * Pushes events from several threads with SDL_HINT_EVENT_QUEUE_LOCKFREE
+ * enabled, overflowing the lock-free ring, and checks that every event
+ * arrives in the order it was pushed by its thread.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+static int SDLCALL events_lockFreeQueue(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+    SDL_Thread *threads[LOCKFREE_PRODUCERS];
+    int expected[LOCKFREE_PRODUCERS];
+    SDL_Event event;
+    int i, status, received = 0;
+    bool ordered = true;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_QUEUE_LOCKFREE, "1");
+
+    for (i = 0; i < LOCKFREE_PRODUCERS; ++i) {
+        expected[i] = 0;
+        threads[i] = SDL_CreateThread(PushUserEventsThread, "PushUserEvents", (void *)(intptr_t)i);
+        SDLTest_AssertCheck(threads[i] != NULL, "Create producer thread %d", i);
+    }
+    for (i = 0; i < LOCKFREE_PRODUCERS; ++i) {
+        SDL_WaitThread(threads[i], &status);
+        SDLTest_AssertCheck(status == 0, "Check producer thread %d pushed all events, got status %d", i, status);
+    }
+
+    SDLTest_AssertCheck(SDL_HasEvent(SDL_EVENT_USER), "Check SDL_HasEvent returns true");
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER) == 1) {
+        const Sint32 producer = event.user.code;
+        if (producer < 0 || producer >= LOCKFREE_PRODUCERS || (intptr_t)event.user.data1 != expected[producer]) {
+            ordered = false;
+            break;
+        }
+        ++expected[producer];
+        ++received;
+    }
+    SDLTest_AssertCheck(ordered, "Check events from each producer arrive in order");
+    SDLTest_AssertCheck(received == LOCKFREE_PRODUCERS * LOCKFREE_EVENTS_PER_PRODUCER, "Check number of events received, expected %d, got %d", LOCKFREE_PRODUCERS * LOCKFREE_EVENTS_PER_PRODUCER, received);
+
+    SDL_ResetHint(SDL_HINT_EVENT_QUEUE_LOCKFREE);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Queues interleaved events of several types and checks that they can be
+ * pulled out by type, in queue order, without disturbing the others.
+ *
+ * \sa SDL_DrainEvents
+ * \sa SDL_FlushEvent
+ * \sa SDL_HasEvent
+ */
+static int SDLCALL events_drainEvents(void *arg)
+{
+    const Uint32 base = SDL_RegisterEvents(3);
+    Uint32 types[2];
+    SDL_Event events[64];
+    SDL_Event event;
+    int i, result;
+    bool ordered = true;
+
+    SDLTest_AssertCheck(base != 0, "Register 3 user events");
+    if (!base) {
+        return TEST_ABORTED;
+    }
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < 60; ++i) {
+        SDL_zero(event);
+        event.type = base + (i % 3);
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    /* Pull out two of the three types, the results should be interleaved in queue order */
+    types[0] = base + 2;
+    types[1] = base;
+    result = SDL_DrainEvents(events, SDL_arraysize(events), types, SDL_arraysize(types));
+    SDLTest_AssertCheck(result == 40, "Check SDL_DrainEvents result, expected: 40, got: %d", result);
+    for (i = 0; i < result; ++i) {
+        const int expected = (i / 2) * 3 + ((i % 2) ? 2 : 0);
+        if (events[i].user.code != expected || events[i].type != base + (Uint32)(expected % 3)) {
+            ordered = false;
+        }
+    }
+    SDLTest_AssertCheck(ordered, "Check drained events are in queue order");
+
+    SDLTest_AssertCheck(!SDL_HasEvent(base), "Check SDL_HasEvent returns false for a drained type");
+    SDLTest_AssertCheck(SDL_HasEvent(base + 1), "Check SDL_HasEvent returns true for a remaining type");
+    result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, base, base + 2);
+    SDLTest_AssertCheck(result == 20, "Check remaining events, expected: 20, got: %d", result);
+
+    /* Drain in pieces */
+    types[0] = base + 1;
+    result = SDL_DrainEvents(events, 5, types, 1);
+    SDLTest_AssertCheck(result == 5, "Check partial SDL_DrainEvents result, expected: 5, got: %d", result);
+    SDLTest_AssertCheck(events[0].user.code == 1 && events[4].user.code == 13, "Check partial drain returns the oldest events");
+
+    SDL_FlushEvent(base + 1);
+    SDLTest_AssertCheck(!SDL_HasEvents(base, base + 2), "Check SDL_HasEvents returns false after SDL_FlushEvent");
+
+    /* Invalid parameters are reported as errors, not as an empty queue */
+    SDL_PushEvent(&event);
+    result = SDL_DrainEvents(NULL, 5, types, 1);
+    SDLTest_AssertCheck(result == -1, "Check SDL_DrainEvents with NULL events, expected: -1, got: %d", result);
+    result = SDL_DrainEvents(events, 5, NULL, 1);
+    SDLTest_AssertCheck(result == -1, "Check SDL_DrainEvents with NULL types, expected: -1, got: %d", result);
+    SDLTest_AssertCheck(SDL_HasEvent(event.type), "Check failed SDL_DrainEvents calls left the queue alone");
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that consecutive motion events are merged when
+ * SDL_HINT_EVENT_COALESCE_MOTION is enabled.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+static int SDLCALL events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    SDL_Event events[4];
+    int i, result;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "2");
+
+    /* Three motion events with the same state, followed by one with a button held */
+    for (i = 0; i < 4; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.common.timestamp = 1000 + i;
+        event.motion.windowID = 1;
+        event.motion.which = 1;
+        event.motion.state = (i == 3) ? SDL_BUTTON_LMASK : 0;
+        event.motion.x = 10.0f * (i + 1);
+        event.motion.y = 20.0f * (i + 1);
+        event.motion.xrel = 1.0f;
+        event.motion.yrel = 2.0f;
+        SDL_PushEvent(&event);
+    }
+
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDLTest_AssertCheck(result == 2, "Check number of motion events, expected: 2, got: %d", result);
+    if (result == 2) {
+        SDLTest_AssertCheck(events[0].motion.x == 30.0f && events[0].motion.y == 60.0f, "Check merged event has the latest position, got: %g,%g", events[0].motion.x, events[0].motion.y);
+        SDLTest_AssertCheck(events[0].motion.xrel == 3.0f && events[0].motion.yrel == 6.0f, "Check merged event accumulates relative motion, got: %g,%g", events[0].motion.xrel, events[0].motion.yrel);
+        SDLTest_AssertCheck(events[0].motion.timestamp == 1002, "Check merged event has the latest timestamp, got: %" SDL_PRIu64, events[0].motion.timestamp);
+        SDLTest_AssertCheck(events[0].motion.num_samples == 3 && events[0].motion.samples != NULL, "Check merged event has 3 samples, got: %d", events[0].motion.num_samples);
+        if (events[0].motion.num_samples == 3 && events[0].motion.samples) {
+            SDLTest_AssertCheck(events[0].motion.samples[0].x == 10.0f && events[0].motion.samples[2].x == 30.0f, "Check samples are oldest first");
+        }
+        SDLTest_AssertCheck(events[1].motion.num_samples == 0 && events[1].motion.xrel == 1.0f, "Check the event with a different button state wasn't merged");
+    }
+
+    /* Samples of a peeked event stay valid while more motion is merged into it */
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    for (i = 0; i < 5; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.windowID = 1;
+        event.motion.which = 1;
+        event.motion.x = 10.0f * (i + 1);
+        SDL_PushEvent(&event);
+        if (i == 1) {
+            result = SDL_PeepEvents(&events[2], 1, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+            SDLTest_AssertCheck(result == 1 && events[2].motion.num_samples == 2, "Check peeked event has 2 samples, got: %d", events[2].motion.num_samples);
+        }
+    }
+    result = SDL_PeepEvents(&events[3], 1, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDLTest_AssertCheck(result == 1 && events[3].motion.num_samples == 5, "Check merged event has 5 samples, got: %d", events[3].motion.num_samples);
+    if (events[2].motion.num_samples == 2 && events[2].motion.samples) {
+        SDLTest_AssertCheck(events[2].motion.samples[0].x == 10.0f && events[2].motion.samples[1].x == 20.0f, "Check earlier peeked samples are unchanged, got: %g,%g", events[2].motion.samples[0].x, events[2].motion.samples[1].x);
+    }
+    if (events[3].motion.num_samples == 5 && events[3].motion.samples) {
+        SDLTest_AssertCheck(events[3].motion.samples[1].x == 20.0f && events[3].motion.samples[4].x == 50.0f, "Check grown samples are oldest first");
+    }
+
+    /* Without the hint, nothing is merged */
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+    for (i = 0; i < 2; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_PEN_MOTION;
+        event.pmotion.which = 1;
+        SDL_PushEvent(&event);
+    }
+    result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_PEN_MOTION, SDL_EVENT_PEN_MOTION);
+    SDLTest_AssertCheck(result == 2, "Check pen motion isn't merged by default, expected: 2, got: %d", result);
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -323,12 +558,27 @@ static const SDLTest_TestCaseReference eventsTest_mainThreadCallbacks = {
     events_mainThreadCallbacks, "events_mainThreadCallbacks", "Run callbacks on the main thread", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_lockFreeQueue = {
+    events_lockFreeQueue, "events_lockFreeQueue", "Pushes events from several threads through the lock-free queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_drainEvents = {
+    events_drainEvents, "events_drainEvents", "Removes events of a set of types from the queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
     &eventsTest_mainThreadCallbacks,
+    &eventsTest_lockFreeQueue,
+    &eventsTest_drainEvents,
+    &eventsTest_coalesceMotion,
     NULL
 };
 
@@ -393,6 +393,73 @@ static int SDLCALL iostrm_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a memory mapped file.
+ *
+ * \sa SDL_IOFromFile
+ * \sa SDL_LoadFileNoCopy
+ */
+static int SDLCALL iostrm_testFileMapped(void *arg)
+{
+    SDL_IOStream *rw;
+    SDL_ReleaseFileDataCallback release = NULL;
+    void *userdata = NULL;
+    const void *data;
+    const void *mem;
+    size_t size = 0;
+    int result;
+
+    /* Read test. */
+    rw = SDL_IOFromFile(IOStreamReadTestFilename, "rbm");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"rbm\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in mapped mode does not return NULL");
+
+    /* Bail out if NULL */
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Run generic tests */
+    testGenericIOStreamValidations(rw, false);
+
+    /* If the file was mapped, the mapping holds the file contents */
+    mem = SDL_GetPointerProperty(SDL_GetIOProperties(rw), SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+    if (mem) {
+        size = (size_t)SDL_GetNumberProperty(SDL_GetIOProperties(rw), SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, 0);
+        SDLTest_AssertCheck(size == SDL_strlen(IOStreamHelloWorldTestString), "Verify mapped size, expected %d, got %d", (int)SDL_strlen(IOStreamHelloWorldTestString), (int)size);
+        SDLTest_AssertCheck(SDL_memcmp(mem, IOStreamHelloWorldTestString, size) == 0, "Verify mapped contents");
+    }
+
+    /* Close handle */
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    /* Mapping is read-only */
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "wm");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile(..,\"wm\") does not return NULL");
+    if (rw) {
+        SDLTest_AssertCheck(SDL_WriteIO(rw, "x", 1) == 1, "Verify writing to a file opened with \"wm\"");
+        SDL_CloseIO(rw);
+    }
+
+    /* Load the whole file without copying */
+    data = SDL_LoadFileNoCopy(IOStreamAlphabetFilename, &size, &release, &userdata);
+    SDLTest_AssertPass("Call to SDL_LoadFileNoCopy() succeeded");
+    SDLTest_AssertCheck(data != NULL, "Verify SDL_LoadFileNoCopy() does not return NULL");
+    SDLTest_AssertCheck(release != NULL, "Verify SDL_LoadFileNoCopy() returns a release callback");
+    if (data && release) {
+        SDLTest_AssertCheck(size == SDL_strlen(IOStreamAlphabetString), "Verify loaded size, expected %d, got %d", (int)SDL_strlen(IOStreamAlphabetString), (int)size);
+        SDLTest_AssertCheck(SDL_memcmp(data, IOStreamAlphabetString, size) == 0, "Verify loaded contents");
+        release(userdata, data);
+    }
+
+    data = SDL_LoadFileNoCopy("a file that does not exist", &size, &release, &userdata);
+    SDLTest_AssertCheck(data == NULL, "Verify SDL_LoadFileNoCopy() of a missing file returns NULL");
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -647,6 +714,234 @@ static int SDLCALL iostrm_testFileWriteReadEndian(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading and writing through the userspace buffer.
+ *
+ * \sa SDL_SetIOBufferSize
+ * \sa SDL_ReadU32LEArray
+ */
+static int SDLCALL iostrm_testBufferedIO(void *arg)
+{
+    SDL_IOStream *rw;
+    Uint16 value16;
+    Uint32 value32;
+    Uint64 value64;
+    Uint16 values16[19];
+    Uint32 values32[21];
+    Uint64 values64[5];
+    Sint64 position;
+    bool ok;
+    int i;
+
+    rw = SDL_IOFromFile(IOStreamWriteTestFilename, "w+b");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile(..,\"w+b\") does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* A tiny buffer makes every operation cross a refill or flush */
+    ok = SDL_SetIOBufferSize(rw, 7);
+    SDLTest_AssertCheck(ok, "Verify SDL_SetIOBufferSize(rw, 7) succeeded");
+
+    testGenericIOStreamValidations(rw, true);
+
+    /* Write a mix of typed values */
+    position = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(position == 0, "Verify seek to 0, got %" SDL_PRIs64, position);
+    ok = SDL_WriteU16LE(rw, 0x1234);
+    ok = SDL_WriteU32BE(rw, 0x89ABCDEF) && ok;
+    ok = SDL_WriteU64LE(rw, 0x0123456789ABCDEFULL) && ok;
+    for (i = 0; i < SDL_arraysize(values16); ++i) {
+        ok = SDL_WriteU16BE(rw, (Uint16)(i * 0x0101 + 1)) && ok;
+    }
+    for (i = 0; i < SDL_arraysize(values32); ++i) {
+        ok = SDL_WriteU32LE(rw, (Uint32)i * 0x01020304) && ok;
+    }
+    for (i = 0; i < SDL_arraysize(values64); ++i) {
+        ok = SDL_WriteU64BE(rw, (Uint64)i * 0x0102030405060708ULL) && ok;
+    }
+    SDLTest_AssertCheck(ok, "Verify typed writes succeeded");
+    position = SDL_TellIO(rw);
+    SDLTest_AssertCheck(position == 14 + 2 * 19 + 4 * 21 + 8 * 5, "Verify position after writes, got %" SDL_PRIs64, position);
+    SDLTest_AssertCheck(SDL_GetIOSize(rw) == position, "Verify size includes buffered writes");
+
+    /* Read them back */
+    position = SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(position == 0, "Verify seek to 0, got %" SDL_PRIs64, position);
+    ok = SDL_ReadU16LE(rw, &value16);
+    SDLTest_AssertCheck(ok && value16 == 0x1234, "Verify SDL_ReadU16LE, got 0x%x", value16);
+    ok = SDL_ReadU32BE(rw, &value32);
+    SDLTest_AssertCheck(ok && value32 == 0x89ABCDEF, "Verify SDL_ReadU32BE, got 0x%x", value32);
+    ok = SDL_ReadU64LE(rw, &value64);
+    SDLTest_AssertCheck(ok && value64 == 0x0123456789ABCDEFULL, "Verify SDL_ReadU64LE, got 0x%" SDL_PRIx64, value64);
+
+    /* Seeking inside the read buffer */
+    position = SDL_SeekIO(rw, -4, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(position == 10, "Verify relative seek inside the buffer, expected 10, got %" SDL_PRIs64, position);
+    position = SDL_SeekIO(rw, 4, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(position == 14, "Verify relative seek inside the buffer, expected 14, got %" SDL_PRIs64, position);
+
+    ok = SDL_ReadU16BEArray(rw, values16, SDL_arraysize(values16));
+    SDLTest_AssertCheck(ok, "Verify SDL_ReadU16BEArray succeeded");
+    for (i = 0; i < SDL_arraysize(values16); ++i) {
+        SDLTest_AssertCheck(values16[i] == (Uint16)(i * 0x0101 + 1), "Verify value16[%d], got 0x%x", i, values16[i]);
+    }
+    ok = SDL_ReadU32LEArray(rw, values32, SDL_arraysize(values32));
+    SDLTest_AssertCheck(ok, "Verify SDL_ReadU32LEArray succeeded");
+    for (i = 0; i < SDL_arraysize(values32); ++i) {
+        SDLTest_AssertCheck(values32[i] == (Uint32)i * 0x01020304, "Verify value32[%d], got 0x%x", i, values32[i]);
+    }
+    ok = SDL_ReadU64BEArray(rw, values64, SDL_arraysize(values64));
+    SDLTest_AssertCheck(ok, "Verify SDL_ReadU64BEArray succeeded");
+    for (i = 0; i < SDL_arraysize(values64); ++i) {
+        SDLTest_AssertCheck(values64[i] == (Uint64)i * 0x0102030405060708ULL, "Verify value64[%d], got 0x%" SDL_PRIx64, i, values64[i]);
+    }
+
+    /* Reading past the end */
+    ok = SDL_ReadU32LE(rw, &value32);
+    SDLTest_AssertCheck(!ok, "Verify reading past the end fails");
+    SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify status is EOF, got %d", (int)SDL_GetIOStatus(rw));
+
+    /* Overwrite a value after reading, then turn the buffer off and check it */
+    position = SDL_SeekIO(rw, 2, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(position == 2, "Verify seek to 2, got %" SDL_PRIs64, position);
+    ok = SDL_ReadU16BE(rw, &value16);
+    SDLTest_AssertCheck(ok && value16 == 0x89AB, "Verify SDL_ReadU16BE, got 0x%x", value16);
+    ok = SDL_WriteU16BE(rw, 0x5555);
+    SDLTest_AssertCheck(ok, "Verify writing after reading succeeded");
+    ok = SDL_SetIOBufferSize(rw, 0);
+    SDLTest_AssertCheck(ok, "Verify SDL_SetIOBufferSize(rw, 0) succeeded");
+    position = SDL_SeekIO(rw, 2, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(position == 2, "Verify seek to 2, got %" SDL_PRIs64, position);
+    ok = SDL_ReadU32BE(rw, &value32);
+    SDLTest_AssertCheck(ok && value32 == 0x89AB5555, "Verify unbuffered SDL_ReadU32BE, got 0x%x", value32);
+
+    SDL_CloseIO(rw);
+    SDL_RemovePath(IOStreamWriteTestFilename);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests batched async reads into a registered buffer.
+ *
+ * This runs on whichever async I/O backend is available; where buffers or
+ * batches aren't supported natively they must still behave correctly.
+ *
+ * \sa SDL_BeginAsyncIOBatch
+ * \sa SDL_EndAsyncIOBatch
+ * \sa SDL_RegisterAsyncIOBuffer
+ * \sa SDL_UnregisterAsyncIOBuffer
+ */
+static int SDLCALL iostrm_testAsyncIOBatch(void *arg)
+{
+    const int num_blocks = (int)SDL_strlen(IOStreamAlphabetString) / 2;
+    SDL_PropertiesID props;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOOutcome outcome;
+    Uint8 *registered;
+    Uint8 tail[16];
+    bool seen[(sizeof(IOStreamAlphabetString) - 1) / 2 + 1];
+    int completed = 0;
+    bool ok;
+    int i;
+
+    SDL_zeroa(seen);
+    SDL_memset(tail, 0xEE, sizeof(tail));
+
+    /* Fewer entries than reads, so a backend with a submission ring fills it mid-batch */
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_ENTRIES_NUMBER, 4);
+    SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_FILES_NUMBER, 1);
+    SDL_SetNumberProperty(props, SDL_PROP_ASYNCIOQUEUE_CREATE_REGISTERED_BUFFERS_NUMBER, 1);
+    queue = SDL_CreateAsyncIOQueueWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueueWithProperties() succeeded");
+    if (!queue) {
+        return TEST_ABORTED;
+    }
+
+    ok = SDL_EndAsyncIOBatch(queue);
+    SDLTest_AssertCheck(!ok, "Verify SDL_EndAsyncIOBatch() without a batch fails");
+
+    registered = (Uint8 *)SDL_malloc(num_blocks * 2);
+    SDLTest_AssertCheck(registered != NULL, "Verify buffer allocation succeeded");
+    asyncio = SDL_AsyncIOFromFile(IOStreamAlphabetFilename, "r");
+    SDLTest_AssertCheck(asyncio != NULL, "Verify SDL_AsyncIOFromFile(\"%s\", \"r\") succeeded", IOStreamAlphabetFilename);
+    if (!registered || !asyncio) {
+        SDL_free(registered);
+        SDL_DestroyAsyncIOQueue(queue);
+        return TEST_ABORTED;
+    }
+    SDL_memset(registered, 0xEE, num_blocks * 2);
+
+    ok = SDL_RegisterAsyncIOBuffer(queue, registered, num_blocks * 2);
+    SDLTest_AssertCheck(ok, "Verify SDL_RegisterAsyncIOBuffer() succeeded");
+
+    /* Read the alphabet two letters at a time, back to front, inside nested batches */
+    ok = SDL_BeginAsyncIOBatch(queue);
+    SDLTest_AssertCheck(ok, "Verify SDL_BeginAsyncIOBatch() succeeded");
+    for (i = num_blocks - 1; i >= 0; --i) {
+        if (i == num_blocks / 2) {
+            ok = SDL_BeginAsyncIOBatch(queue);
+            SDLTest_AssertCheck(ok, "Verify nested SDL_BeginAsyncIOBatch() succeeded");
+        }
+        ok = SDL_ReadAsyncIO(asyncio, registered + i * 2, (Uint64)i * 2, 2, queue, (void *)(intptr_t)i);
+        SDLTest_AssertCheck(ok, "Verify SDL_ReadAsyncIO() of block %d succeeded", i);
+    }
+    /* ...and a read from unregistered memory that runs past the end of the file */
+    ok = SDL_ReadAsyncIO(asyncio, tail, 20, sizeof(tail), queue, (void *)(intptr_t)num_blocks);
+    SDLTest_AssertCheck(ok, "Verify SDL_ReadAsyncIO() past the end of the file succeeded");
+    ok = SDL_EndAsyncIOBatch(queue);
+    SDLTest_AssertCheck(ok, "Verify nested SDL_EndAsyncIOBatch() succeeded");
+    ok = SDL_EndAsyncIOBatch(queue);
+    SDLTest_AssertCheck(ok, "Verify SDL_EndAsyncIOBatch() succeeded");
+
+    while (completed <= num_blocks) {
+        int index;
+
+        if (!SDL_WaitAsyncIOResult(queue, &outcome, 5000)) {
+            SDLTest_AssertCheck(false, "Verify all reads completed, only got %d", completed);
+            break;
+        }
+        ++completed;
+        index = (int)(intptr_t)outcome.userdata;
+        SDLTest_AssertCheck(index >= 0 && index <= num_blocks && !seen[index], "Verify result %d is delivered once", index);
+        if (index < 0 || index > num_blocks) {
+            continue;
+        }
+        seen[index] = true;
+        SDLTest_AssertCheck(outcome.result == SDL_ASYNCIO_COMPLETE, "Verify read %d completed, got %d", index, (int)outcome.result);
+        SDLTest_AssertCheck(outcome.type == SDL_ASYNCIO_TASK_READ, "Verify read %d is a read task", index);
+        if (index < num_blocks) {
+            SDLTest_AssertCheck(outcome.buffer == registered + index * 2, "Verify read %d buffer", index);
+            SDLTest_AssertCheck(outcome.bytes_transferred == 2, "Verify read %d transferred 2 bytes, got %" SDL_PRIu64, index, outcome.bytes_transferred);
+        } else {
+            SDLTest_AssertCheck(outcome.buffer == tail, "Verify tail read buffer");
+            SDLTest_AssertCheck(outcome.bytes_transferred == 6, "Verify tail read transferred 6 bytes, got %" SDL_PRIu64, outcome.bytes_transferred);
+        }
+    }
+    SDLTest_AssertCheck(!SDL_GetAsyncIOResult(queue, &outcome), "Verify no extra results were delivered");
+
+    SDLTest_AssertCheck(SDL_memcmp(registered, IOStreamAlphabetString, num_blocks * 2) == 0, "Verify the registered buffer holds the alphabet");
+    SDLTest_AssertCheck(SDL_memcmp(tail, "UVWXYZ", 6) == 0, "Verify the tail read holds the end of the alphabet");
+    SDLTest_AssertCheck(tail[6] == 0xEE, "Verify the tail read didn't write past the end of the file");
+
+    ok = SDL_UnregisterAsyncIOBuffer(queue, registered);
+    SDLTest_AssertCheck(ok, "Verify SDL_UnregisterAsyncIOBuffer() succeeded");
+
+    ok = SDL_CloseAsyncIO(asyncio, false, queue, NULL);
+    SDLTest_AssertCheck(ok, "Verify SDL_CloseAsyncIO() succeeded");
+    ok = SDL_WaitAsyncIOResult(queue, &outcome, 5000);
+    SDLTest_AssertCheck(ok && outcome.type == SDL_ASYNCIO_TASK_CLOSE && outcome.result == SDL_ASYNCIO_COMPLETE, "Verify the close completed");
+
+    SDL_DestroyAsyncIOQueue(queue);
+    SDL_free(registered);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* IOStream test cases */
@@ -686,10 +981,22 @@ static const SDLTest_TestCaseReference iostrmTest9 = {
     iostrm_testCompareRWFromMemWithRWFromFile, "iostrm_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile IOStream for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference iostrmTest10 = {
+    iostrm_testFileMapped, "iostrm_testFileMapped", "Tests reading from a memory mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest11 = {
+    iostrm_testBufferedIO, "iostrm_testBufferedIO", "Tests reading and writing through a userspace buffer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest12 = {
+    iostrm_testAsyncIOBatch, "iostrm_testAsyncIOBatch", "Tests batched async reads into a registered buffer", TEST_ENABLED
+};
+
 /* Sequence of IOStream test cases */
 static const SDLTest_TestCaseReference *iostrmTests[] = {
     &iostrmTest1, &iostrmTest2, &iostrmTest3, &iostrmTest4, &iostrmTest5, &iostrmTest6,
-    &iostrmTest7, &iostrmTest8, &iostrmTest9, NULL
+    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, &iostrmTest12, NULL
 };
 
 /* IOStream test suite (global) */
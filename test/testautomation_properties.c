@@ -382,6 +382,176 @@ static int SDLCALL properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test getting, setting and destroying properties from several threads at once
+ */
+#define NUM_CONCURRENT_THREADS 4
+#define NUM_CONCURRENT_ITERATIONS 2000
+struct properties_concurrent_data
+{
+    SDL_PropertiesID shared;
+    SDL_AtomicU32 churned;
+    SDL_AtomicInt cleanups;
+    SDL_AtomicInt errors;
+    int index;
+};
+static void SDLCALL concurrent_cleanup(void *userdata, void *value)
+{
+    struct properties_concurrent_data *data = (struct properties_concurrent_data *)userdata;
+    SDL_AddAtomicInt(&data->cleanups, 1);
+}
+static int SDLCALL properties_concurrent_thread(void *arg)
+{
+    struct properties_concurrent_data *thread_data = (struct properties_concurrent_data *)arg;
+    struct properties_concurrent_data *data = thread_data - thread_data->index;
+    char name[32], value[32];
+    const char *string;
+    SDL_PropertiesID props;
+    int i;
+
+    SDL_snprintf(name, sizeof(name), "thread%d", thread_data->index);
+    for (i = 0; i < NUM_CONCURRENT_ITERATIONS; ++i) {
+        /* Replace our own properties in the shared group, and read everybody's. */
+        SDL_snprintf(value, sizeof(value), "%d", i);
+        SDL_SetStringProperty(data->shared, name, value);
+        SDL_SetNumberProperty(data->shared, "number", i);
+        string = SDL_GetStringProperty(data->shared, name, NULL);
+        if (!string || SDL_atoi(string) != i) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+        if (SDL_GetNumberProperty(data->shared, "number", -1) < 0) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+        string = SDL_GetStringProperty(data->shared, "number", NULL);
+        if (!string || SDL_atoi(string) < 0) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+
+        /* Read a group that another thread might be destroying, it's either there or it isn't. */
+        props = SDL_GetAtomicU32(&data->churned);
+        string = SDL_GetStringProperty(props, "check", "gone");
+        if (SDL_strcmp(string, "check") != 0 && SDL_strcmp(string, "gone") != 0) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+
+        /* Publish a new group, and destroy the one it replaces while other threads might be reading it. */
+        props = SDL_CreateProperties();
+        SDL_SetStringProperty(props, "check", "check");
+        SDL_SetPointerPropertyWithCleanup(props, "pointer", data, concurrent_cleanup, data);
+        SDL_SetPointerPropertyWithCleanup(props, "pointer", data, concurrent_cleanup, data);
+        SDL_DestroyProperties(SDL_SetAtomicU32(&data->churned, props));
+    }
+    return 0;
+}
+static int SDLCALL properties_testConcurrency(void *arg)
+{
+    struct properties_concurrent_data data[NUM_CONCURRENT_THREADS];
+    SDL_Thread *threads[NUM_CONCURRENT_THREADS];
+    int i, cleanups, expected, errors;
+
+    SDL_zeroa(data);
+    data[0].shared = SDL_CreateProperties();
+    SDLTest_AssertCheck(data[0].shared != 0, "Verify SDL_CreateProperties() succeeded");
+
+    SDLTest_AssertPass("Starting %d threads that get, set and destroy properties", NUM_CONCURRENT_THREADS);
+    for (i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+        data[i].index = i;
+        threads[i] = SDL_CreateThread(properties_concurrent_thread, "properties_concurrent", &data[i]);
+    }
+    for (i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_DestroyProperties(SDL_GetAtomicU32(&data[0].churned));
+
+    errors = SDL_GetAtomicInt(&data[0].errors);
+    SDLTest_AssertCheck(errors == 0, "Verify threads read only values that were set, got %d bad reads", errors);
+    for (i = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "thread%d", i);
+        if (threads[i]) {
+            SDLTest_AssertCheck(SDL_GetNumberProperty(data[0].shared, name, -1) == NUM_CONCURRENT_ITERATIONS - 1,
+                "Verify %s has its last value, got %" SDL_PRIs64, name, SDL_GetNumberProperty(data[0].shared, name, -1));
+        }
+    }
+
+    /* Every pointer was set twice, and cleaned up once when it was replaced and once when its group was destroyed. */
+    cleanups = SDL_GetAtomicInt(&data[0].cleanups);
+    for (i = 0, expected = 0; i < NUM_CONCURRENT_THREADS; ++i) {
+        if (threads[i]) {
+            expected += 2 * NUM_CONCURRENT_ITERATIONS;
+        }
+    }
+    SDLTest_AssertCheck(cleanups == expected, "Verify every cleanup ran once, got %d, expected %d", cleanups, expected);
+
+    SDL_DestroyProperties(data[0].shared);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that properties changed under SDL_LockProperties() are seen together
+ */
+struct properties_pair_data
+{
+    SDL_AtomicInt done;
+    SDL_PropertiesID props;
+};
+static int SDLCALL properties_pair_thread(void *arg)
+{
+    struct properties_pair_data *data = (struct properties_pair_data *)arg;
+    Sint64 i;
+
+    for (i = 1; !SDL_GetAtomicInt(&data->done); ++i) {
+        SDL_LockProperties(data->props);
+        /* Other threads shouldn't ever see the intermediate value, give them every chance to. */
+        SDL_SetNumberProperty(data->props, "x", -1);
+        SDL_Delay(0);
+        SDL_SetNumberProperty(data->props, "y", i);
+        SDL_SetNumberProperty(data->props, "x", i);
+        SDL_UnlockProperties(data->props);
+    }
+    return 0;
+}
+static int SDLCALL properties_testLockedPairs(void *arg)
+{
+    struct properties_pair_data data;
+    SDL_Thread *thread;
+    Sint64 x, y;
+    int i, torn = 0, intermediate = 0;
+
+    SDL_SetAtomicInt(&data.done, 0);
+    data.props = SDL_CreateProperties();
+    SDL_SetNumberProperty(data.props, "x", 0);
+    SDL_SetNumberProperty(data.props, "y", 0);
+
+    thread = SDL_CreateThread(properties_pair_thread, "properties_pair", &data);
+    if (thread) {
+        SDLTest_AssertPass("Reading properties while another thread changes them together");
+        for (i = 0; i < 10000; ++i) {
+            SDL_LockProperties(data.props);
+            x = SDL_GetNumberProperty(data.props, "x", -2);
+            y = SDL_GetNumberProperty(data.props, "y", -2);
+            SDL_UnlockProperties(data.props);
+            if (x != y) {
+                ++torn;
+            }
+
+            /* Reading without the lock has to wait for the other thread to unlock too. */
+            if (SDL_GetNumberProperty(data.props, "x", -2) < 0) {
+                ++intermediate;
+            }
+        }
+        SDL_SetAtomicInt(&data.done, 1);
+        SDL_WaitThread(thread, NULL);
+
+        SDLTest_AssertCheck(torn == 0, "Verify locked reads saw x and y change together, got %d mismatches", torn);
+        SDLTest_AssertCheck(intermediate == 0, "Verify unlocked reads waited for the lock, got %d intermediate values", intermediate);
+    }
+    SDL_DestroyProperties(data.props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -401,12 +571,22 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestConcurrency = {
+    properties_testConcurrency, "properties_testConcurrency", "Test getting, setting and destroying properties from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTestLockedPairs = {
+    properties_testLockedPairs, "properties_testLockedPairs", "Test that properties changed while locked are seen together", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestConcurrency,
+    &propertiesTestLockedPairs,
     NULL
 };
 
@@ -291,6 +291,259 @@ static int SDLCALL render_testBlit(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests batched blitting.
+ */
+static int SDLCALL render_testBlitBatch(void *arg)
+{
+    SDL_FRect srcrects[8];
+    SDL_FRect *dstrects;
+    SDL_FColor colors[8];
+    double angles[8];
+    SDL_FlipMode flips[8];
+    SDL_Texture *tface;
+    SDL_Surface *referenceSurface = NULL;
+    SDL_Surface *batchSurface = NULL;
+    const SDL_Rect screen = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    int i, j, ni, nj, count;
+    int ret;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Need drawcolor or just skip test. */
+    SDLTest_AssertCheck(hasDrawColor(), "hasDrawColor)");
+
+    /* Create face surface. */
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Draw the same grid as render_testBlit in a single call */
+    ni = TESTRENDER_SCREEN_W - tface->w;
+    nj = TESTRENDER_SCREEN_H - tface->h;
+    dstrects = (SDL_FRect *)SDL_malloc(((ni / 4) + 1) * ((nj / 4) + 1) * sizeof(*dstrects));
+    if (!dstrects) {
+        SDL_DestroyTexture(tface);
+        return TEST_ABORTED;
+    }
+    count = 0;
+    for (j = 0; j <= nj; j += 4) {
+        for (i = 0; i <= ni; i += 4) {
+            dstrects[count].x = (float)i;
+            dstrects[count].y = (float)j;
+            dstrects[count].w = (float)tface->w;
+            dstrects[count].h = (float)tface->h;
+            ++count;
+        }
+    }
+    CHECK_FUNC(SDL_RenderTextures, (renderer, tface, NULL, dstrects, NULL, NULL, NULL, count))
+
+    /* See if it's the same */
+    referenceSurface = SDLTest_ImageBlit();
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+    SDL_DestroySurface(referenceSurface);
+    SDL_free(dstrects);
+
+    /* Draw sprites with per-sprite parameters in a batch */
+    for (i = 0; i < (int)SDL_arraysize(srcrects); ++i) {
+        srcrects[i].x = (float)(i * 2);
+        srcrects[i].y = (float)i;
+        srcrects[i].w = (float)(tface->w / 2);
+        srcrects[i].h = (float)(tface->h / 2);
+        colors[i].r = 1.0f;
+        colors[i].g = (float)(i + 1) / 8;
+        colors[i].b = (float)(8 - i) / 8;
+        colors[i].a = 1.0f;
+        angles[i] = (i % 4) * 90.0;
+        flips[i] = (SDL_FlipMode)(i % 3);
+    }
+    dstrects = (SDL_FRect *)SDL_malloc(SDL_arraysize(srcrects) * sizeof(*dstrects));
+    if (!dstrects) {
+        SDL_DestroyTexture(tface);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < (int)SDL_arraysize(srcrects); ++i) {
+        dstrects[i].x = (float)((i % 4) * 20);
+        dstrects[i].y = (float)((i / 4) * 30);
+        dstrects[i].w = 16.0f;
+        dstrects[i].h = 16.0f;
+    }
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTextures, (renderer, tface, srcrects, dstrects, colors, angles, flips, (int)SDL_arraysize(srcrects)))
+    batchSurface = SDL_RenderReadPixels(renderer, &screen);
+    SDLTest_AssertCheck(batchSurface != NULL, "Validate result from SDL_RenderReadPixels, got NULL, %s", SDL_GetError());
+
+    /* Draw the same sprites one at a time and compare */
+    clearScreen();
+    for (i = 0; i < (int)SDL_arraysize(srcrects); ++i) {
+        CHECK_FUNC(SDL_SetTextureColorModFloat, (tface, colors[i].r, colors[i].g, colors[i].b))
+        CHECK_FUNC(SDL_RenderTextureRotated, (renderer, tface, &srcrects[i], &dstrects[i], angles[i], NULL, flips[i]))
+    }
+    CHECK_FUNC(SDL_SetTextureColorModFloat, (tface, 1.0f, 1.0f, 1.0f))
+    if (batchSurface) {
+        referenceSurface = SDL_ConvertSurface(batchSurface, RENDER_COMPARE_FORMAT);
+        compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+        SDL_DestroySurface(referenceSurface);
+        SDL_DestroySurface(batchSurface);
+    }
+
+    /* Invalid parameters */
+    ret = SDL_RenderTextures(renderer, tface, NULL, NULL, NULL, NULL, NULL, 1);
+    SDLTest_AssertCheck(!ret, "Validate SDL_RenderTextures() fails without dstrects");
+    ret = SDL_RenderTextures(renderer, tface, NULL, dstrects, NULL, NULL, NULL, -1);
+    SDLTest_AssertCheck(!ret, "Validate SDL_RenderTextures() fails with a negative count");
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_free(dstrects);
+    SDL_DestroyTexture(tface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing textures packed into an atlas.
+ *
+ * \sa SDL_CreateTextureWithProperties
+ */
+static int SDLCALL render_testBlitAtlas(void *arg)
+{
+    SDL_Surface *face, *converted;
+    SDL_Texture *tface, *tsmall[4];
+    SDL_Surface *referenceSurface = NULL;
+    SDL_PropertiesID props, renderer_props;
+    SDL_FRect rect, *srcrects, *dstrects;
+    SDL_Vertex vertices[3];
+    int i, j, ni, nj, n;
+    int ret;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Need drawcolor or just skip test. */
+    SDLTest_AssertCheck(hasDrawColor(), "hasDrawColor)");
+
+    face = SDLTest_ImageFace();
+    if (!face) {
+        return TEST_ABORTED;
+    }
+    converted = SDL_ConvertSurface(face, SDL_PIXELFORMAT_ARGB8888);
+    SDL_DestroySurface(face);
+    if (!converted) {
+        return TEST_ABORTED;
+    }
+
+    /* Create the face as an atlased texture */
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, converted->format);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, converted->w);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, converted->h);
+    SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_ATLAS_BOOLEAN, true);
+    tface = SDL_CreateTextureWithProperties(renderer, props);
+    SDLTest_AssertCheck(tface != NULL, "Verify SDL_CreateTextureWithProperties() result");
+    if (tface == NULL) {
+        SDL_DestroyProperties(props);
+        SDL_DestroySurface(converted);
+        return TEST_ABORTED;
+    }
+    CHECK_FUNC(SDL_UpdateTexture, (tface, NULL, converted->pixels, converted->pitch))
+
+    /* A few more small textures share the page */
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, 8);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, 8);
+    for (i = 0; i < (int)SDL_arraysize(tsmall); ++i) {
+        tsmall[i] = SDL_CreateTextureWithProperties(renderer, props);
+        SDLTest_AssertCheck(tsmall[i] != NULL, "Verify SDL_CreateTextureWithProperties() result");
+    }
+    SDL_DestroyProperties(props);
+
+    renderer_props = SDL_GetRendererProperties(renderer);
+    ret = (int)SDL_GetNumberProperty(renderer_props, SDL_PROP_RENDERER_ATLAS_PAGES_NUMBER, 0);
+    SDLTest_AssertCheck(ret == 1, "Validate atlas page count, expected: 1, got: %d", ret);
+    ret = (int)SDL_GetNumberProperty(renderer_props, SDL_PROP_RENDERER_ATLAS_USED_PIXELS_NUMBER, 0);
+    SDLTest_AssertCheck(ret == converted->w * converted->h + 4 * 8 * 8, "Validate atlas used pixels, expected: %d, got: %d", converted->w * converted->h + 4 * 8 * 8, ret);
+    SDL_DestroySurface(converted);
+
+    /* Draw the same grid as render_testBlit, alternating with another atlased texture */
+    rect.w = (float)tface->w;
+    rect.h = (float)tface->h;
+    ni = TESTRENDER_SCREEN_W - tface->w;
+    nj = TESTRENDER_SCREEN_H - tface->h;
+    for (j = 0; j <= nj; j += 4) {
+        for (i = 0; i <= ni; i += 4) {
+            const SDL_FRect offscreen = { -16.0f, -16.0f, 8.0f, 8.0f };
+            rect.x = (float)i;
+            rect.y = (float)j;
+            CHECK_FUNC(SDL_RenderTexture, (renderer, tface, NULL, &rect))
+            CHECK_FUNC(SDL_RenderTexture, (renderer, tsmall[0], NULL, &offscreen))
+        }
+    }
+
+    /* See if it's the same */
+    referenceSurface = SDLTest_ImageBlit();
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+    SDL_DestroySurface(referenceSurface);
+
+    SDL_RenderPresent(renderer);
+    ret = (int)SDL_GetNumberProperty(renderer_props, SDL_PROP_RENDERER_ATLAS_BATCHES_SAVED_NUMBER, 0);
+    SDLTest_AssertCheck(ret > 0, "Validate atlas batches saved, expected: >0, got: %d", ret);
+
+    /* Draw the grid again as sprites, half of them with explicit source rectangles */
+    clearScreen();
+    n = ((ni / 4) + 1) * ((nj / 4) + 1);
+    srcrects = (SDL_FRect *)SDL_malloc(n * sizeof(*srcrects));
+    dstrects = (SDL_FRect *)SDL_malloc(n * sizeof(*dstrects));
+    SDLTest_AssertCheck(srcrects && dstrects, "Verify SDL_malloc() result");
+    if (srcrects && dstrects) {
+        n = 0;
+        for (j = 0; j <= nj; j += 4) {
+            for (i = 0; i <= ni; i += 4) {
+                srcrects[n].x = 0.0f;
+                srcrects[n].y = 0.0f;
+                srcrects[n].w = (float)tface->w;
+                srcrects[n].h = (float)tface->h;
+                dstrects[n].x = (float)i;
+                dstrects[n].y = (float)j;
+                dstrects[n].w = (float)tface->w;
+                dstrects[n].h = (float)tface->h;
+                ++n;
+            }
+        }
+        CHECK_FUNC(SDL_RenderTextures, (renderer, tface, NULL, dstrects, NULL, NULL, NULL, n / 2))
+        CHECK_FUNC(SDL_RenderTextures, (renderer, tface, &srcrects[n / 2], &dstrects[n / 2], NULL, NULL, NULL, n - n / 2))
+
+        referenceSurface = SDLTest_ImageBlit();
+        compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+        SDL_DestroySurface(referenceSurface);
+    }
+    SDL_free(srcrects);
+    SDL_free(dstrects);
+
+    /* Wrapping texture coordinates can't be used with atlased textures */
+    SDL_zeroa(vertices);
+    vertices[1].position.x = 10.0f;
+    vertices[1].tex_coord.x = 2.0f;
+    vertices[2].position.y = 10.0f;
+    vertices[2].tex_coord.y = 2.0f;
+    ret = SDL_RenderGeometry(renderer, tface, vertices, SDL_arraysize(vertices), NULL, 0);
+    SDLTest_AssertCheck(!ret, "Validate SDL_RenderGeometry() fails with wrapping texture coordinates");
+
+    /* Clean up. */
+    SDL_DestroyTexture(tface);
+    for (i = 0; i < (int)SDL_arraysize(tsmall); ++i) {
+        SDL_DestroyTexture(tsmall[i]);
+    }
+    ret = (int)SDL_GetNumberProperty(renderer_props, SDL_PROP_RENDERER_ATLAS_PAGES_NUMBER, -1);
+    SDLTest_AssertCheck(ret == 0, "Validate atlas page count, expected: 0, got: %d", ret);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests tiled blitting routines.
  */
@@ -1323,6 +1576,63 @@ static int SDLCALL render_testRGBSurfaceNoAlpha(void* arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests that the software renderer only presents what was drawn
+ */
+static int SDLCALL render_testPresentDirtyRects(void *arg)
+{
+    static const struct
+    {
+        SDL_Rect viewport;
+        SDL_FRect rects[2];
+        int num_rects;
+        Sint64 expected;
+    } frames[] = {
+        /* Nothing drawn */
+        { { 0, 0, 320, 240 }, { { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f } }, 0, 0 },
+        /* One rect */
+        { { 0, 0, 320, 240 }, { { 10.0f, 10.0f, 20.0f, 20.0f } }, 1, 20 * 20 },
+        /* Two rects apart */
+        { { 0, 0, 320, 240 }, { { 0.0f, 0.0f, 10.0f, 10.0f }, { 100.0f, 100.0f, 10.0f, 10.0f } }, 2, 2 * 10 * 10 },
+        /* Two overlapping rects are presented as one */
+        { { 0, 0, 320, 240 }, { { 0.0f, 0.0f, 10.0f, 10.0f }, { 5.0f, 5.0f, 10.0f, 10.0f } }, 2, 15 * 15 },
+        /* Clipped to the viewport */
+        { { 100, 100, 50, 50 }, { { 0.0f, 0.0f, 100.0f, 100.0f } }, 1, 50 * 50 },
+        /* Off the window */
+        { { 0, 0, 320, 240 }, { { 400.0f, 10.0f, 20.0f, 20.0f } }, 1, 0 },
+    };
+    SDL_PropertiesID props;
+    Sint64 presented;
+    int i;
+
+    if (!renderer || SDL_strcmp(SDL_GetRendererName(renderer), SDL_SOFTWARE_RENDERER) != 0) {
+        SDLTest_Log("Skipping test, only the software renderer tracks presented pixels");
+        return TEST_SKIPPED;
+    }
+    props = SDL_GetRendererProperties(renderer);
+
+    /* The first present sends the whole window */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+    CHECK_FUNC(SDL_RenderPresent, (renderer))
+    presented = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_PIXELS_NUMBER, -1);
+    SDLTest_AssertCheck(presented == 320 * 240, "Validate presented pixels after clear, expected: %d, got: %" SDL_PRIs64, 320 * 240, presented);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 128, 0, SDL_ALPHA_OPAQUE))
+    for (i = 0; i < (int)SDL_arraysize(frames); ++i) {
+        CHECK_FUNC(SDL_SetRenderViewport, (renderer, &frames[i].viewport))
+        if (frames[i].num_rects > 0) {
+            CHECK_FUNC(SDL_RenderFillRects, (renderer, frames[i].rects, frames[i].num_rects))
+        }
+        CHECK_FUNC(SDL_RenderPresent, (renderer))
+        presented = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_PIXELS_NUMBER, -1);
+        SDLTest_AssertCheck(presented == frames[i].expected, "Validate presented pixels in frame %d, expected: %" SDL_PRIs64 ", got: %" SDL_PRIs64, i, frames[i].expected, presented);
+    }
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, NULL))
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Test clip rect
  */
@@ -1984,6 +2294,540 @@ static int SDLCALL render_testTextureState(void *arg)
     return TEST_COMPLETED;
 }
 
+#define GEOMETRY_TEXTURE_SIZE 16
+#define GEOMETRY_TARGET_W     97
+#define GEOMETRY_TARGET_H     71
+#define GEOMETRY_TRIANGLES    4
+
+/* Fills surface with pixels from a fixed seed, every channel gets random values */
+static void fillGeometrySurface(SDL_Surface *surface, Uint64 *seed)
+{
+    int x, y;
+
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(surface->format); ++x) {
+            row[x] = (Uint8)SDL_rand_bits_r(seed);
+        }
+    }
+}
+
+/* Draws overlapping textured and filled triangles with uneven edges and vertex colors, the texture coordinates go up to 4 * uv_scale.
+ * With clamp_coords, the largest texel coordinates of each triangle are pulled in by one, the way SDL_TEXTURE_ADDRESS_CLAMP does it.
+ */
+static bool renderGeometryTriangles(SDL_Surface *target, SDL_Surface *texture_surface, float uv_scale, bool clamp_coords,
+                                    SDL_TextureAddressMode address_mode, SDL_BlendMode mode, int first, int count)
+{
+    static const float xy[] = {
+        2.5f, 3.0f, 90.25f, 11.5f, 30.0f, 68.75f,
+        96.0f, 1.0f, 60.5f, 70.0f, 11.0f, 40.0f,
+        -7.0f, 20.0f, 48.0f, 35.0f, 20.0f, 80.0f,
+        40.0f, 2.0f, 70.0f, 60.0f, 52.0f, 64.0f
+    };
+    static const float uv[] = {
+        0.0f, 0.0f, 3.5f, 0.5f, 1.0f, 3.25f,
+        0.25f, 0.25f, 2.75f, 3.75f, 0.5f, 1.5f,
+        1.0f, 1.0f, 2.0f, 1.0f, 1.0f, 2.0f,
+        0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f
+    };
+    static const SDL_FColor colors[] = {
+        { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.5f, 1.0f, 0.25f, 0.75f }, { 1.0f, 0.2f, 0.6f, 0.5f },
+        { 0.8f, 0.8f, 0.8f, 0.8f }, { 0.8f, 0.8f, 0.8f, 0.8f }, { 0.8f, 0.8f, 0.8f, 0.8f },
+        { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 0.1f, 0.9f, 0.3f, 0.6f }, { 1.0f, 0.0f, 1.0f, 1.0f }, { 0.0f, 0.4f, 1.0f, 0.3f }
+    };
+    SDL_Vertex vertices[SDL_arraysize(colors)];
+    SDL_Renderer *sw;
+    SDL_Texture *texture;
+    int i, j;
+
+    sw = SDL_CreateSoftwareRenderer(target);
+    if (!sw) {
+        return false;
+    }
+    texture = SDL_CreateTextureFromSurface(sw, texture_surface);
+    if (!texture) {
+        SDL_DestroyRenderer(sw);
+        return false;
+    }
+
+    for (i = 0; i < SDL_arraysize(vertices); ++i) {
+        vertices[i].position.x = xy[i * 2 + 0];
+        vertices[i].position.y = xy[i * 2 + 1];
+        vertices[i].color = colors[i];
+        vertices[i].tex_coord.x = uv[i * 2 + 0] * uv_scale;
+        vertices[i].tex_coord.y = uv[i * 2 + 1] * uv_scale;
+    }
+    if (clamp_coords) {
+        for (i = 0; i < SDL_arraysize(vertices); i += 3) {
+            SDL_Vertex *v = &vertices[i];
+            const float max_u = SDL_max(v[0].tex_coord.x, SDL_max(v[1].tex_coord.x, v[2].tex_coord.x));
+            const float max_v = SDL_max(v[0].tex_coord.y, SDL_max(v[1].tex_coord.y, v[2].tex_coord.y));
+            const float min_u = SDL_min(v[0].tex_coord.x, SDL_min(v[1].tex_coord.x, v[2].tex_coord.x));
+            const float min_v = SDL_min(v[0].tex_coord.y, SDL_min(v[1].tex_coord.y, v[2].tex_coord.y));
+            for (j = 0; j < 3; ++j) {
+                if (max_u > min_u && v[j].tex_coord.x == max_u) {
+                    v[j].tex_coord.x -= 1.0f / texture_surface->w;
+                }
+                if (max_v > min_v && v[j].tex_coord.y == max_v) {
+                    v[j].tex_coord.y -= 1.0f / texture_surface->h;
+                }
+            }
+        }
+    }
+
+    SDL_SetTextureBlendMode(texture, mode);
+    SDL_SetRenderDrawBlendMode(sw, mode);
+    SDL_SetRenderTextureAddressMode(sw, address_mode, address_mode);
+
+    /* The first three triangles are textured, the last one is filled */
+    for (i = first; i < first + count; ++i) {
+        SDL_RenderGeometry(sw, i < 3 ? texture : NULL, &vertices[i * 3], 3, NULL, 0);
+    }
+    SDL_FlushRenderer(sw);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(sw);
+    return true;
+}
+
+/* Checks that two surfaces of the same format and size hold the same colors, padding bits are ignored */
+static bool compareGeometrySurfaces(SDL_Surface *surface1, SDL_Surface *surface2)
+{
+    const SDL_PixelFormatDetails *fmt = SDL_GetPixelFormatDetails(surface1->format);
+    const int bpp = SDL_BYTESPERPIXEL(surface1->format);
+    const Uint32 mask = fmt->Rmask | fmt->Gmask | fmt->Bmask | fmt->Amask;
+    int x, y;
+
+    if (surface1->format != surface2->format || surface1->w != surface2->w || surface1->h != surface2->h) {
+        return false;
+    }
+    for (y = 0; y < surface1->h; ++y) {
+        const Uint8 *row1 = (const Uint8 *)surface1->pixels + y * surface1->pitch;
+        const Uint8 *row2 = (const Uint8 *)surface2->pixels + y * surface2->pitch;
+        for (x = 0; x < surface1->w; ++x) {
+            Uint32 pixel1 = 0, pixel2 = 0;
+            SDL_memcpy(&pixel1, row1 + x * bpp, bpp);
+            SDL_memcpy(&pixel2, row2 + x * bpp, bpp);
+            if (((pixel1 ^ pixel2) & mask) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Renders the triangles one at a time on an ARGB8888 copy of the target, converting back in between */
+static SDL_Surface *renderGeometryConverted(SDL_Surface *background, SDL_PixelFormat format, SDL_Surface *texture_surface, SDL_BlendMode mode, int count)
+{
+    SDL_Surface *result = SDL_ConvertSurface(background, format);
+    int i;
+
+    for (i = 0; result && i < count; ++i) {
+        SDL_Surface *argb = SDL_CreateSurface(result->w, result->h, SDL_PIXELFORMAT_ARGB8888);
+        bool rendered = false;
+
+        /* SDL_ReadSurfacePixel() expands the channels the same way the triangle code reads them */
+        if (argb) {
+            int x, y;
+            for (y = 0; y < result->h; ++y) {
+                for (x = 0; x < result->w; ++x) {
+                    Uint8 r, g, b, a;
+                    SDL_ReadSurfacePixel(result, x, y, &r, &g, &b, &a);
+                    SDL_WriteSurfacePixel(argb, x, y, r, g, b, a);
+                }
+            }
+            rendered = renderGeometryTriangles(argb, texture_surface, 0.25f, false, SDL_TEXTURE_ADDRESS_CLAMP, mode, i, 1);
+        }
+
+        SDL_DestroySurface(result);
+        result = rendered ? SDL_ConvertSurface(argb, format) : NULL;
+        SDL_DestroySurface(argb);
+    }
+    return result;
+}
+
+/**
+ * Tests software triangle rendering against references that don't go through the same code
+ *
+ * Wrapped texture coordinates are checked against the same texture tiled 4 times, so that
+ * the coordinates never wrap, and clamped ones against the same texels addressed with wrapping,
+ * which keeps them off the SIMD spans. Colorkeyed textures are checked against textures with
+ * the same pixels made transparent. Other target formats are checked by drawing each triangle
+ * on an ARGB8888 copy of the target and converting it back, which is how those targets read
+ * and write pixels.
+ *
+ * \sa SDL_RenderGeometry
+ */
+static int SDLCALL render_testGeometryReference(void *arg)
+{
+    static const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    static const SDL_PixelFormat target_formats[] = {
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB1555, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XBGR8888
+    };
+    SDL_Surface *texture = NULL, *tiled = NULL, *keyed = NULL, *unkeyed = NULL;
+    SDL_Surface *background = NULL, *actual = NULL, *expected = NULL;
+    const Uint32 key = 0xFF3050A0;
+    Uint64 seed = 1;
+    SDL_Rect rect;
+    bool result;
+    int x, y, i, j;
+
+    texture = SDL_CreateSurface(GEOMETRY_TEXTURE_SIZE, GEOMETRY_TEXTURE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    tiled = SDL_CreateSurface(GEOMETRY_TEXTURE_SIZE * 4, GEOMETRY_TEXTURE_SIZE * 4, SDL_PIXELFORMAT_ARGB8888);
+    background = SDL_CreateSurface(GEOMETRY_TARGET_W, GEOMETRY_TARGET_H, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(texture && tiled && background, "Create geometry test surfaces");
+    if (!texture || !tiled || !background) {
+        goto done;
+    }
+    fillGeometrySurface(texture, &seed);
+    fillGeometrySurface(background, &seed);
+    SDL_SetSurfaceBlendMode(texture, SDL_BLENDMODE_NONE);
+    for (y = 0; y < tiled->h; y += texture->h) {
+        for (x = 0; x < tiled->w; x += texture->w) {
+            rect.x = x;
+            rect.y = y;
+            rect.w = texture->w;
+            rect.h = texture->h;
+            SDL_BlitSurface(texture, NULL, tiled, &rect);
+        }
+    }
+
+    /* Wrapped texture coordinates */
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        actual = SDL_DuplicateSurface(background);
+        expected = SDL_DuplicateSurface(background);
+        result = actual && expected &&
+                 renderGeometryTriangles(actual, texture, 1.0f, false, SDL_TEXTURE_ADDRESS_WRAP, modes[i], 0, GEOMETRY_TRIANGLES) &&
+                 renderGeometryTriangles(expected, tiled, 0.25f, false, SDL_TEXTURE_ADDRESS_WRAP, modes[i], 0, GEOMETRY_TRIANGLES);
+        SDLTest_AssertCheck(result, "Render wrapped geometry with blend mode 0x%x", (unsigned int)modes[i]);
+        if (result) {
+            SDLTest_AssertCheck(compareGeometrySurfaces(actual, expected),
+                                "Verify wrapped geometry with blend mode 0x%x matches the tiled reference", (unsigned int)modes[i]);
+        }
+        SDL_DestroySurface(actual);
+        SDL_DestroySurface(expected);
+        actual = expected = NULL;
+    }
+
+    /* Clamped coordinates take the SIMD spans where available, wrapped ones never do */
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        actual = SDL_DuplicateSurface(background);
+        expected = SDL_DuplicateSurface(background);
+        result = actual && expected &&
+                 renderGeometryTriangles(actual, texture, 0.25f, false, SDL_TEXTURE_ADDRESS_CLAMP, modes[i], 0, GEOMETRY_TRIANGLES) &&
+                 renderGeometryTriangles(expected, texture, 0.25f, true, SDL_TEXTURE_ADDRESS_WRAP, modes[i], 0, GEOMETRY_TRIANGLES);
+        SDLTest_AssertCheck(result, "Render clamped geometry with blend mode 0x%x", (unsigned int)modes[i]);
+        if (result) {
+            SDLTest_AssertCheck(compareGeometrySurfaces(actual, expected),
+                                "Verify clamped geometry with blend mode 0x%x matches the wrapped reference", (unsigned int)modes[i]);
+        }
+        SDL_DestroySurface(actual);
+        SDL_DestroySurface(expected);
+        actual = expected = NULL;
+    }
+
+    /* Colorkeyed textures become alpha textures, so a keyed pixel has to leave the target alone */
+    keyed = SDL_CreateSurface(GEOMETRY_TEXTURE_SIZE, GEOMETRY_TEXTURE_SIZE, SDL_PIXELFORMAT_XRGB8888);
+    unkeyed = SDL_CreateSurface(GEOMETRY_TEXTURE_SIZE, GEOMETRY_TEXTURE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(keyed && unkeyed, "Create colorkey test surfaces");
+    if (!keyed || !unkeyed) {
+        goto done;
+    }
+    SDL_BlitSurface(texture, NULL, keyed, NULL);
+    for (y = 0; y < keyed->h; ++y) {
+        Uint32 *keyed_row = (Uint32 *)((Uint8 *)keyed->pixels + y * keyed->pitch);
+        Uint32 *unkeyed_row = (Uint32 *)((Uint8 *)unkeyed->pixels + y * unkeyed->pitch);
+        for (x = 0; x < keyed->w; ++x) {
+            if (((x ^ y) & 3) == 0 || x == y) {
+                keyed_row[x] = key;
+                unkeyed_row[x] = key & 0x00FFFFFF;
+            } else {
+                keyed_row[x] |= 0xFF000000;
+                unkeyed_row[x] = keyed_row[x];
+            }
+        }
+    }
+    SDL_SetSurfaceColorKey(keyed, true, key);
+    actual = SDL_DuplicateSurface(background);
+    expected = SDL_DuplicateSurface(background);
+    result = actual && expected &&
+             renderGeometryTriangles(actual, keyed, 1.0f, false, SDL_TEXTURE_ADDRESS_WRAP, SDL_BLENDMODE_BLEND, 0, GEOMETRY_TRIANGLES) &&
+             renderGeometryTriangles(expected, unkeyed, 1.0f, false, SDL_TEXTURE_ADDRESS_WRAP, SDL_BLENDMODE_BLEND, 0, GEOMETRY_TRIANGLES);
+    SDLTest_AssertCheck(result, "Render colorkeyed geometry");
+    if (result) {
+        SDLTest_AssertCheck(compareGeometrySurfaces(actual, expected), "Verify colorkeyed geometry matches the transparent reference");
+    }
+    SDL_DestroySurface(actual);
+    SDL_DestroySurface(expected);
+    actual = expected = NULL;
+
+    /* Other target formats, without wrapping so the 8888 SIMD spans are used where available.
+     * Blended fills are drawn on an ARGB8888 surface and then blitted, so they round like
+     * the surface blitters for each format and are left out. */
+    for (i = 0; i < SDL_arraysize(target_formats); ++i) {
+        const char *format_name = SDL_GetPixelFormatName(target_formats[i]);
+
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            const int count = (modes[j] == SDL_BLENDMODE_NONE) ? GEOMETRY_TRIANGLES : GEOMETRY_TRIANGLES - 1;
+
+            actual = SDL_ConvertSurface(background, target_formats[i]);
+            expected = renderGeometryConverted(background, target_formats[i], texture, modes[j], count);
+            result = actual && expected &&
+                     renderGeometryTriangles(actual, texture, 0.25f, false, SDL_TEXTURE_ADDRESS_CLAMP, modes[j], 0, count);
+            SDLTest_AssertCheck(result, "Render geometry to %s with blend mode 0x%x", format_name, (unsigned int)modes[j]);
+            if (result) {
+                SDLTest_AssertCheck(compareGeometrySurfaces(actual, expected),
+                                    "Verify geometry on %s with blend mode 0x%x matches the ARGB8888 reference", format_name, (unsigned int)modes[j]);
+            }
+            SDL_DestroySurface(actual);
+            SDL_DestroySurface(expected);
+            actual = expected = NULL;
+        }
+    }
+
+done:
+    SDL_DestroySurface(texture);
+    SDL_DestroySurface(tiled);
+    SDL_DestroySurface(keyed);
+    SDL_DestroySurface(unkeyed);
+    SDL_DestroySurface(background);
+
+    return TEST_COMPLETED;
+}
+
+#define SW_THREADS_TARGET_W 300
+#define SW_THREADS_TARGET_H 200
+
+/* Draws a fixed command stream that crosses the 64 pixel tile edges of the software renderer.
+ * The sprite is RLE encoded when SDL_HINT_SURFACE_AUTO_RLE is set, as long as it isn't color modulated.
+ */
+static SDL_Surface *renderSoftwareThreads(const char *threads, SDL_Surface *alpha_surface, SDL_Surface *sprite_surface, SDL_Surface *opaque_surface)
+{
+    SDL_Surface *target;
+    SDL_Renderer *sw = NULL;
+    SDL_Texture *alpha_texture = NULL, *sprite_texture = NULL, *opaque_texture = NULL;
+    SDL_FPoint points[64];
+    SDL_FRect rects[16];
+    SDL_Vertex vertices[6];
+    SDL_Rect viewport, clip;
+    SDL_FRect srcrect, dstrect;
+    bool result = false;
+    int i;
+
+    target = SDL_CreateSurface(SW_THREADS_TARGET_W, SW_THREADS_TARGET_H, SDL_PIXELFORMAT_ARGB8888);
+    if (!target) {
+        return NULL;
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+    sw = SDL_CreateSoftwareRenderer(target);
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    if (!sw) {
+        goto done;
+    }
+    alpha_texture = SDL_CreateTextureFromSurface(sw, alpha_surface);
+    sprite_texture = SDL_CreateTextureFromSurface(sw, sprite_surface);
+    opaque_texture = SDL_CreateTextureFromSurface(sw, opaque_surface);
+    if (!alpha_texture || !sprite_texture || !opaque_texture) {
+        goto done;
+    }
+
+    SDL_SetRenderDrawColor(sw, 20, 40, 60, 255);
+    SDL_RenderClear(sw);
+
+    /* Points and rectangles on and around the tile edges */
+    for (i = 0; i < SDL_arraysize(points); ++i) {
+        points[i].x = (float)((i % 8) * 64 - 1 + (i / 8) % 3);
+        points[i].y = (float)((i / 8) * 27 % SW_THREADS_TARGET_H);
+    }
+    SDL_SetRenderDrawColor(sw, 255, 255, 0, 255);
+    SDL_RenderPoints(sw, points, SDL_arraysize(points));
+
+    for (i = 0; i < SDL_arraysize(rects); ++i) {
+        rects[i].x = (float)(i * 19 - 10);
+        rects[i].y = (float)(i * 13 - 5);
+        rects[i].w = (float)(30 + i * 7);
+        rects[i].h = (float)(20 + (i % 5) * 15);
+    }
+    SDL_SetRenderDrawBlendMode(sw, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sw, 200, 50, 100, 128);
+    SDL_RenderFillRects(sw, rects, SDL_arraysize(rects));
+
+    /* Unscaled copies, the sprite is only modulated part of the time so it goes in and out of RLE */
+    for (i = 0; i < 6; ++i) {
+        dstrect.x = (float)(i * 50 - 20);
+        dstrect.y = (float)(i * 31 - 10);
+        dstrect.w = (float)alpha_surface->w;
+        dstrect.h = (float)alpha_surface->h;
+        SDL_SetTextureColorMod(alpha_texture, (Uint8)(255 - i * 30), 255, (Uint8)(100 + i * 20));
+        SDL_RenderTexture(sw, alpha_texture, NULL, &dstrect);
+
+        dstrect.x += 37.0f;
+        dstrect.w = (float)opaque_surface->w;
+        dstrect.h = (float)opaque_surface->h;
+        SDL_SetTextureBlendMode(opaque_texture, (i & 1) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetTextureAlphaMod(opaque_texture, (Uint8)(255 - i * 40));
+        SDL_RenderTexture(sw, opaque_texture, NULL, &dstrect);
+
+        dstrect.x = (float)(i * 47 + 5);
+        dstrect.y = (float)(130 - i * 23);
+        dstrect.w = (float)sprite_surface->w;
+        dstrect.h = (float)sprite_surface->h;
+        SDL_SetTextureColorMod(sprite_texture, 255, (i == 3) ? 128 : 255, 255);
+        SDL_RenderTexture(sw, sprite_texture, NULL, &dstrect);
+    }
+
+    /* A partial source rectangle, then scaled and rotated copies that end the tiled batches */
+    srcrect.x = 5.0f;
+    srcrect.y = 3.0f;
+    srcrect.w = 60.0f;
+    srcrect.h = 40.0f;
+    dstrect.x = 120.0f;
+    dstrect.y = 150.0f;
+    dstrect.w = srcrect.w;
+    dstrect.h = srcrect.h;
+    SDL_RenderTexture(sw, opaque_texture, &srcrect, &dstrect);
+    dstrect.x = 10.0f;
+    dstrect.y = 100.0f;
+    dstrect.w = 150.0f;
+    dstrect.h = 90.0f;
+    SDL_RenderTexture(sw, alpha_texture, NULL, &dstrect);
+    SDL_RenderTextureRotated(sw, opaque_texture, NULL, &dstrect, 30.0, NULL, SDL_FLIP_HORIZONTAL);
+
+    /* Lines are drawn serially between tiled commands */
+    SDL_SetRenderDrawColor(sw, 0, 255, 128, 255);
+    SDL_RenderLine(sw, 0.0f, 0.0f, (float)(SW_THREADS_TARGET_W - 1), (float)(SW_THREADS_TARGET_H - 1));
+    SDL_RenderLine(sw, 63.0f, 0.0f, 63.0f, (float)(SW_THREADS_TARGET_H - 1));
+
+    /* Triangles spanning several tiles, textured and filled */
+    for (i = 0; i < SDL_arraysize(vertices); ++i) {
+        vertices[i].position.x = (float)((i * 113 + 7) % (SW_THREADS_TARGET_W + 40)) - 20.0f;
+        vertices[i].position.y = (float)((i * 71 + 3) % (SW_THREADS_TARGET_H + 40)) - 20.0f;
+        vertices[i].color.r = 1.0f;
+        vertices[i].color.g = (float)(i + 1) / 6.0f;
+        vertices[i].color.b = 1.0f - (float)i / 6.0f;
+        vertices[i].color.a = 0.5f + (float)i / 12.0f;
+        vertices[i].tex_coord.x = (float)(i % 2);
+        vertices[i].tex_coord.y = (float)((i / 2) % 2);
+    }
+    SDL_RenderGeometry(sw, alpha_texture, vertices, 3, NULL, 0);
+    SDL_RenderGeometry(sw, NULL, &vertices[3], 3, NULL, 0);
+
+    /* The same again inside a viewport and clip rectangle that don't line up with the tiles */
+    viewport.x = 33;
+    viewport.y = 45;
+    viewport.w = 200;
+    viewport.h = 120;
+    clip.x = 10;
+    clip.y = 7;
+    clip.w = 150;
+    clip.h = 90;
+    SDL_SetRenderViewport(sw, &viewport);
+    SDL_SetRenderClipRect(sw, &clip);
+    SDL_SetRenderDrawColor(sw, 90, 180, 255, 100);
+    SDL_RenderFillRects(sw, rects, SDL_arraysize(rects));
+    dstrect.x = 20.0f;
+    dstrect.y = 10.0f;
+    dstrect.w = (float)opaque_surface->w;
+    dstrect.h = (float)opaque_surface->h;
+    SDL_RenderTexture(sw, opaque_texture, NULL, &dstrect);
+    SDL_RenderTexture(sw, sprite_texture, NULL, &dstrect);
+    SDL_RenderGeometry(sw, alpha_texture, vertices, 3, NULL, 0);
+    SDL_RenderGeometry(sw, NULL, &vertices[3], 3, NULL, 0);
+
+    result = SDL_FlushRenderer(sw);
+
+done:
+    SDL_DestroyTexture(alpha_texture);
+    SDL_DestroyTexture(sprite_texture);
+    SDL_DestroyTexture(opaque_texture);
+    SDL_DestroyRenderer(sw);
+    if (!result) {
+        SDL_DestroySurface(target);
+        target = NULL;
+    }
+    return target;
+}
+
+/**
+ * Tests that the software renderer draws the same pixels with and without tile threads
+ *
+ * The commands cross tile edges, change texture state between copies and mix tiled
+ * commands with ones that are drawn serially. Automatic RLE is enabled so that the
+ * sprite copies are split into tiles from an RLE encoded source.
+ *
+ * \sa SDL_HINT_RENDER_SOFTWARE_THREADS
+ */
+static int SDLCALL render_testSoftwareThreads(void *arg)
+{
+    static const char *threads[] = { "1", "2", "4" };
+    SDL_Surface *alpha_surface, *sprite_surface, *opaque_surface;
+    SDL_Surface *expected = NULL, *actual;
+    Uint64 seed = 0x5eed;
+    int i, x, y;
+
+    alpha_surface = SDL_CreateSurface(90, 70, SDL_PIXELFORMAT_ARGB8888);
+    sprite_surface = SDL_CreateSurface(100, 80, SDL_PIXELFORMAT_ARGB8888);
+    opaque_surface = SDL_CreateSurface(83, 77, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(alpha_surface && sprite_surface && opaque_surface, "Create texture surfaces");
+    if (!alpha_surface || !sprite_surface || !opaque_surface) {
+        goto done;
+    }
+    fillGeometrySurface(alpha_surface, &seed);
+    fillGeometrySurface(opaque_surface, &seed);
+
+    /* A sprite with long transparent, opaque and translucent runs, which is worth RLE encoding */
+    fillGeometrySurface(sprite_surface, &seed);
+    for (y = 0; y < sprite_surface->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)sprite_surface->pixels + y * sprite_surface->pitch);
+        for (x = 0; x < sprite_surface->w; ++x) {
+            const int dx = x - sprite_surface->w / 2;
+            const int dy = y - sprite_surface->h / 2;
+            if (dx * dx + dy * dy > 35 * 35) {
+                row[x] = 0;
+            } else if (dx < 0) {
+                row[x] |= 0xFF000000;
+            } else {
+                row[x] = (row[x] & 0x00FFFFFF) | 0x80000000;
+            }
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_AUTO_RLE, "1");
+
+    expected = renderSoftwareThreads("0", alpha_surface, sprite_surface, opaque_surface);
+    SDLTest_AssertCheck(expected != NULL, "Render without tile threads");
+    if (!expected) {
+        goto done;
+    }
+
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        actual = renderSoftwareThreads(threads[i], alpha_surface, sprite_surface, opaque_surface);
+        SDLTest_AssertCheck(actual != NULL, "Render with %s tile threads", threads[i]);
+        if (actual) {
+            bool same = true;
+            for (y = 0; y < actual->h && same; ++y) {
+                same = (SDL_memcmp((Uint8 *)actual->pixels + y * actual->pitch,
+                                   (Uint8 *)expected->pixels + y * expected->pitch, actual->w * 4) == 0);
+            }
+            SDLTest_AssertCheck(same, "Verify rendering with %s tile threads matches rendering without them", threads[i]);
+            SDL_DestroySurface(actual);
+        }
+    }
+
+done:
+    SDL_ResetHint(SDL_HINT_SURFACE_AUTO_RLE);
+    SDL_DestroySurface(alpha_surface);
+    SDL_DestroySurface(sprite_surface);
+    SDL_DestroySurface(opaque_surface);
+    SDL_DestroySurface(expected);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -2003,6 +2847,14 @@ static const SDLTest_TestCaseReference renderTestBlit = {
     render_testBlit, "render_testBlit", "Tests blitting", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestBlitBatch = {
+    render_testBlitBatch, "render_testBlitBatch", "Tests batched blitting", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlitAtlas = {
+    render_testBlitAtlas, "render_testBlitAtlas", "Tests blitting from a texture atlas", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference renderTestBlitTiled = {
     render_testBlitTiled, "render_testBlitTiled", "Tests tiled blitting", TEST_ENABLED
 };
@@ -2039,6 +2891,14 @@ static const SDLTest_TestCaseReference renderTestUVWrapping = {
     render_testUVWrapping, "render_testUVWrapping", "Tests geometry UV wrapping", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestGeometryReference = {
+    render_testGeometryReference, "render_testGeometryReference", "Tests software geometry rendering against reference images", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareThreads = {
+    render_testSoftwareThreads, "render_testSoftwareThreads", "Tests software rendering with tile threads against rendering without them", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference renderTestTextureState = {
     render_testTextureState, "render_testTextureState", "Tests texture state changes", TEST_ENABLED
 };
@@ -2051,12 +2911,18 @@ static const SDLTest_TestCaseReference renderTestRGBSurfaceNoAlpha = {
     render_testRGBSurfaceNoAlpha, "render_testRGBSurfaceNoAlpha", "Tests RGB surface with no alpha using software renderer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestPresentDirtyRects = {
+    render_testPresentDirtyRects, "render_testPresentDirtyRects", "Tests presenting only what was drawn with the software renderer", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
     &renderTestPrimitives,
     &renderTestPrimitivesWithViewport,
     &renderTestBlit,
+    &renderTestBlitBatch,
+    &renderTestBlitAtlas,
     &renderTestBlitTiled,
     &renderTestBlit9Grid,
     &renderTestBlit9GridTiled,
@@ -2066,9 +2932,12 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestClipRect,
     &renderTestLogicalSize,
     &renderTestUVWrapping,
+    &renderTestGeometryReference,
+    &renderTestSoftwareThreads,
     &renderTestTextureState,
     &renderTestGetSetTextureScaleMode,
     &renderTestRGBSurfaceNoAlpha,
+    &renderTestPresentDirtyRects,
     NULL
 };
 
@@ -1536,7 +1536,8 @@ static int SDLCALL surface_testScale(void *arg)
         SDL_PIXELFORMAT_ARGB128_FLOAT, SDL_PIXELFORMAT_RGBA128_FLOAT,
     };
     SDL_ScaleMode modes[] = {
-        SDL_SCALEMODE_NEAREST, SDL_SCALEMODE_LINEAR, SDL_SCALEMODE_PIXELART
+        SDL_SCALEMODE_NEAREST, SDL_SCALEMODE_LINEAR, SDL_SCALEMODE_PIXELART,
+        SDL_SCALEMODE_BICUBIC, SDL_SCALEMODE_LANCZOS, SDL_SCALEMODE_AREA
     };
     SDL_Surface *surface, *result;
     SDL_PixelFormat format;
@@ -1575,7 +1576,10 @@ static int SDLCALL surface_testScale(void *arg)
                 SDL_GetPixelFormatName(format),
                 mode == SDL_SCALEMODE_NEAREST ? "nearest" :
                 mode == SDL_SCALEMODE_LINEAR ? "linear" :
-                mode == SDL_SCALEMODE_PIXELART ? "pixelart" : "unknown",
+                mode == SDL_SCALEMODE_PIXELART ? "pixelart" :
+                mode == SDL_SCALEMODE_BICUBIC ? "bicubic" :
+                mode == SDL_SCALEMODE_LANCZOS ? "lanczos" :
+                mode == SDL_SCALEMODE_AREA ? "area" : "unknown",
                 srcR, srcG, srcB, srcA, actualR, actualG, actualB, actualA);
 
             SDL_DestroySurface(surface);
@@ -1586,6 +1590,507 @@ static int SDLCALL surface_testScale(void *arg)
     return TEST_COMPLETED;
 }
 
+static int SDLCALL surface_testScaleFiltered(void *arg)
+{
+    SDL_ScaleMode modes[] = {
+        SDL_SCALEMODE_BICUBIC, SDL_SCALEMODE_LANCZOS, SDL_SCALEMODE_AREA
+    };
+    SDL_Surface *source, *result;
+    Uint64 seed = 1;
+    Uint32 pixel;
+    int i, x, y, ret;
+
+    source = SDL_CreateSurface(67, 45, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(source != NULL, "SDL_CreateSurface()");
+    if (!source) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < source->h; ++y) {
+        for (x = 0; x < source->w; ++x) {
+            ((Uint32 *)((Uint8 *)source->pixels + y * source->pitch))[x] = (Uint32)SDL_rand_bits_r(&seed);
+        }
+    }
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        /* Stretching to the same size doesn't change anything */
+        result = SDL_CreateSurface(source->w, source->h, source->format);
+        SDLTest_AssertCheck(result != NULL, "SDL_CreateSurface()");
+        if (result) {
+            ret = SDL_StretchSurface(source, NULL, result, NULL, modes[i]);
+            SDLTest_AssertCheck(ret == true, "SDL_StretchSurface(), mode %d", modes[i]);
+            ret = 0;
+            for (y = 0; y < source->h; ++y) {
+                ret += SDL_memcmp((Uint8 *)source->pixels + y * source->pitch, (Uint8 *)result->pixels + y * result->pitch, source->w * 4) != 0;
+            }
+            SDLTest_AssertCheck(ret == 0, "Checking mode %d identity stretch, %d rows differ", modes[i], ret);
+            SDL_DestroySurface(result);
+        }
+
+        /* Solid colors stay solid at any size */
+        ret = SDL_FillSurfaceRect(source, NULL, 0x80C0FF20);
+        SDLTest_AssertCheck(ret == true, "SDL_FillSurfaceRect()");
+        result = SDL_ScaleSurface(source, 150, 17, modes[i]);
+        SDLTest_AssertCheck(result != NULL, "SDL_ScaleSurface(), mode %d", modes[i]);
+        if (result) {
+            ret = 0;
+            for (y = 0; y < result->h; ++y) {
+                for (x = 0; x < result->w; ++x) {
+                    pixel = ((Uint32 *)((Uint8 *)result->pixels + y * result->pitch))[x];
+                    ret += (pixel != 0x80C0FF20);
+                }
+            }
+            SDLTest_AssertCheck(ret == 0, "Checking mode %d solid color scaling, %d pixels differ", modes[i], ret);
+            SDL_DestroySurface(result);
+        }
+        for (y = 0; y < source->h; ++y) {
+            for (x = 0; x < source->w; ++x) {
+                ((Uint32 *)((Uint8 *)source->pixels + y * source->pitch))[x] = (Uint32)SDL_rand_bits_r(&seed);
+            }
+        }
+    }
+
+    /* Shrinking by 2 with the area filter averages each 2x2 block */
+    for (y = 0; y < source->h; ++y) {
+        for (x = 0; x < source->w; ++x) {
+            ((Uint32 *)((Uint8 *)source->pixels + y * source->pitch))[x] = ((x + y) & 1) ? 0xFFFFFFFF : 0xFF000000;
+        }
+    }
+    result = SDL_CreateSurface(32, 16, source->format);
+    SDLTest_AssertCheck(result != NULL, "SDL_CreateSurface()");
+    if (result) {
+        SDL_Rect srcrect = { 0, 0, 64, 32 };
+        ret = SDL_StretchSurface(source, &srcrect, result, NULL, SDL_SCALEMODE_AREA);
+        SDLTest_AssertCheck(ret == true, "SDL_StretchSurface()");
+        ret = 0;
+        for (y = 0; y < result->h; ++y) {
+            for (x = 0; x < result->w; ++x) {
+                pixel = ((Uint32 *)((Uint8 *)result->pixels + y * result->pitch))[x];
+                ret += (pixel != 0xFF7F7F7F && pixel != 0xFF808080);
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Checking area shrinking, %d pixels aren't gray", ret);
+        SDL_DestroySurface(result);
+    }
+
+    SDL_DestroySurface(source);
+    return TEST_COMPLETED;
+}
+
+static void FillRLESprite(SDL_Surface *surface, Uint64 *seed)
+{
+    int x, y;
+
+    for (y = 0; y < surface->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; ++x) {
+            Uint32 color = (Uint32)SDL_rand_bits_r(seed) | 0x00010000;
+            switch (SDL_rand_r(seed, 4)) {
+            case 0:
+            case 1:
+                /* Transparent */
+                row[x] = 0;
+                break;
+            case 2:
+                /* Translucent */
+                row[x] = (color & 0x00FFFFFF) | 0x80000000;
+                break;
+            default:
+                /* Opaque */
+                row[x] = color | 0xFF000000;
+                break;
+            }
+            if (!SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
+                row[x] &= 0x00FFFFFF;
+            }
+        }
+    }
+}
+
+static int SDLCALL surface_testRLE(void *arg)
+{
+    const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888 };
+    const SDL_Rect srcrects[] = {
+        { 0, 0, 97, 61 },
+        { 5, 18, 60, 30 },
+        { 0, 45, 97, 16 },
+    };
+    SDL_Surface *src = NULL, *fresh = NULL, *patch = NULL, *dst1 = NULL, *dst2 = NULL;
+    SDL_Rect rect;
+    Uint64 seed = 1;
+    Uint32 color;
+    int i, j, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        src = SDL_CreateSurface(97, 61, formats[i]);
+        patch = SDL_CreateSurface(40, 9, formats[i]);
+        dst1 = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_XRGB8888);
+        dst2 = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(src && patch && dst1 && dst2, "SDL_CreateSurface()");
+        if (!src || !patch || !dst1 || !dst2) {
+            goto done;
+        }
+        FillRLESprite(src, &seed);
+        FillRLESprite(patch, &seed);
+        SDL_SetSurfaceBlendMode(patch, SDL_BLENDMODE_NONE);
+        if (SDL_ISPIXELFORMAT_ALPHA(formats[i])) {
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        } else {
+            SDL_SetSurfaceColorKey(src, true, 0);
+        }
+        SDL_SetSurfaceRLE(src, true);
+        ret = SDL_BlitSurface(src, NULL, dst1, NULL);
+        SDLTest_AssertCheck(ret == true, "SDL_BlitSurface(), expected: true, got: %d", ret);
+        SDLTest_AssertCheck(SDL_MUSTLOCK(src), "Verify that the RLE surface must be locked");
+
+        /* Change some rows of the encoded surface, by blitting into it and by locking it */
+        rect.x = 30;
+        rect.y = 20;
+        rect.w = patch->w;
+        rect.h = patch->h;
+        ret = SDL_BlitSurface(patch, NULL, src, &rect);
+        SDLTest_AssertCheck(ret == true, "SDL_BlitSurface() into the RLE surface, expected: true, got: %d", ret);
+        ret = SDL_LockSurface(src);
+        SDLTest_AssertCheck(ret == true, "SDL_LockSurface(), expected: true, got: %d", ret);
+        color = SDL_ISPIXELFORMAT_ALPHA(formats[i]) ? 0xC07F7F7F : 0x007F7F7F;
+        for (j = 10; j < src->w; ++j) {
+            ((Uint32 *)((Uint8 *)src->pixels + 50 * src->pitch))[j] = color;
+        }
+        SDL_memset((Uint8 *)src->pixels + 51 * src->pitch, 0, src->w * 4);
+        SDL_UnlockSurface(src);
+
+        /* The result should be the same as a surface that was encoded from scratch */
+        fresh = SDL_DuplicateSurface(src);
+        SDLTest_AssertCheck(fresh != NULL, "SDL_DuplicateSurface()");
+        if (!fresh) {
+            goto done;
+        }
+        if (!SDL_ISPIXELFORMAT_ALPHA(formats[i])) {
+            /* Colorkey blits are exact, so compare against the regular blitter */
+            SDL_SetSurfaceRLE(fresh, false);
+        }
+        for (j = 0; j < SDL_arraysize(srcrects); ++j) {
+            rect.x = 3;
+            rect.y = j;
+            SDL_FillSurfaceRect(dst1, NULL, 0x204060);
+            SDL_FillSurfaceRect(dst2, NULL, 0x204060);
+            SDL_BlitSurface(src, &srcrects[j], dst1, &rect);
+            SDL_BlitSurface(fresh, &srcrects[j], dst2, &rect);
+            ret = 0;
+            for (y = 0; y < dst1->h; ++y) {
+                ret += SDL_memcmp((Uint8 *)dst1->pixels + y * dst1->pitch, (Uint8 *)dst2->pixels + y * dst2->pitch, dst1->w * 4) != 0;
+            }
+            SDLTest_AssertCheck(ret == 0, "Checking %s RLE blit %d, %d rows differ", SDL_GetPixelFormatName(formats[i]), j, ret);
+        }
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(fresh);
+        SDL_DestroySurface(patch);
+        SDL_DestroySurface(dst1);
+        SDL_DestroySurface(dst2);
+        src = fresh = patch = dst1 = dst2 = NULL;
+    }
+
+    /* Sprites with large transparent areas are encoded automatically */
+    SDL_SetHint(SDL_HINT_SURFACE_AUTO_RLE, "1");
+    src = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    dst1 = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(src && dst1, "SDL_CreateSurface()");
+    if (!src || !dst1) {
+        goto done;
+    }
+    rect.x = 16;
+    rect.y = 16;
+    rect.w = 32;
+    rect.h = 32;
+    SDL_FillSurfaceRect(src, NULL, 0);
+    SDL_FillSurfaceRect(src, &rect, 0xFF80C0FF);
+    SDL_BlitSurface(src, NULL, dst1, NULL);
+    SDLTest_AssertCheck(SDL_SurfaceHasRLE(src), "Verify that a sparse sprite is RLE encoded automatically");
+    SDL_DestroySurface(src);
+
+    /* ... but not sprites where the transparent pixels are scattered */
+    src = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "SDL_CreateSurface()");
+    if (!src) {
+        goto done;
+    }
+    for (y = 0; y < src->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (j = 0; j < src->w; ++j) {
+            row[j] = ((j + y) & 1) ? 0xFF80C0FF : 0;
+        }
+    }
+    SDL_BlitSurface(src, NULL, dst1, NULL);
+    SDLTest_AssertCheck(!SDL_SurfaceHasRLE(src), "Verify that a noisy sprite isn't RLE encoded automatically");
+
+done:
+    SDL_ResetHint(SDL_HINT_SURFACE_AUTO_RLE);
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(fresh);
+    SDL_DestroySurface(patch);
+    SDL_DestroySurface(dst1);
+    SDL_DestroySurface(dst2);
+    return TEST_COMPLETED;
+}
+
+static SDL_Surface *CreateRandomSurface(int w, int h, SDL_PixelFormat format, Uint64 *seed)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        if (palette) {
+            SDL_Color colors[256];
+            for (x = 0; x < palette->ncolors; ++x) {
+                const Uint32 color = SDL_rand_bits_r(seed);
+                colors[x].r = (Uint8)(color >> 24);
+                colors[x].g = (Uint8)(color >> 16);
+                colors[x].b = (Uint8)(color >> 8);
+                colors[x].a = (Uint8)color;
+            }
+            SDL_SetPaletteColors(palette, colors, 0, palette->ncolors);
+        }
+    }
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->pitch; ++x) {
+            row[x] = (Uint8)SDL_rand_bits_r(seed);
+        }
+    }
+    return surface;
+}
+
+/* Blits a fresh copy of src so the blit map is recalculated with the current hints */
+static SDL_Surface *BlitWithPipelineHint(const char *hint, SDL_Surface *src, SDL_Surface *dst, SDL_BlendMode mode, bool modulate, bool colorkey, Uint32 key, bool scaled)
+{
+    SDL_Surface *src_copy = SDL_DuplicateSurface(src);
+    SDL_Surface *dst_copy = SDL_DuplicateSurface(dst);
+    SDL_Rect dstrect;
+
+    if (!src_copy || !dst_copy) {
+        SDL_DestroySurface(src_copy);
+        SDL_DestroySurface(dst_copy);
+        return NULL;
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_PIPELINE, hint);
+    SDL_SetSurfaceBlendMode(src_copy, mode);
+    if (modulate) {
+        SDL_SetSurfaceColorMod(src_copy, 200, 110, 50);
+        SDL_SetSurfaceAlphaMod(src_copy, 150);
+    }
+    if (colorkey) {
+        SDL_SetSurfaceColorKey(src_copy, true, key);
+    }
+    if (scaled) {
+        dstrect.x = 3;
+        dstrect.y = 2;
+        dstrect.w = dst_copy->w - 7;
+        dstrect.h = dst_copy->h - 5;
+        SDL_BlitSurfaceScaled(src_copy, NULL, dst_copy, &dstrect, SDL_SCALEMODE_NEAREST);
+    } else {
+        dstrect.x = 5;
+        dstrect.y = 1;
+        SDL_BlitSurface(src_copy, NULL, dst_copy, &dstrect);
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_PIPELINE);
+
+    SDL_DestroySurface(src_copy);
+    return dst_copy;
+}
+
+#define SURFACE_THREADS_OPS 6
+
+/* Runs every operation that can be split across the surface threads */
+static bool RunSurfaceThreadOps(SDL_Surface *src, SDL_Surface *results[SURFACE_THREADS_OPS])
+{
+    int i;
+
+    results[0] = SDL_ConvertSurface(src, SDL_PIXELFORMAT_RGB565);
+    results[1] = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ABGR2101010);
+    results[2] = SDL_ConvertSurface(src, SDL_PIXELFORMAT_NV12);
+
+    results[3] = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_XRGB8888);
+    if (results[3]) {
+        SDL_FillSurfaceRect(results[3], NULL, 0xFF204060);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceColorMod(src, 200, 150, 255);
+        SDL_SetSurfaceAlphaMod(src, 180);
+        SDL_BlitSurface(src, NULL, results[3], NULL);
+        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+        SDL_SetSurfaceAlphaMod(src, 255);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    }
+
+    results[4] = SDL_ScaleSurface(src, src->w * 3 / 2, src->h * 3 / 2, SDL_SCALEMODE_LINEAR);
+
+    results[5] = SDL_DuplicateSurface(src);
+    if (results[5]) {
+        SDL_PremultiplySurfaceAlpha(results[5], false);
+    }
+
+    for (i = 0; i < SURFACE_THREADS_OPS; ++i) {
+        if (!results[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool CompareSurfacePixels(SDL_Surface *surface1, SDL_Surface *surface2)
+{
+    int pitch, rows, y;
+
+    if (surface1->format != surface2->format || surface1->w != surface2->w || surface1->h != surface2->h) {
+        return false;
+    }
+
+    if (surface1->format == SDL_PIXELFORMAT_NV12) {
+        /* The Y plane is followed by the interleaved UV plane at half height */
+        pitch = surface1->w;
+        rows = surface1->h + (surface1->h + 1) / 2;
+    } else {
+        pitch = surface1->w * SDL_BYTESPERPIXEL(surface1->format);
+        rows = surface1->h;
+    }
+    for (y = 0; y < rows; ++y) {
+        const Uint8 *row1 = (const Uint8 *)surface1->pixels + y * surface1->pitch;
+        const Uint8 *row2 = (const Uint8 *)surface2->pixels + y * surface2->pitch;
+        if (SDL_memcmp(row1, row2, pitch) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Tests that the blit pipeline gives the same results as the per-pixel slow blitter.
+ */
+static int SDLCALL surface_testBlitPipeline(void *arg)
+{
+    /* Pairs without a dedicated blitter, so they go through the generic path */
+    static const struct
+    {
+        SDL_PixelFormat src;
+        SDL_PixelFormat dst;
+    } format_pairs[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB2101010 },
+        { SDL_PIXELFORMAT_ARGB2101010, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ABGR2101010, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XBGR2101010 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB2101010 },
+        { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_INDEX8 },
+        { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_INDEX8 },
+    };
+    static const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD, SDL_BLENDMODE_ADD_PREMULTIPLIED, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    Uint64 seed = 1;
+    int i, j, variant;
+
+    for (i = 0; i < SDL_arraysize(format_pairs); ++i) {
+        SDL_Surface *src = CreateRandomSurface(301, 37, format_pairs[i].src, &seed);
+        SDL_Surface *dst = CreateRandomSurface(311, 43, format_pairs[i].dst, &seed);
+        const char *src_name = SDL_GetPixelFormatName(format_pairs[i].src);
+        const char *dst_name = SDL_GetPixelFormatName(format_pairs[i].dst);
+        const SDL_Rect keyrect = { 20, 5, 100, 20 };
+        Uint32 key = 0;
+
+        SDLTest_AssertCheck(src && dst, "Create %s and %s surfaces", src_name, dst_name);
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            return TEST_ABORTED;
+        }
+        key = SDL_MapSurfaceRGB(src, 10, 20, 30);
+        SDL_FillSurfaceRect(src, &keyrect, key);
+
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            /* Bit 0 modulates, bit 1 uses the colorkey, bit 2 scales */
+            for (variant = 0; variant < 8; ++variant) {
+                const bool modulate = (variant & 1) != 0;
+                const bool colorkey = (variant & 2) != 0;
+                const bool scaled = (variant & 4) != 0;
+                SDL_Surface *expected = BlitWithPipelineHint("0", src, dst, modes[j], modulate, colorkey, key, scaled);
+                SDL_Surface *actual = BlitWithPipelineHint("1", src, dst, modes[j], modulate, colorkey, key, scaled);
+
+                SDLTest_AssertCheck(expected && actual && CompareSurfacePixels(expected, actual),
+                                    "Verify %s to %s blit with blend mode 0x%x%s%s%s matches the slow blitter",
+                                    src_name, dst_name, (unsigned int)modes[j],
+                                    modulate ? ", modulated" : "", colorkey ? ", colorkey" : "", scaled ? ", scaled" : "");
+                SDL_DestroySurface(expected);
+                SDL_DestroySurface(actual);
+            }
+        }
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that splitting surface operations across threads doesn't change the output.
+ */
+static int SDLCALL surface_testThreads(void *arg)
+{
+    static const char *const op_names[SURFACE_THREADS_OPS] = {
+        "convert to RGB565", "convert to ABGR2101010", "convert to NV12",
+        "blended and modulated blit", "linear scale", "premultiply alpha"
+    };
+    static const char *const thread_counts[] = { "1", "3", "8" };
+    SDL_Surface *src;
+    SDL_Surface *expected[SURFACE_THREADS_OPS] = { NULL };
+    SDL_Surface *actual[SURFACE_THREADS_OPS] = { NULL };
+    Uint64 seed = 1;
+    bool result;
+    int x, y, i, j;
+
+    /* Big enough that the surface threads are used */
+    src = SDL_CreateSurface(320, 241, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "SDL_CreateSurface()");
+    if (!src) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < src->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < src->w; ++x) {
+            row[x] = SDL_rand_bits_r(&seed);
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_THREADS, "0");
+    result = RunSurfaceThreadOps(src, expected);
+    SDLTest_AssertCheck(result, "Single threaded operations, expected true, got %s", result ? "true" : "false");
+
+    for (i = 0; result && i < SDL_arraysize(thread_counts); ++i) {
+        SDL_SetHint(SDL_HINT_SURFACE_THREADS, thread_counts[i]);
+        result = RunSurfaceThreadOps(src, actual);
+        SDLTest_AssertCheck(result, "Operations with %s threads, expected true, got %s", thread_counts[i], result ? "true" : "false");
+
+        for (j = 0; j < SURFACE_THREADS_OPS; ++j) {
+            if (actual[j]) {
+                SDLTest_AssertCheck(CompareSurfacePixels(expected[j], actual[j]),
+                                    "Verify %s with %s threads matches the single threaded result", op_names[j], thread_counts[i]);
+                SDL_DestroySurface(actual[j]);
+                actual[j] = NULL;
+            }
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+
+    for (j = 0; j < SURFACE_THREADS_OPS; ++j) {
+        SDL_DestroySurface(expected[j]);
+    }
+    SDL_DestroySurface(src);
+
+    return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -1694,6 +2199,22 @@ static const SDLTest_TestCaseReference surfaceTestScale = {
     surface_testScale, "surface_testScale", "Test scaling operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestScaleFiltered = {
+    surface_testScaleFiltered, "surface_testScaleFiltered", "Test bicubic, Lanczos and area scaling.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRLE = {
+    surface_testRLE, "surface_testRLE", "Test RLE encoding of changed and automatically encoded surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitPipeline = {
+    surface_testBlitPipeline, "surface_testBlitPipeline", "Test that the blit pipeline matches the slow blitter.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestThreads = {
+    surface_testThreads, "surface_testThreads", "Test that threaded surface operations match single threaded ones.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestInvalidFormat,
@@ -1722,6 +2243,10 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
     &surfaceTestScale,
+    &surfaceTestScaleFiltered,
+    &surfaceTestRLE,
+    &surfaceTestBlitPipeline,
+    &surfaceTestThreads,
     NULL
 };
 
@@ -174,6 +174,328 @@ static int SDLCALL timer_addRemoveTimer(void *arg)
 #endif
 }
 
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+static SDL_AtomicInt g_timerOrderCount;
+static int g_timerOrder[5];
+
+static Uint32 SDLCALL timerOrderCallback(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    const int index = SDL_AddAtomicInt(&g_timerOrderCount, 1);
+    if (index < (int)SDL_arraysize(g_timerOrder)) {
+        g_timerOrder[index] = (int)(intptr_t)param;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * Adds and removes many timers, and checks that timers fire in order of
+ * their deadlines.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_RemoveTimer
+ */
+static int SDLCALL timer_manyTimers(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    static const int intervals[] = { 50, 30, 40, 10, 20 };
+    SDL_TimerID ids[2000];
+    int i, removed = 0, missing = 0;
+    bool ordered = true;
+
+    /* Add a lot of timers that won't fire during the test */
+    g_paramCheck = 0;
+    g_timerCallbackCalled = 0;
+    for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+        ids[i] = SDL_AddTimer(100000 + i, timerTestCallback, NULL);
+    }
+
+    /* Add some short timers out of order, they should fire sorted by interval */
+    SDL_SetAtomicInt(&g_timerOrderCount, 0);
+    for (i = 0; i < (int)SDL_arraysize(intervals); ++i) {
+        SDL_AddTimer(intervals[i], timerOrderCallback, (void *)(intptr_t)intervals[i]);
+    }
+    SDL_Delay(200);
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerOrderCount) == (int)SDL_arraysize(intervals), "Check all short timers fired, expected: %d, got: %d", (int)SDL_arraysize(intervals), SDL_GetAtomicInt(&g_timerOrderCount));
+    for (i = 1; i < (int)SDL_arraysize(g_timerOrder); ++i) {
+        if (g_timerOrder[i - 1] > g_timerOrder[i]) {
+            ordered = false;
+        }
+    }
+    SDLTest_AssertCheck(ordered, "Check short timers fired in order of their deadlines");
+
+    /* Remove the long timers, in reverse order, twice */
+    for (i = (int)SDL_arraysize(ids) - 1; i >= 0; --i) {
+        if (SDL_RemoveTimer(ids[i])) {
+            ++removed;
+        }
+    }
+    for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+        if (!SDL_RemoveTimer(ids[i])) {
+            ++missing;
+        }
+    }
+    SDLTest_AssertCheck(removed == (int)SDL_arraysize(ids), "Check all timers were removed, expected: %d, got: %d", (int)SDL_arraysize(ids), removed);
+    SDLTest_AssertCheck(missing == (int)SDL_arraysize(ids), "Check removed timers can't be removed again, expected: %d, got: %d", (int)SDL_arraysize(ids), missing);
+    SDLTest_AssertCheck(g_timerCallbackCalled == 0, "Check long timers were not called, expected: 0, got: %i", g_timerCallbackCalled);
+
+    return TEST_COMPLETED;
+#endif
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+static SDL_AtomicInt g_timerOneShotCount;
+
+static Uint32 SDLCALL timerOneShotCallback(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    SDL_AddAtomicInt(&g_timerOneShotCount, 1);
+    return 0;
+}
+#endif
+
+/**
+ * Lets many one-shot timers fire, and checks that their IDs are retired.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_RemoveTimer
+ */
+static int SDLCALL timer_oneShotTimers(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    SDL_TimerID ids[500];
+    SDL_TimerID id;
+    int i, round, added = 0, stale = 0;
+
+    /* Twice, so the second round reuses the timers retired by the first */
+    for (round = 0; round < 2; ++round) {
+        SDL_SetAtomicInt(&g_timerOneShotCount, 0);
+        for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+            ids[i] = SDL_AddTimer(1 + (i % 10), timerOneShotCallback, NULL);
+            if (ids[i]) {
+                ++added;
+            }
+        }
+        for (i = 0; i < 200 && SDL_GetAtomicInt(&g_timerOneShotCount) < (int)SDL_arraysize(ids); ++i) {
+            SDL_Delay(10);
+        }
+        SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerOneShotCount) == (int)SDL_arraysize(ids), "Check all one-shot timers fired, expected: %d, got: %d", (int)SDL_arraysize(ids), SDL_GetAtomicInt(&g_timerOneShotCount));
+
+        /* The callbacks have returned, give the timer thread a moment to retire the last of them */
+        SDL_Delay(50);
+        for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+            if (!SDL_RemoveTimer(ids[i])) {
+                ++stale;
+            }
+        }
+    }
+    SDLTest_AssertCheck(added == 2 * (int)SDL_arraysize(ids), "Check all timers were added, expected: %d, got: %d", 2 * (int)SDL_arraysize(ids), added);
+    SDLTest_AssertCheck(stale == 2 * (int)SDL_arraysize(ids), "Check retired timers can't be removed, expected: %d, got: %d", 2 * (int)SDL_arraysize(ids), stale);
+
+    /* A new timer reusing a retired structure gets its own ID */
+    id = SDL_AddTimer(100000, timerOneShotCallback, NULL);
+    SDLTest_AssertCheck(id != 0 && id != ids[0], "Check new timer has a fresh ID, got: %" SDL_PRIu32, id);
+    SDLTest_AssertCheck(!SDL_RemoveTimer(ids[0]), "Check a retired ID doesn't resolve to the new timer");
+    SDLTest_AssertCheck(SDL_RemoveTimer(id), "Check the new timer can be removed");
+
+    return TEST_COMPLETED;
+#endif
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+#define TIMER_WORKER_TIMERS 4
+#define TIMER_WORKER_FIRES  3
+
+static SDL_AtomicInt g_timerWorkerCounts[TIMER_WORKER_TIMERS];
+static SDL_AtomicInt g_timerWorkerRunning;
+static SDL_AtomicInt g_timerWorkerMaxRunning;
+static SDL_AtomicInt g_timerSlowStarted;
+static SDL_AtomicInt g_timerSlowFinished;
+
+static Uint32 SDLCALL timerWorkerCallback(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    const int index = (int)(intptr_t)param;
+    const int running = SDL_AddAtomicInt(&g_timerWorkerRunning, 1) + 1;
+    int max_running;
+
+    do {
+        max_running = SDL_GetAtomicInt(&g_timerWorkerMaxRunning);
+    } while (running > max_running && !SDL_CompareAndSwapAtomicInt(&g_timerWorkerMaxRunning, max_running, running));
+
+    /* A slow callback, so the timers overlap if they run on different workers */
+    SDL_Delay(50);
+    SDL_AddAtomicInt(&g_timerWorkerRunning, -1);
+
+    if (SDL_AddAtomicInt(&g_timerWorkerCounts[index], 1) + 1 < TIMER_WORKER_FIRES) {
+        return interval;
+    }
+    return 0;
+}
+
+static Uint32 SDLCALL timerSlowCallback(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    SDL_AddAtomicInt(&g_timerSlowStarted, 1);
+    SDL_Delay(100);
+    SDL_AddAtomicInt(&g_timerSlowFinished, 1);
+    return interval;
+}
+#endif
+
+/**
+ * Runs slow timer callbacks on the worker pool, and removes a timer while
+ * its callback is running.
+ *
+ * This needs SDL_HINT_TIMER_WORKER_THREADS to be set before the timer
+ * thread starts, see the testautomation-timer-workers test.
+ *
+ * \sa SDL_HINT_TIMER_WORKER_THREADS
+ * \sa SDL_RemoveTimer
+ */
+static int SDLCALL timer_workerThreads(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    const char *hint = SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS);
+    const int num_workers = hint ? SDL_atoi(hint) : 0;
+    SDL_TimerID id;
+    bool result;
+    int i, count;
+
+    if (num_workers < 2) {
+        SDLTest_Log("Set SDL_TIMER_WORKER_THREADS to 2 or more to run timer callbacks on workers");
+        return TEST_SKIPPED;
+    }
+
+    /* Slow repeating timers overlap, and each fires the number of times it asks for */
+    SDL_SetAtomicInt(&g_timerWorkerRunning, 0);
+    SDL_SetAtomicInt(&g_timerWorkerMaxRunning, 0);
+    for (i = 0; i < TIMER_WORKER_TIMERS; ++i) {
+        SDL_SetAtomicInt(&g_timerWorkerCounts[i], 0);
+    }
+    for (i = 0; i < TIMER_WORKER_TIMERS; ++i) {
+        id = SDL_AddTimer(10, timerWorkerCallback, (void *)(intptr_t)i);
+        SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+    }
+    for (i = 0; i < 300; ++i) {
+        int done = 0, j;
+        for (j = 0; j < TIMER_WORKER_TIMERS; ++j) {
+            if (SDL_GetAtomicInt(&g_timerWorkerCounts[j]) >= TIMER_WORKER_FIRES) {
+                ++done;
+            }
+        }
+        if (done == TIMER_WORKER_TIMERS) {
+            break;
+        }
+        SDL_Delay(10);
+    }
+    /* Make sure nothing fires after returning 0 */
+    SDL_Delay(100);
+    for (i = 0; i < TIMER_WORKER_TIMERS; ++i) {
+        count = SDL_GetAtomicInt(&g_timerWorkerCounts[i]);
+        SDLTest_AssertCheck(count == TIMER_WORKER_FIRES, "Check timer %d fired %d times, got: %d", i, TIMER_WORKER_FIRES, count);
+    }
+    count = SDL_GetAtomicInt(&g_timerWorkerMaxRunning);
+    SDLTest_AssertCheck(count >= 2, "Check callbacks ran at the same time, expected: >=2, got: %d", count);
+
+    /* Remove a repeating timer while its callback is running on a worker */
+    SDL_SetAtomicInt(&g_timerSlowStarted, 0);
+    SDL_SetAtomicInt(&g_timerSlowFinished, 0);
+    id = SDL_AddTimer(10, timerSlowCallback, NULL);
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+    for (i = 0; i < 100 && SDL_GetAtomicInt(&g_timerSlowStarted) == 0; ++i) {
+        SDL_Delay(5);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerSlowStarted) == 1 && SDL_GetAtomicInt(&g_timerSlowFinished) == 0, "Check the callback is running");
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertCheck(result == true, "Check removing a running timer succeeds, expected: true, got: %i", result);
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertCheck(result == false, "Check removing it again fails, expected: false, got: %i", result);
+    SDL_Delay(300);
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerSlowFinished) == 1, "Check the running callback finished, expected: 1, got: %d", SDL_GetAtomicInt(&g_timerSlowFinished));
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerSlowStarted) == 1, "Check the removed timer didn't fire again, expected: 1, got: %d", SDL_GetAtomicInt(&g_timerSlowStarted));
+
+    return TEST_COMPLETED;
+#endif
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+static SDL_AtomicInt g_timerPropertiesCount;
+
+static Uint64 SDLCALL timerPropertiesCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    /* Fire three times, then stop */
+    if (SDL_AddAtomicInt(&g_timerPropertiesCount, 1) + 1 < 3) {
+        return interval;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * Adds timers with properties and checks the timer statistics.
+ *
+ * \sa SDL_AddTimerWithProperties
+ * \sa SDL_GetTimerStatistics
+ */
+static int SDLCALL timer_addTimerWithProperties(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    SDL_TimerStatistics stats;
+    SDL_PropertiesID props;
+    SDL_TimerID id;
+    bool result;
+    int i;
+
+    result = SDL_GetTimerStatistics(NULL, false);
+    SDLTest_AssertCheck(result == false, "Check SDL_GetTimerStatistics(NULL) fails, expected: false, got: %i", result);
+
+    result = SDL_GetTimerStatistics(&stats, true);
+    SDLTest_AssertPass("Call to SDL_GetTimerStatistics(&stats, true)");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+
+    /* A timer without a callback is an error */
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TIMER_CREATE_INTERVAL_NUMBER, 10 * SDL_NS_PER_MS);
+    id = SDL_AddTimerWithProperties(props);
+    SDLTest_AssertCheck(id == 0, "Check timer without callback fails, expected: 0, got: %" SDL_PRIu32, id);
+
+    /* Pinned and unpinned repeating timers */
+    SDL_SetAtomicInt(&g_timerPropertiesCount, 0);
+    SDL_SetPointerProperty(props, SDL_PROP_TIMER_CREATE_CALLBACK_POINTER, (void *)timerPropertiesCallback);
+    id = SDL_AddTimerWithProperties(props);
+    SDLTest_AssertPass("Call to SDL_AddTimerWithProperties()");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+    SDL_SetNumberProperty(props, SDL_PROP_TIMER_CREATE_WORKER_NUMBER, 1);
+    id = SDL_AddTimerWithProperties(props);
+    SDLTest_AssertPass("Call to SDL_AddTimerWithProperties() with a worker");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+    SDL_DestroyProperties(props);
+
+    for (i = 0; i < 100 && SDL_GetAtomicInt(&g_timerPropertiesCount) < 4; ++i) {
+        SDL_Delay(10);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_timerPropertiesCount) >= 4, "Check timers repeated, expected: >=4, got: %d", SDL_GetAtomicInt(&g_timerPropertiesCount));
+
+    result = SDL_GetTimerStatistics(&stats, false);
+    SDLTest_AssertPass("Call to SDL_GetTimerStatistics(&stats, false)");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+    SDLTest_AssertCheck(stats.num_callbacks >= 4, "Check number of callbacks, expected: >=4, got: %" SDL_PRIu64, stats.num_callbacks);
+    SDLTest_AssertCheck(stats.max_lateness <= stats.total_lateness, "Check max lateness is within total lateness, %" SDL_PRIu64 " <= %" SDL_PRIu64, stats.max_lateness, stats.total_lateness);
+
+    return TEST_COMPLETED;
+#endif
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -193,9 +515,25 @@ static const SDLTest_TestCaseReference timerTest4 = {
     timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    timer_manyTimers, "timer_manyTimers", "Add and remove many timers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest6 = {
+    timer_addTimerWithProperties, "timer_addTimerWithProperties", "Call to SDL_AddTimerWithProperties and SDL_GetTimerStatistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest7 = {
+    timer_oneShotTimers, "timer_oneShotTimers", "Retire the IDs of one-shot timers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest8 = {
+    timer_workerThreads, "timer_workerThreads", "Run timer callbacks on worker threads", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, &timerTest7, &timerTest8, NULL
 };
 
 /* Timer test suite (global) */
@@ -0,0 +1,209 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for surface blits between many pairs of pixel formats
+
+   Each pair is blitted with a plain copy, alpha blending, a colorkey, a
+   surface alpha and color modulation with blending, and the throughput is
+   logged for each. Set SDL_CPU_FEATURE_MASK (e.g. "-avx512bw,-avx2") to
+   compare the different SIMD blitters.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static const SDL_PixelFormat formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_XRGB2101010,
+    SDL_PIXELFORMAT_ARGB2101010,
+};
+
+typedef enum
+{
+    MODE_COPY,
+    MODE_BLEND,
+    MODE_COLORKEY,
+    MODE_SURFACE_ALPHA,
+    MODE_MODULATE_BLEND,
+    NUM_MODES
+} BlitMode;
+
+static const char *mode_names[NUM_MODES] = {
+    "copy",
+    "blend",
+    "colorkey",
+    "surface alpha",
+    "modulate+blend",
+};
+
+static SDL_Surface *create_surface(SDL_PixelFormat format, int w, int h)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    Uint64 seed = format;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        int i;
+
+        if (!palette) {
+            SDL_DestroySurface(surface);
+            return NULL;
+        }
+        for (i = 0; i < palette->ncolors; ++i) {
+            palette->colors[i].r = (Uint8)i;
+            palette->colors[i].g = (Uint8)(i * 3);
+            palette->colors[i].b = (Uint8)(255 - i);
+            palette->colors[i].a = (Uint8)(i * 7);
+        }
+    }
+    for (y = 0; y < h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < w * SDL_BYTESPERPIXEL(format); ++x) {
+            row[x] = (Uint8)SDL_rand_r(&seed, 256);
+        }
+    }
+    return surface;
+}
+
+static bool run_benchmark(SDL_PixelFormat src_format, SDL_PixelFormat dst_format, BlitMode mode, int w, int h, int duration_ms)
+{
+    SDL_Surface *src, *dst;
+    Uint64 start, elapsed;
+    int blits = 0;
+
+    src = create_surface(src_format, w, h);
+    dst = create_surface(dst_format, w, h);
+    if (!src || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s", SDL_GetError());
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        return false;
+    }
+
+    switch (mode) {
+    case MODE_COPY:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        break;
+    case MODE_BLEND:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        break;
+    case MODE_COLORKEY:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorKey(src, true, SDL_MapSurfaceRGB(src, 0, 0, 0));
+        /* Keep the blit from being turned into an RLE blit */
+        SDL_SetSurfaceRLE(src, false);
+        break;
+    case MODE_SURFACE_ALPHA:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceAlphaMod(src, 160);
+        break;
+    case MODE_MODULATE_BLEND:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceColorMod(src, 200, 160, 120);
+        SDL_SetSurfaceAlphaMod(src, 192);
+        break;
+    default:
+        break;
+    }
+
+    start = SDL_GetTicksNS();
+    do {
+        if (!SDL_BlitSurface(src, NULL, dst, NULL)) {
+            SDL_Log("%-24s -> %-24s %-15s: %s", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), mode_names[mode], SDL_GetError());
+            break;
+        }
+        blits++;
+        elapsed = SDL_GetTicksNS() - start;
+    } while (elapsed < (Uint64)duration_ms * SDL_NS_PER_MS);
+
+    if (blits > 0) {
+        SDL_Log("%-24s -> %-24s %-15s: %8.2f Mpixels/s",
+                SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), mode_names[mode],
+                ((double)blits * w * h) / ((double)elapsed / SDL_NS_PER_SECOND) / 1000000.0);
+    }
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int duration_ms = 50;
+    int width = 256;
+    int height = 256;
+    int i, j, mode;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--ms") == 0 && argv[i + 1]) {
+                duration_ms = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && argv[i + 2]) {
+                width = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                height = SDL_max(SDL_atoi(argv[i + 2]), 1);
+                consumed = 3;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--ms N]", "[--size W H]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%dx%d, %d ms per combination", width, height, duration_ms);
+
+    for (i = 0; i < (int)SDL_arraysize(formats); ++i) {
+        for (j = 0; j < (int)SDL_arraysize(formats); ++j) {
+            for (mode = 0; mode < NUM_MODES; ++mode) {
+                if (!run_benchmark(formats[i], formats[j], (BlitMode)mode, width, height, duration_ms)) {
+                    break;
+                }
+            }
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,276 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for large surface operations with a growing number of threads
+
+   Each operation is run with every thread count, and the result is checked
+   against the single threaded result.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    OP_CONVERT,
+    OP_PREMULTIPLY,
+    OP_STRETCH,
+    OP_BLIT_BLEND
+} Operation;
+
+typedef struct
+{
+    Operation op;
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    SDL_ScaleMode scale_mode;
+} TestCase;
+
+static const TestCase cases[] = {
+    { OP_CONVERT, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB24, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_ARGB8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_ABGR8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_NV12, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_YUY2, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_PIXELFORMAT_ARGB8888, SDL_SCALEMODE_NEAREST },
+    { OP_CONVERT, SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_PIXELFORMAT_XBGR2101010, SDL_SCALEMODE_NEAREST },
+    { OP_PREMULTIPLY, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_SCALEMODE_NEAREST },
+    { OP_PREMULTIPLY, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_SCALEMODE_NEAREST },
+    { OP_STRETCH, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_LINEAR },
+    { OP_STRETCH, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_BICUBIC },
+    { OP_STRETCH, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_LANCZOS },
+    { OP_STRETCH, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_AREA },
+    { OP_BLIT_BLEND, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_NEAREST },
+};
+
+static const char *op_names[] = {
+    "convert",
+    "premultiply",
+    "stretch",
+    "blend",
+};
+
+static const char *scale_mode_names[] = {
+    "nearest",
+    "linear",
+    "pixelart",
+    "bicubic",
+    "lanczos",
+    "area",
+};
+
+static SDL_Surface *create_source(SDL_PixelFormat format, int w, int h)
+{
+    SDL_Surface *surface;
+    SDL_Surface *converted;
+    Uint64 seed = format;
+    int x, y;
+
+    surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return NULL;
+    }
+    for (y = 0; y < h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < w; ++x) {
+            row[x] = (Uint32)SDL_rand_bits_r(&seed);
+        }
+    }
+    if (format == SDL_PIXELFORMAT_ARGB8888) {
+        return surface;
+    }
+    converted = SDL_ConvertSurface(surface, format);
+    SDL_DestroySurface(surface);
+    return converted;
+}
+
+static Uint64 checksum_surface(SDL_Surface *surface)
+{
+    SDL_Surface *converted = NULL;
+    Uint64 checksum = 0;
+    int x, y, row_size;
+
+    /* The planes of YUV surfaces aren't all in the rows, so check what they look like instead */
+    if (SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+        converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_XRGB8888);
+        if (!converted) {
+            return 0;
+        }
+        surface = converted;
+    }
+
+    row_size = surface->w * SDL_BYTESPERPIXEL(surface->format);
+    for (y = 0; y < surface->h; ++y) {
+        const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < row_size; ++x) {
+            checksum = (checksum * 31) + row[x];
+        }
+    }
+    SDL_DestroySurface(converted);
+    return checksum;
+}
+
+static bool run_operation(const TestCase *test, SDL_Surface *src, SDL_Surface *dst)
+{
+    switch (test->op) {
+    case OP_CONVERT:
+        return SDL_ConvertPixels(src->w, src->h, src->format, src->pixels, src->pitch, dst->format, dst->pixels, dst->pitch);
+    case OP_PREMULTIPLY:
+        return SDL_PremultiplyAlpha(src->w, src->h, src->format, src->pixels, src->pitch, dst->format, dst->pixels, dst->pitch, false);
+    case OP_STRETCH:
+        return SDL_StretchSurface(src, NULL, dst, NULL, test->scale_mode);
+    case OP_BLIT_BLEND:
+        return SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    return false;
+}
+
+static bool run_benchmark(const TestCase *test, SDL_Surface *src, SDL_Surface *dst, int num_threads, int duration_ms, Uint64 *checksum)
+{
+    Uint64 start, elapsed;
+    int iterations = 0;
+    char threads[16];
+
+    SDL_snprintf(threads, sizeof(threads), "%d", num_threads);
+    SDL_SetHint(SDL_HINT_SURFACE_THREADS, threads);
+
+    SDL_ClearSurface(dst, 0.25f, 0.5f, 0.75f, 1.0f);
+    if (!run_operation(test, src, dst)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s failed: %s", op_names[test->op], SDL_GetError());
+        return false;
+    }
+    *checksum = checksum_surface(dst);
+
+    start = SDL_GetTicksNS();
+    do {
+        run_operation(test, src, dst);
+        iterations++;
+        elapsed = SDL_GetTicksNS() - start;
+    } while (elapsed < (Uint64)duration_ms * SDL_NS_PER_MS);
+
+    SDL_Log("  %2d threads: %8.2f Mpixels/s, %7.3f ms, checksum %016" SDL_PRIx64,
+            num_threads, ((double)iterations * dst->w * dst->h) / ((double)elapsed / SDL_NS_PER_SECOND) / 1000000.0,
+            (double)elapsed / iterations / SDL_NS_PER_MS, *checksum);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int max_threads = 8;
+    int duration_ms = 500;
+    int width = 1920;
+    int height = 1080;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--ms") == 0 && argv[i + 1]) {
+                duration_ms = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && argv[i + 2]) {
+                width = SDL_max(SDL_atoi(argv[i + 1]), 2);
+                height = SDL_max(SDL_atoi(argv[i + 2]), 2);
+                consumed = 3;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-threads N]", "[--ms N]", "[--size W H]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d CPUs, %dx%d", SDL_GetNumLogicalCPUCores(), width, height);
+
+    for (i = 0; i < (int)SDL_arraysize(cases) && result == 0; ++i) {
+        const TestCase *test = &cases[i];
+        SDL_Surface *src, *dst;
+        Uint64 expected = 0;
+        int num_threads;
+
+        src = create_source(test->src_format, width, height);
+        if (test->op == OP_STRETCH && test->scale_mode == SDL_SCALEMODE_AREA) {
+            /* Area filtering is meant for shrinking */
+            dst = SDL_CreateSurface(width * 2 / 3, height * 2 / 3, test->dst_format);
+        } else if (test->op == OP_STRETCH) {
+            dst = SDL_CreateSurface(width * 3 / 2, height * 3 / 2, test->dst_format);
+        } else {
+            dst = SDL_CreateSurface(width, height, test->dst_format);
+        }
+        if (!src || !dst) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s", SDL_GetError());
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            result = 1;
+            break;
+        }
+        if (test->op == OP_BLIT_BLEND) {
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        }
+
+        if (test->op == OP_STRETCH) {
+            SDL_Log("%s %s %dx%d -> %dx%d", op_names[test->op], scale_mode_names[test->scale_mode],
+                    src->w, src->h, dst->w, dst->h);
+        } else {
+            SDL_Log("%s %s -> %s", op_names[test->op],
+                    SDL_GetPixelFormatName(test->src_format), SDL_GetPixelFormatName(test->dst_format));
+        }
+
+        /* 0 is the plain single threaded path, everything else is checked against it */
+        for (num_threads = 0; num_threads <= max_threads; num_threads = num_threads ? (num_threads * 2) : 1) {
+            Uint64 checksum;
+            if (!run_benchmark(test, src, dst, num_threads, duration_ms, &checksum)) {
+                result = 1;
+                break;
+            }
+            if (num_threads == 0) {
+                expected = checksum;
+            } else if (checksum != expected) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d threads gave a different result!", num_threads);
+                result = 1;
+            }
+        }
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
@@ -0,0 +1,180 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for copying large files
+
+   A file is copied with SDL_CopyFile(), with SDL_CopyFileAsync(), and with a
+   plain SDL_ReadIO()/SDL_WriteIO() loop through a small buffer for
+   reference, and the throughput of each is reported.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SOURCE_FILE "testcopyfileperf-src.dat"
+#define DEST_FILE "testcopyfileperf-dst.dat"
+
+static bool create_file(const char *file, Sint64 size)
+{
+    SDL_IOStream *io;
+    Uint8 *chunk;
+    const size_t chunk_size = 1024 * 1024;
+    Sint64 written = 0;
+    size_t i;
+    bool result = true;
+
+    chunk = (Uint8 *)SDL_malloc(chunk_size);
+    if (!chunk) {
+        return false;
+    }
+    for (i = 0; i < chunk_size; ++i) {
+        chunk[i] = (Uint8)(i * 31);
+    }
+
+    io = SDL_IOFromFile(file, "wb");
+    if (!io) {
+        SDL_free(chunk);
+        return false;
+    }
+    while (written < size && result) {
+        const size_t amount = (size_t)SDL_min((Sint64)chunk_size, size - written);
+        result = (SDL_WriteIO(io, chunk, amount) == amount);
+        written += amount;
+    }
+    if (!SDL_CloseIO(io)) {
+        result = false;
+    }
+    SDL_free(chunk);
+    return result;
+}
+
+static bool copy_with_streams(const char *oldpath, const char *newpath)
+{
+    SDL_IOStream *input, *output;
+    char buffer[4096];
+    size_t len;
+    bool result = false;
+
+    input = SDL_IOFromFile(oldpath, "rb");
+    output = SDL_IOFromFile(newpath, "wb");
+    if (input && output) {
+        result = true;
+        while (result && (len = SDL_ReadIO(input, buffer, sizeof(buffer))) > 0) {
+            result = (SDL_WriteIO(output, buffer, len) == len);
+        }
+        result = result && SDL_FlushIO(output);
+    }
+    if (input) {
+        SDL_CloseIO(input);
+    }
+    if (output && !SDL_CloseIO(output)) {
+        result = false;
+    }
+    return result;
+}
+
+static bool copy_async(const char *oldpath, const char *newpath)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOOutcome outcome;
+    bool result = false;
+
+    queue = SDL_CreateAsyncIOQueue();
+    if (!queue) {
+        return false;
+    }
+    if (SDL_CopyFileAsync(oldpath, newpath, queue, NULL) && SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+        result = (outcome.result == SDL_ASYNCIO_COMPLETE);
+    }
+    SDL_DestroyAsyncIOQueue(queue);
+    return result;
+}
+
+static void run_copy(const char *name, bool (*copy)(const char *, const char *), Sint64 size)
+{
+    Uint64 start, elapsed;
+
+    SDL_RemovePath(DEST_FILE);
+
+    start = SDL_GetTicksNS();
+    if (!copy(SOURCE_FILE, DEST_FILE)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s failed: %s", name, SDL_GetError());
+        return;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-20s %8.2f ms, %8.1f MB/s", name, (double)elapsed / SDL_NS_PER_MS,
+            ((double)size / (1024.0 * 1024.0)) / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND));
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int size_mb = 256;
+    int iterations = 3;
+    Sint64 size;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                size_mb = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--size MEGABYTES]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    size = (Sint64)size_mb * 1024 * 1024;
+    SDL_Log("Creating a %d MB test file", size_mb);
+    if (!create_file(SOURCE_FILE, size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create %s: %s", SOURCE_FILE, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    for (i = 0; i < iterations; ++i) {
+        run_copy("4 KB read/write", copy_with_streams, size);
+        run_copy("SDL_CopyFile", SDL_CopyFile, size);
+        run_copy("SDL_CopyFileAsync", copy_async, size);
+    }
+
+    SDL_RemovePath(SOURCE_FILE);
+    SDL_RemovePath(DEST_FILE);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -149,6 +149,8 @@ int main(int argc, char *argv[])
         char **globlist;
         SDL_Storage *storage = NULL;
         SDL_IOStream *stream;
+        SDL_AsyncIOQueue *queue;
+        SDL_AsyncIOOutcome outcome;
         const char *text = "foo\n";
         SDL_PathInfo pathinfo;
 
@@ -220,6 +222,31 @@ int main(int argc, char *argv[])
                 SDL_free(textB);
             }
 
+            queue = SDL_CreateAsyncIOQueue();
+            if (!queue) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateAsyncIOQueue() failed: %s", SDL_GetError());
+            } else if (!SDL_CopyFileAsync("testfilesystem-B", "testfilesystem-C", queue, queue)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CopyFileAsync('testfilesystem-B', 'testfilesystem-C') failed: %s", SDL_GetError());
+            } else if (!SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_WaitAsyncIOResult() didn't return the copy");
+            } else if ((outcome.type != SDL_ASYNCIO_TASK_COPY) || (outcome.result != SDL_ASYNCIO_COMPLETE) || (outcome.userdata != queue)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CopyFileAsync('testfilesystem-B', 'testfilesystem-C') reported type %d, result %d", (int)outcome.type, (int)outcome.result);
+            } else if (outcome.bytes_transferred != SDL_strlen(text)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CopyFileAsync('testfilesystem-B', 'testfilesystem-C') copied %d bytes, expected %d", (int)outcome.bytes_transferred, (int)SDL_strlen(text));
+            } else {
+                size_t sizeC;
+                char *textC = (char *)SDL_LoadFile("testfilesystem-C", &sizeC);
+                if (!textC || sizeC != SDL_strlen(text) || SDL_strcmp(textC, text) != 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Contents of testfilesystem-C didn't match, expected %s, got %s", text, textC);
+                }
+                SDL_free(textC);
+
+                if (!SDL_RemovePath("testfilesystem-C")) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RemovePath('testfilesystem-C') failed: %s", SDL_GetError());
+                }
+            }
+            SDL_DestroyAsyncIOQueue(queue);
+
             if (!SDL_RemovePath("testfilesystem-A")) {
                 SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RemovePath('testfilesystem-A') failed: %s", SDL_GetError());
             }
@@ -0,0 +1,494 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Test of SDL's internal hash table
+
+   SDL_HashTable isn't part of the public API, so its source is built into
+   this program directly. Every check runs against a table created with and
+   without thread safety, since they replace and clear items differently.
+*/
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include "../src/SDL_epoch.c"
+#include "../src/SDL_hashtable.c"
+
+#define NUM_KEYS 5000
+
+/* Keys are small integers, values are the key plus an offset so a replaced value can be told apart. */
+#define KEY(i)          ((const void *)(uintptr_t)((i) + 1))
+#define VALUE(i, gen)   ((const void *)(uintptr_t)(((gen) * 1000000) + (i) + 1))
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                              \
+    do {                                              \
+        if (!(cond)) {                                \
+            SDL_Log("FAILED: " __VA_ARGS__);          \
+            failures++;                               \
+        }                                             \
+    } while (0)
+
+typedef struct
+{
+    int num_destroyed;
+    Uint32 destroyed_sum;
+} DestroyCounts;
+
+static void SDLCALL count_destroyed(void *userdata, const void *key, const void *value)
+{
+    DestroyCounts *counts = (DestroyCounts *)userdata;
+    counts->num_destroyed++;
+    counts->destroyed_sum += (Uint32)(uintptr_t)value;
+}
+
+/* Put every key in one of 4 buckets, so probe sequences run across many groups and through lots of tombstones. */
+static Uint32 SDLCALL hash_colliding(void *unused, const void *key)
+{
+    return ((Uint32)(uintptr_t)key & 3) * 0x40000001u;
+}
+
+static bool SDLCALL keymatch_id(void *unused, const void *a, const void *b)
+{
+    return a == b;
+}
+
+typedef struct
+{
+    bool seen[NUM_KEYS];
+    int num_seen;
+    int num_bad;
+    int stop_after;
+} IterateState;
+
+static bool SDLCALL iterate_item(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+{
+    IterateState *state = (IterateState *)userdata;
+    const int i = (int)(uintptr_t)key - 1;
+
+    if (i < 0 || i >= NUM_KEYS || state->seen[i] || value != VALUE(i, 0)) {
+        state->num_bad++;
+    } else {
+        state->seen[i] = true;
+    }
+    state->num_seen++;
+    return (state->num_seen != state->stop_after);
+}
+
+static bool has_all(SDL_HashTable *table, int first, int last, int step, int gen)
+{
+    int i;
+    for (i = first; i < last; i += step) {
+        const void *value = NULL;
+        if (!SDL_FindInHashTable(table, KEY(i), &value) || value != VALUE(i, gen)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool has_none(SDL_HashTable *table, int first, int last, int step)
+{
+    int i;
+    for (i = first; i < last; i += step) {
+        if (SDL_FindInHashTable(table, KEY(i), NULL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_insert_replace_remove(bool threadsafe, SDL_HashCallback hash)
+{
+    DestroyCounts counts;
+    SDL_HashTable *table;
+    int i;
+
+    SDL_zero(counts);
+    table = SDL_CreateHashTable(0, threadsafe, hash, keymatch_id, count_destroyed, &counts);
+    CHECK(table != NULL, "SDL_CreateHashTable(): %s", SDL_GetError());
+    if (!table) {
+        return;
+    }
+    CHECK(SDL_HashTableEmpty(table), "new table isn't empty");
+
+    /* Starting from the smallest table, this has to grow it several times. */
+    for (i = 0; i < NUM_KEYS; ++i) {
+        if (!SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 0), false)) {
+            CHECK(false, "insert of key %d failed: %s", i, SDL_GetError());
+            break;
+        }
+    }
+    CHECK(!SDL_HashTableEmpty(table), "table is empty after inserts");
+    CHECK(has_all(table, 0, NUM_KEYS, 1, 0), "inserted keys not found after growing");
+    CHECK(has_none(table, NUM_KEYS, NUM_KEYS * 2, 1), "keys found that were never inserted");
+
+    /* A duplicate without replace leaves the old item alone. */
+    CHECK(!SDL_InsertIntoHashTable(table, KEY(7), VALUE(7, 1), false), "duplicate insert without replace succeeded");
+    CHECK(has_all(table, 7, 8, 1, 0), "duplicate insert without replace changed the value");
+    CHECK(counts.num_destroyed == 0, "duplicate insert without replace destroyed %d items", counts.num_destroyed);
+
+    /* Replacing destroys the old item exactly once. */
+    for (i = 0; i < NUM_KEYS; i += 3) {
+        CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 1), true), "replace of key %d failed", i);
+    }
+    CHECK(counts.num_destroyed == (NUM_KEYS + 2) / 3, "replace destroyed %d items, expected %d", counts.num_destroyed, (NUM_KEYS + 2) / 3);
+    CHECK(has_all(table, 0, NUM_KEYS, 3, 1), "replaced keys don't have their new values");
+    CHECK(has_all(table, 1, NUM_KEYS, 3, 0) && has_all(table, 2, NUM_KEYS, 3, 0), "replace changed other keys");
+
+    /* Removing leaves tombstones, which lookups have to probe past. */
+    counts.num_destroyed = 0;
+    for (i = 1; i < NUM_KEYS; i += 3) {
+        CHECK(SDL_RemoveFromHashTable(table, KEY(i)), "remove of key %d failed", i);
+    }
+    CHECK(!SDL_RemoveFromHashTable(table, KEY(1)), "removed a key twice");
+    CHECK(counts.num_destroyed == (NUM_KEYS + 1) / 3, "remove destroyed %d items, expected %d", counts.num_destroyed, (NUM_KEYS + 1) / 3);
+    CHECK(has_none(table, 1, NUM_KEYS, 3), "removed keys still found");
+    CHECK(has_all(table, 0, NUM_KEYS, 3, 1) && has_all(table, 2, NUM_KEYS, 3, 0), "keys lost after removing others");
+
+    /* Churn through many more keys than fit, so tombstones pile up and get cleaned out by rehashing. */
+    for (i = NUM_KEYS; i < NUM_KEYS * 10; ++i) {
+        CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 0), false), "churn insert of key %d failed", i);
+        CHECK(SDL_RemoveFromHashTable(table, KEY(i)), "churn remove of key %d failed", i);
+    }
+    CHECK(has_all(table, 0, NUM_KEYS, 3, 1) && has_all(table, 2, NUM_KEYS, 3, 0), "keys lost after churn");
+    CHECK(has_none(table, 1, NUM_KEYS, 3) && has_none(table, NUM_KEYS, NUM_KEYS * 10, 1), "removed keys found after churn");
+
+    /* Removed keys can go back in. */
+    for (i = 1; i < NUM_KEYS; i += 3) {
+        CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 2), false), "reinsert of key %d failed", i);
+    }
+    CHECK(has_all(table, 1, NUM_KEYS, 3, 2), "reinserted keys not found");
+
+    SDL_DestroyHashTable(table);
+}
+
+static void test_clear(bool threadsafe)
+{
+    DestroyCounts counts;
+    SDL_HashTable *table;
+    Uint32 expected_sum = 0;
+    int round, i;
+
+    SDL_zero(counts);
+    table = SDL_CreateHashTable(16, threadsafe, SDL_HashID, SDL_KeyMatchID, count_destroyed, &counts);
+    CHECK(table != NULL, "SDL_CreateHashTable(): %s", SDL_GetError());
+    if (!table) {
+        return;
+    }
+
+    for (round = 0; round < 3; ++round) {
+        counts.num_destroyed = 0;
+        counts.destroyed_sum = 0;
+        expected_sum = 0;
+        for (i = 0; i < NUM_KEYS; ++i) {
+            CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, round), false), "insert of key %d in round %d failed", i, round);
+            expected_sum += (Uint32)(uintptr_t)VALUE(i, round);
+        }
+        SDL_ClearHashTable(table);
+        CHECK(counts.num_destroyed == NUM_KEYS, "clear destroyed %d items, expected %d", counts.num_destroyed, NUM_KEYS);
+        CHECK(counts.destroyed_sum == expected_sum, "clear destroyed the wrong items");
+        CHECK(SDL_HashTableEmpty(table), "table isn't empty after clear");
+        CHECK(has_none(table, 0, NUM_KEYS, 1), "keys found after clear");
+    }
+
+    /* Reusing the cleared table. */
+    for (i = 0; i < NUM_KEYS; i += 2) {
+        CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 0), false), "insert of key %d after clear failed", i);
+    }
+    CHECK(has_all(table, 0, NUM_KEYS, 2, 0), "keys inserted after clear not found");
+    CHECK(has_none(table, 1, NUM_KEYS, 2), "keys found that weren't inserted after clear");
+
+    counts.num_destroyed = 0;
+    SDL_DestroyHashTable(table);
+    CHECK(counts.num_destroyed == (NUM_KEYS + 1) / 2, "destroy destroyed %d items, expected %d", counts.num_destroyed, (NUM_KEYS + 1) / 2);
+}
+
+/* Lets allocations be made to fail, to get at the out-of-memory paths. */
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_AtomicInt fail_allocations;
+
+static void * SDLCALL failing_malloc(size_t size)
+{
+    return SDL_GetAtomicInt(&fail_allocations) ? NULL : real_malloc(size);
+}
+
+static void * SDLCALL failing_calloc(size_t nmemb, size_t size)
+{
+    return SDL_GetAtomicInt(&fail_allocations) ? NULL : real_calloc(nmemb, size);
+}
+
+static void * SDLCALL failing_realloc(void *mem, size_t size)
+{
+    return SDL_GetAtomicInt(&fail_allocations) ? NULL : real_realloc(mem, size);
+}
+
+typedef struct
+{
+    SDL_Semaphore *entered;
+    SDL_Semaphore *leave;
+} ReaderState;
+
+static int SDLCALL reader_thread(void *userdata)
+{
+    ReaderState *state = (ReaderState *)userdata;
+
+    SDL_EnterReadEpoch();
+    SDL_SignalSemaphore(state->entered);
+    SDL_WaitSemaphore(state->leave);
+    SDL_LeaveReadEpoch();
+    return 0;
+}
+
+/* Clearing a threadsafe table without memory for new slots can't wait for readers, since they might be waiting on the
+   writer. The items have to stay around until a later write gets to reclaim them. */
+static void test_clear_out_of_memory(void)
+{
+    SDL_free_func real_free;
+    DestroyCounts counts;
+    SDL_HashTable *table;
+    ReaderState state;
+    SDL_Thread *thread;
+    int i;
+
+    SDL_zero(counts);
+    table = SDL_CreateHashTable(16, true, SDL_HashID, SDL_KeyMatchID, count_destroyed, &counts);
+    CHECK(table != NULL, "SDL_CreateHashTable(): %s", SDL_GetError());
+    if (!table) {
+        return;
+    }
+    for (i = 0; i < NUM_KEYS; ++i) {
+        CHECK(SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 0), false), "insert of key %d failed", i);
+    }
+
+    state.entered = SDL_CreateSemaphore(0);
+    state.leave = SDL_CreateSemaphore(0);
+    thread = SDL_CreateThread(reader_thread, "reader", &state);
+    CHECK(thread != NULL, "SDL_CreateThread(): %s", SDL_GetError());
+    if (!thread) {
+        SDL_DestroyHashTable(table);
+        return;
+    }
+    SDL_WaitSemaphore(state.entered);
+
+    /* This used to wait for the reader while still holding the table's lock. */
+    SDL_GetMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(failing_malloc, failing_calloc, failing_realloc, real_free);
+    SDL_SetAtomicInt(&fail_allocations, 1);
+    SDL_ClearHashTable(table);
+    CHECK(SDL_HashTableEmpty(table), "table isn't empty after out-of-memory clear");
+    CHECK(has_none(table, 0, NUM_KEYS, 1), "keys found after out-of-memory clear");
+    SDL_SetAtomicInt(&fail_allocations, 0);
+    SDL_SetMemoryFunctions(real_malloc, real_calloc, real_realloc, real_free);
+    CHECK(counts.num_destroyed == 0, "%d items destroyed while a reader might still see them", counts.num_destroyed);
+
+    SDL_SignalSemaphore(state.leave);
+    SDL_WaitThread(thread, NULL);
+    SDL_DestroySemaphore(state.entered);
+    SDL_DestroySemaphore(state.leave);
+
+    /* The next write that can allocate reclaims the cleared items. */
+    CHECK(SDL_InsertIntoHashTable(table, KEY(0), VALUE(0, 1), false), "insert after out-of-memory clear failed");
+    CHECK(has_all(table, 0, 1, 1, 1) && has_none(table, 1, NUM_KEYS, 1), "wrong keys found after out-of-memory clear");
+    SDL_QuitEpoch();
+    CHECK(counts.num_destroyed == NUM_KEYS, "reclaimed %d cleared items, expected %d", counts.num_destroyed, NUM_KEYS);
+
+    counts.num_destroyed = 0;
+    SDL_DestroyHashTable(table);
+    CHECK(counts.num_destroyed == 1, "destroy destroyed %d items, expected 1", counts.num_destroyed);
+}
+
+static void test_bulk(bool threadsafe)
+{
+    const void *keys[64];
+    const void *values[64];
+    const void *found[64];
+    DestroyCounts counts;
+    SDL_HashTable *table;
+    int i;
+
+    SDL_zero(counts);
+    table = SDL_CreateHashTable(0, threadsafe, SDL_HashID, SDL_KeyMatchID, count_destroyed, &counts);
+    CHECK(table != NULL, "SDL_CreateHashTable(): %s", SDL_GetError());
+    if (!table) {
+        return;
+    }
+
+    /* Keys 0-31 each appear twice, first with generation 0 and then generation 1. */
+    for (i = 0; i < 64; ++i) {
+        keys[i] = KEY(i % 32);
+        values[i] = VALUE(i % 32, i / 32);
+    }
+
+    /* Without replace, the first of each duplicate wins and the call reports the rest as failures. */
+    CHECK(!SDL_InsertManyIntoHashTable(table, keys, values, 64, false), "bulk insert with duplicates and no replace succeeded");
+    CHECK(has_all(table, 0, 32, 1, 0), "bulk insert without replace didn't keep the first values");
+    CHECK(counts.num_destroyed == 0, "bulk insert without replace destroyed %d items", counts.num_destroyed);
+
+    /* With replace, the last of each duplicate wins, and every item it replaced is destroyed:
+       the first 32 replace the generation 0 items with copies of themselves, then those are replaced with generation 1. */
+    CHECK(SDL_InsertManyIntoHashTable(table, keys, values, 64, true), "bulk insert with replace failed: %s", SDL_GetError());
+    CHECK(has_all(table, 0, 32, 1, 1), "bulk insert with replace didn't keep the last values");
+    CHECK(counts.num_destroyed == 64, "bulk insert with replace destroyed %d items, expected 64", counts.num_destroyed);
+    CHECK(counts.destroyed_sum == 2 * (32 * 33 / 2), "bulk insert with replace destroyed the wrong items");
+
+    /* Duplicate and missing keys in a bulk lookup, more than one batch's worth. */
+    for (i = 0; i < 64; ++i) {
+        keys[i] = KEY((i * 7) % 48);
+    }
+    SDL_memset(found, 0xFF, sizeof(found));
+    {
+        int expected = 0;
+        const int num_found = SDL_FindManyInHashTable(table, keys, found, 64);
+        for (i = 0; i < 64; ++i) {
+            const int key = (i * 7) % 48;
+            if (key < 32) {
+                expected++;
+                CHECK(found[i] == VALUE(key, 1), "bulk lookup of key %d at %d returned the wrong value", key, i);
+            } else {
+                CHECK(found[i] == NULL, "bulk lookup of missing key %d at %d returned a value", key, i);
+            }
+        }
+        CHECK(num_found == expected, "bulk lookup found %d keys, expected %d", num_found, expected);
+    }
+
+    CHECK(SDL_FindManyInHashTable(table, keys, found, 0) == 0, "empty bulk lookup didn't return 0");
+    CHECK(SDL_InsertManyIntoHashTable(table, NULL, NULL, 0, false), "empty bulk insert failed");
+    CHECK(SDL_FindManyInHashTable(table, NULL, found, 1) == -1, "bulk lookup without keys didn't fail");
+    CHECK(!SDL_InsertManyIntoHashTable(table, keys, values, -1, false), "bulk insert with a negative count succeeded");
+
+    SDL_DestroyHashTable(table);
+}
+
+static void test_iterate(bool threadsafe)
+{
+    IterateState *state;
+    SDL_HashTable *table;
+    int i;
+
+    state = (IterateState *)SDL_calloc(1, sizeof(*state));
+    table = SDL_CreateHashTable(0, threadsafe, hash_colliding, keymatch_id, NULL, NULL);
+    CHECK(state && table, "setup failed: %s", SDL_GetError());
+    if (!state || !table) {
+        SDL_free(state);
+        SDL_DestroyHashTable(table);
+        return;
+    }
+
+    for (i = 0; i < NUM_KEYS; ++i) {
+        SDL_InsertIntoHashTable(table, KEY(i), VALUE(i, 0), false);
+    }
+    for (i = 0; i < NUM_KEYS; ++i) {
+        if ((i % 5) != 0) {
+            SDL_RemoveFromHashTable(table, KEY(i));
+        }
+    }
+
+    CHECK(SDL_IterateHashTable(table, iterate_item, state), "iteration failed");
+    CHECK(state->num_bad == 0, "iteration after deletes saw %d removed, repeated or wrong items", state->num_bad);
+    CHECK(state->num_seen == NUM_KEYS / 5, "iteration after deletes saw %d items, expected %d", state->num_seen, NUM_KEYS / 5);
+    for (i = 0; i < NUM_KEYS; i += 5) {
+        if (!state->seen[i]) {
+            CHECK(false, "iteration after deletes missed key %d", i);
+            break;
+        }
+    }
+
+    /* Stopping early. */
+    SDL_zerop(state);
+    state->stop_after = 10;
+    CHECK(SDL_IterateHashTable(table, iterate_item, state), "iteration failed");
+    CHECK(state->num_seen == 10, "iteration didn't stop when asked, saw %d items", state->num_seen);
+
+    /* Nothing left to see. */
+    for (i = 0; i < NUM_KEYS; i += 5) {
+        SDL_RemoveFromHashTable(table, KEY(i));
+    }
+    SDL_zerop(state);
+    CHECK(SDL_IterateHashTable(table, iterate_item, state), "iteration failed");
+    CHECK(state->num_seen == 0, "iteration of an emptied table saw %d items", state->num_seen);
+    CHECK(SDL_HashTableEmpty(table), "table isn't empty after removing everything");
+
+    SDL_DestroyHashTable(table);
+    SDL_free(state);
+}
+
+static int run_test(void)
+{
+    int i;
+
+    for (i = 0; i < 2; ++i) {
+        const bool threadsafe = (i == 1);
+
+        SDL_Log("Testing %s tables", threadsafe ? "threadsafe" : "unlocked");
+        test_insert_replace_remove(threadsafe, SDL_HashID);
+        test_insert_replace_remove(threadsafe, hash_colliding);
+        test_clear(threadsafe);
+        test_bulk(threadsafe);
+        test_iterate(threadsafe);
+    }
+    test_clear_out_of_memory();
+
+    if (failures) {
+        SDL_Log("%d checks failed", failures);
+        return 0;
+    }
+    SDL_Log("All tests passed");
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int result;
+    SDLTest_CommonState *state;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    result = run_test() ? 0 : 1;
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
@@ -0,0 +1,178 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for parsing binary files field by field
+
+   A file of fixed-layout records is written with the typed writers, then
+   parsed with the typed readers, once without a stream buffer and once with
+   one set by SDL_SetIOBufferSize(). The payload of each record is also read
+   with SDL_ReadU32LEArray() to compare it against reading one value at a
+   time.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define TEST_FILE "testiostreamperf.dat"
+#define PAYLOAD_COUNT 16
+
+static bool write_records(int num_records, size_t buffer_size)
+{
+    SDL_IOStream *io;
+    bool result = true;
+    int i, j;
+
+    io = SDL_IOFromFile(TEST_FILE, "wb");
+    if (!io) {
+        return false;
+    }
+    if (buffer_size > 0) {
+        SDL_SetIOBufferSize(io, buffer_size);
+    }
+    for (i = 0; i < num_records && result; ++i) {
+        result = SDL_WriteU32LE(io, (Uint32)i);
+        result = SDL_WriteU16BE(io, (Uint16)(i * 7)) && result;
+        result = SDL_WriteU8(io, (Uint8)i) && result;
+        result = SDL_WriteS64LE(io, (Sint64)i * -1000) && result;
+        for (j = 0; j < PAYLOAD_COUNT; ++j) {
+            result = SDL_WriteU32LE(io, (Uint32)(i + j)) && result;
+        }
+    }
+    if (!SDL_CloseIO(io)) {
+        result = false;
+    }
+    return result;
+}
+
+static bool parse_records(int num_records, size_t buffer_size, bool bulk, Uint64 *checksum)
+{
+    SDL_IOStream *io;
+    Uint32 id, payload[PAYLOAD_COUNT];
+    Uint16 flags;
+    Uint8 kind;
+    Sint64 timestamp;
+    Uint64 sum = 0;
+    bool result = true;
+    int i, j;
+
+    io = SDL_IOFromFile(TEST_FILE, "rb");
+    if (!io) {
+        return false;
+    }
+    if (buffer_size > 0) {
+        SDL_SetIOBufferSize(io, buffer_size);
+    }
+    for (i = 0; i < num_records && result; ++i) {
+        result = SDL_ReadU32LE(io, &id);
+        result = SDL_ReadU16BE(io, &flags) && result;
+        result = SDL_ReadU8(io, &kind) && result;
+        result = SDL_ReadS64LE(io, &timestamp) && result;
+        if (bulk) {
+            result = SDL_ReadU32LEArray(io, payload, PAYLOAD_COUNT) && result;
+        } else {
+            for (j = 0; j < PAYLOAD_COUNT; ++j) {
+                result = SDL_ReadU32LE(io, &payload[j]) && result;
+            }
+        }
+        sum += id + flags + kind + (Uint64)timestamp;
+        for (j = 0; j < PAYLOAD_COUNT; ++j) {
+            sum += payload[j];
+        }
+    }
+    SDL_CloseIO(io);
+    *checksum = sum;
+    return result;
+}
+
+static void run_parse(const char *name, int num_records, size_t buffer_size, bool bulk)
+{
+    Uint64 start, elapsed, checksum = 0;
+
+    start = SDL_GetTicksNS();
+    if (!parse_records(num_records, buffer_size, bulk, &checksum)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: parsing failed: %s", name, SDL_GetError());
+        return;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-32s %8.2f ms, %6.1f ns per field (checksum %" SDL_PRIu64 ")", name,
+            (double)elapsed / SDL_NS_PER_MS, (double)elapsed / ((double)num_records * (4 + PAYLOAD_COUNT)), checksum);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int num_records = 500000;
+    int buffer_size = 64 * 1024;
+    Uint64 start;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--records") == 0 && argv[i + 1]) {
+                num_records = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--buffer") == 0 && argv[i + 1]) {
+                buffer_size = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--records N]", "[--buffer BYTES]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    start = SDL_GetTicksNS();
+    if (!write_records(num_records, 0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s", TEST_FILE, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Log("%-32s %8.2f ms", "Write, unbuffered", (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS);
+
+    start = SDL_GetTicksNS();
+    if (!write_records(num_records, (size_t)buffer_size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s", TEST_FILE, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Log("%-32s %8.2f ms", "Write, buffered", (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS);
+
+    run_parse("Read, unbuffered", num_records, 0, false);
+    run_parse("Read, buffered", num_records, (size_t)buffer_size, false);
+    run_parse("Read, unbuffered, bulk payload", num_records, 0, true);
+    run_parse("Read, buffered, bulk payload", num_records, (size_t)buffer_size, true);
+
+    SDL_RemovePath(TEST_FILE);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,229 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for loading large files
+
+   A file is loaded with SDL_LoadFile(), which reads it into a heap buffer,
+   and with SDL_LoadFileNoCopy(), which maps it where the platform allows.
+   Each load is timed on its own and again including a pass over every byte,
+   and the growth in resident memory is reported where it can be measured.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#ifdef SDL_PLATFORM_LINUX
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+/* Resident memory in bytes, or -1 if it can't be measured */
+static Sint64 get_resident_memory(void)
+{
+#ifdef SDL_PLATFORM_LINUX
+    long pages = -1;
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (fp) {
+        long size;
+        if (fscanf(fp, "%ld %ld", &size, &pages) != 2) {
+            pages = -1;
+        }
+        fclose(fp);
+    }
+    if (pages >= 0) {
+        return (Sint64)pages * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+static Uint64 checksum(const void *data, size_t size)
+{
+    const Uint8 *bytes = (const Uint8 *)data;
+    Uint64 sum = 0;
+    size_t i;
+
+    for (i = 0; i < size; ++i) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+static bool create_file(const char *file, Sint64 size)
+{
+    SDL_IOStream *io;
+    Uint8 *chunk;
+    const size_t chunk_size = 1024 * 1024;
+    Sint64 written = 0;
+    size_t i;
+    bool result = true;
+
+    chunk = (Uint8 *)SDL_malloc(chunk_size);
+    if (!chunk) {
+        return false;
+    }
+    for (i = 0; i < chunk_size; ++i) {
+        chunk[i] = (Uint8)(i * 31);
+    }
+
+    io = SDL_IOFromFile(file, "wb");
+    if (!io) {
+        SDL_free(chunk);
+        return false;
+    }
+    while (written < size && result) {
+        const size_t amount = (size_t)SDL_min((Sint64)chunk_size, size - written);
+        result = (SDL_WriteIO(io, chunk, amount) == amount);
+        written += amount;
+    }
+    if (!SDL_CloseIO(io)) {
+        result = false;
+    }
+    SDL_free(chunk);
+    return result;
+}
+
+static void report(const char *name, Uint64 load_ns, Uint64 total_ns, Sint64 rss_before, Sint64 rss_after)
+{
+    if (rss_before >= 0 && rss_after >= 0) {
+        SDL_Log("%-20s load %8.2f ms, load + read %8.2f ms, resident memory +%.1f MB",
+                name, (double)load_ns / SDL_NS_PER_MS, (double)total_ns / SDL_NS_PER_MS,
+                (double)(rss_after - rss_before) / (1024.0 * 1024.0));
+    } else {
+        SDL_Log("%-20s load %8.2f ms, load + read %8.2f ms",
+                name, (double)load_ns / SDL_NS_PER_MS, (double)total_ns / SDL_NS_PER_MS);
+    }
+}
+
+static bool run_load_file(const char *file)
+{
+    Sint64 rss_before, rss_after;
+    Uint64 start, loaded, finished;
+    size_t size = 0;
+    void *data;
+    Uint64 sum;
+
+    rss_before = get_resident_memory();
+    start = SDL_GetTicksNS();
+    data = SDL_LoadFile(file, &size);
+    loaded = SDL_GetTicksNS();
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", file, SDL_GetError());
+        return false;
+    }
+    sum = checksum(data, size);
+    finished = SDL_GetTicksNS();
+    rss_after = get_resident_memory();
+    SDL_free(data);
+
+    report("SDL_LoadFile", loaded - start, finished - start, rss_before, rss_after);
+    return sum != 0;
+}
+
+static bool run_load_file_no_copy(const char *file)
+{
+    Sint64 rss_before, rss_after;
+    Uint64 start, loaded, finished;
+    SDL_ReleaseFileDataCallback release;
+    void *userdata;
+    size_t size = 0;
+    const void *data;
+    Uint64 sum;
+
+    rss_before = get_resident_memory();
+    start = SDL_GetTicksNS();
+    data = SDL_LoadFileNoCopy(file, &size, &release, &userdata);
+    loaded = SDL_GetTicksNS();
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", file, SDL_GetError());
+        return false;
+    }
+    sum = checksum(data, size);
+    finished = SDL_GetTicksNS();
+    rss_after = get_resident_memory();
+    release(userdata, data);
+
+    report("SDL_LoadFileNoCopy", loaded - start, finished - start, rss_before, rss_after);
+    return sum != 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *file = NULL;
+    bool created = false;
+    int size_mb = 256;
+    int iterations = 3;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                size_mb = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (!file && argv[i][0] != '-') {
+                file = argv[i];
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--size MEGABYTES]", "[--iterations N]", "[file]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    if (!file) {
+        file = "testloadfileperf.dat";
+        SDL_Log("Creating a %d MB test file", size_mb);
+        if (!create_file(file, (Sint64)size_mb * 1024 * 1024)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create %s: %s", file, SDL_GetError());
+            SDL_Quit();
+            return 1;
+        }
+        created = true;
+    }
+
+    /* The first pass of each warms the page cache, so the file isn't read from disk */
+    for (i = 0; i < iterations; ++i) {
+        if (!run_load_file(file) || !run_load_file_no_copy(file)) {
+            break;
+        }
+    }
+
+    if (created) {
+        SDL_RemovePath(file);
+    }
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for reading properties from many threads while another thread
+   keeps changing them
+
+   Each run is done twice: once with plain lock-free reads, and once with
+   every read wrapped in SDL_LockProperties(), which serializes the readers
+   on the properties mutex the way every read used to.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define NUM_PROPERTIES 64
+
+static SDL_PropertiesID props;
+static char names[NUM_PROPERTIES][32];
+static SDL_AtomicInt running;
+static bool use_locks;
+
+typedef struct
+{
+    SDL_Thread *thread;
+    Uint64 reads;
+    Uint64 checksum;
+} Reader;
+
+static int SDLCALL reader_thread(void *data)
+{
+    Reader *reader = (Reader *)data;
+    Uint64 reads = 0;
+    Uint64 checksum = 0;
+    int i = 0;
+
+    while (SDL_GetAtomicInt(&running)) {
+        if (use_locks) {
+            SDL_LockProperties(props);
+        }
+        checksum += (uintptr_t)SDL_GetPointerProperty(props, names[i], NULL);
+        checksum += SDL_strlen(SDL_GetStringProperty(props, names[i], ""));
+        if (use_locks) {
+            SDL_UnlockProperties(props);
+        }
+        reads += 2;
+        i = (i + 1) % NUM_PROPERTIES;
+    }
+
+    reader->reads = reads;
+    reader->checksum = checksum;
+    return 0;
+}
+
+static bool run_benchmark(int num_threads, int duration_ms, int write_interval_us)
+{
+    Reader *readers;
+    Uint64 start, elapsed, total_reads = 0;
+    int writes = 0;
+    int i;
+
+    readers = (Reader *)SDL_calloc(num_threads, sizeof(*readers));
+    if (!readers) {
+        return false;
+    }
+
+    SDL_SetAtomicInt(&running, 1);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        readers[i].thread = SDL_CreateThread(reader_thread, "reader", &readers[i]);
+        if (!readers[i].thread) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create thread: %s", SDL_GetError());
+            num_threads = i;
+            break;
+        }
+    }
+
+    /* Keep replacing the pointer properties while the readers run. The strings
+       are left alone, since a string returned without holding the lock could
+       be freed by a write while the reader is still looking at it. */
+    while ((SDL_GetTicksNS() - start) < (Uint64)duration_ms * SDL_NS_PER_MS) {
+        const int which = ((writes * 2) + 1) % NUM_PROPERTIES;
+        SDL_SetPointerProperty(props, names[which], (void *)(uintptr_t)(writes + 1));
+        writes++;
+        if (write_interval_us > 0) {
+            SDL_DelayNS((Uint64)write_interval_us * SDL_NS_PER_US);
+        }
+    }
+
+    SDL_SetAtomicInt(&running, 0);
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(readers[i].thread, NULL);
+        total_reads += readers[i].reads;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%2d threads, %s: %8.2f million reads/s, %6.1f ns/read per thread, %6d writes",
+            num_threads, use_locks ? "locked   " : "lock-free",
+            (double)total_reads / ((double)elapsed / SDL_NS_PER_SECOND) / 1000000.0,
+            total_reads ? ((double)elapsed * num_threads / total_reads) : 0.0,
+            writes);
+
+    SDL_free(readers);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int max_threads = 8;
+    int duration_ms = 500;
+    int write_interval_us = 100;
+    int num_threads;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--ms") == 0 && argv[i + 1]) {
+                duration_ms = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--write-interval") == 0 && argv[i + 1]) {
+                write_interval_us = SDL_max(SDL_atoi(argv[i + 1]), 0);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-threads N]", "[--ms N]", "[--write-interval MICROSECONDS]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    props = SDL_CreateProperties();
+    if (!props) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create properties: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < NUM_PROPERTIES; ++i) {
+        SDL_snprintf(names[i], sizeof(names[i]), "benchmark.property.%d", i);
+        if (i % 2) {
+            SDL_SetPointerProperty(props, names[i], (void *)(uintptr_t)(i + 1));
+        } else {
+            SDL_SetStringProperty(props, names[i], "initial");
+        }
+    }
+
+    SDL_Log("%d CPUs, a write every %d us", SDL_GetNumLogicalCPUCores(), write_interval_us);
+
+    for (num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        use_locks = false;
+        if (!run_benchmark(num_threads, duration_ms, write_interval_us)) {
+            break;
+        }
+        use_locks = true;
+        if (!run_benchmark(num_threads, duration_ms, write_interval_us)) {
+            break;
+        }
+    }
+
+    SDL_DestroyProperties(props);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -37,6 +37,7 @@ static Uint64 next_fps_check;
 static Uint32 frames;
 static const int fps_check_delay = 5000;
 static int use_rendergeometry = 0;
+static bool use_batch;
 static bool suspend_when_occluded;
 
 /* Number of iterations to move sprites - used for visual tests. */
@@ -231,7 +232,10 @@ static void MoveSprites(SDL_Renderer *renderer, SDL_Texture *sprite)
     }
 
     /* Draw sprites */
-    if (use_rendergeometry == 0) {
+    if (use_batch) {
+        /* Submit all the sprites in a single call */
+        SDL_RenderTextures(renderer, sprite, NULL, positions, NULL, NULL, NULL, num_sprites);
+    } else if (use_rendergeometry == 0) {
         for (i = 0; i < num_sprites; ++i) {
             position = &positions[i];
 
@@ -454,6 +458,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
             } else if (SDL_strcasecmp(argv[i], "--cyclealpha") == 0) {
                 cycle_alpha = true;
                 consumed = 1;
+            } else if (SDL_strcasecmp(argv[i], "--batch") == 0) {
+                use_batch = true;
+                consumed = 1;
             } else if (SDL_strcasecmp(argv[i], "--suspend-when-occluded") == 0) {
                 suspend_when_occluded = true;
                 consumed = 1;
@@ -485,6 +492,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                 "[--cyclecolor]",
                 "[--cyclealpha]",
                 "[--suspend-when-occluded]",
+                "[--batch]",
                 "[--iterations N]",
                 "[--use-rendergeometry mode1|mode2]",
                 "[num_sprites]",
@@ -0,0 +1,294 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for the software renderer with a growing number of tile threads
+
+   The same scene is drawn into an offscreen surface with every thread count,
+   and the result is checked against the single threaded renderer.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define NUM_RECTS     200
+#define NUM_SPRITES   300
+#define NUM_TRIANGLES 200
+#define NUM_LINES     50
+#define NUM_POINTS    2000
+#define SPRITE_SIZE   48
+
+typedef struct
+{
+    SDL_FRect rects[NUM_RECTS];
+    SDL_Color rect_colors[NUM_RECTS];
+    SDL_FRect sprites[NUM_SPRITES];
+    SDL_Vertex triangles[NUM_TRIANGLES * 3];
+    SDL_FPoint lines[NUM_LINES * 2];
+    SDL_FPoint points[NUM_POINTS];
+} Scene;
+
+static Scene scene;
+static Uint64 seed = 1;
+
+static float rand_float(float max)
+{
+    return (float)SDL_rand_r(&seed, (Sint32)max);
+}
+
+static Uint8 rand_byte(void)
+{
+    return (Uint8)SDL_rand_r(&seed, 256);
+}
+
+static void create_scene(int w, int h)
+{
+    int i;
+
+    for (i = 0; i < NUM_RECTS; ++i) {
+        scene.rects[i].x = rand_float((float)w) - 50.0f;
+        scene.rects[i].y = rand_float((float)h) - 50.0f;
+        scene.rects[i].w = 20.0f + rand_float(200.0f);
+        scene.rects[i].h = 20.0f + rand_float(200.0f);
+        scene.rect_colors[i].r = rand_byte();
+        scene.rect_colors[i].g = rand_byte();
+        scene.rect_colors[i].b = rand_byte();
+        scene.rect_colors[i].a = rand_byte();
+    }
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        scene.sprites[i].x = rand_float((float)w) - SPRITE_SIZE / 2;
+        scene.sprites[i].y = rand_float((float)h) - SPRITE_SIZE / 2;
+        scene.sprites[i].w = SPRITE_SIZE;
+        scene.sprites[i].h = SPRITE_SIZE;
+    }
+    for (i = 0; i < NUM_TRIANGLES * 3; ++i) {
+        const int corner = i % 3;
+        SDL_Vertex *vertex = &scene.triangles[i];
+        if (corner == 0) {
+            vertex->position.x = rand_float((float)w);
+            vertex->position.y = rand_float((float)h);
+        } else {
+            vertex->position.x = scene.triangles[i - corner].position.x + rand_float(300.0f) - 150.0f;
+            vertex->position.y = scene.triangles[i - corner].position.y + rand_float(300.0f) - 150.0f;
+        }
+        vertex->color.r = rand_byte() / 255.0f;
+        vertex->color.g = rand_byte() / 255.0f;
+        vertex->color.b = rand_byte() / 255.0f;
+        vertex->color.a = rand_byte() / 255.0f;
+        vertex->tex_coord.x = (corner == 1) ? 1.0f : 0.0f;
+        vertex->tex_coord.y = (corner == 2) ? 1.0f : 0.0f;
+    }
+    for (i = 0; i < NUM_LINES * 2; ++i) {
+        scene.lines[i].x = rand_float((float)w);
+        scene.lines[i].y = rand_float((float)h);
+    }
+    for (i = 0; i < NUM_POINTS; ++i) {
+        scene.points[i].x = rand_float((float)w);
+        scene.points[i].y = rand_float((float)h);
+    }
+}
+
+static SDL_Texture *create_sprite(SDL_Renderer *renderer)
+{
+    SDL_Texture *texture;
+    SDL_Surface *surface;
+    int x, y;
+
+    surface = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return NULL;
+    }
+    for (y = 0; y < SPRITE_SIZE; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < SPRITE_SIZE; ++x) {
+            const Uint8 a = (Uint8)((x + y) * 255 / (2 * SPRITE_SIZE - 2));
+            row[x] = ((Uint32)a << 24) | (((x / 8 + y / 8) & 1) ? 0xFF8020 : 0x2080FF);
+        }
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+static void draw_scene(SDL_Renderer *renderer, SDL_Texture *sprite, int w, int h)
+{
+    SDL_Rect clip;
+    int i;
+
+    SDL_SetRenderDrawColor(renderer, 32, 32, 48, 255);
+    SDL_RenderClear(renderer);
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < NUM_RECTS; ++i) {
+        const SDL_Color *color = &scene.rect_colors[i];
+        SDL_SetRenderDrawColor(renderer, color->r, color->g, color->b, color->a);
+        SDL_RenderFillRect(renderer, &scene.rects[i]);
+    }
+
+    SDL_RenderGeometry(renderer, NULL, scene.triangles, NUM_TRIANGLES * 3, NULL, 0);
+
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        SDL_SetTextureAlphaMod(sprite, (Uint8)(128 + (i % 128)));
+        SDL_RenderTexture(renderer, sprite, NULL, &scene.sprites[i]);
+    }
+
+    clip.x = w / 4;
+    clip.y = h / 4;
+    clip.w = w / 2;
+    clip.h = h / 2;
+    SDL_SetRenderClipRect(renderer, &clip);
+    SDL_RenderGeometry(renderer, sprite, scene.triangles, NUM_TRIANGLES * 3, NULL, 0);
+    SDL_SetRenderClipRect(renderer, NULL);
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 160);
+    SDL_RenderLines(renderer, scene.lines, NUM_LINES * 2);
+    SDL_RenderPoints(renderer, scene.points, NUM_POINTS);
+}
+
+static Uint64 checksum_surface(SDL_Surface *surface)
+{
+    Uint64 checksum = 0;
+    int x, y;
+
+    for (y = 0; y < surface->h; ++y) {
+        const Uint32 *row = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; ++x) {
+            checksum = (checksum * 31) + row[x];
+        }
+    }
+    return checksum;
+}
+
+static bool run_benchmark(SDL_Surface *surface, int num_threads, int duration_ms, Uint64 *checksum)
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    Uint64 start, elapsed;
+    int frames = 0;
+    char threads[16];
+
+    SDL_snprintf(threads, sizeof(threads), "%d", num_threads);
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+
+    renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create renderer: %s", SDL_GetError());
+        return false;
+    }
+    sprite = create_sprite(renderer);
+    if (!sprite) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create texture: %s", SDL_GetError());
+        SDL_DestroyRenderer(renderer);
+        return false;
+    }
+
+    draw_scene(renderer, sprite, surface->w, surface->h);
+    SDL_FlushRenderer(renderer);
+    *checksum = checksum_surface(surface);
+
+    start = SDL_GetTicksNS();
+    do {
+        draw_scene(renderer, sprite, surface->w, surface->h);
+        SDL_FlushRenderer(renderer);
+        frames++;
+        elapsed = SDL_GetTicksNS() - start;
+    } while (elapsed < (Uint64)duration_ms * SDL_NS_PER_MS);
+
+    SDL_Log("%2d threads: %8.2f frames/s, %7.3f ms/frame, checksum %016" SDL_PRIx64,
+            num_threads, (double)frames / ((double)elapsed / SDL_NS_PER_SECOND),
+            (double)elapsed / frames / SDL_NS_PER_MS, *checksum);
+
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyRenderer(renderer);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *surface;
+    int max_threads = 8;
+    int duration_ms = 1000;
+    int width = 1280;
+    int height = 720;
+    Uint64 expected = 0;
+    int num_threads;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--ms") == 0 && argv[i + 1]) {
+                duration_ms = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && argv[i + 2]) {
+                width = SDL_max(SDL_atoi(argv[i + 1]), 1);
+                height = SDL_max(SDL_atoi(argv[i + 2]), 1);
+                consumed = 3;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-threads N]", "[--ms N]", "[--size W H]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_XRGB8888);
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    create_scene(width, height);
+
+    SDL_Log("%d CPUs, %dx%d", SDL_GetNumLogicalCPUCores(), width, height);
+
+    /* 0 is the plain single threaded renderer, everything else is checked against it */
+    for (num_threads = 0; num_threads <= max_threads; num_threads = num_threads ? (num_threads * 2) : 1) {
+        Uint64 checksum;
+        if (!run_benchmark(surface, num_threads, duration_ms, &checksum)) {
+            result = 1;
+            break;
+        }
+        if (num_threads == 0) {
+            expected = checksum;
+        } else if (checksum != expected) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d threads drew a different image!", num_threads);
+            result = 1;
+        }
+    }
+
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
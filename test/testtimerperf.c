@@ -0,0 +1,187 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark for the cost of adding, removing and firing timers as the
+   number of active timers grows, and for how late timers fire when some
+   callbacks are slow
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static SDL_AtomicInt fired;
+static Uint64 total_lateness; /* only touched by the timer thread until all timers have fired */
+
+static Uint64 SDLCALL
+oneshot(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    const Uint64 scheduled = (Uint64)(uintptr_t)param;
+    const Uint64 now = SDL_GetTicksNS();
+
+    if (now > scheduled) {
+        total_lateness += (now - scheduled);
+    }
+    SDL_AddAtomicInt(&fired, 1);
+    return 0;
+}
+
+static Uint64 SDLCALL
+never(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    return interval;
+}
+
+static Uint64 SDLCALL
+slow(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    SDL_DelayNS(interval / 2);
+    return interval;
+}
+
+static Uint64 SDLCALL
+fast(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    return interval;
+}
+
+static double ns_per_op(Uint64 elapsed, int count)
+{
+    return count ? ((double)elapsed / count) : 0.0;
+}
+
+static bool run_benchmark(int count)
+{
+    SDL_TimerID *ids;
+    Uint64 start, elapsed_add, elapsed_remove, elapsed_fire;
+    const Uint64 spread = 50 * SDL_NS_PER_MS;
+    int i;
+
+    ids = (SDL_TimerID *)SDL_malloc(count * sizeof(*ids));
+    if (!ids) {
+        return false;
+    }
+
+    /* Add and remove timers that never fire */
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        ids[i] = SDL_AddTimerNS(SDL_NS_PER_SECOND * 1000 + i, never, NULL);
+        if (!ids[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't add timer: %s", SDL_GetError());
+            SDL_free(ids);
+            return false;
+        }
+    }
+    elapsed_add = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_RemoveTimer(ids[i]);
+    }
+    elapsed_remove = SDL_GetTicksNS() - start;
+
+    /* Fire one-shot timers spread over a short window */
+    SDL_SetAtomicInt(&fired, 0);
+    total_lateness = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        const Uint64 interval = 1 + (spread * (Uint64)i) / count;
+        SDL_AddTimerNS(interval, oneshot, (void *)(uintptr_t)(SDL_GetTicksNS() + interval));
+    }
+    while (SDL_GetAtomicInt(&fired) < count) {
+        SDL_Delay(1);
+    }
+    elapsed_fire = SDL_GetTicksNS() - start;
+
+    SDL_Log("%6d timers: add %8.1f ns/timer, remove %8.1f ns/timer, fire all %7.2f ms (%.1f us average lateness)",
+            count, ns_per_op(elapsed_add, count), ns_per_op(elapsed_remove, count),
+            (double)elapsed_fire / SDL_NS_PER_MS, (double)total_lateness / SDL_NS_PER_US / count);
+
+    SDL_free(ids);
+    return true;
+}
+
+static void run_jitter_benchmark(void)
+{
+    SDL_TimerStatistics stats;
+    SDL_TimerID ids[8];
+    int i;
+
+    /* A few slow callbacks compete with fast ones for the timer thread */
+    for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+        ids[i] = SDL_AddTimerNS(2 * SDL_NS_PER_MS, (i < 2) ? slow : fast, NULL);
+    }
+    SDL_GetTimerStatistics(&stats, true);
+    SDL_Delay(500);
+    SDL_GetTimerStatistics(&stats, true);
+    for (i = 0; i < (int)SDL_arraysize(ids); ++i) {
+        SDL_RemoveTimer(ids[i]);
+    }
+
+    SDL_Log("Jitter with %s worker threads: %" SDL_PRIu64 " callbacks, %.1f us average lateness, %.1f us max lateness",
+            SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS) ? SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS) : "0",
+            stats.num_callbacks,
+            stats.num_callbacks ? ((double)stats.total_lateness / SDL_NS_PER_US / stats.num_callbacks) : 0.0,
+            (double)stats.max_lateness / SDL_NS_PER_US);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int counts[] = { 100, 1000, 10000, 50000 };
+    SDLTest_CommonState *state;
+    int max_count = 50000;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-timers") == 0 && argv[i + 1]) {
+                max_count = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--workers") == 0 && argv[i + 1]) {
+                SDL_SetHint(SDL_HINT_TIMER_WORKER_THREADS, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-timers N]", "[--workers N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    for (i = 0; i < (int)SDL_arraysize(counts) && counts[i] <= max_count; ++i) {
+        if (!run_benchmark(counts[i])) {
+            break;
+        }
+    }
+    run_jitter_benchmark();
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}